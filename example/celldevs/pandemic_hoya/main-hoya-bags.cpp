@@ -0,0 +1,117 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * Measures the time and the allocations of the hoya scenario with the message bags chosen when
+ * compiling. Build it twice, with '-DCADMIUM_MESSAGE_BAG_INLINE_CAPACITY=1' and without it, to
+ * compare bags keeping one message inside with std::vector bags. Both builds must print the same
+ * states digest. Allocations are counted with the operator new of allocation_counter.hpp.
+ */
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <cadmium/modeling/dynamic_coupled.hpp>
+#include <cadmium/modeling/dynamic_flattened_coupled.hpp>
+#include <cadmium/engine/pdevs_dynamic_runner.hpp>
+#include <cadmium/logger/common_loggers.hpp>
+#include "hoya_coupled.hpp"
+#include "allocation_counter.hpp"
+
+using namespace std;
+using namespace cadmium;
+using namespace cadmium::celldevs;
+
+using TIME = double;
+
+struct run_result {
+    double build_seconds;
+    std::size_t build_allocations;
+    double run_seconds;
+    std::size_t run_allocations;
+    std::size_t states_digest;
+};
+
+run_result run_scenario(std::string const &scenario_config_file_path, TIME sim_time, bool flattened) {
+    run_result result{};
+    auto start = std::chrono::steady_clock::now();
+    std::size_t allocations_before = allocations.load();
+    hoya_coupled<TIME> test = hoya_coupled<TIME>("pandemic_hoya");
+    test.add_lattice_json(scenario_config_file_path);
+    test.couple_cells();
+    std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> t = std::make_shared<hoya_coupled<TIME>>(test);
+    std::unique_ptr<cadmium::dynamic::engine::runner<TIME, logger::not_logger>> r;
+    if (flattened) {
+        r = std::make_unique<cadmium::dynamic::engine::runner<TIME, logger::not_logger>>(t, TIME(0), cadmium::dynamic::engine::flatten_hierarchy);
+    } else {
+        r = std::make_unique<cadmium::dynamic::engine::runner<TIME, logger::not_logger>>(t, TIME(0));
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    result.build_seconds = elapsed.count();
+    result.build_allocations = allocations.load() - allocations_before;
+
+    start = std::chrono::steady_clock::now();
+    allocations_before = allocations.load();
+    r->run_until(sim_time);
+    elapsed = std::chrono::steady_clock::now() - start;
+    result.run_seconds = elapsed.count();
+    result.run_allocations = allocations.load() - allocations_before;
+
+    for (const auto& m : cadmium::dynamic::modeling::flatten<TIME>(t).atomics) {
+        auto atomic = std::dynamic_pointer_cast<cadmium::dynamic::modeling::atomic_abstract<TIME>>(m);
+        result.states_digest = result.states_digest * 31 + std::hash<std::string>()(atomic->model_state_as_string());
+    }
+    return result;
+}
+
+void print_result(std::string const &name, run_result const &result, TIME sim_time) {
+    cout << name << ": built in " << result.build_seconds << " s with " << result.build_allocations << " allocations, "
+         << "simulated in " << result.run_seconds << " s with " << result.run_allocations / sim_time << " allocations per day" << endl;
+}
+
+int main(int argc, char ** argv) {
+    if (argc < 2) {
+        cout << "Program used with wrong parameters. The program must be invoked as follows:";
+        cout << argv[0] << " SCENARIO_CONFIG.json [MAX_SIMULATION_TIME (default: 200)]" << endl;
+        return -1;
+    }
+    std::string scenario_config_file_path = argv[1];
+    TIME sim_time = (argc > 2)? atof(argv[2]) : 200;
+    counting = true;
+
+    cout << "messages kept inside the bags: " << CADMIUM_MESSAGE_BAG_INLINE_CAPACITY << endl;
+    run_result hierarchical = run_scenario(scenario_config_file_path, sim_time, false);
+    print_result("hierarchical", hierarchical, sim_time);
+    run_result flattened = run_scenario(scenario_config_file_path, sim_time, true);
+    print_result("flattened", flattened, sim_time);
+    cout << "states digest: " << hierarchical.states_digest << endl;
+    if (hierarchical.states_digest != flattened.states_digest) {
+        cout << "the flattened simulation reached different states" << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,131 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * What-if analysis of the hoya scenario: simulates the common days once and then branches the
+ * simulation into several policies reducing the virulence, each one continuing in a forked process.
+ * Compares it with simulating every policy from the start, both must reach the same results.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cadmium/modeling/dynamic_coupled.hpp>
+#include <cadmium/modeling/dynamic_flattened_coupled.hpp>
+#include <cadmium/engine/pdevs_dynamic_runner.hpp>
+#include <cadmium/engine/pdevs_dynamic_branching.hpp>
+#include <cadmium/logger/common_loggers.hpp>
+#include "hoya_coupled.hpp"
+
+using namespace std;
+using namespace cadmium;
+using namespace cadmium::celldevs;
+
+using TIME = double;
+using runner_type = cadmium::dynamic::engine::runner<TIME, logger::not_logger>;
+
+std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> build_scenario(std::string const &scenario_config_file_path) {
+    hoya_coupled<TIME> test = hoya_coupled<TIME>("pandemic_hoya");
+    test.add_lattice_json(scenario_config_file_path);
+    test.couple_cells();
+    return std::make_shared<hoya_coupled<TIME>>(test);
+}
+
+std::vector<std::shared_ptr<hoya_cell<TIME>>> cells_of(std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> const &t) {
+    std::vector<std::shared_ptr<hoya_cell<TIME>>> cells;
+    for (const auto& m : cadmium::dynamic::modeling::flatten<TIME>(t).atomics) {
+        cells.push_back(std::dynamic_pointer_cast<hoya_cell<TIME>>(m));
+    }
+    return cells;
+}
+
+// the policy of each branch reduces the virulence by 10% more than the previous one
+void apply_policy(std::vector<std::shared_ptr<hoya_cell<TIME>>> const &cells, std::size_t policy) {
+    for (auto const &cell: cells) {
+        cell->virulence *= 1 - 0.1 * policy;
+    }
+}
+
+std::string infected(std::vector<std::shared_ptr<hoya_cell<TIME>>> const &cells) {
+    double total = 0;
+    for (auto const &cell: cells) {
+        total += cell->state.current_state.infected * cell->state.current_state.population;
+    }
+    std::ostringstream out;
+    out << total;
+    return out.str();
+}
+
+int main(int argc, char ** argv) {
+    if (argc < 2) {
+        cout << "Program used with wrong parameters. The program must be invoked as follows:";
+        cout << argv[0] << " SCENARIO_CONFIG.json [BRANCH_TIME (default: 20)] [MAX_SIMULATION_TIME (default: 60)] [POLICIES (default: 8)]" << endl;
+        return -1;
+    }
+    std::string scenario_config_file_path = argv[1];
+    TIME branch_time = (argc > 2)? atof(argv[2]) : 20;
+    TIME sim_time = (argc > 3)? atof(argv[3]) : 60;
+    std::size_t policies = (argc > 4)? atoi(argv[4]) : 8;
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::string> from_start;
+    for (std::size_t p = 0; p < policies; p++) {
+        auto model = build_scenario(scenario_config_file_path);
+        auto cells = cells_of(model);
+        runner_type r(model, {0});
+        r.run_until(branch_time);
+        apply_policy(cells, p);
+        r.run_until(sim_time);
+        from_start.push_back(infected(cells));
+    }
+    std::chrono::duration<double> from_start_time = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    auto model = build_scenario(scenario_config_file_path);
+    auto cells = cells_of(model);
+    runner_type r(model, {0});
+    r.run_until(branch_time);
+    std::vector<std::string> branched = cadmium::dynamic::engine::branch(r, policies, [&cells, sim_time](std::size_t p, runner_type &branch_runner) {
+        apply_policy(cells, p);
+        branch_runner.run_until(sim_time);
+        return infected(cells);
+    });
+    std::chrono::duration<double> branched_time = std::chrono::steady_clock::now() - start;
+
+    for (std::size_t p = 0; p < policies; p++) {
+        cout << "policy " << p << ": " << branched[p] << " infected" << endl;
+    }
+    cout << "every policy from the start: " << from_start_time.count() << " s" << endl;
+    cout << "branched at time " << branch_time << ": " << branched_time.count() << " s" << endl;
+    cout << "speedup: " << from_start_time.count() / branched_time.count() << endl;
+    if (from_start != branched) {
+        cout << "the branches reached different results" << endl;
+        return 1;
+    }
+    return 0;
+}
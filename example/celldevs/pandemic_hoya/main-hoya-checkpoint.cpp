@@ -0,0 +1,112 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * Simulates the scenario writing checkpoints until the middle of the simulation, then restores a new
+ * runner from the checkpoint file and finishes the simulation with it. The restored simulation must
+ * reach the same states than a simulation without interruptions.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cadmium/modeling/dynamic_coupled.hpp>
+#include <cadmium/modeling/dynamic_flattened_coupled.hpp>
+#include <cadmium/engine/pdevs_dynamic_runner.hpp>
+#include <cadmium/logger/common_loggers.hpp>
+#include "hoya_coupled.hpp"
+
+using namespace std;
+using namespace cadmium;
+using namespace cadmium::celldevs;
+
+using TIME = double;
+
+std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> build_scenario(std::string const &scenario_config_file_path) {
+    hoya_coupled<TIME> test = hoya_coupled<TIME>("pandemic_hoya");
+    test.add_lattice_json(scenario_config_file_path);
+    test.couple_cells();
+    return std::make_shared<hoya_coupled<TIME>>(test);
+}
+
+std::vector<std::string> states(std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> const &t) {
+    std::vector<std::string> result;
+    for (const auto& m : cadmium::dynamic::modeling::flatten<TIME>(t).atomics) {
+        auto atomic = std::dynamic_pointer_cast<cadmium::dynamic::modeling::atomic_abstract<TIME>>(m);
+        result.push_back(atomic->get_id() + ": " + atomic->model_state_as_string());
+    }
+    return result;
+}
+
+int main(int argc, char ** argv) {
+    if (argc < 2) {
+        cout << "Program used with wrong parameters. The program must be invoked as follows:";
+        cout << argv[0] << " SCENARIO_CONFIG.json [MAX_SIMULATION_TIME (default: 200)] [STEPS_BETWEEN_CHECKPOINTS (default: 10)]" << endl;
+        return -1;
+    }
+    std::string scenario_config_file_path = argv[1];
+    TIME sim_time = (argc > 2)? atof(argv[2]) : 200;
+    std::size_t steps = (argc > 3)? atoi(argv[3]) : 10;
+    std::string checkpoint_path = "output/pandemic_hoya_checkpoint.bin";
+
+    auto straight_model = build_scenario(scenario_config_file_path);
+    cadmium::dynamic::engine::runner<TIME, logger::not_logger> straight(straight_model, {0});
+    auto start = std::chrono::steady_clock::now();
+    straight.run_until(sim_time / 2);
+    std::chrono::duration<double> first_half = std::chrono::steady_clock::now() - start;
+    straight.run_until(sim_time);
+
+    double checkpointed_seconds;
+    {
+        auto checkpointed_model = build_scenario(scenario_config_file_path);
+        cadmium::dynamic::engine::runner<TIME, logger::not_logger> checkpointed(checkpointed_model, {0});
+        start = std::chrono::steady_clock::now();
+        checkpointed.checkpoint_every(checkpoint_path, steps);
+        checkpointed.run_until(sim_time / 2);
+        checkpointed.checkpoint();
+        checkpointed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    auto restored_model = build_scenario(scenario_config_file_path);
+    cadmium::dynamic::engine::runner<TIME, logger::not_logger> restored(restored_model, {0});
+    start = std::chrono::steady_clock::now();
+    TIME next = restored.restore_checkpoint(checkpoint_path);
+    std::chrono::duration<double> restore = std::chrono::steady_clock::now() - start;
+    restored.run_until(sim_time);
+
+    std::ifstream checkpoint_file(checkpoint_path, std::ios::binary | std::ios::ate);
+    cout << "checkpoint file: " << checkpoint_file.tellg() << " bytes, restored at time " << next << endl;
+    cout << "first half without checkpoints: " << first_half.count() << " s" << endl;
+    cout << "first half with checkpoints every " << steps << " steps: " << checkpointed_seconds << " s" << endl;
+    cout << "restore: " << restore.count() << " s" << endl;
+    if (states(straight_model) != states(restored_model)) {
+        cout << "the restored simulation reached different states" << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,125 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * Replications of the hoya scenario with the virulence of every cell perturbed at random, with a
+ * different seed for each replication. The ensemble runner reads the scenario once and copies the
+ * cells of each replication, it is compared with building the scenario for every replication.
+ * Both must reach the same results.
+ */
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cadmium/modeling/dynamic_coupled.hpp>
+#include <cadmium/modeling/dynamic_flattened_coupled.hpp>
+#include <cadmium/engine/pdevs_dynamic_runner.hpp>
+#include <cadmium/engine/pdevs_dynamic_ensemble_runner.hpp>
+#include <cadmium/logger/common_loggers.hpp>
+#include "hoya_coupled.hpp"
+
+using namespace std;
+using namespace cadmium;
+using namespace cadmium::celldevs;
+
+using TIME = double;
+
+std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> build_scenario(std::string const &scenario_config_file_path) {
+    hoya_coupled<TIME> test = hoya_coupled<TIME>("pandemic_hoya");
+    test.add_lattice_json(scenario_config_file_path);
+    test.couple_cells();
+    return std::make_shared<hoya_coupled<TIME>>(test);
+}
+
+template <typename MODELS>
+void perturb(MODELS const &models, std::size_t replication) {
+    std::mt19937_64 random(replication);
+    std::uniform_real_distribution<double> factor(0.8, 1.2);
+    for (auto const &m: models) {
+        std::dynamic_pointer_cast<hoya_cell<TIME>>(m)->virulence *= factor(random);
+    }
+}
+
+template <typename MODELS>
+std::string infected(MODELS const &models) {
+    double total = 0;
+    for (auto const &m: models) {
+        auto cell = std::dynamic_pointer_cast<hoya_cell<TIME>>(m);
+        total += cell->state.current_state.infected * cell->state.current_state.population;
+    }
+    std::ostringstream out;
+    out << total;
+    return out.str();
+}
+
+int main(int argc, char ** argv) {
+    if (argc < 2) {
+        cout << "Program used with wrong parameters. The program must be invoked as follows:";
+        cout << argv[0] << " SCENARIO_CONFIG.json [MAX_SIMULATION_TIME (default: 60)] [REPLICATIONS (default: 16)] [THREADS (default: all)]" << endl;
+        return -1;
+    }
+    std::string scenario_config_file_path = argv[1];
+    TIME sim_time = (argc > 2)? atof(argv[2]) : 60;
+    std::size_t replications = (argc > 3)? atoi(argv[3]) : 16;
+    unsigned threads = (argc > 4)? atoi(argv[4]) : std::thread::hardware_concurrency();
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::string> separate;
+    for (std::size_t r = 0; r < replications; r++) {
+        auto model = build_scenario(scenario_config_file_path);
+        auto atomics = cadmium::dynamic::modeling::flatten<TIME>(model).atomics;
+        perturb(atomics, r);
+        cadmium::dynamic::engine::runner<TIME, logger::not_logger> runner(model, {0});
+        runner.run_until(sim_time);
+        separate.push_back(infected(atomics));
+    }
+    std::chrono::duration<double> separate_time = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    cadmium::dynamic::engine::ensemble_runner<TIME, logger::not_logger> ensemble(build_scenario(scenario_config_file_path), {0});
+    std::vector<std::string> replicated = ensemble.run_until(replications, sim_time, [](std::size_t r, auto &models) {
+        perturb(models, r);
+    }, [](std::size_t r, auto &models) {
+        return infected(models);
+    }, threads);
+    std::chrono::duration<double> ensemble_time = std::chrono::steady_clock::now() - start;
+
+    for (std::size_t r = 0; r < replications; r++) {
+        cout << "replication " << r << ": " << replicated[r] << " infected" << endl;
+    }
+    cout << "building every replication: " << separate_time.count() << " s" << endl;
+    cout << "ensemble with " << threads << " threads: " << ensemble_time.count() << " s" << endl;
+    cout << "speedup: " << separate_time.count() / ensemble_time.count() << endl;
+    if (separate != replicated) {
+        cout << "the ensemble reached different results" << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,111 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/**
+ * Compares the team mode with fixed and rebalanced owners on a scenario where the infection front
+ * sweeps the lattice from a corner, so the busy cells move from the blocks of some threads to
+ * the blocks of others. Both runs must reach the same states.
+ */
+
+#define CADMIUM_EXECUTE_TEAM
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cadmium/modeling/dynamic_coupled.hpp>
+#include <cadmium/modeling/dynamic_flattened_coupled.hpp>
+#include <cadmium/engine/pdevs_dynamic_runner.hpp>
+#include <cadmium/logger/common_loggers.hpp>
+#include "hoya_coupled.hpp"
+
+using namespace std;
+using namespace cadmium;
+using namespace cadmium::celldevs;
+
+using TIME = double;
+
+struct run_result {
+    double seconds;
+    std::size_t migrations;
+    std::vector<double> busy_times;
+    std::vector<std::string> states;
+};
+
+run_result run_scenario(std::string const &scenario_config_file_path, TIME sim_time, unsigned threads, std::size_t rebalance_steps) {
+    hoya_coupled<TIME> test = hoya_coupled<TIME>("pandemic_hoya");
+    test.add_lattice_json(scenario_config_file_path);
+    test.couple_cells();
+    std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> t = std::make_shared<hoya_coupled<TIME>>(test);
+
+    cadmium::dynamic::engine::runner<TIME, logger::not_logger> r(t, {0}, cadmium::dynamic::engine::flatten_hierarchy, threads);
+    r.set_rebalance_interval(rebalance_steps);
+    auto start = std::chrono::steady_clock::now();
+    r.run_until(sim_time);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    run_result result{elapsed.count(), r.migrations(), r.busy_times(), {}};
+    for (const auto& m : cadmium::dynamic::modeling::flatten<TIME>(t).atomics) {
+        auto atomic = std::dynamic_pointer_cast<cadmium::dynamic::modeling::atomic_abstract<TIME>>(m);
+        result.states.push_back(atomic->get_id() + ": " + atomic->model_state_as_string());
+    }
+    return result;
+}
+
+void print_busy_times(const run_result& result) {
+    cout << "  busy time by thread (s):";
+    for (double b : result.busy_times) {
+        cout << " " << b / 1e6;
+    }
+    cout << endl;
+}
+
+int main(int argc, char ** argv) {
+    if (argc < 2) {
+        cout << "Program used with wrong parameters. The program must be invoked as follows:";
+        cout << argv[0] << " SCENARIO_CONFIG.json [MAX_SIMULATION_TIME (default: 200)] [THREADS (default: all)] [REBALANCE_STEPS (default: 10)]" << endl;
+        return -1;
+    }
+    std::string scenario_config_file_path = argv[1];
+    TIME sim_time = (argc > 2)? atof(argv[2]) : 200;
+    unsigned threads = (argc > 3)? atoi(argv[3]) : std::thread::hardware_concurrency();
+    std::size_t rebalance_steps = (argc > 4)? atoi(argv[4]) : 10;
+
+    run_result fixed = run_scenario(scenario_config_file_path, sim_time, threads, 0);
+    run_result rebalanced = run_scenario(scenario_config_file_path, sim_time, threads, rebalance_steps);
+
+    cout << "fixed owners: " << fixed.seconds << " s" << endl;
+    cout << "rebalanced every " << rebalance_steps << " steps: " << rebalanced.seconds << " s, "
+         << rebalanced.migrations << " migrations" << endl;
+    print_busy_times(rebalanced);
+    cout << "speedup: " << fixed.seconds / rebalanced.seconds << endl;
+    if (fixed.states != rebalanced.states) {
+        cout << "the rebalanced simulation reached different states" << endl;
+        return 1;
+    }
+    return 0;
+}
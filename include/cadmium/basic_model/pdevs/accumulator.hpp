@@ -92,7 +92,7 @@ namespace cadmium::basic_models::pdevs {
             std::get<on_reset>(state) = false;
         }
 
-        void external_transition(TIME e, typename make_message_bags<input_ports>::type mbs) {
+        void external_transition(TIME e, const typename make_message_bags<input_ports>::type& mbs) {
             if (std::get<on_reset>(state)) {
                 throw std::logic_error("External transition called while on reset state");
             }
@@ -105,22 +105,27 @@ namespace cadmium::basic_models::pdevs {
                 std::get<on_reset>(state) = true; //multiple call equal one call
         }
 
-        void confluence_transition(TIME e, typename make_message_bags<input_ports>::type mbs) {
+        void confluence_transition(TIME e, const typename make_message_bags<input_ports>::type& mbs) {
             //process internal transition first
             internal_transition();
             //then external transition
             //we assume the default constructor of TIME produces a zero
-            external_transition(TIME{}, std::move(mbs));
+            external_transition(TIME{}, mbs);
         }
 
         typename make_message_bags<output_ports>::type output() const {
+            typename make_message_bags<output_ports>::type outmb;
+            output(outmb);
+            return outmb;
+        }
+
+        // output function writing in empty bags given by the simulator
+        void output(typename make_message_bags<output_ports>::type& outmb) const {
             if (!std::get<on_reset>(state)) {
                 throw std::logic_error("Output function called while not on reset state");
             }
 
-            typename make_message_bags<output_ports>::type outmb;
             get_messages<typename defs::sum>(outmb).emplace_back(std::get<VALUE>(state));
-            return outmb;
         }
 
         TIME time_advance() const {
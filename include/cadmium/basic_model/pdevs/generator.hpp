@@ -95,10 +95,15 @@ namespace cadmium::basic_models::pdevs {
         // output function
         typename make_message_bags<output_ports>::type output() const {
             typename make_message_bags<output_ports>::type bags;
-            cadmium::get_messages<typename defs::out>(bags).push_back(output_message());
+            output(bags);
             return bags;
         }
 
+        // output function writing in empty bags given by the simulator
+        void output(typename make_message_bags<output_ports>::type& bags) const {
+            cadmium::get_messages<typename defs::out>(bags).push_back(output_message());
+        }
+
         // time_advance function
         TIME time_advance() const {
             //we assume default constructor of TIME is 0 and infinity is defined in numeric_limits
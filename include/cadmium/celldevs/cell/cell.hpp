@@ -37,6 +37,7 @@
 #include <unordered_map>
 #include <memory>
 #include <cadmium/modeling/message_bag.hpp>
+#include <cadmium/modeling/state_codec.hpp>
 #include <cadmium/celldevs/utils/utils.hpp>
 #include <cadmium/celldevs/cell/msg.hpp>
 #include <cadmium/celldevs/delay_buffer/delay_buffer_factory.hpp>
@@ -87,6 +88,15 @@ namespace cadmium::celldevs {
 
         virtual ~cell() = default;
 
+        /**
+         * Copies a cell with its state and a copy of its output delay buffer, used to simulate replications of a
+         * scenario without building it again.
+         * @param other cell to be copied.
+         */
+        cell(cell const &other) : cell_id(other.cell_id), neighbors(other.neighbors),
+                                  simulation_clock(other.simulation_clock), next_internal(other.next_internal),
+                                  buffer(other.buffer->clone()), state(other.state) {}
+
         /**
          * Creates a new cell with neighbors which vicinities is explicitly specified.
          * @tparam Args additional arguments for initializing the delay buffer
@@ -147,15 +157,14 @@ namespace cadmium::celldevs {
          * It updates clock and next internal event. Then, it refreshes neighbors' state and computes next cell state.
          * if the new cell state is different to the current state, it adds the new state to the output delay buffer.
          * @param e elapsed time from the last event.
-         * @param mbs message bag containing new neighbors' state messages.
+         * @param mbs message bag containing new neighbors' state messages, read in place.
          */
-        void external_transition(T e, typename cadmium::make_message_bags<input_ports>::type mbs) {
+        void external_transition(T e, typename cadmium::make_message_bags<input_ports>::type const &mbs) {
             // Update clock and next internal event
             simulation_clock += e;
             next_internal -= e;
             // Refresh the neighbors' current state
-            std::vector<cell_state_message<C, S>> bagPortIn = cadmium::get_messages<typename cell_ports_def<C, S>::cell_in>(mbs);
-            for (cell_state_message<C, S> msg: bagPortIn) {
+            for (cell_state_message<C, S> const &msg: cadmium::get_messages<typename cell_ports_def<C, S>::cell_in>(mbs)) {
                 auto it = state.neighbors_state.find(msg.cell_id);
                 if (it != state.neighbors_state.end()) {
                     state.neighbors_state[msg.cell_id] = msg.state;
@@ -173,24 +182,66 @@ namespace cadmium::celldevs {
         }
 
         /// Confluence transition function.
-        void confluence_transition([[maybe_unused]] T e, typename cadmium::make_message_bags<input_ports>::type mbs) {
+        void confluence_transition([[maybe_unused]] T e, typename cadmium::make_message_bags<input_ports>::type const &mbs) {
             internal_transition();
-            external_transition(T(), move(mbs));
+            external_transition(T(), mbs);
         }
 
         /// Time advance function.
         T time_advance() const { return next_internal; }
 
+        /**
+         * Encodes the data of the cell that changes during a simulation, to checkpoint it: the clock, the time until
+         * the next internal transition, the cell state, the neighbors' states in the order of the neighbors and the
+         * output delay buffer. The vicinities are not encoded, they are restored building the cell again.
+         * @param out string where the bytes are appended.
+         */
+        void encode_state(std::string &out) const {
+            if constexpr (cadmium::dynamic::state_codec<T>::defined && cadmium::dynamic::state_codec<S>::defined) {
+                cadmium::dynamic::state_codec<T>::encode(simulation_clock, out);
+                cadmium::dynamic::state_codec<T>::encode(next_internal, out);
+                cadmium::dynamic::state_codec<S>::encode(state.current_state, out);
+                cadmium::dynamic::message_codec<std::uint64_t>::encode(neighbors.size(), out);
+                for (auto const &neighbor: neighbors)
+                    cadmium::dynamic::state_codec<S>::encode(state.neighbors_state.at(neighbor), out);
+                buffer->encode(out);
+            } else {
+                throw std::domain_error("The cell state cannot be encoded");
+            }
+        }
+
+        /**
+         * Decodes the data encoded by encode_state into a cell built with the same neighbors.
+         * @param data pointer to the encoded bytes, moved after them.
+         * @param end end of the encoded bytes.
+         */
+        void decode_state(const char *&data, const char *end) {
+            if constexpr (cadmium::dynamic::state_codec<T>::defined && cadmium::dynamic::state_codec<S>::defined) {
+                cadmium::dynamic::state_codec<T>::decode(simulation_clock, data, end);
+                cadmium::dynamic::state_codec<T>::decode(next_internal, data, end);
+                cadmium::dynamic::state_codec<S>::decode(state.current_state, data, end);
+                if (cadmium::dynamic::message_codec<std::uint64_t>::decode(data, end) != neighbors.size())
+                    throw std::domain_error("The encoded cell has different neighbors");
+                for (auto const &neighbor: neighbors)
+                    cadmium::dynamic::state_codec<S>::decode(state.neighbors_state.at(neighbor), data, end);
+                buffer->decode(data, end);
+            } else {
+                throw std::domain_error("The cell state cannot be decoded");
+            }
+        }
+
         /// @return the next message to be transmitted from the output delay_buffer buffer
         typename cadmium::make_message_bags<output_ports>::type output() const {
-            std::vector<cell_state_message<C, S>> bag_port_out = std::vector<cell_state_message<C, S>>();
-            bag_port_out.push_back(cell_state_message<C, S>(cell_id, buffer->next_state()));
-
             typename cadmium::make_message_bags<output_ports>::type bag;
-            cadmium::get_messages<typename cell_ports_def<C, S>::cell_out>(bag) = bag_port_out;
+            output(bag);
             return bag;
         }
 
+        /// Writes the next message to be transmitted in the empty bag given by the simulator, reusing its memory.
+        void output(typename cadmium::make_message_bags<output_ports>::type &bag) const {
+            cadmium::get_messages<typename cell_ports_def<C, S>::cell_out>(bag).emplace_back(cell_id, buffer->next_state());
+        }
+
         /**
          * Operator overloading function for printing the cell's state.
          * @param os output string stream.
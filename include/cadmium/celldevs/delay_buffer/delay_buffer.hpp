@@ -29,6 +29,10 @@
 #define CADMIUM_CELLDEVS_DELAY_BUFFER_HPP
 
 #include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <cadmium/modeling/state_codec.hpp>
 
 namespace cadmium::celldevs {
     /**
@@ -56,6 +60,14 @@ namespace cadmium::celldevs {
 
         /// Removes from buffer the next scheduled state transmission.
         virtual void pop_buffer() {};
+        /// Appends the scheduled states to out, used to checkpoint simulations.
+        virtual void encode(std::string &out) const {};
+        /// Restores the scheduled states encoded by encode, moving data after them.
+        virtual void decode(const char *&data, const char *end) {};
+        /// @return a copy of the buffer with its scheduled states, used to copy cells.
+        virtual std::unique_ptr<delay_buffer<T, S>> clone() const {
+            throw std::domain_error("The delay buffer can not be copied");
+        };
     };
 } //namespace cadmium::celldevs
 
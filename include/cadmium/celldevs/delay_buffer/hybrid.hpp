@@ -31,6 +31,7 @@
 #include <limits>
 #include <utility>
 #include <deque>
+#include <vector>
 #include <cadmium/celldevs//delay_buffer/delay_buffer.hpp>
 
 namespace cadmium::celldevs {
@@ -73,6 +74,31 @@ namespace cadmium::celldevs {
                 delayed_outputs.pop_front();
             }
         }
+        /// Encodes the latest transmitted state and the queue of scheduled states
+        void encode(std::string &out) const override {
+            if constexpr (cadmium::dynamic::state_codec<T>::defined && cadmium::dynamic::state_codec<S>::defined) {
+                cadmium::dynamic::state_codec<S>::encode(last_state, out);
+                std::vector<std::pair<T, S>> scheduled(delayed_outputs.begin(), delayed_outputs.end());
+                cadmium::dynamic::state_codec<std::vector<std::pair<T, S>>>::encode(scheduled, out);
+            } else {
+                throw std::domain_error("The cell states of the delay buffer cannot be encoded");
+            }
+        }
+        /// Decodes the latest transmitted state and the queue of scheduled states
+        void decode(const char *&data, const char *end) override {
+            if constexpr (cadmium::dynamic::state_codec<T>::defined && cadmium::dynamic::state_codec<S>::defined) {
+                cadmium::dynamic::state_codec<S>::decode(last_state, data, end);
+                std::vector<std::pair<T, S>> scheduled;
+                cadmium::dynamic::state_codec<std::vector<std::pair<T, S>>>::decode(scheduled, data, end);
+                delayed_outputs.assign(scheduled.begin(), scheduled.end());
+            } else {
+                throw std::domain_error("The cell states of the delay buffer cannot be decoded");
+            }
+        }
+        /// Returns a copy of the buffer
+        std::unique_ptr<delay_buffer<T, S>> clone() const override {
+            return std::make_unique<hybrid_delay_buffer<T, S>>(*this);
+        }
     };
 } //namespace cadmium::celldevs
 
@@ -60,6 +60,28 @@ namespace cadmium::celldevs {
 
         /// Sets the next scheduled time to infinity
         void pop_buffer() override { time = std::numeric_limits<T>::infinity(); }
+        /// Encodes the state to be transmitted and its time
+        void encode(std::string &out) const override {
+            if constexpr (cadmium::dynamic::state_codec<T>::defined && cadmium::dynamic::state_codec<S>::defined) {
+                cadmium::dynamic::state_codec<S>::encode(last_state, out);
+                cadmium::dynamic::state_codec<T>::encode(time, out);
+            } else {
+                throw std::domain_error("The cell states of the delay buffer cannot be encoded");
+            }
+        }
+        /// Decodes the state to be transmitted and its time
+        void decode(const char *&data, const char *end) override {
+            if constexpr (cadmium::dynamic::state_codec<T>::defined && cadmium::dynamic::state_codec<S>::defined) {
+                cadmium::dynamic::state_codec<S>::decode(last_state, data, end);
+                cadmium::dynamic::state_codec<T>::decode(time, data, end);
+            } else {
+                throw std::domain_error("The cell states of the delay buffer cannot be decoded");
+            }
+        }
+        /// Returns a copy of the buffer
+        std::unique_ptr<delay_buffer<T, S>> clone() const override {
+            return std::make_unique<inertial_delay_buffer<T, S>>(*this);
+        }
     };
 } //namespace cadmium::celldevs
 #endif //CADMIUM_CELLDEVS_INERTIAL_DELAY_BUFFER_HPP
@@ -30,6 +30,7 @@
 
 #include <limits>
 #include <queue>
+#include <utility>
 #include <vector>
 #include <unordered_map>
 #include <cadmium/celldevs//delay_buffer/delay_buffer.hpp>
@@ -77,6 +78,38 @@ namespace cadmium::celldevs {
                 timeline.pop();  // .. and from the timeline
             }
         }
+        /// Encodes the latest transmitted state and the scheduled states sorted by time
+        void encode(std::string &out) const override {
+            if constexpr (cadmium::dynamic::state_codec<T>::defined && cadmium::dynamic::state_codec<S>::defined) {
+                cadmium::dynamic::state_codec<S>::encode(last_state, out);
+                std::vector<std::pair<T, S>> scheduled;
+                for (auto pending = timeline; !pending.empty(); pending.pop()) {
+                    scheduled.emplace_back(pending.top(), delayed_outputs.at(pending.top()));
+                }
+                cadmium::dynamic::state_codec<std::vector<std::pair<T, S>>>::encode(scheduled, out);
+            } else {
+                throw std::domain_error("The cell states of the delay buffer cannot be encoded");
+            }
+        }
+        /// Decodes the latest transmitted state and schedules again the encoded states
+        void decode(const char *&data, const char *end) override {
+            if constexpr (cadmium::dynamic::state_codec<T>::defined && cadmium::dynamic::state_codec<S>::defined) {
+                cadmium::dynamic::state_codec<S>::decode(last_state, data, end);
+                std::vector<std::pair<T, S>> scheduled;
+                cadmium::dynamic::state_codec<std::vector<std::pair<T, S>>>::decode(scheduled, data, end);
+                timeline = decltype(timeline)();
+                delayed_outputs.clear();
+                for (auto const &s: scheduled) {
+                    add_to_buffer(s.second, s.first);
+                }
+            } else {
+                throw std::domain_error("The cell states of the delay buffer cannot be decoded");
+            }
+        }
+        /// Returns a copy of the buffer
+        std::unique_ptr<delay_buffer<T, S>> clone() const override {
+            return std::make_unique<transport_delay_buffer<T, S>>(*this);
+        }
     };
 } //namespace cadmium::celldevs
 #endif //CADMIUM_CELLDEVS_TRANSPORT_DELAY_BUFFER_HPP
@@ -28,6 +28,8 @@
 #define CADMIUM_HELPERS_HPP
 
 #include<tuple>
+#include<type_traits>
+#include<utility>
 
 namespace cadmium {
     namespace concept {
@@ -46,6 +48,18 @@ namespace cadmium {
             }
         };
 
+        /**
+         * @brief Checks if MODEL can write its output in bags it did not create, declaring the method
+         * void output(BAGS&) const besides the output() one. The bags are empty but keep the memory
+         * of the previous outputs.
+         */
+        template<typename MODEL, typename BAGS, typename = void>
+        struct declares_output_in_place : std::false_type {};
+
+        template<typename MODEL, typename BAGS>
+        struct declares_output_in_place<MODEL, BAGS, std::void_t<decltype(std::declval<const MODEL&>().output(std::declval<BAGS&>()))>>
+                : std::true_type {};
+
         namespace { //details
             template<typename, template<typename...> class>
             struct is_specialization : std::false_type {};
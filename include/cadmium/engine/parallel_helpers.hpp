@@ -34,6 +34,17 @@
 #include <thread>
 #include <algorithm>
 #include <array>
+#include <atomic>
+
+/* below this amount of elements the loops run sequentially, fork/join overhead dominates */
+#ifndef CADMIUM_PARALLEL_SEQUENTIAL_THRESHOLD
+#define CADMIUM_PARALLEL_SEQUENTIAL_THRESHOLD 16
+#endif
+
+/* amount of chunks created by thread when splitting the loops by cost */
+#ifndef CADMIUM_PARALLEL_CHUNKS_BY_THREAD
+#define CADMIUM_PARALLEL_CHUNKS_BY_THREAD 4
+#endif
 
 namespace cadmium {
     namespace parallel {
@@ -42,6 +53,15 @@ namespace cadmium {
     	void cpu_parallel_for_each(ITERATOR first, ITERATOR last, FUNC& f, size_t thread_number = std::thread::hardware_concurrency()){
     		/* get amount of elements to compute */
     		size_t n = std::distance(first, last);
+    		/* nothing to compute, OpenMP does not accept an empty team */
+    		if(n == 0){
+    			return;
+    		}
+    		/* small loops are cheaper without forking a team */
+    		if(n < CADMIUM_PARALLEL_SEQUENTIAL_THRESHOLD || thread_number <= 1){
+    			std::for_each(first, last, f);
+    			return;
+    		}
     		/* if the amount of elements is less than the number of threads execute on n elements */
     		if(n<thread_number){
     			thread_number=n;
@@ -71,6 +91,70 @@ namespace cadmium {
     			}
     		}
     	}
+
+    	/**
+    	 * @brief cpu_parallel_for_each_weighted calls f(i) for every i in [0, n), the indexes are
+    	 * split in contiguous chunks of similar expected cost that threads take dynamically.
+    	 * @param n is the amount of indexes.
+    	 * @param f is called once by index.
+    	 * @param cost returns the expected cost of f(i), as a non negative double.
+    	 * @param thread_number is the size of the OpenMP team.
+    	 * @param bounds keeps the bounds of the chunks, callers running every step reuse it to avoid allocating them.
+    	 */
+    	template<typename FUNC, typename COST>
+    	void cpu_parallel_for_each_weighted(size_t n, FUNC& f, const COST& cost, size_t thread_number, std::vector<size_t>& bounds){
+    		/* nothing to compute, or too little to pay for the fork/join */
+    		if(n < CADMIUM_PARALLEL_SEQUENTIAL_THRESHOLD || thread_number <= 1){
+    			for(size_t i = 0; i < n; i++){
+    				f(i);
+    			}
+    			return;
+    		}
+    		if(n < thread_number){
+    			thread_number = n;
+    		}
+    		size_t chunk_number = std::min(n, thread_number * CADMIUM_PARALLEL_CHUNKS_BY_THREAD);
+
+    		/* chunk c is [bounds[c], bounds[c+1]), each one accumulating about total/chunk_number */
+    		double total = 0;
+    		for(size_t i = 0; i < n; i++){
+    			total += cost(i);
+    		}
+    		bounds.clear();
+    		bounds.reserve(chunk_number + 1);
+    		bounds.push_back(0);
+    		double accumulated = 0;
+    		for(size_t i = 0; i < n && bounds.size() < chunk_number; i++){
+    			accumulated += cost(i);
+    			if(accumulated * chunk_number >= total * bounds.size()){
+    				bounds.push_back(i + 1);
+    			}
+    		}
+    		if(bounds.back() != n){
+    			bounds.push_back(n);
+    		}
+    		size_t chunks = bounds.size() - 1;
+
+    		/* threads take the next chunk available, compensating estimation errors */
+    		std::atomic<size_t> next_chunk{0};
+			#pragma omp parallel num_threads(thread_number) proc_bind(close)
+    		{
+    			for(size_t c = next_chunk.fetch_add(1); c < chunks; c = next_chunk.fetch_add(1)){
+    				for(size_t i = bounds[c]; i < bounds[c+1]; i++){
+    					f(i);
+    				}
+    			}
+    		}
+    	}
+
+    	/**
+    	 * @brief cpu_parallel_for_each_weighted allocating the bounds of the chunks on each call.
+    	 */
+    	template<typename FUNC, typename COST>
+    	void cpu_parallel_for_each_weighted(size_t n, FUNC& f, const COST& cost, size_t thread_number = std::thread::hardware_concurrency()){
+    		std::vector<size_t> bounds;
+    		cpu_parallel_for_each_weighted(n, f, cost, thread_number, bounds);
+    	}
     }
 }
 
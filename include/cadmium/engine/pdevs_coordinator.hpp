@@ -116,30 +116,35 @@ namespace cadmium {
              * @param t time the simulation will be advanced to
              * @todo At this point all messages are copied while routed form onelevel to the next, need to find a good
              * strategy to lower copying, maybe.
-             * @todo Merge the Collect output calls into the advance simulation as done with ICs and EICs routing
              */
 
             void collect_outputs(const TIME &t) {
-
-                LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::coor_info_collect>(t, _model_id);
-
-                //collecting if necessary
-                if (_next < t) {
-                    throw std::domain_error("Trying to obtain output when not internal event is scheduled");
-                } else if (_next == t) {
-                    //log EOC
-                    LOGGER::template log<cadmium::logger::logger_message_routing, cadmium::logger::coor_routing_eoc_collect>(_model_id);
-                    //fill all outboxes and clean the inboxes in the lower levels recursively
-                    cadmium::engine::collect_outputs_in_subcoordinators<TIME, subcoordinators_type>(t, _subcoordinators);
+                if (collect_subcoordinators_outputs(t)) {
                     //use the EOC mapping to compose current level output
-                    _outbox = collect_messages_by_eoc<TIME, eoc, out_bags_type, subcoordinators_type, LOGGER>(_subcoordinators);
+                    cadmium::engine::clear_bags(_outbox);
+                    collect_messages_by_eoc<TIME, eoc, out_bags_type, subcoordinators_type, LOGGER, ic>(_outbox, _subcoordinators);
+                }
+            }
+
+            /**
+             * @brief Collects the outputs and advances the simulation to t in a single call, as the runner
+             * does with the top coordinator. The outbox is not composed unless message routing is logged,
+             * because it has no parent to read it and advance_simulation clears it.
+             * @param t time the simulation will be advanced to
+             */
+            void step(const TIME &t) {
+                if constexpr (cadmium::logger::logs_source_v<LOGGER, cadmium::logger::logger_message_routing>) {
+                    collect_outputs(t);
+                } else {
+                    collect_subcoordinators_outputs(t);
                 }
+                advance_simulation(t);
             }
 
             /**
              * @brief outbox keeps the output generated by the last call to collect_outputs
              */
-            out_bags_type outbox() const noexcept{
+            const out_bags_type& outbox() const noexcept{
                 return _outbox;
             }
 
@@ -149,7 +154,7 @@ namespace cadmium {
              */
             void advance_simulation(const TIME &t) {
                 //clean outbox because messages are routed before calling this funtion at a higher level
-                _outbox = out_bags_type{};
+                cadmium::engine::clear_bags(_outbox);
 
                 LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::coor_info_advance>(_last, t, _model_id);
 
@@ -159,7 +164,7 @@ namespace cadmium {
 
                     //Route the messages standing in the outboxes to mapped inboxes following ICs and EICs
                     LOGGER::template log<cadmium::logger::logger_message_routing, cadmium::logger::coor_routing_ic_collect>(_model_id);
-                    cadmium::engine::route_internal_coupled_messages_on_subcoordinators<TIME, subcoordinators_type, ic, LOGGER>(t, _subcoordinators);
+                    cadmium::engine::route_internal_coupled_messages_on_subcoordinators<TIME, subcoordinators_type, ic, LOGGER, eoc>(t, _subcoordinators);
 
                     LOGGER::template log<cadmium::logger::logger_message_routing, cadmium::logger::coor_routing_eic_collect>(_model_id);
                     cadmium::engine::route_external_input_coupled_messages_on_subcoordinators<TIME, in_bags_type, subcoordinators_type, eic, LOGGER>(t, _inbox, _subcoordinators);
@@ -172,8 +177,27 @@ namespace cadmium {
                     _next = cadmium::engine::min_next_in_tuple<subcoordinators_type>(_subcoordinators);
 
                     //clean inbox because they were processed already
-                    _inbox = in_bags_type{};
+                    cadmium::engine::clear_bags(_inbox);
+                }
+            }
+
+        private:
+            //collects the outputs of the subcoordinators at t, returns if this coordinator was imminent
+            bool collect_subcoordinators_outputs(const TIME &t) {
+
+                LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::coor_info_collect>(t, _model_id);
+
+                //collecting if necessary
+                if (_next < t) {
+                    throw std::domain_error("Trying to obtain output when not internal event is scheduled");
+                } else if (_next == t) {
+                    //log EOC
+                    LOGGER::template log<cadmium::logger::logger_message_routing, cadmium::logger::coor_routing_eoc_collect>(_model_id);
+                    //fill all outboxes and clean the inboxes in the lower levels recursively
+                    cadmium::engine::collect_outputs_in_subcoordinators<TIME, subcoordinators_type>(t, _subcoordinators);
+                    return true;
                 }
+                return false;
             }
         };
     }
@@ -99,15 +99,29 @@ namespace cadmium {
                     _last = initial_time;
                     _next = initial_time + _model->time_advance();
 
-                    LOGGER::template log<cadmium::logger::logger_state, cadmium::logger::sim_state>(initial_time, _model->get_id(), _model->model_state_as_string());
+                    if constexpr (cadmium::logger::logs_source_v<LOGGER, cadmium::logger::logger_state>) {
+                        LOGGER::template log<cadmium::logger::logger_state, cadmium::logger::sim_state>(initial_time, _model->get_id(), _model->model_state_as_string());
+                    }
                 }
 
                 #ifdef CADMIUM_EXECUTE_CONCURRENT
-                void init(TIME initial_time, boost::basic_thread_pool* threadpool) {
+                void init(TIME initial_time, cadmium::concurrency::work_stealing_executor* threadpool) {
                     this->init(initial_time);
                 }
                 #endif //CADMIUM_EXECUTE_CONCURRENT
 
+                #ifdef CPU_PARALLEL
+                void init(TIME initial_time, size_t thread_number) override {
+                    this->init(initial_time);
+                }
+                #endif //CPU_PARALLEL
+
+                #ifdef CADMIUM_EXECUTE_TEAM
+                void init(TIME initial_time, cadmium::concurrency::worker_team* team) override {
+                    this->init(initial_time);
+                }
+                #endif //CADMIUM_EXECUTE_TEAM
+
                 std::string get_model_id() const override {
                     return _model->get_id();
                 }
@@ -146,8 +160,10 @@ namespace cadmium {
                         _outbox = cadmium::dynamic::message_bags();
                     }
 
-                    std::string messages_by_port = _model->messages_by_port_as_string(_outbox);
-                    LOGGER::template log<cadmium::logger::logger_messages, cadmium::logger::sim_messages_collect>(t, _model->get_id(), messages_by_port);
+                    if constexpr (cadmium::logger::logs_source_v<LOGGER, cadmium::logger::logger_messages>) {
+                        std::string messages_by_port = _model->messages_by_port_as_string(_outbox);
+                        LOGGER::template log<cadmium::logger::logger_messages, cadmium::logger::sim_messages_collect>(t, _model->get_id(), messages_by_port);
+                    }
                 }
 
                 /**
@@ -190,7 +206,9 @@ namespace cadmium {
                         }
                     }
 
-                    LOGGER::template log<cadmium::logger::logger_state,cadmium::logger::sim_state>(t, _model->get_id(), _model->model_state_as_string());
+                    if constexpr (cadmium::logger::logs_source_v<LOGGER, cadmium::logger::logger_state>) {
+                        LOGGER::template log<cadmium::logger::logger_state,cadmium::logger::sim_state>(t, _model->get_id(), _model->model_state_as_string());
+                    }
                 }
 
             #else
@@ -215,8 +233,10 @@ namespace cadmium {
                         _outbox = cadmium::dynamic::message_bags();
                     }
 
-                    std::string messages_by_port = _model->messages_by_port_as_string(_outbox);
-                    LOGGER::template log<cadmium::logger::logger_messages, cadmium::logger::sim_messages_collect>(t, _model->get_id(), messages_by_port);
+                    if constexpr (cadmium::logger::logs_source_v<LOGGER, cadmium::logger::logger_messages>) {
+                        std::string messages_by_port = _model->messages_by_port_as_string(_outbox);
+                        LOGGER::template log<cadmium::logger::logger_messages, cadmium::logger::sim_messages_collect>(t, _model->get_id(), messages_by_port);
+                    }
                 }
 
                 void advance_simulation(const TIME &t) override {
@@ -0,0 +1,194 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef CADMIUM_PDEVS_DYNAMIC_BRANCHING_HPP
+#define CADMIUM_PDEVS_DYNAMIC_BRANCHING_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace cadmium {
+    namespace dynamic {
+        namespace engine {
+
+            namespace branching_detail {
+                inline void write_all(int fd, const std::string& bytes) {
+                    std::size_t written = 0;
+                    while (written < bytes.size()) {
+                        ssize_t n = ::write(fd, bytes.data() + written, bytes.size() - written);
+                        if (n < 0 && errno != EINTR) {
+                            return;
+                        }
+                        written += n < 0 ? 0 : static_cast<std::size_t>(n);
+                    }
+                }
+
+                inline std::string read_all(int fd) {
+                    std::string bytes;
+                    char buffer[4096];
+                    for (;;) {
+                        ssize_t n = ::read(fd, buffer, sizeof(buffer));
+                        if (n == 0 || (n < 0 && errno != EINTR)) {
+                            return bytes;
+                        }
+                        bytes.append(buffer, n < 0 ? 0 : static_cast<std::size_t>(n));
+                    }
+                }
+
+                struct running_branch {
+                    std::size_t branch;
+                    pid_t pid;
+                    int fd;
+                };
+            }
+
+            /**
+             * @brief Continues the simulation of a runner in several independent branches, each one in a
+             * forked process sharing the memory of the simulation until the current time copy on write.
+             *
+             * @details
+             * Each branch calls continuation(b, r) with its index and its copy of the runner. It may patch
+             * the parameters of the models through the pointers kept by the caller, which point to its
+             * own copy of them, and then calls r.run_until. The value returned by the continuation, a
+             * std::string or void, is sent back to this process, which keeps simulating from the same
+             * time as if no branch was run. Branches run in parallel, at most concurrent at once.
+             *
+             * Only the thread calling fork exists in the branches, so the runner must be sequential,
+             * without CADMIUM_EXECUTE_CONCURRENT, CADMIUM_EXECUTE_TEAM or CPU_PARALLEL, and the calling
+             * thread should not hold locks needed by the continuation. Branches end without running
+             * destructors, after flushing std::cout and std::cerr.
+             *
+             * @return the value returned by each branch. If a branch throws or dies, after waiting for
+             * all of them it throws std::runtime_error with the error of the first failed branch.
+             */
+            template<typename RUNNER, typename CONTINUATION>
+            std::vector<std::string> branch(RUNNER& runner, std::size_t branches, CONTINUATION&& continuation, std::size_t concurrent = std::thread::hardware_concurrency()) {
+                #if defined CADMIUM_EXECUTE_CONCURRENT || defined CADMIUM_EXECUTE_TEAM || defined CPU_PARALLEL
+                throw std::domain_error("Branches fork the process, so they need a sequential runner");
+                #else
+                using result_type = std::invoke_result_t<CONTINUATION&, std::size_t, RUNNER&>;
+                static_assert(std::is_void_v<result_type> || std::is_convertible_v<result_type, std::string>, "Branches must return void or a std::string");
+
+                std::vector<std::string> results(branches);
+                std::vector<std::string> errors(branches);
+                std::deque<branching_detail::running_branch> running;
+                concurrent = std::max<std::size_t>(concurrent, 1);
+
+                // the first byte of the bytes sent by a branch tells if it succeeded
+                auto wait_oldest = [&running, &results, &errors]() {
+                    branching_detail::running_branch b = running.front();
+                    running.pop_front();
+                    std::string bytes = branching_detail::read_all(b.fd);
+                    ::close(b.fd);
+                    int status = 0;
+                    while (::waitpid(b.pid, &status, 0) < 0 && errno == EINTR) {}
+                    if (!bytes.empty() && bytes[0] == 0 && WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+                        results[b.branch] = bytes.substr(1);
+                    } else if (bytes.size() > 1 && bytes[0] == 1) {
+                        errors[b.branch] = bytes.substr(1);
+                    } else {
+                        errors[b.branch] = "the process ended unexpectedly";
+                    }
+                };
+
+                std::cout.flush();
+                std::cerr.flush();
+                for (std::size_t b = 0; b < branches; b++) {
+                    if (running.size() >= concurrent) {
+                        wait_oldest();
+                    }
+                    int fds[2];
+                    if (::pipe(fds) != 0) {
+                        errors[b] = "unable to create a pipe";
+                        continue;
+                    }
+                    pid_t pid = ::fork();
+                    if (pid < 0) {
+                        ::close(fds[0]);
+                        ::close(fds[1]);
+                        errors[b] = "unable to fork";
+                        continue;
+                    }
+                    if (pid == 0) {
+                        ::close(fds[0]);
+                        for (const auto& other : running) {
+                            ::close(other.fd);
+                        }
+                        std::string bytes(1, '\0');
+                        int code = 0;
+                        try {
+                            if constexpr (std::is_void_v<result_type>) {
+                                continuation(b, runner);
+                            } else {
+                                bytes += std::string(continuation(b, runner));
+                            }
+                        } catch (const std::exception& e) {
+                            bytes.assign(1, '\1');
+                            bytes += e.what();
+                            code = 1;
+                        } catch (...) {
+                            bytes.assign(1, '\1');
+                            bytes += "unknown exception";
+                            code = 1;
+                        }
+                        std::cout.flush();
+                        std::cerr.flush();
+                        branching_detail::write_all(fds[1], bytes);
+                        ::_exit(code);
+                    }
+                    ::close(fds[1]);
+                    running.push_back({b, pid, fds[0]});
+                }
+                while (!running.empty()) {
+                    wait_oldest();
+                }
+                for (std::size_t b = 0; b < branches; b++) {
+                    if (!errors[b].empty()) {
+                        throw std::runtime_error("Branch " + std::to_string(b) + " failed: " + errors[b]);
+                    }
+                }
+                return results;
+                #endif
+            }
+        }
+    }
+}
+
+#endif //CADMIUM_PDEVS_DYNAMIC_BRANCHING_HPP
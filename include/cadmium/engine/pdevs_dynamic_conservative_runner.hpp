@@ -0,0 +1,457 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CADMIUM_PDEVS_DYNAMIC_CONSERVATIVE_RUNNER_HPP
+#define CADMIUM_PDEVS_DYNAMIC_CONSERVATIVE_RUNNER_HPP
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <cadmium/modeling/dynamic_coupled.hpp>
+#include <cadmium/modeling/dynamic_flattened_coupled.hpp>
+#include <cadmium/engine/pdevs_dynamic_simulator.hpp>
+#include <cadmium/engine/pdevs_dynamic_engine_helpers.hpp>
+#include <cadmium/engine/pdevs_dynamic_fel.hpp>
+#include <cadmium/engine/pdevs_dynamic_runner.hpp>
+#include <cadmium/engine/work_stealing_executor.hpp>
+
+namespace cadmium {
+    namespace dynamic {
+        namespace engine {
+
+            /**
+             * @brief Group of atomic models of a flattened model that the conservative runner simulates
+             * independently of the other groups inside the safe time windows.
+             *
+             * Models are identified by their local index in the process. Routes between models of the
+             * process are followed on each step, the ones coming from other processes are routed by the
+             * runner, which then notifies the receivers.
+             */
+            template<typename TIME, typename LOGGER, template<typename> class FEL=binary_heap_fel>
+            class logical_process {
+                subcoordinators_type<TIME> _simulators;
+                std::vector<TIME> _lookaheads;
+                std::vector<std::size_t> _boundary; // models with routes to other processes
+
+                bound_routes _routes;
+                std::vector<std::vector<std::size_t>> _routes_by_source;
+                std::vector<std::size_t> _route_destination;
+
+                FEL<TIME> _fel;
+                TIME _imminent_time;
+                std::vector<std::size_t> _imminent;
+                std::vector<std::size_t> _active;
+                std::vector<bool> _is_active;
+                std::vector<bool> _is_boundary;
+                std::vector<std::size_t> _selected_routes;
+
+                void activate(std::size_t i) {
+                    if (!_is_active[i]) {
+                        _is_active[i] = true;
+                        _active.push_back(i);
+                    }
+                }
+
+            public:
+                /**
+                 * @return The local index of the model in the process.
+                 */
+                std::size_t add_model(const std::shared_ptr<cadmium::dynamic::modeling::atomic_abstract<TIME>>& m) {
+                    _simulators.push_back(std::make_shared<cadmium::dynamic::engine::simulator<TIME, LOGGER>>(m));
+                    _lookaheads.push_back(m->lookahead());
+                    _routes_by_source.emplace_back();
+                    _is_active.push_back(false);
+                    _is_boundary.push_back(false);
+                    return _simulators.size() - 1;
+                }
+
+                engine<TIME>& model(std::size_t i) {
+                    return *_simulators[i];
+                }
+
+                /**
+                 * @brief Adds a route between two models of the process, followed inside the safe windows.
+                 */
+                void add_route(std::size_t from, std::size_t to, const std::shared_ptr<link_abstract>& l) {
+                    _routes.push_back({_simulators[from]->output_endpoint(l->from_port_type_index()), _simulators[to]->input_endpoint(l->to_port_type_index()), l});
+                    _routes_by_source[from].push_back(_routes.size() - 1);
+                    _route_destination.push_back(to);
+                }
+
+                /**
+                 * @brief Declares the model sends messages to other processes.
+                 */
+                void add_boundary(std::size_t i) {
+                    if (!_is_boundary[i]) {
+                        _is_boundary[i] = true;
+                        _boundary.push_back(i);
+                    }
+                }
+
+                void init(const TIME& initial_time) {
+                    std::vector<TIME> next_times;
+                    for (auto& s : _simulators) {
+                        s->init(initial_time);
+                        next_times.push_back(s->next());
+                    }
+                    _fel.assign(next_times);
+                }
+
+                TIME next() const {
+                    return _fel.empty() ? std::numeric_limits<TIME>::infinity() : _fel.min();
+                }
+
+                /**
+                 * @brief Lower bound of the time of the next message this process sends to other processes.
+                 * The messages of a model are sent at its next internal transition, and any transition of
+                 * the model, happening no earlier than the next event of the process, delays its following
+                 * output at least its lookahead.
+                 */
+                TIME earliest_output() const {
+                    TIME earliest = std::numeric_limits<TIME>::infinity();
+                    TIME process_next = next();
+                    for (std::size_t i : _boundary) {
+                        earliest = std::min({earliest, _simulators[i]->next(), process_next + _lookaheads[i]});
+                    }
+                    return earliest;
+                }
+
+                /**
+                 * @brief Collects the outputs of the models imminent at t.
+                 */
+                void collect_outputs(const TIME& t) {
+                    _imminent.clear();
+                    if (next() == t) {
+                        _fel.imminent(t, _imminent);
+                        std::sort(_imminent.begin(), _imminent.end());
+                    }
+                    _imminent_time = t;
+                    for (std::size_t i : _imminent) {
+                        _simulators[i]->collect_outputs(t);
+                    }
+                }
+
+                /**
+                 * @return The models imminent in the last collect_outputs call.
+                 */
+                const std::vector<std::size_t>& imminent() const noexcept {
+                    return _imminent;
+                }
+
+                /**
+                 * @brief Notifies the model received messages routed by the runner for the next advance.
+                 */
+                void received(std::size_t i) {
+                    activate(i);
+                }
+
+                /**
+                 * @brief Routes the messages between the models of the process and advances to t the
+                 * imminent models and the ones receiving messages. collect_outputs(t) must be called before.
+                 */
+                void advance_simulation(const TIME& t) {
+                    _selected_routes.clear();
+                    for (std::size_t i : _imminent) {
+                        _selected_routes.insert(_selected_routes.end(), _routes_by_source[i].begin(), _routes_by_source[i].end());
+                    }
+                    std::sort(_selected_routes.begin(), _selected_routes.end());
+                    route_bound_messages<LOGGER>(_routes, _selected_routes);
+                    for (std::size_t r : _selected_routes) {
+                        std::size_t to = _route_destination[r];
+                        if (!_is_active[to] && !_simulators[to]->inbox_empty()) {
+                            activate(to);
+                        }
+                    }
+                    advance_models(t);
+                }
+
+                /**
+                 * @brief Advances to t the imminent models and the ones receiving messages, without routing
+                 * the messages between the models of the process. collect_outputs(t) must be called before.
+                 */
+                void advance_models(const TIME& t) {
+                    if (_imminent_time != t) {
+                        throw std::domain_error("Trying to advance a logical process without collecting its outputs");
+                    }
+                    for (std::size_t i : _imminent) {
+                        activate(i);
+                    }
+                    std::sort(_active.begin(), _active.end());
+                    for (std::size_t i : _active) {
+                        _simulators[i]->advance_simulation(t);
+                        TIME next = _simulators[i]->next();
+                        if (_is_boundary[i] && next < t + _lookaheads[i]) {
+                            throw std::domain_error("Model " + _simulators[i]->get_model_id() + " scheduled an output before its lookahead");
+                        }
+                        _fel.update(i, next);
+                        _is_active[i] = false;
+                    }
+                    _active.clear();
+                    _imminent.clear();
+                }
+
+                /**
+                 * @brief Simulates the events of the process happening before t.
+                 * @return The amount of steps simulated.
+                 */
+                std::size_t run_until(const TIME& t) {
+                    std::size_t steps = 0;
+                    for (TIME next = this->next(); next < t; next = this->next()) {
+                        collect_outputs(next);
+                        advance_simulation(next);
+                        steps++;
+                    }
+                    return steps;
+                }
+            };
+
+            /**
+             * @brief Conservative parallel runner, in the style of YAWNS.
+             *
+             * @details
+             * The atomic models of the flattened coupled model are split in logical processes. On each
+             * iteration the runner computes the earliest time any process may send a message to another
+             * one, from the next events of the processes and the lookahead of their models. Events before
+             * that time are safe: every process simulates them in parallel without synchronizing. When no
+             * event is safe, all the processes run a synchronized step at the next event time, exchanging
+             * the messages between processes. With zero lookahead, which is the default of the models,
+             * every step is synchronized.
+             *
+             * Asynchronous atomic models are not supported.
+             *
+             * @param TIME Representation of time to be used to run the simulation
+             * @param LOGGER what, where and how to log from the simulation, logs of different processes interleave
+             * @param FEL future event list policy used by the processes, see pdevs_dynamic_fel.hpp
+             */
+            template<class TIME, typename LOGGER=default_logger<TIME>, template<typename> class FEL=binary_heap_fel>
+            class conservative_runner {
+                using process_type = logical_process<TIME, LOGGER, FEL>;
+
+                // route of an IC of the flattened model, with the same index of the IC
+                struct process_route {
+                    std::size_t to_process;
+                    std::size_t to; // local index in to_process
+                    bound_route route;
+                };
+
+                std::vector<std::unique_ptr<process_type>> _processes;
+                std::vector<process_route> _routes;
+                // routes by process and local index of their source model
+                std::vector<std::vector<std::vector<std::size_t>>> _routes_by_source;
+                std::vector<std::size_t> _selected_routes;
+                std::vector<std::size_t> _steps;
+                cadmium::concurrency::work_stealing_executor _executor;
+
+                TIME _next;
+                std::size_t _windows = 0;
+                std::size_t _window_steps = 0;
+                std::size_t _synchronized_steps = 0;
+
+                void build(const cadmium::dynamic::modeling::flattened_coupled<TIME>& flat, const std::vector<std::size_t>& process_of, std::size_t processes) {
+                    if (process_of.size() != flat.atomics.size()) {
+                        throw std::domain_error("Every atomic model must be assigned to a logical process");
+                    }
+                    for (std::size_t p = 0; p < processes; p++) {
+                        _processes.push_back(std::make_unique<process_type>());
+                    }
+                    _routes_by_source.resize(processes);
+
+                    std::vector<std::size_t> local(flat.atomics.size());
+                    for (std::size_t a = 0; a < flat.atomics.size(); a++) {
+                        auto m = std::dynamic_pointer_cast<cadmium::dynamic::modeling::atomic_abstract<TIME>>(flat.atomics[a]);
+                        if (m == nullptr) {
+                            throw std::domain_error("The conservative runner only supports atomic models");
+                        }
+                        if (process_of[a] >= processes) {
+                            throw std::domain_error("Atomic model assigned to an invalid logical process");
+                        }
+                        local[a] = _processes[process_of[a]]->add_model(m);
+                        _routes_by_source[process_of[a]].emplace_back();
+                    }
+
+                    for (const auto& ic : flat.ic) {
+                        std::size_t from_process = process_of[ic.from];
+                        std::size_t to_process = process_of[ic.to];
+                        process_type& from = *_processes[from_process];
+                        process_type& to = *_processes[to_process];
+                        if (from_process == to_process) {
+                            from.add_route(local[ic.from], local[ic.to], ic.link);
+                        } else {
+                            from.add_boundary(local[ic.from]);
+                        }
+                        bound_route r{from.model(local[ic.from]).output_endpoint(ic.link->from_port_type_index()), to.model(local[ic.to]).input_endpoint(ic.link->to_port_type_index()), ic.link};
+                        _routes.push_back({to_process, local[ic.to], r});
+                        _routes_by_source[from_process][local[ic.from]].push_back(_routes.size() - 1);
+                    }
+                    _steps.resize(processes);
+                }
+
+                void init(const TIME& init_time) {
+                    LOGGER::template log<cadmium::logger::logger_global_time, cadmium::logger::run_global_time>(init_time);
+                    LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::run_info>("Preparing model");
+                    auto init_process = [this, &init_time](std::size_t p) { _processes[p]->init(init_time); };
+                    _executor.parallel_for(_processes.size(), init_process);
+                    _next = next_in_processes();
+                }
+
+                TIME next_in_processes() const {
+                    TIME next = std::numeric_limits<TIME>::infinity();
+                    for (const auto& p : _processes) {
+                        next = std::min(next, p->next());
+                    }
+                    return next;
+                }
+
+                void synchronized_step(const TIME& t) {
+                    auto collect = [this, &t](std::size_t p) { _processes[p]->collect_outputs(t); };
+                    _executor.parallel_for(_processes.size(), collect);
+
+                    // all the messages are routed here, in the order of the ICs, so each model receives
+                    // them in the same order of a sequential simulation
+                    _selected_routes.clear();
+                    for (std::size_t p = 0; p < _processes.size(); p++) {
+                        for (std::size_t i : _processes[p]->imminent()) {
+                            const auto& routes = _routes_by_source[p][i];
+                            _selected_routes.insert(_selected_routes.end(), routes.begin(), routes.end());
+                        }
+                    }
+                    std::sort(_selected_routes.begin(), _selected_routes.end());
+                    for (std::size_t r : _selected_routes) {
+                        const process_route& pr = _routes[r];
+                        route_link_messages<LOGGER>(*pr.route.link, pr.route.from, pr.route.to);
+                        if (!_processes[pr.to_process]->model(pr.to).inbox_empty()) {
+                            _processes[pr.to_process]->received(pr.to);
+                        }
+                    }
+
+                    auto advance = [this, &t](std::size_t p) { _processes[p]->advance_models(t); };
+                    _executor.parallel_for(_processes.size(), advance);
+                    _synchronized_steps++;
+                }
+
+            public:
+                /**
+                 * @brief Splits the atomic models of the flattened coupled model in contiguous blocks of
+                 * the depth-first order, so models of the same coupled model tend to share their process.
+                 * @param processes is the amount of logical processes.
+                 * @param thread_count is the amount of threads simulating the processes.
+                 */
+                conservative_runner(std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> coupled_model, const TIME& init_time,
+                                    std::size_t processes = std::thread::hardware_concurrency(), unsigned thread_count = std::thread::hardware_concurrency())
+                : _executor(thread_count) {
+                    cadmium::dynamic::modeling::flattened_coupled<TIME> flat = cadmium::dynamic::modeling::flatten<TIME>(coupled_model);
+                    processes = std::max<std::size_t>(1, std::min(processes, flat.atomics.size()));
+                    std::vector<std::size_t> process_of(flat.atomics.size());
+                    for (std::size_t a = 0; a < process_of.size(); a++) {
+                        process_of[a] = a * processes / process_of.size();
+                    }
+                    build(flat, process_of, processes);
+                    init(init_time);
+                }
+
+                /**
+                 * @param process_of is the logical process of each atomic model, in the order of the
+                 * flattened coupled model, see cadmium::dynamic::modeling::flatten.
+                 * @param thread_count is the amount of threads simulating the processes.
+                 */
+                conservative_runner(std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> coupled_model, const TIME& init_time,
+                                    const std::vector<std::size_t>& process_of, unsigned thread_count = std::thread::hardware_concurrency())
+                : _executor(thread_count) {
+                    std::size_t processes = process_of.empty() ? 1 : *std::max_element(process_of.begin(), process_of.end()) + 1;
+                    build(cadmium::dynamic::modeling::flatten<TIME>(coupled_model), process_of, processes);
+                    init(init_time);
+                }
+
+                conservative_runner(const conservative_runner&) = delete;
+                conservative_runner& operator=(const conservative_runner&) = delete;
+
+                /**
+                 * @brief runUntil starts the simulation and stops when the next event is scheduled after t.
+                 * @param t is the limit time for the simulation.
+                 * @return the TIME of the next event to happen when simulation stopped.
+                 */
+                TIME run_until(const TIME& t) {
+                    LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::run_info>("Starting run");
+                    while (_next < t) {
+                        LOGGER::template log<cadmium::logger::logger_global_time, cadmium::logger::run_global_time>(_next);
+                        TIME safe = t;
+                        for (const auto& p : _processes) {
+                            safe = std::min(safe, p->earliest_output());
+                        }
+
+                        if (_next < safe) {
+                            auto run_window = [this, &safe](std::size_t p) { _steps[p] = _processes[p]->run_until(safe); };
+                            _executor.parallel_for(_processes.size(), run_window);
+                            _windows++;
+                            for (std::size_t s : _steps) {
+                                _window_steps += s;
+                            }
+                        } else {
+                            synchronized_step(_next);
+                        }
+                        _next = next_in_processes();
+                    }
+                    LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::run_info>("Finished run");
+                    return _next;
+                }
+
+                /**
+                 * @brief runUntilPassivate starts the simulation and stops when there is no next internal event to happen.
+                 */
+                void run_until_passivate() {
+                    run_until(std::numeric_limits<TIME>::infinity());
+                }
+
+                std::size_t processes() const noexcept {
+                    return _processes.size();
+                }
+
+                /**
+                 * @brief Amount of safe windows simulated without synchronizing the processes.
+                 */
+                std::size_t windows() const noexcept {
+                    return _windows;
+                }
+
+                /**
+                 * @brief Amount of process steps simulated inside the safe windows.
+                 */
+                std::size_t window_steps() const noexcept {
+                    return _window_steps;
+                }
+
+                std::size_t synchronized_steps() const noexcept {
+                    return _synchronized_steps;
+                }
+            };
+        }
+    }
+}
+
+#endif //CADMIUM_PDEVS_DYNAMIC_CONSERVATIVE_RUNNER_HPP
@@ -26,22 +26,36 @@
 
 #ifndef CADMIUM_PDEVS_DYNAMIC_COORDINATOR_HPP
 #define CADMIUM_PDEVS_DYNAMIC_COORDINATOR_HPP
+#include <algorithm>
+#include <cstdint>
 #include <limits>
+#include <vector>
 
 #include <cadmium/modeling/dynamic_coupled.hpp>
+#include <cadmium/modeling/dynamic_flattened_coupled.hpp>
 #include <cadmium/engine/pdevs_dynamic_simulator.hpp>
 #include <cadmium/engine/pdevs_dynamic_asynchronus_simulator.hpp>
 #include <cadmium/engine/pdevs_dynamic_engine.hpp>
 #include <cadmium/modeling/dynamic_message_bag.hpp>
+#include <cadmium/modeling/message_codec.hpp>
+#include <cadmium/modeling/state_codec.hpp>
 #include <cadmium/logger/dynamic_common_loggers.hpp>
 #include <cadmium/engine/pdevs_dynamic_engine_helpers.hpp>
+#include <cadmium/engine/pdevs_dynamic_fel.hpp>
 #include <cadmium/logger/common_loggers.hpp>
 
 namespace cadmium {
     namespace dynamic {
         namespace engine {
 
-            template<typename TIME, typename LOGGER>
+            /**
+             * @brief Dynamic coordinator of a coupled model.
+             *
+             * The coordinator keeps the next time of its subengines in a future event list (FEL) and only
+             * visits the imminent subengines and the ones receiving messages on each step.
+             * @tparam FEL is the future event list policy, see pdevs_dynamic_fel.hpp
+             */
+            template<typename TIME, typename LOGGER, template<typename> class FEL=binary_heap_fel>
             class coordinator : public cadmium::dynamic::engine::engine<TIME> {
 
                 //MODEL is assumed valid, the whole model tree is checked at "runner level" to fail fast
@@ -55,16 +69,74 @@ namespace cadmium {
                 external_couplings<TIME> _external_input_couplings;
                 internal_couplings<TIME> _internal_coupligns;
 
+                FEL<TIME> _fel;
+                // couplings by index of their source or destination subcoordinator
+                std::vector<std::vector<std::size_t>> _eocs_by_source;
+                std::vector<std::vector<std::size_t>> _ics_by_source;
+                std::vector<std::size_t> _ic_destination;
+                std::vector<std::size_t> _eic_destination;
+                // links of the couplings bound to their ports, with the same index of the coupling
+                bound_routes _eoc_routes;
+                bound_routes _eic_routes;
+                bound_routes _ic_routes;
+                // input ports routed by the EICs, the entries of _inbox cleared in place after each step
+                std::vector<std::type_index> _inbox_ports;
+                // entries of _outbox released when it is cleared, reused by the next outputs
+                dynamic::message_bags _spare_outbox;
+
+                // imminent subcoordinators found by the last collect_outputs, valid for _imminent_time
+                std::vector<std::size_t> _imminent;
+                TIME _imminent_time;
+                bool _imminent_ready = false;
+
+                // scratch structures reused on each step
+                std::vector<std::size_t> _active;
+                std::vector<bool> _is_active;
+                std::vector<std::size_t> _selected_couplings;
+                subcoordinators_type<TIME> _selected_subcoordinators;
+                // subcoordinators advanced since the last checkpoint
+                std::vector<std::size_t> _changed;
+                std::vector<bool> _is_changed;
+                #if defined CADMIUM_EXECUTE_CONCURRENT || defined CPU_PARALLEL || defined CADMIUM_EXECUTE_TEAM
+                routes_by_destination _routes_by_destination;
+                #endif
+
+                #ifdef RT_DEVS
+                bool _interrupted = false;
+                #endif //RT_DEVS
+
                 #ifdef CADMIUM_EXECUTE_CONCURRENT
-                boost::basic_thread_pool* _threadpool;
+                cadmium::concurrency::work_stealing_executor* _threadpool;
                 #endif //CADMIUM_EXECUTE_CONCURRENT
 
                 std::vector <class cadmium::dynamic::modeling::AsyncEventSubject *> _async_subjects;
                 
                 #ifdef CPU_PARALLEL
                 size_t _thread_number;
+                // transition cost measured by subcoordinator, in microseconds
+                std::vector<double> _costs;
+                // bounds of the chunks the threads take, reused by every step
+                std::vector<std::size_t> _chunk_bounds;
                 #endif //CPU_PARALLEL
 
+                #ifdef CADMIUM_EXECUTE_TEAM
+                cadmium::concurrency::worker_team* _team;
+                // team participant running each subcoordinator
+                std::vector<std::size_t> _owners;
+                // part of each subcoordinator, empty to split them in contiguous blocks
+                std::vector<std::size_t> _part_of;
+                cadmium::concurrency::team_selection _team_selection;
+                // steps between rebalances of the owners, 0 keeps them fixed
+                std::size_t _rebalance_interval = 0;
+                std::size_t _steps_since_rebalance = 0;
+                // time taken by each subcoordinator since the last rebalance, and its moving estimation, in microseconds
+                std::vector<double> _interval_costs;
+                std::vector<double> _cost_estimates;
+                // time each participant was busy running its subcoordinators, in microseconds
+                std::vector<double> _busy_times;
+                std::size_t _migrations = 0;
+                #endif //CADMIUM_EXECUTE_TEAM
+
             public:
 
                 dynamic::message_bags _inbox;
@@ -77,14 +149,22 @@ namespace cadmium {
                  */
                 coordinator() = delete;
 
+                // routes are bound to the _inbox and _outbox of this coordinator
+                coordinator(const coordinator&) = delete;
+                coordinator& operator=(const coordinator&) = delete;
+
                 coordinator(std::shared_ptr<model_type> coupled_model)
                         : _model_id(coupled_model->get_id())
                 {
                     #ifdef CADMIUM_EXECUTE_CONCURRENT
                     _threadpool = nullptr;
                     #endif //CADMIUM_EXECUTE_CONCURRENT
+                    #ifdef CADMIUM_EXECUTE_TEAM
+                    _team = nullptr;
+                    #endif //CADMIUM_EXECUTE_TEAM
 
                     std::map<std::string, std::shared_ptr<engine<TIME>>> engines_by_id;
+                    std::map<std::string, std::size_t> indexes_by_id;
 
                     for(auto& m : coupled_model->_models) {
                         std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> m_coupled = std::dynamic_pointer_cast<cadmium::dynamic::modeling::coupled<TIME>>(m);
@@ -92,72 +172,129 @@ namespace cadmium {
                         std::shared_ptr<cadmium::dynamic::modeling::atomic_abstract<TIME>> m_atomic = std::dynamic_pointer_cast<cadmium::dynamic::modeling::atomic_abstract<TIME>>(m);
 
                         if (m_coupled == nullptr) {
-                            if (m_atomic == nullptr && m_async == nullptr) {
-                                throw std::domain_error("Invalid submodel is neither coupled nor atomic");
-                            } else if(m_atomic != nullptr && m_async != nullptr) {
-                                throw std::domain_error("Invalid submodel is both atomic and async");
-                            }
-
-                            if(m_async == nullptr) {
-                                std::shared_ptr<cadmium::dynamic::engine::engine<TIME>> simulator = std::make_shared<cadmium::dynamic::engine::simulator<TIME, LOGGER>>(m_atomic);
-                                _subcoordinators.push_back(simulator);
-                            } else {
-                                std::shared_ptr<cadmium::dynamic::engine::engine<TIME>> simulator = std::make_shared<cadmium::dynamic::engine::asynchronus_simulator<TIME, LOGGER>>(m_async);
-                                _subcoordinators.push_back(simulator);
-                                _async_subjects.push_back((cadmium::dynamic::modeling::AsyncEventSubject *) m_async.get());
-                            }
+                            add_simulator(m);
                         } else {
                             if (m_atomic != nullptr || m_async != nullptr) {
                                 throw std::domain_error("Invalid submodel is defined as both coupled and atomic");
                             }
-                            std::shared_ptr<cadmium::dynamic::engine::engine<TIME>> coordinator = std::make_shared<cadmium::dynamic::engine::coordinator<TIME, LOGGER>>(m_coupled);
+                            std::shared_ptr<cadmium::dynamic::engine::engine<TIME>> coordinator = std::make_shared<cadmium::dynamic::engine::coordinator<TIME, LOGGER, FEL>>(m_coupled);
                             _subcoordinators.push_back(coordinator);
-                            for(auto x : dynamic_cast<cadmium::dynamic::engine::coordinator<TIME, LOGGER> *>(coordinator.get())->get_async_subjects()){
+                            for(auto x : dynamic_cast<cadmium::dynamic::engine::coordinator<TIME, LOGGER, FEL> *>(coordinator.get())->get_async_subjects()){
                                 _async_subjects.push_back(x);
                             }
                         }
 
                         engines_by_id.insert(std::make_pair(_subcoordinators.back()->get_model_id(), _subcoordinators.back()));
+                        indexes_by_id.insert(std::make_pair(_subcoordinators.back()->get_model_id(), _subcoordinators.size() - 1));
                     }
 
+                    _eocs_by_source.resize(_subcoordinators.size());
+                    _ics_by_source.resize(_subcoordinators.size());
+                    _is_active.assign(_subcoordinators.size(), false);
+                    _is_changed.assign(_subcoordinators.size(), false);
+                    #ifdef CPU_PARALLEL
+                    _costs.assign(_subcoordinators.size(), 1.0);
+                    #endif //CPU_PARALLEL
+                    #if defined CADMIUM_EXECUTE_CONCURRENT || defined CPU_PARALLEL || defined CADMIUM_EXECUTE_TEAM
+                    _routes_by_destination.resize(_subcoordinators.size());
+                    #endif
+
                     // Generates structures for direct access to external couplings to not iterate all coordinators each time.
 
                     for (const auto& eoc : coupled_model->_eoc) {
                     	if (engines_by_id.find(eoc._from) == engines_by_id.end()) {
                     		throw std::domain_error("External output coupling from invalid model");
                     	}
-
-                    	cadmium::dynamic::engine::external_coupling<TIME> new_eoc;
-                    	new_eoc.first = engines_by_id.at(eoc._from);
-                    	new_eoc.second.push_back(eoc._link);
-                    	_external_output_couplings.push_back(new_eoc);
+                    	add_external_output_coupling(indexes_by_id.at(eoc._from), eoc._link);
                     }
 
                     for (const auto& eic : coupled_model->_eic) {
                     	if (engines_by_id.find(eic._to) == engines_by_id.end()) {
                     		throw std::domain_error("External input coupling to invalid model");
                     	}
-
-                    	cadmium::dynamic::engine::external_coupling<TIME> new_eic;
-                    	new_eic.first = engines_by_id.at(eic._to);
-                    	new_eic.second.push_back(eic._link);
-                    	_external_input_couplings.push_back(new_eic);
-
+                    	add_external_input_coupling(indexes_by_id.at(eic._to), eic._link);
                     }
 
                     for (const auto& ic : coupled_model->_ic) {
                     	if (engines_by_id.find(ic._from) == engines_by_id.end() || engines_by_id.find(ic._to) == engines_by_id.end()) {
                     		throw std::domain_error("Internal coupling to invalid model");
                     	}
+                    	add_internal_coupling(indexes_by_id.at(ic._from), indexes_by_id.at(ic._to), ic._link);
+                    }
+
+                }
+
+                /**
+                 * @brief Constructs a single level coordinator running all the atomic models of a flattened
+                 * hierarchy, messages are routed directly between atomic models.
+                 * @param flat_model is the flattened coupled model, see cadmium::dynamic::modeling::flatten.
+                 */
+                explicit coordinator(const cadmium::dynamic::modeling::flattened_coupled<TIME>& flat_model)
+                        : coordinator(flat_model, flat_model.atomics)
+                {}
+
+                /**
+                 * @brief Constructs a single level coordinator running the given atomic models with the
+                 * couplings of a flattened hierarchy, so the replications of a model share its couplings.
+                 * @param atomics are copies of the atomic models of flat_model, in the same order.
+                 */
+                coordinator(const cadmium::dynamic::modeling::flattened_coupled<TIME>& flat_model, const cadmium::dynamic::modeling::Models& atomics)
+                        : _model_id(flat_model.id)
+                {
+                    #ifdef CADMIUM_EXECUTE_CONCURRENT
+                    _threadpool = nullptr;
+                    #endif //CADMIUM_EXECUTE_CONCURRENT
+                    #ifdef CADMIUM_EXECUTE_TEAM
+                    _team = nullptr;
+                    #endif //CADMIUM_EXECUTE_TEAM
+
+                    if (atomics.size() != flat_model.atomics.size()) {
+                        throw std::domain_error("The atomic models do not match the flattened model");
+                    }
+                    for (const auto& m : atomics) {
+                        add_simulator(m);
+                    }
+
+                    _eocs_by_source.resize(_subcoordinators.size());
+                    _ics_by_source.resize(_subcoordinators.size());
+                    _is_active.assign(_subcoordinators.size(), false);
+                    _is_changed.assign(_subcoordinators.size(), false);
+                    #ifdef CPU_PARALLEL
+                    _costs.assign(_subcoordinators.size(), 1.0);
+                    #endif //CPU_PARALLEL
+                    #if defined CADMIUM_EXECUTE_CONCURRENT || defined CPU_PARALLEL || defined CADMIUM_EXECUTE_TEAM
+                    _routes_by_destination.resize(_subcoordinators.size());
+                    #endif
+
+                    for (const auto& eoc : flat_model.eoc) {
+                        add_external_output_coupling(eoc.model, eoc.link);
+                    }
 
-                    	cadmium::dynamic::engine::internal_coupling<TIME> new_ic;
-                    	new_ic.first.first = engines_by_id.at(ic._from);
-                    	new_ic.first.second = engines_by_id.at(ic._to);
-                    	new_ic.second.push_back(ic._link);
-                    	_internal_coupligns.push_back(new_ic);
+                    for (const auto& eic : flat_model.eic) {
+                        add_external_input_coupling(eic.model, eic.link);
                     }
 
+                    for (const auto& ic : flat_model.ic) {
+                        add_internal_coupling(ic.from, ic.to, ic.link);
+                    }
+                }
+
+                /**
+                 * @brief Constructs a single level coordinator running the atomic models of a flattened
+                 * hierarchy grouped by part, see cadmium::dynamic::engine::partition_atomics. The models
+                 * of each part are contiguous, so parallel loops split them along the parts, and in team
+                 * mode each part is owned by a single participant.
+                 * @param part_of is the part of each atomic model of the flattened hierarchy.
+                 */
+                coordinator(const cadmium::dynamic::modeling::flattened_coupled<TIME>& flat_model, const std::vector<std::size_t>& part_of)
+                        : coordinator(cadmium::dynamic::modeling::group_by_part(flat_model, part_of))
+                {
+                    #ifdef CADMIUM_EXECUTE_TEAM
+                    _part_of = part_of;
+                    std::sort(_part_of.begin(), _part_of.end());
+                    #endif //CADMIUM_EXECUTE_TEAM
                 }
+
                 /**
                  * @brief init function sets the start time
                  * @param initial_time is the start time
@@ -173,19 +310,45 @@ namespace cadmium {
                     #else
 						#if defined CPU_PARALLEL
                     	cadmium::dynamic::engine::init_subcoordinators<TIME>(initial_time, _subcoordinators, _thread_number);
+						#elif defined CADMIUM_EXECUTE_TEAM
+                    	if (_part_of.empty()) {
+                    		_owners = cadmium::concurrency::contiguous_owners(_subcoordinators.size(), team_size());
+                    	} else {
+                    		_owners.clear();
+                    		for (std::size_t part : _part_of) {
+                    			_owners.push_back(part % team_size());
+                    		}
+                    	}
+                    	#if CADMIUM_TEAM_FIRST_TOUCH
+                    	place_models();
+                    	#endif //CADMIUM_TEAM_FIRST_TOUCH
+                    	_steps_since_rebalance = 0;
+                    	_interval_costs.assign(_subcoordinators.size(), 0.0);
+                    	_cost_estimates.assign(_subcoordinators.size(), 0.0);
+                    	_busy_times.assign(team_size(), 0.0);
+                    	_migrations = 0;
+                    	cadmium::dynamic::engine::init_subcoordinators<TIME>(initial_time, _subcoordinators, _team);
 						#else
                     	cadmium::dynamic::engine::init_subcoordinators<TIME>(initial_time, _subcoordinators);
 						#endif
                     #endif //CADMIUM_EXECUTE_CONCURRENT
 
 
-                    //find the one with the lowest next time
-                    _next = cadmium::dynamic::engine::min_next_in_subcoordinators<TIME>(_subcoordinators);
+                    //schedule all subcoordinators and find the one with the lowest next time
+                    std::vector<TIME> next_times;
+                    next_times.reserve(_subcoordinators.size());
+                    for (const auto& c : _subcoordinators) {
+                        next_times.push_back(c->next());
+                    }
+                    _fel.assign(next_times);
+                    _imminent_ready = false;
+                    _next = next_in_fel();
+                    clear_changed();
                 }
 
                 #ifdef CADMIUM_EXECUTE_CONCURRENT
 
-                void init(TIME initial_time, boost::basic_thread_pool* threadpool) override {
+                void init(TIME initial_time, cadmium::concurrency::work_stealing_executor* threadpool) override {
                     _threadpool = threadpool;
                     this->init(initial_time);
                 }
@@ -199,6 +362,54 @@ namespace cadmium {
                 }
                 #endif //CPU_PARALLEL
 
+                #ifdef CADMIUM_EXECUTE_TEAM
+                void init(TIME initial_time, cadmium::concurrency::worker_team* team) override {
+                    _team = team;
+                    this->init(initial_time);
+                }
+
+                /**
+                 * @brief Every given amount of steps, measures the time each team participant was busy
+                 * with its subcoordinators and, when the busiest one exceeds the average by
+                 * CADMIUM_TEAM_REBALANCE_THRESHOLD, moves subcoordinators between participants to
+                 * balance the estimated cost of their blocks. Owners only change between steps and
+                 * routing does not depend on them, so results are the same as with fixed owners.
+                 * @param steps between rebalances, 0 keeps the owners fixed.
+                 */
+                void set_rebalance_interval(std::size_t steps) noexcept {
+                    _rebalance_interval = steps;
+                    _steps_since_rebalance = 0;
+                }
+
+                /**
+                 * @brief Time each team participant was busy running its subcoordinators until the last
+                 * rebalance, in microseconds. Only measured when rebalancing.
+                 */
+                const std::vector<double>& busy_times() const noexcept {
+                    return _busy_times;
+                }
+
+                /**
+                 * @brief Amount of subcoordinators moved to another participant by rebalances.
+                 */
+                std::size_t migrations() const noexcept {
+                    return _migrations;
+                }
+
+                /**
+                 * @brief Relocates the models of each subcoordinator from the thread of the team participant
+                 * owning it, so their memory is placed on the NUMA node where they run. Done on init and
+                 * for the subcoordinators moved by rebalances unless CADMIUM_TEAM_FIRST_TOUCH is 0.
+                 */
+                void place_models() {
+                    std::vector<std::size_t> all(_subcoordinators.size());
+                    for (std::size_t i = 0; i < all.size(); i++) {
+                        all[i] = i;
+                    }
+                    place_models(all);
+                }
+                #endif //CADMIUM_EXECUTE_TEAM
+
 
                 std::string get_model_id() const override {
                     return _model_id;
@@ -216,31 +427,100 @@ namespace cadmium {
                  * @param t time the simulation will be advanced to
                  * @todo At this point all messages are copied while routed from one level to the next, need to find a good
                  * strategy to lower copying, maybe.
-                 * @todo Merge the Collect output calls into the advance simulation as done with ICs and EICs routing
                  */
                 void collect_outputs(const TIME &t) override {
-                    LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::coor_info_collect>(t, _model_id);
+                    if (collect_imminent_outputs(t)) {
+                        // Use the EOC mapping to compose current level output, only imminent subcoordinators have outputs
+                        select_couplings(_eocs_by_source);
+                        clear_outbox();
+                        for (std::size_t eoc : _selected_couplings) {
+                            if (_eoc_routes[eoc].link->has_messages(_eoc_routes[eoc].from)) {
+                                cadmium::dynamic::reuse_message_bag(_outbox, _spare_outbox, _eoc_routes[eoc].link->to_port_type_index());
+                            }
+                        }
+                        cadmium::dynamic::engine::route_bound_messages<LOGGER>(_eoc_routes, _selected_couplings);
+                    }
+                }
 
-                    //collecting if necessary
-                    if (_next < t) {
-                        throw std::domain_error("Trying to obtain output when not internal event is scheduled");
-                    } else if (_next == t) {
-                        //log EOC
-                        LOGGER::template log<cadmium::logger::logger_message_routing, cadmium::logger::coor_routing_eoc_collect>(t, _model_id);
+                /**
+                 * @brief Collects the outputs and advances the simulation to t in a single call, as the
+                 * runners do with the top coordinator. The outbox is not composed unless message routing
+                 * is logged, because it has no parent to read it and advance_simulation clears it.
+                 * @param t time the simulation will be advanced to
+                 */
+                void step(const TIME &t) override {
+                    if constexpr (cadmium::logger::logs_source_v<LOGGER, cadmium::logger::logger_message_routing>) {
+                        collect_outputs(t);
+                    } else {
+                        collect_imminent_outputs(t);
+                    }
+                    advance_simulation(t);
+                }
 
-                        // Fill all outboxes and clean the inboxes in the lower levels recursively
-						#ifdef CADMIUM_EXECUTE_CONCURRENT
-                        cadmium::dynamic::engine::collect_outputs_in_subcoordinators<TIME>(t, _subcoordinators, _threadpool);
-						#else
-							#if defined CPU_PARALLEL
-                        	cadmium::dynamic::engine::collect_outputs_in_subcoordinators<TIME>(t, _subcoordinators, _thread_number);
-							#else
-                        	cadmium::dynamic::engine::collect_outputs_in_subcoordinators<TIME>(t, _subcoordinators);
-							#endif
-						#endif
+                /**
+                 * @brief relocates the models of every subcoordinator from the calling thread.
+                 */
+                void relocate() override {
+                    for (auto& c : _subcoordinators) {
+                        c->relocate();
+                    }
+                }
 
-                        // Use the EOC mapping to compose current level output
-                        _outbox = cadmium::dynamic::engine::collect_messages_by_eoc<TIME, LOGGER>(_external_output_couplings);
+                /**
+                 * @brief Encodes the last transition time and the subcoordinators. A full checkpoint
+                 * encodes all of them, otherwise only the ones advanced since the last checkpoint are
+                 * encoded after their index, so a delta is applied on the previous checkpoints.
+                 * @note Only valid between steps, when the inboxes and outboxes are empty.
+                 */
+                void save_checkpoint(std::string& out, bool full) override {
+                    if constexpr (cadmium::dynamic::state_codec<TIME>::defined) {
+                        cadmium::dynamic::state_codec<TIME>::encode(_last, out);
+                        if (full) {
+                            for (auto& c : _subcoordinators) {
+                                c->save_checkpoint(out, true);
+                            }
+                        } else {
+                            cadmium::dynamic::message_codec<std::uint64_t>::encode(_changed.size(), out);
+                            for (std::size_t i : _changed) {
+                                cadmium::dynamic::message_codec<std::uint64_t>::encode(i, out);
+                                _subcoordinators[i]->save_checkpoint(out, false);
+                            }
+                        }
+                        clear_changed();
+                    } else {
+                        engine<TIME>::save_checkpoint(out, full);
+                    }
+                }
+
+                void load_checkpoint(const char*& data, const char* end, bool full) override {
+                    if constexpr (cadmium::dynamic::state_codec<TIME>::defined) {
+                        cadmium::dynamic::state_codec<TIME>::decode(_last, data, end);
+                        if (full) {
+                            std::vector<TIME> next_times;
+                            next_times.reserve(_subcoordinators.size());
+                            for (auto& c : _subcoordinators) {
+                                c->load_checkpoint(data, end, true);
+                                next_times.push_back(c->next());
+                            }
+                            _fel.assign(next_times);
+                        } else {
+                            std::uint64_t changed = cadmium::dynamic::message_codec<std::uint64_t>::decode(data, end);
+                            for (std::uint64_t k = 0; k < changed; k++) {
+                                std::uint64_t i = cadmium::dynamic::message_codec<std::uint64_t>::decode(data, end);
+                                if (i >= _subcoordinators.size()) {
+                                    throw std::domain_error("Invalid subcoordinator in checkpoint");
+                                }
+                                _subcoordinators[i]->load_checkpoint(data, end, false);
+                                _fel.update(i, _subcoordinators[i]->next());
+                            }
+                        }
+                        clear_changed();
+                        clear_inbox();
+                        clear_outbox();
+                        _imminent_ready = false;
+                        _next = next_in_fel();
+                    } else {
+                        engine<TIME>::load_checkpoint(data, end, full);
                     }
                 }
 
@@ -259,13 +539,26 @@ namespace cadmium {
                     return _inbox;
                 }
 
+                /**
+                 * @brief checks the bags of the input ports routed by the EICs, the bags of _inbox are kept
+                 * between steps and cleared in place.
+                 */
+                bool inbox_empty() override {
+                    for (const auto& r : _eic_routes) {
+                        if (r.link->has_messages(r.from)) {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+
                 /**
                  * @brief advanceSimulation advances the execution to t, at t introduces the messages into the system (if any).
                  * @param t is the time the transition is expected to be run.
                  */
                 void advance_simulation(const TIME &t) override {
                     //clean outbox because messages are routed before calling this function at a higher level
-                    _outbox = cadmium::dynamic::message_bags();
+                    clear_outbox();
 
                     LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::coor_info_advance>(_last, t, _model_id);
 
@@ -273,30 +566,95 @@ namespace cadmium {
                         throw std::domain_error("Trying to obtain output when out of the advance time scope");
                     } else {
 
-                        //Route the messages standing in the outboxes to mapped inboxes following ICs and EICs
-                        LOGGER::template log<cadmium::logger::logger_message_routing, cadmium::logger::coor_routing_ic_collect>(t, _model_id);
-                        cadmium::dynamic::engine::route_internal_coupled_messages_on_subcoordinators<TIME, LOGGER>(_internal_coupligns);
+                        // outputs are only collected when advancing at the time they were collected for
+                        if (!_imminent_ready || _imminent_time != t) {
+                            if (_next == t) {
+                                find_imminent(t);
+                            } else {
+                                _imminent.clear();
+                            }
+                        }
+                        _imminent_ready = false;
 
-                        LOGGER::template log<cadmium::logger::logger_message_routing, cadmium::logger::coor_routing_eic_collect>(t, _model_id);
-                        cadmium::dynamic::engine::route_external_input_coupled_messages_on_subcoordinators<TIME, LOGGER>(_inbox, _external_input_couplings);
+                        //Route the messages standing in the outboxes to mapped inboxes following ICs and EICs
+                        select_couplings(_ics_by_source);
+                        bool received = !inbox_empty();
+                        #if defined CADMIUM_EXECUTE_CONCURRENT || defined CPU_PARALLEL || defined CADMIUM_EXECUTE_TEAM
+                        if constexpr (!cadmium::logger::logs_source_v<LOGGER, cadmium::logger::logger_message_routing>) {
+                            route_by_destination(received);
+                        } else {
+                            route_sequentially(t, received);
+                        }
+                        #else
+                        route_sequentially(t, received);
+                        #endif
+
+                        // Only imminent subcoordinators and the ones receiving messages are advanced
+                        _active.clear();
+                        for (std::size_t i : _imminent) {
+                            activate(i);
+                        }
+                        for (std::size_t ic : _selected_couplings) {
+                            activate_if_received(_ic_destination[ic]);
+                        }
+                        if (received) {
+                            for (std::size_t to : _eic_destination) {
+                                activate_if_received(to);
+                            }
+                        }
+                        #ifdef RT_DEVS
+                        if (_interrupted) {
+                            for (std::size_t i = 0; i < _subcoordinators.size(); i++) {
+                                activate(i);
+                            }
+                        }
+                        #endif //RT_DEVS
+                        std::sort(_active.begin(), _active.end());
 
                         //recurse on advance_simulation
 						#ifdef CADMIUM_EXECUTE_CONCURRENT
-                        cadmium::dynamic::engine::advance_simulation_in_subengines<TIME>(t, _subcoordinators, _threadpool);
+                        cadmium::dynamic::engine::select_subcoordinators<TIME>(_subcoordinators, _active, _selected_subcoordinators);
+                        cadmium::dynamic::engine::advance_simulation_in_subengines<TIME>(t, _selected_subcoordinators, _threadpool);
 						#else
 							#if defined CPU_PARALLEL
-                        	cadmium::dynamic::engine::advance_simulation_in_subengines<TIME>(t, _subcoordinators, _thread_number);
+                        	cadmium::dynamic::engine::advance_simulation_in_subengines<TIME>(t, _subcoordinators, _active, _costs, _thread_number, _chunk_bounds);
+							#elif defined CADMIUM_EXECUTE_TEAM
+                        	select_by_owner(_active);
+                        	if (_rebalance_interval > 0) {
+                        		cadmium::dynamic::engine::advance_simulation_in_subengines<TIME>(t, _subcoordinators, _team_selection, _team, _interval_costs);
+                        	} else {
+                        		cadmium::dynamic::engine::advance_simulation_in_subengines<TIME>(t, _subcoordinators, _team_selection, _team);
+                        	}
 							#else
-                        	cadmium::dynamic::engine::advance_simulation_in_subengines<TIME>(t, _subcoordinators);
+                        	cadmium::dynamic::engine::select_subcoordinators<TIME>(_subcoordinators, _active, _selected_subcoordinators);
+                        	cadmium::dynamic::engine::advance_simulation_in_subengines<TIME>(t, _selected_subcoordinators);
 							#endif
 						#endif
 
+                        //reschedule the advanced subcoordinators
+                        for (std::size_t i : _active) {
+                            _fel.update(i, _subcoordinators[i]->next());
+                            _is_active[i] = false;
+                            if (!_is_changed[i]) {
+                                _is_changed[i] = true;
+                                _changed.push_back(i);
+                            }
+                        }
+                        #ifdef RT_DEVS
+                        _interrupted = false;
+                        #endif //RT_DEVS
+                        #ifdef CADMIUM_EXECUTE_TEAM
+                        if (_rebalance_interval > 0 && ++_steps_since_rebalance >= _rebalance_interval) {
+                            rebalance();
+                        }
+                        #endif //CADMIUM_EXECUTE_TEAM
+
                         //set _last and _next
                         _last = t;
-                        _next = cadmium::dynamic::engine::min_next_in_subcoordinators<TIME>(_subcoordinators);
+                        _next = next_in_fel();
 
                         //clean inbox because they were processed already
-                        _inbox = cadmium::dynamic::message_bags();
+                        clear_inbox();
                     }
                 }
 
@@ -311,9 +669,296 @@ namespace cadmium {
                  */
                 void interrupt_notify(const TIME &t) {
                     _next = t;
+                    wake_up_on_interrupt();
+                }
+
+                #endif
+
+            private:
+                void add_simulator(const std::shared_ptr<cadmium::dynamic::modeling::model>& m) {
+                    std::shared_ptr<cadmium::dynamic::modeling::asynchronus_atomic_abstract<TIME>> m_async = std::dynamic_pointer_cast<cadmium::dynamic::modeling::asynchronus_atomic_abstract<TIME>>(m);
+                    std::shared_ptr<cadmium::dynamic::modeling::atomic_abstract<TIME>> m_atomic = std::dynamic_pointer_cast<cadmium::dynamic::modeling::atomic_abstract<TIME>>(m);
+
+                    if (m_atomic == nullptr && m_async == nullptr) {
+                        throw std::domain_error("Invalid submodel is neither coupled nor atomic");
+                    } else if(m_atomic != nullptr && m_async != nullptr) {
+                        throw std::domain_error("Invalid submodel is both atomic and async");
+                    }
+
+                    if(m_async == nullptr) {
+                        std::shared_ptr<cadmium::dynamic::engine::engine<TIME>> simulator = std::make_shared<cadmium::dynamic::engine::simulator<TIME, LOGGER>>(m_atomic);
+                        _subcoordinators.push_back(simulator);
+                    } else {
+                        std::shared_ptr<cadmium::dynamic::engine::engine<TIME>> simulator = std::make_shared<cadmium::dynamic::engine::asynchronus_simulator<TIME, LOGGER>>(m_async);
+                        _subcoordinators.push_back(simulator);
+                        _async_subjects.push_back((cadmium::dynamic::modeling::AsyncEventSubject *) m_async.get());
+                    }
+                }
+
+                void add_external_output_coupling(std::size_t from, const std::shared_ptr<link_abstract>& l) {
+                    cadmium::dynamic::engine::external_coupling<TIME> new_eoc;
+                    new_eoc.first = _subcoordinators.at(from);
+                    new_eoc.second.push_back(l);
+                    _external_output_couplings.push_back(new_eoc);
+                    _eocs_by_source[from].push_back(_external_output_couplings.size() - 1);
+                    _eoc_routes.push_back({_subcoordinators[from]->output_endpoint(l->from_port_type_index()), cadmium::dynamic::port_endpoint{nullptr, &_outbox}, l});
+                }
+
+                void add_external_input_coupling(std::size_t to, const std::shared_ptr<link_abstract>& l) {
+                    cadmium::dynamic::engine::external_coupling<TIME> new_eic;
+                    new_eic.first = _subcoordinators.at(to);
+                    new_eic.second.push_back(l);
+                    _external_input_couplings.push_back(new_eic);
+                    _eic_destination.push_back(to);
+                    _eic_routes.push_back({cadmium::dynamic::port_endpoint{nullptr, &_inbox}, _subcoordinators[to]->input_endpoint(l->to_port_type_index()), l});
+                    if (std::find(_inbox_ports.begin(), _inbox_ports.end(), l->from_port_type_index()) == _inbox_ports.end()) {
+                        _inbox_ports.push_back(l->from_port_type_index());
+                    }
+                }
+
+                void add_internal_coupling(std::size_t from, std::size_t to, const std::shared_ptr<link_abstract>& l) {
+                    cadmium::dynamic::engine::internal_coupling<TIME> new_ic;
+                    new_ic.first.first = _subcoordinators.at(from);
+                    new_ic.first.second = _subcoordinators.at(to);
+                    new_ic.second.push_back(l);
+                    _internal_coupligns.push_back(new_ic);
+                    _ics_by_source[from].push_back(_internal_coupligns.size() - 1);
+                    _ic_destination.push_back(to);
+                    _ic_routes.push_back({_subcoordinators[from]->output_endpoint(l->from_port_type_index()), _subcoordinators[to]->input_endpoint(l->to_port_type_index()), l});
+                }
+
+                #ifdef RT_DEVS
+                void wake_up_on_interrupt() {
+                    _interrupted = true;
+                    for (auto& c : _subcoordinators) {
+                        auto sub = dynamic_cast<cadmium::dynamic::engine::coordinator<TIME, LOGGER, FEL> *>(c.get());
+                        if (sub != nullptr) {
+                            sub->wake_up_on_interrupt();
+                        }
+                    }
+                }
+                #endif //RT_DEVS
+
+                void clear_changed() {
+                    for (std::size_t i : _changed) {
+                        _is_changed[i] = false;
+                    }
+                    _changed.clear();
+                }
+
+                TIME next_in_fel() const {
+                    return _fel.empty() ? std::numeric_limits<TIME>::infinity() : _fel.min();
+                }
+
+                void find_imminent(const TIME &t) {
+                    _imminent.clear();
+                    #ifdef RT_DEVS
+                    // an interrupt wakes up every subcoordinator to let the asynchronous ones check their events
+                    if (_interrupted) {
+                        for (std::size_t i = 0; i < _subcoordinators.size(); i++) {
+                            _imminent.push_back(i);
+                        }
+                    } else {
+                        _fel.imminent(t, _imminent);
+                    }
+                    #else
+                    _fel.imminent(t, _imminent);
+                    #endif //RT_DEVS
+                    std::sort(_imminent.begin(), _imminent.end());
+                    _imminent_time = t;
+                    _imminent_ready = true;
+                }
+
+                // empties the bags of the EICs keeping their memory, the ports without EICs are removed
+                void clear_inbox() {
+                    for (const auto& r : _eic_routes) {
+                        r.link->clear_from_messages(_inbox);
+                    }
+                    if (_inbox.size() > _inbox_ports.size()) {
+                        for (auto it = _inbox.begin(); it != _inbox.end();) {
+                            if (std::find(_inbox_ports.begin(), _inbox_ports.end(), it->first) == _inbox_ports.end()) {
+                                it = _inbox.erase(it);
+                            } else {
+                                ++it;
+                            }
+                        }
+                    }
+                }
+
+                // empties the bags of the EOCs and releases them to _spare_outbox, so the outbox only
+                // defines the ports with messages
+                void clear_outbox() {
+                    for (const auto& r : _eoc_routes) {
+                        r.link->clear_to_messages(_outbox);
+                    }
+                    cadmium::dynamic::release_message_bags(_outbox, _spare_outbox);
                 }
 
+                // routes the selected ICs and then the EICs, keeping the routing logs in order
+                void route_sequentially(const TIME &t, bool received) {
+                    LOGGER::template log<cadmium::logger::logger_message_routing, cadmium::logger::coor_routing_ic_collect>(t, _model_id);
+                    cadmium::dynamic::engine::route_bound_messages<LOGGER>(_ic_routes, _selected_couplings);
+
+                    LOGGER::template log<cadmium::logger::logger_message_routing, cadmium::logger::coor_routing_eic_collect>(t, _model_id);
+                    if (received) {
+                        cadmium::dynamic::engine::route_bound_messages<LOGGER>(_eic_routes);
+                    }
+                }
+
+                #if defined CADMIUM_EXECUTE_CONCURRENT || defined CPU_PARALLEL || defined CADMIUM_EXECUTE_TEAM
+                // routes the selected ICs and the EICs concurrently, one task by destination subcoordinator
+                void route_by_destination(bool received) {
+                    _routes_by_destination.clear();
+                    for (std::size_t ic : _selected_couplings) {
+                        _routes_by_destination.add(_ic_destination[ic], _ic_routes[ic]);
+                    }
+                    if (received) {
+                        for (std::size_t eic = 0; eic < _eic_routes.size(); eic++) {
+                            _routes_by_destination.add(_eic_destination[eic], _eic_routes[eic]);
+                        }
+                    }
+                    _routes_by_destination.group();
+                    #if defined CADMIUM_EXECUTE_CONCURRENT
+                    cadmium::dynamic::engine::route_messages_by_destination<LOGGER>(_routes_by_destination, _threadpool);
+                    #elif defined CADMIUM_EXECUTE_TEAM
+                    // the owner of the destination routes to it, its inbox is then read in the same thread
+                    _team_selection.reset(team_size());
+                    for (std::size_t g = 0; g < _routes_by_destination.size(); g++) {
+                        _team_selection.add(_owners[_routes_by_destination.destination(g)], g);
+                    }
+                    cadmium::dynamic::engine::route_messages_by_destination<LOGGER>(_routes_by_destination, _team_selection, _team);
+                    #else
+                    cadmium::dynamic::engine::route_messages_by_destination<LOGGER>(_routes_by_destination, _thread_number, _chunk_bounds);
+                    #endif
+                }
                 #endif
+
+                #ifdef CADMIUM_EXECUTE_TEAM
+                std::size_t team_size() const {
+                    return _team == nullptr ? 1 : _team->size();
+                }
+
+                void rebalance() {
+                    std::size_t participants = team_size();
+                    std::vector<double> busy(participants, 0.0);
+                    for (std::size_t i = 0; i < _subcoordinators.size(); i++) {
+                        busy[_owners[i]] += _interval_costs[i];
+                        // the estimation halves the weight of the older intervals
+                        _cost_estimates[i] = (_cost_estimates[i] + _interval_costs[i]) / 2;
+                        _interval_costs[i] = 0;
+                    }
+                    double total = 0;
+                    double busiest = 0;
+                    for (std::size_t p = 0; p < participants; p++) {
+                        _busy_times[p] += busy[p];
+                        total += busy[p];
+                        busiest = std::max(busiest, busy[p]);
+                    }
+                    _steps_since_rebalance = 0;
+                    if (participants > 1 && busiest * participants > total * CADMIUM_TEAM_REBALANCE_THRESHOLD) {
+                        std::vector<std::size_t> owners = cadmium::concurrency::balanced_owners(_cost_estimates, participants);
+                        std::vector<std::size_t> moved;
+                        for (std::size_t i = 0; i < owners.size(); i++) {
+                            if (owners[i] != _owners[i]) {
+                                moved.push_back(i);
+                            }
+                        }
+                        _migrations += moved.size();
+                        _owners = std::move(owners);
+                        #if CADMIUM_TEAM_FIRST_TOUCH
+                        place_models(moved);
+                        #endif //CADMIUM_TEAM_FIRST_TOUCH
+                    }
+                }
+
+                // relocates the given subcoordinators in the thread of their owner, even the small selections
+                void place_models(const std::vector<std::size_t>& indexes) {
+                    select_by_owner(indexes);
+                    auto relocate_owned = [this](std::size_t p) -> void {
+                        for (std::size_t i : _team_selection.of(p)) {
+                            _subcoordinators[i]->relocate();
+                        }
+                    };
+                    if (_team == nullptr) {
+                        relocate_owned(0);
+                    } else {
+                        // the calling thread relocates the models of the last participant on its processor
+                        cadmium::concurrency::worker_team::caller_scope pinned(*_team);
+                        _team->run_phase(relocate_owned);
+                    }
+                }
+
+                // selects the given subcoordinators, split by their owner
+                void select_by_owner(const std::vector<std::size_t>& indexes) {
+                    _team_selection.reset(team_size());
+                    for (std::size_t i : indexes) {
+                        _team_selection.add(_owners[i], i);
+                    }
+                }
+                #endif //CADMIUM_EXECUTE_TEAM
+
+                // collects the outputs of the imminent subcoordinators at t, returns if there were any
+                bool collect_imminent_outputs(const TIME &t) {
+                    LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::coor_info_collect>(t, _model_id);
+
+                    //collecting if necessary
+                    if (_next < t) {
+                        throw std::domain_error("Trying to obtain output when not internal event is scheduled");
+                    }
+                    if (_next == t) {
+                        //log EOC
+                        LOGGER::template log<cadmium::logger::logger_message_routing, cadmium::logger::coor_routing_eoc_collect>(t, _model_id);
+
+                        // Fill the outboxes and clean the inboxes of the imminent subcoordinators recursively
+                        find_imminent(t);
+						#ifdef CADMIUM_EXECUTE_CONCURRENT
+                        cadmium::dynamic::engine::select_subcoordinators<TIME>(_subcoordinators, _imminent, _selected_subcoordinators);
+                        cadmium::dynamic::engine::collect_outputs_in_subcoordinators<TIME>(t, _selected_subcoordinators, _threadpool);
+						#else
+							#if defined CPU_PARALLEL
+                        	cadmium::dynamic::engine::select_subcoordinators<TIME>(_subcoordinators, _imminent, _selected_subcoordinators);
+                        	cadmium::dynamic::engine::collect_outputs_in_subcoordinators<TIME>(t, _selected_subcoordinators, _thread_number);
+							#elif defined CADMIUM_EXECUTE_TEAM
+                        	select_by_owner(_imminent);
+                        	if (_rebalance_interval > 0) {
+                        		cadmium::dynamic::engine::collect_outputs_in_subcoordinators<TIME>(t, _subcoordinators, _team_selection, _team, _interval_costs);
+                        	} else {
+                        		cadmium::dynamic::engine::collect_outputs_in_subcoordinators<TIME>(t, _subcoordinators, _team_selection, _team);
+                        	}
+							#else
+                        	cadmium::dynamic::engine::select_subcoordinators<TIME>(_subcoordinators, _imminent, _selected_subcoordinators);
+                        	cadmium::dynamic::engine::collect_outputs_in_subcoordinators<TIME>(t, _selected_subcoordinators);
+							#endif
+						#endif
+                        return true;
+                    }
+                    _imminent.clear();
+                    _imminent_time = t;
+                    _imminent_ready = true;
+                    return false;
+                }
+
+                // selects the couplings of the imminent subcoordinators keeping the declaration order
+                void select_couplings(const std::vector<std::vector<std::size_t>>& couplings_by_source) {
+                    _selected_couplings.clear();
+                    for (std::size_t i : _imminent) {
+                        _selected_couplings.insert(_selected_couplings.end(), couplings_by_source[i].begin(), couplings_by_source[i].end());
+                    }
+                    std::sort(_selected_couplings.begin(), _selected_couplings.end());
+                }
+
+                void activate(std::size_t i) {
+                    if (!_is_active[i]) {
+                        _is_active[i] = true;
+                        _active.push_back(i);
+                    }
+                }
+
+                void activate_if_received(std::size_t i) {
+                    if (!_is_active[i] && !_subcoordinators[i]->inbox_empty()) {
+                        activate(i);
+                    }
+                }
             };
         }
     }
@@ -27,10 +27,17 @@
 #ifndef CADMIUM_PDEVS_DYNAMIC_ENGINE_HPP
 #define CADMIUM_PDEVS_DYNAMIC_ENGINE_HPP
 
+#include <stdexcept>
+#include <string>
+#include <typeindex>
 #include <cadmium/modeling/dynamic_message_bag.hpp>
 
 #ifdef CADMIUM_EXECUTE_CONCURRENT
-#include <boost/thread/executors/basic_thread_pool.hpp>
+#include <cadmium/engine/work_stealing_executor.hpp>
+#endif
+
+#ifdef CADMIUM_EXECUTE_TEAM
+#include <cadmium/engine/worker_team.hpp>
 #endif
 
 namespace cadmium {
@@ -49,13 +56,17 @@ namespace cadmium {
                 virtual void init(TIME initial_time) = 0;
 
                 #ifdef CADMIUM_EXECUTE_CONCURRENT
-                virtual void init(TIME initial_time, boost::basic_thread_pool* threadpool) = 0;
+                virtual void init(TIME initial_time, cadmium::concurrency::work_stealing_executor* threadpool) = 0;
                 #endif
 
                 #ifdef CPU_PARALLEL
                 virtual void init(TIME initial_time, size_t thread_number) = 0;
                 #endif
 
+                #ifdef CADMIUM_EXECUTE_TEAM
+                virtual void init(TIME initial_time, cadmium::concurrency::worker_team* team) = 0;
+                #endif
+
                 virtual std::string get_model_id() const = 0;
 
                 virtual TIME next() const noexcept = 0;
@@ -66,8 +77,61 @@ namespace cadmium {
 
                 virtual cadmium::dynamic::message_bags& inbox() = 0;
 
+                /**
+                 * @brief Location where the messages received in an input port are stored, by default the inbox.
+                 * @param port is the type index of the input port.
+                 */
+                virtual cadmium::dynamic::port_endpoint input_endpoint(std::type_index port) {
+                    return cadmium::dynamic::port_endpoint{nullptr, &inbox()};
+                }
+
+                /**
+                 * @brief Location where the messages sent through an output port are stored, by default the outbox.
+                 * @param port is the type index of the output port.
+                 */
+                virtual cadmium::dynamic::port_endpoint output_endpoint(std::type_index port) {
+                    return cadmium::dynamic::port_endpoint{nullptr, &outbox()};
+                }
+
+                /**
+                 * @brief checks if there are messages waiting to be processed in the next advance_simulation call.
+                 */
+                virtual bool inbox_empty() {
+                    return inbox().empty();
+                }
+
                 virtual void advance_simulation(const TIME &t) = 0;
 
+                /**
+                 * @brief reallocates the memory of the models run by the engine from the calling thread,
+                 * see cadmium::dynamic::modeling::atomic_abstract::relocate.
+                 */
+                virtual void relocate() {}
+
+                /**
+                 * @brief appends the state of the engine to out, used to checkpoint simulations between steps.
+                 * @param full if false only the subengines advanced since the last checkpoint are encoded.
+                 */
+                virtual void save_checkpoint(std::string& out, bool full) {
+                    throw std::domain_error("The engine of " + get_model_id() + " does not support checkpoints");
+                }
+
+                /**
+                 * @brief restores the state encoded by save_checkpoint with the same full value, moving data after it.
+                 */
+                virtual void load_checkpoint(const char*& data, const char* end, bool full) {
+                    throw std::domain_error("The engine of " + get_model_id() + " does not support checkpoints");
+                }
+
+                /**
+                 * @brief collects the outputs and advances the simulation to t, for engines without a parent
+                 * reading their outbox.
+                 */
+                virtual void step(const TIME &t) {
+                    collect_outputs(t);
+                    advance_simulation(t);
+                }
+
                 virtual ~engine(){}
             };
         }
@@ -27,13 +27,15 @@
 #ifndef CADMIUM_PDEVS_DYNAMIC_ENGINE_HELPERS_HPP
 #define CADMIUM_PDEVS_DYNAMIC_ENGINE_HELPERS_HPP
 
+#include <utility>
+#include <vector>
+
 #include <cadmium/modeling/dynamic_message_bag.hpp>
 #include <cadmium/engine/pdevs_dynamic_engine.hpp>
 #include <cadmium/logger/common_loggers.hpp>
 
 #ifdef CADMIUM_EXECUTE_CONCURRENT
-#include <cadmium/engine/concurrency_helpers.hpp>
-#include <boost/thread/executors/basic_thread_pool.hpp>
+#include <cadmium/engine/work_stealing_executor.hpp>
 #endif //CADMIUM_EXECUTE_CONCURRENT
 
 #ifdef CPU_PARALLEL
@@ -41,6 +43,11 @@
 #include <algorithm>
 #endif //CPU_PARALLEL
 
+#ifdef CADMIUM_EXECUTE_TEAM
+#include <chrono>
+#include <cadmium/engine/worker_team.hpp>
+#endif //CADMIUM_EXECUTE_TEAM
+
 
 namespace cadmium {
     namespace dynamic {
@@ -53,7 +60,7 @@ namespace cadmium {
                     using port_type = typename bag_type::port;
 
                     if (dynamic_bag.find(typeid(port_type)) != dynamic_bag.cend()) {
-                        return boost::any_cast<bag_type>(dynamic_bag.at(typeid(port_type))).messages.empty();
+                        return boost::any_cast<const bag_type&>(dynamic_bag.at(typeid(port_type))).messages.empty();
                     }
                     // A not declared bag in the dynamic_bag is the same as a bag with empty messages
                     return true;
@@ -67,6 +74,20 @@ namespace cadmium {
                 return std::apply(check_empty, box);
             }
 
+            /**
+             * @brief Routes the messages of a link, the routed messages are described only if LOGGER logs message routing.
+             */
+            template<typename LOGGER>
+            void route_link_messages(const cadmium::dynamic::engine::link_abstract& l, const cadmium::dynamic::port_endpoint& from, const cadmium::dynamic::port_endpoint& to) {
+                l.route(from, to);
+
+                if constexpr (cadmium::logger::logs_source_v<LOGGER, cadmium::logger::logger_message_routing>) {
+                    cadmium::dynamic::logger::routed_messages message_to_log = l.describe_route(from, to);
+
+                    LOGGER::template log<cadmium::logger::logger_message_routing, cadmium::logger::coor_routing_collect>(message_to_log.from_port, message_to_log.to_port, message_to_log.from_messages, message_to_log.to_messages);
+                }
+            }
+
             template<typename TIME>
             using subcoordinators_type = typename std::vector<std::shared_ptr<cadmium::dynamic::engine::engine<TIME>>>;
             using external_port_couplings = typename std::map<std::string, std::vector<std::shared_ptr<cadmium::dynamic::engine::link_abstract>>>;
@@ -103,9 +124,14 @@ namespace cadmium {
 
             #ifdef CADMIUM_EXECUTE_CONCURRENT
             template<typename TIME>
-            void init_subcoordinators(TIME t, subcoordinators_type<TIME>& subcoordinators, boost::basic_thread_pool* threadpool) {
+            void init_subcoordinators(TIME t, subcoordinators_type<TIME>& subcoordinators, cadmium::concurrency::work_stealing_executor* threadpool) {
                 auto init_coordinator = [&t, threadpool](auto & c)->void { c->init(t, threadpool); };
-                std::for_each(subcoordinators.begin(), subcoordinators.end(), init_coordinator);
+                if (threadpool == nullptr) {
+                    std::for_each(subcoordinators.begin(), subcoordinators.end(), init_coordinator);
+                } else {
+                    cadmium::concurrency::concurrent_for_each(*threadpool, subcoordinators.begin(),
+                                                              subcoordinators.end(), init_coordinator);
+                }
             }
             #else
                 #ifdef CPU_PARALLEL
@@ -123,9 +149,17 @@ namespace cadmium {
                 #endif //CPU_PARALLEL
             #endif //CADMIUM_EXECUTE_CONCURRENT
 
+            #ifdef CADMIUM_EXECUTE_TEAM
+            template<typename TIME>
+            void init_subcoordinators(TIME t, subcoordinators_type<TIME>& subcoordinators, cadmium::concurrency::worker_team* team) {
+                auto init_coordinator = [&t, team](auto & c)->void { c->init(t, team); };
+                std::for_each(subcoordinators.begin(), subcoordinators.end(), init_coordinator);
+            }
+            #endif //CADMIUM_EXECUTE_TEAM
+
             #ifdef CADMIUM_EXECUTE_CONCURRENT
             template<typename TIME>
-            void advance_simulation_in_subengines(TIME t, subcoordinators_type<TIME>& subcoordinators, boost::basic_thread_pool* threadpool) {
+            void advance_simulation_in_subengines(TIME t, subcoordinators_type<TIME>& subcoordinators, cadmium::concurrency::work_stealing_executor* threadpool) {
                 auto advance_time= [&t](auto &c)->void { c->advance_simulation(t); };
 
                 if (threadpool == nullptr) {
@@ -142,6 +176,25 @@ namespace cadmium {
                     auto advance_time= [&t](auto &c)->void { c->advance_simulation(t); };
                     cadmium::parallel::cpu_parallel_for_each(subcoordinators.begin(), subcoordinators.end(), advance_time, thread_number);
                 }
+
+                /**
+                 * @brief advances the subcoordinators listed in active, balancing the threads by the cost
+                 * measured on previous transitions. costs[i] is updated with the time subcoordinators[i] took.
+                 * @param bounds is reused for the bounds of the chunks of each call.
+                 */
+                template<typename TIME>
+                void advance_simulation_in_subengines(TIME t, subcoordinators_type<TIME>& subcoordinators, const std::vector<std::size_t>& active, std::vector<double>& costs, size_t thread_number, std::vector<std::size_t>& bounds) {
+                    auto advance_time = [&](std::size_t k)->void {
+                        std::size_t i = active[k];
+                        auto start = std::chrono::steady_clock::now();
+                        subcoordinators[i]->advance_simulation(t);
+                        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+                        // moving average, keeps the estimation stable against sporadic slow transitions
+                        costs[i] += (elapsed.count() - costs[i]) / 4;
+                    };
+                    auto cost = [&](std::size_t k)->double { return costs[active[k]]; };
+                    cadmium::parallel::cpu_parallel_for_each_weighted(active.size(), advance_time, cost, thread_number, bounds);
+                }
                 #else
                 template<typename TIME>
                 void advance_simulation_in_subengines(TIME t, subcoordinators_type<TIME>& subcoordinators) {
@@ -151,10 +204,36 @@ namespace cadmium {
                 #endif //CPU_PARALLEL
             #endif //CADMIUM_EXECUTE_CONCURRENT
 
+            #ifdef CADMIUM_EXECUTE_TEAM
+            /**
+             * @brief advances the selected subcoordinators, each one in the team participant owning it.
+             */
+            template<typename TIME>
+            void advance_simulation_in_subengines(TIME t, subcoordinators_type<TIME>& subcoordinators, const cadmium::concurrency::team_selection& selected, cadmium::concurrency::worker_team* team) {
+                auto advance_time = [&t, &subcoordinators](std::size_t i)->void { subcoordinators[i]->advance_simulation(t); };
+                cadmium::concurrency::for_each_selected(team, selected, advance_time);
+            }
+
+            /**
+             * @brief advances the selected subcoordinators like the overload above, adding to costs[i]
+             * the time subcoordinators[i] took, in microseconds.
+             */
+            template<typename TIME>
+            void advance_simulation_in_subengines(TIME t, subcoordinators_type<TIME>& subcoordinators, const cadmium::concurrency::team_selection& selected, cadmium::concurrency::worker_team* team, std::vector<double>& costs) {
+                auto advance_time = [&t, &subcoordinators, &costs](std::size_t i)->void {
+                    auto start = std::chrono::steady_clock::now();
+                    subcoordinators[i]->advance_simulation(t);
+                    // only the owner of i writes costs[i]
+                    costs[i] += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+                };
+                cadmium::concurrency::for_each_selected(team, selected, advance_time);
+            }
+            #endif //CADMIUM_EXECUTE_TEAM
+
 
             #ifdef CADMIUM_EXECUTE_CONCURRENT
             template<typename TIME>
-            void collect_outputs_in_subcoordinators(TIME t, subcoordinators_type<TIME>& subcoordinators, boost::basic_thread_pool* threadpool) {
+            void collect_outputs_in_subcoordinators(TIME t, subcoordinators_type<TIME>& subcoordinators, cadmium::concurrency::work_stealing_executor* threadpool) {
                 auto collect_output = [&t](auto & c)->void { c->collect_outputs(t); };
                 if (threadpool == nullptr) {
                     std::for_each(subcoordinators.begin(), subcoordinators.end(), collect_output);
@@ -179,15 +258,38 @@ namespace cadmium {
                 #endif //CPU_PARALLEL
             #endif //CADMIUM_EXECUTE_CONCURRENT
 
+            #ifdef CADMIUM_EXECUTE_TEAM
+            /**
+             * @brief collects the outputs of the selected subcoordinators, each one in the team participant owning it.
+             */
+            template<typename TIME>
+            void collect_outputs_in_subcoordinators(TIME t, subcoordinators_type<TIME>& subcoordinators, const cadmium::concurrency::team_selection& selected, cadmium::concurrency::worker_team* team) {
+                auto collect_output = [&t, &subcoordinators](std::size_t i)->void { subcoordinators[i]->collect_outputs(t); };
+                cadmium::concurrency::for_each_selected(team, selected, collect_output);
+            }
+
+            /**
+             * @brief collects the outputs of the selected subcoordinators like the overload above, adding
+             * to costs[i] the time subcoordinators[i] took, in microseconds.
+             */
+            template<typename TIME>
+            void collect_outputs_in_subcoordinators(TIME t, subcoordinators_type<TIME>& subcoordinators, const cadmium::concurrency::team_selection& selected, cadmium::concurrency::worker_team* team, std::vector<double>& costs) {
+                auto collect_output = [&t, &subcoordinators, &costs](std::size_t i)->void {
+                    auto start = std::chrono::steady_clock::now();
+                    subcoordinators[i]->collect_outputs(t);
+                    costs[i] += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+                };
+                cadmium::concurrency::for_each_selected(team, selected, collect_output);
+            }
+            #endif //CADMIUM_EXECUTE_TEAM
+
             template<typename TIME, typename LOGGER>
             cadmium::dynamic::message_bags collect_messages_by_eoc(const external_couplings<TIME>& coupling) {
                 cadmium::dynamic::message_bags ret;
                 auto collect_output = [&ret](auto & c)->void {
                     cadmium::dynamic::message_bags outbox = c.first->outbox();
                     for (const auto& l : c.second) {
-                        cadmium::dynamic::logger::routed_messages message_to_log = l->route_messages(outbox, ret);
-
-                        LOGGER::template log<cadmium::logger::logger_message_routing, cadmium::logger::coor_routing_collect>(message_to_log.from_port, message_to_log.to_port, message_to_log.from_messages, message_to_log.to_messages);
+                        route_link_messages<LOGGER>(*l, cadmium::dynamic::port_endpoint{nullptr, &outbox}, cadmium::dynamic::port_endpoint{nullptr, &ret});
                     }
                 };
 
@@ -195,14 +297,29 @@ namespace cadmium {
                 return ret;
             }
 
+            /**
+             * @brief Collects the outputs following only the selected EOCs, in the order of the selection
+             * @param coupling are all the EOCs of the coordinator
+             * @param selected are the indexes in coupling of the EOCs to follow
+             */
+            template<typename TIME, typename LOGGER>
+            cadmium::dynamic::message_bags collect_messages_by_eoc(const external_couplings<TIME>& coupling, const std::vector<std::size_t>& selected) {
+                cadmium::dynamic::message_bags ret;
+                for (std::size_t i : selected) {
+                    auto& outbox = coupling[i].first->outbox();
+                    for (const auto& l : coupling[i].second) {
+                        route_link_messages<LOGGER>(*l, cadmium::dynamic::port_endpoint{nullptr, &outbox}, cadmium::dynamic::port_endpoint{nullptr, &ret});
+                    }
+                }
+                return ret;
+            }
+
             template<typename TIME, typename LOGGER>
             void route_external_input_coupled_messages_on_subcoordinators(cadmium::dynamic::message_bags inbox, const external_couplings<TIME>& coupling) {
                 auto route_messages = [&inbox](auto & c)->void {
                     for (const auto& l : c.second) {
                         auto& to_inbox = c.first->inbox();
-                        cadmium::dynamic::logger::routed_messages message_to_log = l->route_messages(inbox, to_inbox);
-
-                        LOGGER::template log<cadmium::logger::logger_message_routing, cadmium::logger::coor_routing_collect>(message_to_log.from_port, message_to_log.to_port, message_to_log.from_messages, message_to_log.to_messages);
+                        route_link_messages<LOGGER>(*l, cadmium::dynamic::port_endpoint{nullptr, &inbox}, cadmium::dynamic::port_endpoint{nullptr, &to_inbox});
                     }
                 };
 
@@ -215,15 +332,191 @@ namespace cadmium {
                     for (const auto& l : c.second) {
                         auto& from_outbox = c.first.first->outbox();
                         auto& to_inbox = c.first.second->inbox();
-                        cadmium::dynamic::logger::routed_messages message_to_log = l->route_messages(from_outbox, to_inbox);
-
-                        LOGGER::template log<cadmium::logger::logger_message_routing, cadmium::logger::coor_routing_collect>(message_to_log.from_port, message_to_log.to_port, message_to_log.from_messages, message_to_log.to_messages);
+                        route_link_messages<LOGGER>(*l, cadmium::dynamic::port_endpoint{nullptr, &from_outbox}, cadmium::dynamic::port_endpoint{nullptr, &to_inbox});
                     }
                 };
 
                 std::for_each(coupling.begin(), coupling.end(), route_messages);
             }
 
+            /**
+             * @brief Routes the messages following only the selected ICs, in the order of the selection
+             * @param coupling are all the ICs of the coordinator
+             * @param selected are the indexes in coupling of the ICs to follow
+             */
+            template<typename TIME, typename LOGGER>
+            void route_internal_coupled_messages_on_subcoordinators(const internal_couplings<TIME>& coupling, const std::vector<std::size_t>& selected) {
+                for (std::size_t i : selected) {
+                    auto& from_outbox = coupling[i].first.first->outbox();
+                    auto& to_inbox = coupling[i].first.second->inbox();
+                    for (const auto& l : coupling[i].second) {
+                        route_link_messages<LOGGER>(*l, cadmium::dynamic::port_endpoint{nullptr, &from_outbox}, cadmium::dynamic::port_endpoint{nullptr, &to_inbox});
+                    }
+                }
+            }
+
+            /**
+             * @brief A link bound to the locations of its from and to port messages, resolved once when the
+             * coordinator is constructed.
+             */
+            struct bound_route {
+                cadmium::dynamic::port_endpoint from;
+                cadmium::dynamic::port_endpoint to;
+                std::shared_ptr<cadmium::dynamic::engine::link_abstract> link;
+            };
+
+            using bound_routes = typename std::vector<bound_route>;
+
+            /**
+             * @brief Routes the messages following all the routes, in their order
+             */
+            template<typename LOGGER>
+            void route_bound_messages(const bound_routes& routes) {
+                for (const auto& r : routes) {
+                    route_link_messages<LOGGER>(*r.link, r.from, r.to);
+                }
+            }
+
+            /**
+             * @brief Routes the messages following only the selected routes, in the order of the selection
+             * @param routes are all the routes of a coupling kind of the coordinator
+             * @param selected are the indexes in routes of the routes to follow
+             */
+            template<typename LOGGER>
+            void route_bound_messages(const bound_routes& routes, const std::vector<std::size_t>& selected) {
+                for (std::size_t i : selected) {
+                    route_link_messages<LOGGER>(*routes[i].link, routes[i].from, routes[i].to);
+                }
+            }
+
+            /**
+             * @brief Routes of a step grouped by the index of their destination subcoordinator.
+             *
+             * @details
+             * Each group is the only writer of its destination, so groups can be routed concurrently.
+             * Inside a group the routes keep the order they were added in, and so the messages reach each
+             * destination in the same order a sequential routing would leave them.
+             */
+            class routes_by_destination {
+                std::vector<std::size_t> _count; // routes added by destination
+                std::vector<std::size_t> _destinations; // destinations with routes, in the order first added
+                std::vector<std::pair<std::size_t, const bound_route*>> _added;
+                std::vector<const bound_route*> _routes; // group g is [_bounds[g], _bounds[g+1])
+                std::vector<std::size_t> _bounds;
+
+            public:
+                /**
+                 * @param destinations is the amount of subcoordinators routes can be added to.
+                 */
+                void resize(std::size_t destinations) {
+                    _count.assign(destinations, 0);
+                }
+
+                void clear() {
+                    for (std::size_t d : _destinations) {
+                        _count[d] = 0;
+                    }
+                    _destinations.clear();
+                    _added.clear();
+                }
+
+                void add(std::size_t destination, const bound_route& r) {
+                    if (_count[destination]++ == 0) {
+                        _destinations.push_back(destination);
+                    }
+                    _added.emplace_back(destination, &r);
+                }
+
+                /**
+                 * @brief Groups the routes added since the last clear, it must be called before routing them.
+                 */
+                void group() {
+                    _bounds.resize(_destinations.size() + 1);
+                    _bounds[0] = 0;
+                    for (std::size_t g = 0; g < _destinations.size(); g++) {
+                        _bounds[g + 1] = _bounds[g] + _count[_destinations[g]];
+                        // from now on _count holds the next position to fill in the destination group
+                        _count[_destinations[g]] = _bounds[g];
+                    }
+                    _routes.resize(_added.size());
+                    for (const auto& a : _added) {
+                        _routes[_count[a.first]++] = a.second;
+                    }
+                }
+
+                std::size_t size() const noexcept {
+                    return _destinations.size();
+                }
+
+                std::size_t destination(std::size_t g) const noexcept {
+                    return _destinations[g];
+                }
+
+                std::size_t routes_in_group(std::size_t g) const noexcept {
+                    return _bounds[g + 1] - _bounds[g];
+                }
+
+                template<typename LOGGER>
+                void route_group(std::size_t g) const {
+                    for (std::size_t i = _bounds[g]; i < _bounds[g + 1]; i++) {
+                        route_link_messages<LOGGER>(*_routes[i]->link, _routes[i]->from, _routes[i]->to);
+                    }
+                }
+            };
+
+            #ifdef CADMIUM_EXECUTE_CONCURRENT
+            /**
+             * @brief Routes the grouped routes, running the groups in the threadpool.
+             */
+            template<typename LOGGER>
+            void route_messages_by_destination(const routes_by_destination& routes, cadmium::concurrency::work_stealing_executor* threadpool) {
+                auto route_group = [&routes](std::size_t g)->void { routes.template route_group<LOGGER>(g); };
+                if (threadpool == nullptr) {
+                    for (std::size_t g = 0; g < routes.size(); g++) {
+                        route_group(g);
+                    }
+                } else {
+                    threadpool->parallel_for(routes.size(), route_group);
+                }
+            }
+            #else
+                #ifdef CPU_PARALLEL
+                /**
+                 * @brief Routes the grouped routes, balancing the threads by the amount of routes in each group.
+                 * @param bounds is reused for the bounds of the chunks of each call.
+                 */
+                template<typename LOGGER>
+                void route_messages_by_destination(const routes_by_destination& routes, size_t thread_number, std::vector<std::size_t>& bounds) {
+                    auto route_group = [&routes](std::size_t g)->void { routes.template route_group<LOGGER>(g); };
+                    auto cost = [&routes](std::size_t g)->double { return routes.routes_in_group(g); };
+                    cadmium::parallel::cpu_parallel_for_each_weighted(routes.size(), route_group, cost, thread_number, bounds);
+                }
+                #endif //CPU_PARALLEL
+            #endif //CADMIUM_EXECUTE_CONCURRENT
+
+            #ifdef CADMIUM_EXECUTE_TEAM
+            /**
+             * @brief Routes the grouped routes, each group in the team participant owning its destination.
+             * @param groups are the indexes of the groups, selected by the owner of their destination.
+             */
+            template<typename LOGGER>
+            void route_messages_by_destination(const routes_by_destination& routes, const cadmium::concurrency::team_selection& groups, cadmium::concurrency::worker_team* team) {
+                auto route_group = [&routes](std::size_t g)->void { routes.template route_group<LOGGER>(g); };
+                cadmium::concurrency::for_each_selected(team, groups, route_group);
+            }
+            #endif //CADMIUM_EXECUTE_TEAM
+
+            /**
+             * @brief Fills selected with the subcoordinators in the given indexes, keeping their order
+             */
+            template<typename TIME>
+            void select_subcoordinators(const subcoordinators_type<TIME>& subcoordinators, const std::vector<std::size_t>& indexes, subcoordinators_type<TIME>& selected) {
+                selected.clear();
+                for (std::size_t i : indexes) {
+                    selected.push_back(subcoordinators[i]);
+                }
+            }
+
             template<typename TIME>
             TIME min_next_in_subcoordinators(const subcoordinators_type<TIME>& subcoordinators) {
                 std::vector<TIME> next_times(subcoordinators.size());
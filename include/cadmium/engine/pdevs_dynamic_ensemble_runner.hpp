@@ -0,0 +1,205 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef CADMIUM_PDEVS_DYNAMIC_ENSEMBLE_RUNNER_HPP
+#define CADMIUM_PDEVS_DYNAMIC_ENSEMBLE_RUNNER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <cadmium/modeling/dynamic_coupled.hpp>
+#include <cadmium/modeling/dynamic_flattened_coupled.hpp>
+#include <cadmium/engine/pdevs_dynamic_runner.hpp>
+
+namespace cadmium {
+    namespace dynamic {
+        namespace engine {
+
+            /**
+             * @brief Sink provider writing the logs of each replication of an ensemble_runner to the stream
+             * set for it with ensemble_runner::set_sinks, std::cout by default.
+             */
+            struct replication_sink_provider {
+                static std::ostream& sink() {
+                    return *current();
+                }
+
+                // stream of the replication run by the calling thread
+                static std::ostream*& current() {
+                    thread_local std::ostream* stream = &std::cout;
+                    return stream;
+                }
+            };
+
+            /**
+             * @brief Runner simulating replications of the same model in parallel, for stochastic studies.
+             *
+             * @details
+             * The model is built and flattened once. Each replication copies its atomic models, see
+             * cadmium::dynamic::modeling::atomic_abstract::clone, and shares the flattened couplings and
+             * their links, so the coupling tables and anything the models were built from, as the
+             * scenario of a Cell-DEVS model, are not built again. Replications are simulated from start
+             * to end by a single thread, with a sequential coordinator, and several threads take the
+             * next replication until all are done.
+             *
+             * @param TIME Representation of time to be used to run the simulation
+             * @param LOGGER what, where and how to log from the simulation, replication_sink_provider
+             * sends the logs of each replication to its own sink
+             * @param FEL future event list policy used by the coordinators, see pdevs_dynamic_fel.hpp
+             */
+            template<class TIME, typename LOGGER=default_logger<TIME>, template<typename> class FEL=binary_heap_fel>
+            class ensemble_runner {
+                cadmium::dynamic::modeling::flattened_coupled<TIME> _structure;
+                TIME _init_time;
+                std::vector<std::ostream*> _sinks;
+
+            public:
+                /**
+                 * @param coupled_model is the model of every replication, its atomic models are only copied.
+                 * @param init_time is the initial time of every replication.
+                 */
+                ensemble_runner(std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> coupled_model, const TIME& init_time)
+                : _structure(cadmium::dynamic::modeling::flatten<TIME>(coupled_model)), _init_time(init_time) {
+                    for (const auto& m : _structure.atomics) {
+                        if (std::dynamic_pointer_cast<cadmium::dynamic::modeling::atomic_abstract<TIME>>(m) == nullptr) {
+                            throw std::domain_error("Only atomic models are supported in an ensemble");
+                        }
+                    }
+                }
+
+                /**
+                 * @brief Sets the stream where the logs of each replication go, by index of replication.
+                 * Only used by loggers with replication_sink_provider, the replications without a stream
+                 * log to std::cout.
+                 */
+                void set_sinks(std::vector<std::ostream*> sinks) {
+                    _sinks = std::move(sinks);
+                }
+
+                /**
+                 * @brief Simulates the replications until t, at most threads at once.
+                 *
+                 * setup(r, models) is called with the index of the replication and its atomic models, in the
+                 * order of the flattened model, before initializing them, to seed them or change their
+                 * parameters. collect(r, models) is called after simulating them, and the std::string it
+                 * returns, if it is not void, is the result of the replication. Both are called from the
+                 * thread simulating the replication.
+                 *
+                 * @return the result of each replication. If one throws, the others are still simulated
+                 * and its exception is thrown at the end.
+                 */
+                template<typename SETUP, typename COLLECT>
+                std::vector<std::string> run_until(std::size_t replications, const TIME& t, SETUP&& setup, COLLECT&& collect, unsigned threads = std::thread::hardware_concurrency()) {
+                    using models_type = std::vector<std::shared_ptr<cadmium::dynamic::modeling::atomic_abstract<TIME>>>;
+                    using result_type = std::invoke_result_t<COLLECT&, std::size_t, models_type&>;
+                    static_assert(std::is_void_v<result_type> || std::is_convertible_v<result_type, std::string>, "Replications must return void or a std::string");
+
+                    std::vector<std::string> results(replications);
+                    std::atomic<std::size_t> next_replication{0};
+                    std::mutex error_mutex;
+                    std::exception_ptr error;
+
+                    auto simulate = [&]() {
+                        for (std::size_t r = next_replication++; r < replications; r = next_replication++) {
+                            try {
+                                replication_sink_provider::current() = r < _sinks.size() && _sinks[r] != nullptr ? _sinks[r] : &std::cout;
+                                models_type models;
+                                cadmium::dynamic::modeling::Models atomics;
+                                for (const auto& m : _structure.atomics) {
+                                    models.push_back(std::static_pointer_cast<cadmium::dynamic::modeling::atomic_abstract<TIME>>(m)->clone());
+                                    atomics.push_back(models.back());
+                                }
+                                setup(r, models);
+                                coordinator<TIME, LOGGER, FEL> top(_structure, atomics);
+                                simulate_replication(top, t);
+                                if constexpr (std::is_void_v<result_type>) {
+                                    collect(r, models);
+                                } else {
+                                    results[r] = collect(r, models);
+                                }
+                            } catch (...) {
+                                std::lock_guard<std::mutex> lock(error_mutex);
+                                if (!error) {
+                                    error = std::current_exception();
+                                }
+                            }
+                            replication_sink_provider::current() = &std::cout;
+                        }
+                    };
+
+                    std::size_t workers = std::min<std::size_t>(std::max(threads, 1u), std::max<std::size_t>(replications, 1));
+                    std::vector<std::thread> helpers;
+                    for (std::size_t w = 1; w < workers; w++) {
+                        helpers.emplace_back(simulate);
+                    }
+                    simulate();
+                    for (auto& h : helpers) {
+                        h.join();
+                    }
+                    if (error) {
+                        std::rethrow_exception(error);
+                    }
+                    return results;
+                }
+
+            private:
+                // each replication runs in a single thread, the coordinators of every mode run sequentially without workers
+                void simulate_replication(coordinator<TIME, LOGGER, FEL>& top, const TIME& t) {
+                    LOGGER::template log<cadmium::logger::logger_global_time, cadmium::logger::run_global_time>(_init_time);
+                    LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::run_info>("Preparing model");
+                    #if defined CADMIUM_EXECUTE_CONCURRENT
+                    top.init(_init_time, static_cast<cadmium::concurrency::work_stealing_executor*>(nullptr));
+                    #elif defined CPU_PARALLEL
+                    top.init(_init_time, static_cast<size_t>(1));
+                    #elif defined CADMIUM_EXECUTE_TEAM
+                    top.init(_init_time, static_cast<cadmium::concurrency::worker_team*>(nullptr));
+                    #else
+                    top.init(_init_time);
+                    #endif
+                    LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::run_info>("Starting run");
+                    TIME next = top.next();
+                    while (next < t) {
+                        LOGGER::template log<cadmium::logger::logger_global_time, cadmium::logger::run_global_time>(next);
+                        top.step(next);
+                        next = top.next();
+                    }
+                    LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::run_info>("Finished run");
+                }
+            };
+        }
+    }
+}
+
+#endif //CADMIUM_PDEVS_DYNAMIC_ENSEMBLE_RUNNER_HPP
@@ -0,0 +1,416 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CADMIUM_PDEVS_DYNAMIC_FEL_HPP
+#define CADMIUM_PDEVS_DYNAMIC_FEL_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Future event list (FEL) policies used by the dynamic coordinator to keep track of the next
+ * scheduled time of each one of its subengines.
+ *
+ * All policies index the subengines by their position in the coordinator and share the same API:
+ * - assign(next_times): rebuilds the list with one entry per subengine.
+ * - update(i, t): reschedules the subengine i to time t.
+ * - min(): returns the lowest scheduled time (the list must not be empty).
+ * - imminent(t, out): appends to out the index of every subengine scheduled at t, in no particular order.
+ * - size() and empty().
+ */
+namespace cadmium {
+    namespace dynamic {
+        namespace engine {
+
+            /**
+             * @brief Baseline FEL, it stores the next times in a vector and scans all of them to find the
+             * minimum and the imminent subengines. It is the behavior the coordinator had before FEL policies.
+             */
+            template<typename TIME>
+            class linear_scan_fel {
+                std::vector<TIME> _times;
+
+            public:
+                void assign(const std::vector<TIME>& next_times) {
+                    _times = next_times;
+                }
+
+                void update(std::size_t i, const TIME& t) {
+                    _times[i] = t;
+                }
+
+                TIME min() const {
+                    return *std::min_element(_times.cbegin(), _times.cend());
+                }
+
+                void imminent(const TIME& t, std::vector<std::size_t>& out) const {
+                    for (std::size_t i = 0; i < _times.size(); i++) {
+                        if (_times[i] == t) {
+                            out.push_back(i);
+                        }
+                    }
+                }
+
+                std::size_t size() const noexcept {
+                    return _times.size();
+                }
+
+                bool empty() const noexcept {
+                    return _times.empty();
+                }
+            };
+
+            /**
+             * @brief Indexed binary min-heap with decrease-key (and increase-key), each update costs O(log n)
+             * and obtaining the minimum costs O(1).
+             */
+            template<typename TIME>
+            class binary_heap_fel {
+                std::vector<TIME> _times; // next time by subengine index
+                std::vector<std::size_t> _heap; // subengine indexes ordered as a heap
+                std::vector<std::size_t> _position; // position in _heap by subengine index
+                mutable std::vector<std::size_t> _pending; // scratch space used by imminent
+
+                bool lower(std::size_t a, std::size_t b) const {
+                    return _times[_heap[a]] < _times[_heap[b]];
+                }
+
+                void swap_nodes(std::size_t a, std::size_t b) {
+                    std::swap(_heap[a], _heap[b]);
+                    _position[_heap[a]] = a;
+                    _position[_heap[b]] = b;
+                }
+
+                void sift_up(std::size_t p) {
+                    while (p > 0) {
+                        std::size_t parent = (p - 1) / 2;
+                        if (!lower(p, parent)) {
+                            break;
+                        }
+                        swap_nodes(p, parent);
+                        p = parent;
+                    }
+                }
+
+                void sift_down(std::size_t p) {
+                    const std::size_t n = _heap.size();
+                    while (true) {
+                        std::size_t smallest = p;
+                        std::size_t left = 2 * p + 1;
+                        std::size_t right = left + 1;
+                        if (left < n && lower(left, smallest)) {
+                            smallest = left;
+                        }
+                        if (right < n && lower(right, smallest)) {
+                            smallest = right;
+                        }
+                        if (smallest == p) {
+                            break;
+                        }
+                        swap_nodes(p, smallest);
+                        p = smallest;
+                    }
+                }
+
+            public:
+                void assign(const std::vector<TIME>& next_times) {
+                    _times = next_times;
+                    _heap.resize(_times.size());
+                    _position.resize(_times.size());
+                    for (std::size_t i = 0; i < _times.size(); i++) {
+                        _heap[i] = i;
+                        _position[i] = i;
+                    }
+                    for (std::size_t p = _heap.size() / 2; p > 0; p--) {
+                        sift_down(p - 1);
+                    }
+                }
+
+                void update(std::size_t i, const TIME& t) {
+                    TIME old = _times[i];
+                    _times[i] = t;
+                    if (t < old) {
+                        sift_up(_position[i]);
+                    } else if (old < t) {
+                        sift_down(_position[i]);
+                    }
+                }
+
+                TIME min() const {
+                    return _times[_heap.front()];
+                }
+
+                void imminent(const TIME& t, std::vector<std::size_t>& out) const {
+                    if (_heap.empty() || _times[_heap.front()] != t) {
+                        return;
+                    }
+                    // entries at t form a subtree hanging from the root, only that subtree is visited
+                    _pending.clear();
+                    _pending.push_back(0);
+                    while (!_pending.empty()) {
+                        std::size_t p = _pending.back();
+                        _pending.pop_back();
+                        out.push_back(_heap[p]);
+                        for (std::size_t child = 2 * p + 1; child <= 2 * p + 2 && child < _heap.size(); child++) {
+                            if (_times[_heap[child]] == t) {
+                                _pending.push_back(child);
+                            }
+                        }
+                    }
+                }
+
+                std::size_t size() const noexcept {
+                    return _times.size();
+                }
+
+                bool empty() const noexcept {
+                    return _times.empty();
+                }
+            };
+
+            /**
+             * @brief Calendar queue (R. Brown, 1988) for arithmetic TIME types.
+             *
+             * Finite times are hashed into buckets of a fixed width that are resized when the number
+             * of scheduled entries grows or shrinks, infinite times (passive subengines) are kept out of
+             * the buckets. Updates cost O(1) and the minimum is cached, it is only searched again, starting
+             * from the previous minimum, when the entry holding it is rescheduled to a later time.
+             */
+            template<typename TIME>
+            class calendar_queue_fel {
+                static_assert(std::is_arithmetic<TIME>::value, "The calendar queue FEL requires an arithmetic TIME");
+
+                using key_type = std::uint64_t;
+                static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+                static constexpr std::size_t min_buckets = 2;
+
+                std::vector<TIME> _times; // next time by subengine index
+                std::vector<key_type> _keys; // absolute bucket number (time / width) by subengine index
+                std::vector<std::size_t> _bucket; // bucket by subengine index, npos for passive subengines
+                std::vector<std::size_t> _slot; // position in the bucket by subengine index
+                std::vector<std::vector<std::size_t>> _buckets;
+                double _width = 1.0;
+                std::size_t _scheduled = 0; // subengines with a finite next time
+
+                mutable TIME _min = TIME{};
+                mutable bool _min_valid = false; // when false, _min is only a lower bound of the minimum
+
+                static bool is_passive(const TIME& t) {
+                    if constexpr (std::numeric_limits<TIME>::has_infinity) {
+                        return t == std::numeric_limits<TIME>::infinity();
+                    } else {
+                        return t == std::numeric_limits<TIME>::max();
+                    }
+                }
+
+                static TIME passive_time() {
+                    if constexpr (std::numeric_limits<TIME>::has_infinity) {
+                        return std::numeric_limits<TIME>::infinity();
+                    } else {
+                        return std::numeric_limits<TIME>::max();
+                    }
+                }
+
+                key_type key_of(const TIME& t) const {
+                    // times too far in the future share the last key, they are still found by the fallback scan
+                    constexpr double max_key = 9007199254740992.0; // 2^53
+                    double k = std::floor(static_cast<double>(t) / _width);
+                    if (k < 0) {
+                        return 0;
+                    }
+                    return static_cast<key_type>(std::min(k, max_key));
+                }
+
+                void insert(std::size_t i) {
+                    if (is_passive(_times[i])) {
+                        _bucket[i] = npos;
+                        return;
+                    }
+                    _keys[i] = key_of(_times[i]);
+                    std::size_t b = _keys[i] & (_buckets.size() - 1);
+                    _bucket[i] = b;
+                    _slot[i] = _buckets[b].size();
+                    _buckets[b].push_back(i);
+                    _scheduled++;
+                }
+
+                void remove(std::size_t i) {
+                    std::size_t b = _bucket[i];
+                    if (b == npos) {
+                        return;
+                    }
+                    auto& bucket = _buckets[b];
+                    std::size_t moved = bucket.back();
+                    bucket[_slot[i]] = moved;
+                    _slot[moved] = _slot[i];
+                    bucket.pop_back();
+                    _bucket[i] = npos;
+                    _scheduled--;
+                }
+
+                double estimate_width() const {
+                    // average gap between a sample of the scheduled times, as suggested by Brown
+                    std::vector<TIME> sample;
+                    for (std::size_t i = 0; i < _times.size() && sample.size() < 32; i++) {
+                        if (!is_passive(_times[i])) {
+                            sample.push_back(_times[i]);
+                        }
+                    }
+                    std::sort(sample.begin(), sample.end());
+                    double gaps = 0;
+                    std::size_t count = 0;
+                    for (std::size_t i = 1; i < sample.size(); i++) {
+                        double gap = static_cast<double>(sample[i]) - static_cast<double>(sample[i - 1]);
+                        if (gap > 0) {
+                            gaps += gap;
+                            count++;
+                        }
+                    }
+                    return count == 0 ? _width : 3.0 * gaps / count;
+                }
+
+                void rebuild(std::size_t buckets) {
+                    _width = estimate_width();
+                    _buckets.assign(buckets, std::vector<std::size_t>());
+                    _scheduled = 0;
+                    for (std::size_t i = 0; i < _times.size(); i++) {
+                        insert(i);
+                    }
+                }
+
+                void resize_if_needed() {
+                    if (_scheduled > 2 * _buckets.size()) {
+                        rebuild(2 * _buckets.size());
+                    } else if (_buckets.size() > min_buckets && _scheduled < _buckets.size() / 4) {
+                        rebuild(_buckets.size() / 2);
+                    }
+                }
+
+                void find_min() const {
+                    if (_scheduled == 0) {
+                        _min = passive_time();
+                        _min_valid = true;
+                        return;
+                    }
+                    // every scheduled time is at least _min, so the days of the calendar are visited in order from it
+                    key_type first = key_of(_min);
+                    for (std::size_t d = 0; d < _buckets.size(); d++) {
+                        key_type day = first + d;
+                        bool found = false;
+                        TIME best = TIME{};
+                        for (std::size_t i : _buckets[day & (_buckets.size() - 1)]) {
+                            if (_keys[i] == day && (!found || _times[i] < best)) {
+                                best = _times[i];
+                                found = true;
+                            }
+                        }
+                        if (found) {
+                            _min = best;
+                            _min_valid = true;
+                            return;
+                        }
+                    }
+                    // a whole year without events, the next event is far away: direct search
+                    bool found = false;
+                    for (const auto& bucket : _buckets) {
+                        for (std::size_t i : bucket) {
+                            if (!found || _times[i] < _min) {
+                                _min = _times[i];
+                                found = true;
+                            }
+                        }
+                    }
+                    _min_valid = true;
+                }
+
+            public:
+                void assign(const std::vector<TIME>& next_times) {
+                    _times = next_times;
+                    _keys.assign(_times.size(), 0);
+                    _bucket.assign(_times.size(), npos);
+                    _slot.assign(_times.size(), 0);
+                    std::size_t buckets = min_buckets;
+                    while (buckets < _times.size()) {
+                        buckets *= 2;
+                    }
+                    rebuild(buckets);
+                    _min_valid = !_times.empty();
+                    _min = _times.empty() ? TIME{} : *std::min_element(_times.cbegin(), _times.cend());
+                }
+
+                void update(std::size_t i, const TIME& t) {
+                    TIME old = _times[i];
+                    remove(i);
+                    _times[i] = t;
+                    insert(i);
+                    if (t < _min) {
+                        _min = t; // still a lower bound, and the actual minimum if it was valid
+                    } else if (_min_valid && old == _min && _min < t) {
+                        _min_valid = false;
+                    }
+                    resize_if_needed();
+                }
+
+                TIME min() const {
+                    if (!_min_valid) {
+                        find_min();
+                    }
+                    return _min;
+                }
+
+                void imminent(const TIME& t, std::vector<std::size_t>& out) const {
+                    if (is_passive(t)) {
+                        for (std::size_t i = 0; i < _times.size(); i++) {
+                            if (_bucket[i] == npos) {
+                                out.push_back(i);
+                            }
+                        }
+                        return;
+                    }
+                    key_type day = key_of(t);
+                    for (std::size_t i : _buckets[day & (_buckets.size() - 1)]) {
+                        if (_times[i] == t) {
+                            out.push_back(i);
+                        }
+                    }
+                }
+
+                std::size_t size() const noexcept {
+                    return _times.size();
+                }
+
+                bool empty() const noexcept {
+                    return _times.empty();
+                }
+            };
+        }
+    }
+}
+
+#endif //CADMIUM_PDEVS_DYNAMIC_FEL_HPP
@@ -0,0 +1,652 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef CADMIUM_PDEVS_DYNAMIC_GRAPH_PARTITIONER_HPP
+#define CADMIUM_PDEVS_DYNAMIC_GRAPH_PARTITIONER_HPP
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cadmium/modeling/dynamic_coupled.hpp>
+#include <cadmium/modeling/dynamic_flattened_coupled.hpp>
+#include <cadmium/logger/common_loggers.hpp>
+#include <cadmium/engine/pdevs_dynamic_conservative_runner.hpp>
+
+/* coarsening stops when the graph has less than this amount of vertices by part */
+#ifndef CADMIUM_PARTITIONER_COARSEST_VERTICES_BY_PART
+#define CADMIUM_PARTITIONER_COARSEST_VERTICES_BY_PART 20
+#endif
+
+/* maximum amount of refinement passes over the vertices at each level */
+#ifndef CADMIUM_PARTITIONER_REFINEMENT_PASSES
+#define CADMIUM_PARTITIONER_REFINEMENT_PASSES 8
+#endif
+
+namespace cadmium {
+    namespace dynamic {
+        namespace engine {
+
+            /**
+             * @brief Undirected graph with weighted vertices and edges, where vertices are models weighted
+             * by their transition cost and edges are their couplings weighted by their message traffic.
+             */
+            class coupling_graph {
+                std::vector<double> _weights;
+                std::vector<std::vector<std::pair<std::size_t, double>>> _adjacency;
+
+            public:
+                coupling_graph() = default;
+
+                explicit coupling_graph(std::size_t vertices, double weight = 1.0)
+                        : _weights(vertices, weight), _adjacency(vertices) {}
+
+                std::size_t add_vertex(double weight = 1.0) {
+                    _weights.push_back(weight);
+                    _adjacency.emplace_back();
+                    return _weights.size() - 1;
+                }
+
+                /**
+                 * @brief Adds the weight to the edge between a and b, loops are ignored.
+                 */
+                void add_edge(std::size_t a, std::size_t b, double weight = 1.0) {
+                    if (a >= size() || b >= size()) {
+                        throw std::domain_error("Edge between unknown vertices");
+                    }
+                    if (a != b) {
+                        _adjacency[a].emplace_back(b, weight);
+                        _adjacency[b].emplace_back(a, weight);
+                    }
+                }
+
+                /**
+                 * @brief Merges the parallel edges added between the same vertices, adding their weights.
+                 */
+                void compact() {
+                    for (auto& edges : _adjacency) {
+                        std::sort(edges.begin(), edges.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+                        std::size_t merged = 0;
+                        for (std::size_t e = 0; e < edges.size(); e++) {
+                            if (merged > 0 && edges[merged - 1].first == edges[e].first) {
+                                edges[merged - 1].second += edges[e].second;
+                            } else {
+                                edges[merged++] = edges[e];
+                            }
+                        }
+                        edges.resize(merged);
+                    }
+                }
+
+                std::size_t size() const noexcept {
+                    return _weights.size();
+                }
+
+                double weight(std::size_t v) const {
+                    return _weights[v];
+                }
+
+                void set_weight(std::size_t v, double weight) {
+                    _weights[v] = weight;
+                }
+
+                double total_weight() const {
+                    double total = 0;
+                    for (double w : _weights) {
+                        total += w;
+                    }
+                    return total;
+                }
+
+                /**
+                 * @return The neighbors of v and the weight of the edges, parallel edges are listed apart
+                 * until the graph is compacted.
+                 */
+                const std::vector<std::pair<std::size_t, double>>& neighbors(std::size_t v) const {
+                    return _adjacency[v];
+                }
+
+                std::size_t edges() const {
+                    std::size_t count = 0;
+                    for (const auto& edges : _adjacency) {
+                        count += edges.size();
+                    }
+                    return count / 2;
+                }
+            };
+
+            /**
+             * @brief Assignment of the vertices of a coupling graph to parts, and its quality.
+             */
+            struct graph_partition {
+                std::size_t parts = 0;
+                std::vector<std::size_t> part_of; // part of each vertex
+                std::vector<double> part_weights;
+                std::size_t edges = 0;
+                std::size_t cut_edges = 0; // edges between vertices of different parts
+                double cut_weight = 0;
+                double imbalance = 0; // weight of the heaviest part over the average
+
+                std::string report() const {
+                    char buffer[160];
+                    std::snprintf(buffer, sizeof(buffer), "parts: %zu, cut edges: %zu of %zu (weight %g), imbalance: %.3f, part weights:",
+                                  parts, cut_edges, edges, cut_weight, imbalance);
+                    std::string result = buffer;
+                    for (double w : part_weights) {
+                        std::snprintf(buffer, sizeof(buffer), " %g", w);
+                        result += buffer;
+                    }
+                    return result;
+                }
+            };
+
+            /**
+             * @brief Measures the cut and the balance of assigning the vertices of a compacted graph to parts.
+             */
+            inline graph_partition evaluate_partition(const coupling_graph& graph, const std::vector<std::size_t>& part_of, std::size_t parts) {
+                if (part_of.size() != graph.size()) {
+                    throw std::domain_error("Every vertex must be assigned to a part");
+                }
+                graph_partition result;
+                result.parts = parts;
+                result.part_of = part_of;
+                result.part_weights.assign(parts, 0.0);
+                for (std::size_t v = 0; v < graph.size(); v++) {
+                    if (part_of[v] >= parts) {
+                        throw std::domain_error("Vertex assigned to an unknown part");
+                    }
+                    result.part_weights[part_of[v]] += graph.weight(v);
+                    for (const auto& [u, w] : graph.neighbors(v)) {
+                        if (v < u) {
+                            result.edges++;
+                            if (part_of[u] != part_of[v]) {
+                                result.cut_edges++;
+                                result.cut_weight += w;
+                            }
+                        }
+                    }
+                }
+                double total = graph.total_weight();
+                double heaviest = parts == 0 ? 0 : *std::max_element(result.part_weights.begin(), result.part_weights.end());
+                result.imbalance = total > 0 ? heaviest * parts / total : 1.0;
+                return result;
+            }
+
+            namespace partitioning {
+                constexpr std::size_t unassigned = std::numeric_limits<std::size_t>::max();
+
+                // highest gain first, and the lowest vertex among equal gains
+                struct candidate_order {
+                    bool operator()(const std::pair<double, std::size_t>& a, const std::pair<double, std::size_t>& b) const noexcept {
+                        return a.first < b.first || (a.first == b.first && a.second > b.second);
+                    }
+                };
+
+                /*
+                 * Heavy edge matching: each vertex, visited from the least connected ones, is merged with the
+                 * unmatched neighbor it has the heaviest edge with, unless the merge is heavier than max_weight.
+                 */
+                inline coupling_graph coarsen(const coupling_graph& graph, double max_weight, std::vector<std::size_t>& coarse_of) {
+                    std::size_t n = graph.size();
+                    std::vector<std::size_t> order(n);
+                    for (std::size_t v = 0; v < n; v++) {
+                        order[v] = v;
+                    }
+                    std::stable_sort(order.begin(), order.end(), [&graph](std::size_t a, std::size_t b) {
+                        return graph.neighbors(a).size() < graph.neighbors(b).size();
+                    });
+                    std::vector<std::size_t> match(n, unassigned);
+                    for (std::size_t v : order) {
+                        if (match[v] != unassigned) {
+                            continue;
+                        }
+                        std::size_t best = v;
+                        double best_weight = -1;
+                        for (const auto& [u, w] : graph.neighbors(v)) {
+                            if (match[u] == unassigned && graph.weight(u) + graph.weight(v) <= max_weight && w > best_weight) {
+                                best = u;
+                                best_weight = w;
+                            }
+                        }
+                        match[v] = best;
+                        match[best] = v;
+                    }
+
+                    coarse_of.assign(n, unassigned);
+                    coupling_graph coarse;
+                    for (std::size_t v = 0; v < n; v++) {
+                        if (coarse_of[v] == unassigned) {
+                            double weight = graph.weight(v) + (match[v] != v ? graph.weight(match[v]) : 0.0);
+                            coarse_of[v] = coarse_of[match[v]] = coarse.add_vertex(weight);
+                        }
+                    }
+                    for (std::size_t v = 0; v < n; v++) {
+                        for (const auto& [u, w] : graph.neighbors(v)) {
+                            if (v < u && coarse_of[v] != coarse_of[u]) {
+                                coarse.add_edge(coarse_of[v], coarse_of[u], w);
+                            }
+                        }
+                    }
+                    coarse.compact();
+                    return coarse;
+                }
+
+                /*
+                 * Splits the vertices in two sides for the first left_parts of parts, growing the left side
+                 * from a vertex far from the first one, always adding the vertex most connected to it.
+                 */
+                inline void bisect(const coupling_graph& graph, const std::vector<std::size_t>& vertices, std::size_t first_part, std::size_t parts,
+                                   std::vector<std::size_t>& part_of, std::vector<int>& mark) {
+                    if (parts == 1 || vertices.size() <= 1) {
+                        for (std::size_t v : vertices) {
+                            part_of[v] = first_part;
+                        }
+                        return;
+                    }
+                    if (vertices.size() <= parts) {
+                        for (std::size_t i = 0; i < vertices.size(); i++) {
+                            part_of[vertices[i]] = first_part + i;
+                        }
+                        return;
+                    }
+                    std::size_t left_parts = parts / 2;
+                    double total = 0;
+                    for (std::size_t v : vertices) {
+                        total += graph.weight(v);
+                        mark[v] = 1; // in the vertices being split
+                    }
+                    double target = total * static_cast<double>(left_parts) / static_cast<double>(parts);
+
+                    // the last vertex reached by a breadth first search is far from the first one
+                    std::vector<std::size_t> queue = {vertices.front()};
+                    mark[vertices.front()] = 3;
+                    for (std::size_t head = 0; head < queue.size(); head++) {
+                        for (const auto& [u, w] : graph.neighbors(queue[head])) {
+                            if (mark[u] == 1) {
+                                mark[u] = 3;
+                                queue.push_back(u);
+                            }
+                        }
+                    }
+                    std::size_t seed = queue.back();
+                    for (std::size_t v : queue) {
+                        mark[v] = 1;
+                    }
+
+                    // mark 2 is the left side, the gain of a vertex is its edge weight to the left side minus
+                    // the weight to the rest, candidates are queued again each time their gain changes
+                    std::vector<double> gain(graph.size(), 0.0);
+                    for (std::size_t v : vertices) {
+                        for (const auto& [u, w] : graph.neighbors(v)) {
+                            if (mark[u] == 1) {
+                                gain[v] -= w;
+                            }
+                        }
+                    }
+                    std::priority_queue<std::pair<double, std::size_t>, std::vector<std::pair<double, std::size_t>>, candidate_order> candidates;
+                    double left_weight = 0;
+                    std::size_t next_unreached = 0;
+                    while (left_weight < target) {
+                        std::size_t best = unassigned;
+                        while (!candidates.empty() && best == unassigned) {
+                            auto [g, u] = candidates.top();
+                            candidates.pop();
+                            if (mark[u] == 1 && g == gain[u]) {
+                                best = u;
+                            }
+                        }
+                        if (best == unassigned) {
+                            if (seed != unassigned) {
+                                best = seed;
+                                seed = unassigned;
+                            } else {
+                                while (mark[vertices[next_unreached]] != 1) {
+                                    next_unreached++;
+                                }
+                                best = vertices[next_unreached];
+                            }
+                        }
+                        // stop before a vertex leaving the sides further from the target than now
+                        if (left_weight > 0 && left_weight + graph.weight(best) - target > target - left_weight) {
+                            break;
+                        }
+                        mark[best] = 2;
+                        left_weight += graph.weight(best);
+                        for (const auto& [u, w] : graph.neighbors(best)) {
+                            if (mark[u] == 1) {
+                                gain[u] += 2 * w;
+                                candidates.emplace(gain[u], u);
+                            }
+                        }
+                    }
+
+                    std::vector<std::size_t> left, right;
+                    for (std::size_t v : vertices) {
+                        (mark[v] == 2 ? left : right).push_back(v);
+                        mark[v] = 0;
+                    }
+                    bisect(graph, left, first_part, left_parts, part_of, mark);
+                    bisect(graph, right, first_part + left_parts, parts - left_parts, part_of, mark);
+                }
+
+                /*
+                 * Greedy k-way refinement: vertices move to the part they are most connected to if it reduces
+                 * the cut without exceeding max_weight, or keeps the cut and balances the parts. Vertices of
+                 * parts exceeding max_weight move even if the cut grows.
+                 */
+                inline void refine(const coupling_graph& graph, std::vector<std::size_t>& part_of, std::size_t parts, double max_weight) {
+                    std::vector<double> part_weights(parts, 0.0);
+                    for (std::size_t v = 0; v < graph.size(); v++) {
+                        part_weights[part_of[v]] += graph.weight(v);
+                    }
+                    std::vector<double> connection(parts, 0.0);
+                    std::vector<bool> touched(parts, false);
+                    std::vector<std::size_t> candidates;
+                    for (unsigned pass = 0; pass < CADMIUM_PARTITIONER_REFINEMENT_PASSES; pass++) {
+                        bool moved = false;
+                        for (std::size_t v = 0; v < graph.size(); v++) {
+                            std::size_t p = part_of[v];
+                            double w = graph.weight(v);
+                            bool overweight = part_weights[p] > max_weight;
+                            candidates.clear();
+                            for (const auto& [u, e] : graph.neighbors(v)) {
+                                std::size_t q = part_of[u];
+                                if (!touched[q]) {
+                                    touched[q] = true;
+                                    candidates.push_back(q);
+                                }
+                                connection[q] += e;
+                            }
+                            if (overweight) {
+                                std::size_t lightest = std::min_element(part_weights.begin(), part_weights.end()) - part_weights.begin();
+                                if (!touched[lightest]) {
+                                    touched[lightest] = true;
+                                    candidates.push_back(lightest);
+                                }
+                            }
+                            std::size_t best = p;
+                            double best_gain = 0;
+                            for (std::size_t q : candidates) {
+                                if (q == p || part_weights[q] + w > max_weight) {
+                                    continue;
+                                }
+                                double gain = connection[q] - connection[p];
+                                bool acceptable = overweight || gain > 0 || (gain == 0 && part_weights[q] + w < part_weights[p]);
+                                bool better = best == p || gain > best_gain || (gain == best_gain && part_weights[q] < part_weights[best]);
+                                if (acceptable && better) {
+                                    best = q;
+                                    best_gain = gain;
+                                }
+                            }
+                            for (std::size_t q : candidates) {
+                                touched[q] = false;
+                                connection[q] = 0;
+                            }
+                            connection[p] = 0;
+                            if (best != p) {
+                                part_weights[p] -= w;
+                                part_weights[best] += w;
+                                part_of[v] = best;
+                                moved = true;
+                            }
+                        }
+                        if (!moved) {
+                            break;
+                        }
+                    }
+                }
+
+                // weight of the lightest vertex with weight, the granularity the parts can be balanced with
+                inline double min_vertex_weight(const coupling_graph& graph) {
+                    double lightest = 0;
+                    for (std::size_t v = 0; v < graph.size(); v++) {
+                        if (graph.weight(v) > 0 && (lightest == 0 || graph.weight(v) < lightest)) {
+                            lightest = graph.weight(v);
+                        }
+                    }
+                    return lightest;
+                }
+            }
+
+            /**
+             * @brief Multilevel k-way partition of a coupling graph minimizing the weight of the cut edges
+             * while keeping the parts balanced.
+             *
+             * @details
+             * The graph is coarsened merging the vertices joined by the heaviest edges, the coarsest graph
+             * is split by recursive bisection, and the partition is refined at each level while projecting
+             * it back to the original graph. The result is deterministic.
+             *
+             * @param parts is the amount of parts.
+             * @param tolerance is the allowed weight of a part over the average, parts may also exceed the
+             * average by the weight of the lightest vertex when the weights can not be balanced closer.
+             */
+            inline graph_partition partition_graph(coupling_graph graph, std::size_t parts, double tolerance = 1.05) {
+                if (parts == 0) {
+                    throw std::domain_error("A graph must be partitioned in at least one part");
+                }
+                graph.compact();
+                double total = graph.total_weight();
+                double average = total / static_cast<double>(parts);
+                std::size_t coarsest = std::max<std::size_t>(2, parts * CADMIUM_PARTITIONER_COARSEST_VERTICES_BY_PART);
+
+                std::vector<coupling_graph> levels;
+                std::vector<std::vector<std::size_t>> coarse_of;
+                const coupling_graph* current = &graph;
+                while (current->size() > coarsest) {
+                    std::vector<std::size_t> map;
+                    coupling_graph coarse = partitioning::coarsen(*current, 1.5 * total / static_cast<double>(coarsest), map);
+                    if (coarse.size() * 20 > current->size() * 19) {
+                        break; // the remaining vertices can not be matched
+                    }
+                    levels.push_back(std::move(coarse));
+                    coarse_of.push_back(std::move(map));
+                    current = &levels.back();
+                }
+
+                std::vector<std::size_t> part_of(current->size(), 0);
+                std::vector<std::size_t> vertices(current->size());
+                for (std::size_t v = 0; v < vertices.size(); v++) {
+                    vertices[v] = v;
+                }
+                std::vector<int> mark(current->size(), 0);
+                partitioning::bisect(*current, vertices, 0, parts, part_of, mark);
+
+                for (std::size_t level = levels.size() + 1; level-- > 0;) {
+                    const coupling_graph& g = level == 0 ? graph : levels[level - 1];
+                    if (level < levels.size()) {
+                        std::vector<std::size_t> fine(g.size());
+                        for (std::size_t v = 0; v < g.size(); v++) {
+                            fine[v] = part_of[coarse_of[level][v]];
+                        }
+                        part_of = std::move(fine);
+                    }
+                    double max_weight = std::max(tolerance * average, average + partitioning::min_vertex_weight(g));
+                    partitioning::refine(g, part_of, parts, max_weight);
+                }
+                return evaluate_partition(graph, part_of, parts);
+            }
+
+            /**
+             * @brief Assigns the vertices to parts in contiguous blocks of similar amount, as the engines do by default.
+             */
+            inline graph_partition contiguous_partition(coupling_graph graph, std::size_t parts) {
+                graph.compact();
+                std::vector<std::size_t> part_of(graph.size());
+                for (std::size_t v = 0; v < graph.size(); v++) {
+                    part_of[v] = v * parts / graph.size();
+                }
+                return evaluate_partition(graph, part_of, parts);
+            }
+
+            /**
+             * @brief Merges the vertices of each group, adding their weights and the weights of their edges.
+             */
+            inline coupling_graph contract_graph(const coupling_graph& graph, const std::vector<std::size_t>& group_of, std::size_t groups) {
+                if (group_of.size() != graph.size()) {
+                    throw std::domain_error("Every vertex must be assigned to a group");
+                }
+                coupling_graph contracted(groups, 0.0);
+                for (std::size_t v = 0; v < graph.size(); v++) {
+                    contracted.set_weight(group_of[v], contracted.weight(group_of[v]) + graph.weight(v));
+                    for (const auto& [u, w] : graph.neighbors(v)) {
+                        if (v < u) {
+                            contracted.add_edge(group_of[v], group_of[u], w);
+                        }
+                    }
+                }
+                contracted.compact();
+                return contracted;
+            }
+
+            /**
+             * @brief Weights of the atomic models and couplings of a flattened coupled model, empty vectors
+             * weight all of them 1.
+             */
+            struct coupling_weights {
+                std::vector<double> transitions; // by flattened atomic model
+                std::vector<double> messages; // by flattened internal coupling
+            };
+
+            /**
+             * @brief Graph of the atomic models of a flattened coupled model, linked by its internal couplings.
+             */
+            template<typename TIME>
+            coupling_graph make_coupling_graph(const cadmium::dynamic::modeling::flattened_coupled<TIME>& flat_model, const coupling_weights& weights = coupling_weights()) {
+                if ((!weights.transitions.empty() && weights.transitions.size() != flat_model.atomics.size())
+                        || (!weights.messages.empty() && weights.messages.size() != flat_model.ic.size())) {
+                    throw std::domain_error("The weights do not match the flattened coupled model");
+                }
+                coupling_graph graph(flat_model.atomics.size());
+                for (std::size_t a = 0; a < weights.transitions.size(); a++) {
+                    graph.set_weight(a, weights.transitions[a]);
+                }
+                for (std::size_t i = 0; i < flat_model.ic.size(); i++) {
+                    graph.add_edge(flat_model.ic[i].from, flat_model.ic[i].to, weights.messages.empty() ? 1.0 : weights.messages[i]);
+                }
+                return graph;
+            }
+
+            /**
+             * @brief Graph of the children of the top coupled model, weighted by the atomic models they contain.
+             */
+            template<typename TIME>
+            coupling_graph make_children_coupling_graph(const std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>>& coupled_model, const coupling_weights& weights = coupling_weights()) {
+                std::vector<std::size_t> child_of;
+                for (std::size_t c = 0; c < coupled_model->_models.size(); c++) {
+                    child_of.insert(child_of.end(), cadmium::dynamic::modeling::count_atomics<TIME>(coupled_model->_models[c]), c);
+                }
+                coupling_graph atomics = make_coupling_graph<TIME>(cadmium::dynamic::modeling::flatten<TIME>(coupled_model), weights);
+                return contract_graph(atomics, child_of, coupled_model->_models.size());
+            }
+
+            /**
+             * @brief Partitions the atomic models of the flattened coupled model, for the runner, the
+             * conservative runner and the time warp runner constructors taking the part of each model.
+             */
+            template<typename TIME>
+            graph_partition partition_atomics(const std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>>& coupled_model, std::size_t parts,
+                                              const coupling_weights& weights = coupling_weights(), double tolerance = 1.05) {
+                return partition_graph(make_coupling_graph<TIME>(cadmium::dynamic::modeling::flatten<TIME>(coupled_model), weights), parts, tolerance);
+            }
+
+            /**
+             * @brief Partitions the children of the top coupled model, for the multiprocess runner and the
+             * socket nodes.
+             */
+            template<typename TIME>
+            graph_partition partition_children(const std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>>& coupled_model, std::size_t parts,
+                                               const coupling_weights& weights = coupling_weights(), double tolerance = 1.05) {
+                return partition_graph(make_children_coupling_graph<TIME>(coupled_model, weights), parts, tolerance);
+            }
+
+            /**
+             * @brief Measures the weights of the flattened coupled model simulating it until the given time:
+             * the transitions of each atomic model and the steps each internal coupling carries messages.
+             * The model is simulated, so the weights are usually measured on a copy built for it.
+             */
+            template<typename TIME, template<typename> class FEL=binary_heap_fel>
+            coupling_weights measure_coupling_weights(const std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>>& coupled_model, const TIME& init_time, const TIME& until) {
+                cadmium::dynamic::modeling::flattened_coupled<TIME> flat = cadmium::dynamic::modeling::flatten<TIME>(coupled_model);
+                if (!flat.eic.empty() || !flat.eoc.empty()) {
+                    throw std::domain_error("Only coupled models without external couplings can be measured");
+                }
+                logical_process<TIME, cadmium::logger::not_logger, FEL> process;
+                for (const auto& m : flat.atomics) {
+                    auto atomic = std::dynamic_pointer_cast<cadmium::dynamic::modeling::atomic_abstract<TIME>>(m);
+                    if (atomic == nullptr) {
+                        throw std::domain_error("Only atomic models are supported when measuring weights");
+                    }
+                    process.add_model(atomic);
+                }
+                std::vector<std::vector<std::size_t>> ics_by_source(flat.atomics.size());
+                for (std::size_t i = 0; i < flat.ic.size(); i++) {
+                    process.add_route(flat.ic[i].from, flat.ic[i].to, flat.ic[i].link);
+                    ics_by_source[flat.ic[i].from].push_back(i);
+                }
+                process.init(init_time);
+
+                coupling_weights weights;
+                weights.transitions.assign(flat.atomics.size(), 0.0);
+                weights.messages.assign(flat.ic.size(), 0.0);
+                std::vector<bool> transitioned(flat.atomics.size(), false);
+                std::vector<std::size_t> advanced;
+                for (TIME t = process.next(); t < until; t = process.next()) {
+                    process.collect_outputs(t);
+                    advanced.clear();
+                    for (std::size_t a : process.imminent()) {
+                        transitioned[a] = true;
+                        advanced.push_back(a);
+                        for (std::size_t i : ics_by_source[a]) {
+                            const auto& ic = flat.ic[i];
+                            if (ic.link->has_messages(process.model(a).output_endpoint(ic.link->from_port_type_index()))) {
+                                weights.messages[i]++;
+                                if (!transitioned[ic.to]) {
+                                    transitioned[ic.to] = true;
+                                    advanced.push_back(ic.to);
+                                }
+                            }
+                        }
+                    }
+                    for (std::size_t a : advanced) {
+                        weights.transitions[a]++;
+                        transitioned[a] = false;
+                    }
+                    process.advance_simulation(t);
+                }
+                return weights;
+            }
+        }
+    }
+}
+
+#endif //CADMIUM_PDEVS_DYNAMIC_GRAPH_PARTITIONER_HPP
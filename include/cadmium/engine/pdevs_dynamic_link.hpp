@@ -28,17 +28,22 @@
 #define CADMIUM_PDEVS_DYNAMIC_LINK_HPP
 
 #include <typeindex>
+#include <iterator>
+#include <vector>
 #include <memory>
+#include <stdexcept>
 
 #include <cadmium/logger/dynamic_common_loggers.hpp>
 #include <cadmium/modeling/dynamic_message_bag.hpp>
+#include <cadmium/modeling/message_bag.hpp>
+#include <cadmium/modeling/message_codec.hpp>
 #include <cadmium/logger/common_loggers_helpers.hpp>
 
 namespace cadmium {
     namespace dynamic {
         namespace engine {
 
-            class link_abstract {
+            class link_abstract : public std::enable_shared_from_this<link_abstract> {
             public:
                 virtual std::type_index from_type_index() const = 0;
 
@@ -51,16 +56,434 @@ namespace cadmium {
                 virtual cadmium::dynamic::logger::routed_messages
                 route_messages(const cadmium::dynamic::message_bags& bags_from, cadmium::dynamic::message_bags& bags_to) const = 0;
 
+                /**
+                 * @brief Routes the messages between ports stored either in typed slots or in message bags.
+                 * @param from is the location of the from port messages, a typed slot must hold the link message type.
+                 * @param to is the location of the to port messages, a typed slot must hold the link message type.
+                 */
+                virtual void route(const cadmium::dynamic::port_endpoint& from, const cadmium::dynamic::port_endpoint& to) const = 0;
+
+                /**
+                 * @brief Describes the messages in both ports of a previous route call, for logging purposes.
+                 */
+                virtual cadmium::dynamic::logger::routed_messages
+                describe_route(const cadmium::dynamic::port_endpoint& from, const cadmium::dynamic::port_endpoint& to) const = 0;
+
+                /**
+                 * @return true if a route call from this location would route any message.
+                 */
+                virtual bool has_messages(const cadmium::dynamic::port_endpoint& from) const = 0;
+
+                /**
+                 * @brief Empties the bag of the from port in bags_from, if it is defined, keeping its memory
+                 * to be reused by the next messages.
+                 */
+                virtual void clear_from_messages(cadmium::dynamic::message_bags& bags_from) const = 0;
+
+                /**
+                 * @brief Empties the bag of the to port in bags_to, if it is defined, keeping its memory
+                 * to be reused by the next messages.
+                 */
+                virtual void clear_to_messages(cadmium::dynamic::message_bags& bags_to) const = 0;
+
+                /**
+                 * @brief Appends to out the messages a route call from this location would route, encoded
+                 * with the cadmium::dynamic::message_codec of the message type.
+                 */
+                virtual void encode_messages(const cadmium::dynamic::port_endpoint& from, std::string& out) const = 0;
+
+                /**
+                 * @brief Routes to the to location the messages encoded by encode_messages in size bytes from data.
+                 */
+                virtual void decode_messages(const char* data, std::size_t size, const cadmium::dynamic::port_endpoint& to) const = 0;
+
+                /**
+                 * @brief Builds a single link routing from the from port of this link to the to port of the next one.
+                 * @note The to port of this link is expected to be the from port of next, only message types are checked.
+                 * @param next is the link following this one.
+                 * @return A link equivalent to routing through this link and then through next.
+                 */
+                virtual std::shared_ptr<link_abstract> chain(const std::shared_ptr<link_abstract>& next) const = 0;
+
                 virtual ~link_abstract() {}
             };
 
+            /**
+             * @brief Read only view of the messages of a port, whatever the amount of messages its bag keeps inside.
+             */
+            template<typename MSG>
+            struct message_range {
+                using value_type = MSG;
+                using const_iterator = const MSG*;
+
+                const MSG* first = nullptr;
+                const MSG* last = nullptr;
+
+                message_range() = default;
+
+                message_range(const MSG* first, const MSG* last) : first(first), last(last) {}
+
+                template<typename BAG>
+                explicit message_range(const BAG& messages) : first(messages.data()), last(messages.data() + messages.size()) {}
+
+                const MSG* begin() const noexcept {
+                    return first;
+                }
+
+                const MSG* end() const noexcept {
+                    return last;
+                }
+
+                bool empty() const noexcept {
+                    return first == last;
+                }
+
+                std::size_t size() const noexcept {
+                    return last - first;
+                }
+
+                const MSG& operator[](std::size_t i) const noexcept {
+                    return first[i];
+                }
+            };
+
+            /**
+             * @brief Read only view of bool messages. The bags of ports keeping no messages inside are
+             * std::vector<bool>, packing their messages in bits, so the view reads them by index.
+             */
+            template<>
+            struct message_range<bool> {
+                using value_type = bool;
+
+                class const_iterator {
+                    const bool* _messages = nullptr;
+                    const std::vector<bool>* _packed = nullptr;
+                    std::size_t _i = 0;
+
+                public:
+                    using iterator_category = std::forward_iterator_tag;
+                    using value_type = bool;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = const bool*;
+                    using reference = bool;
+
+                    const_iterator() = default;
+
+                    const_iterator(const bool* messages, const std::vector<bool>* packed, std::size_t i) noexcept
+                            : _messages(messages), _packed(packed), _i(i) {}
+
+                    bool operator*() const noexcept {
+                        return _packed != nullptr ? (*_packed)[_i] : _messages[_i];
+                    }
+
+                    const_iterator& operator++() noexcept {
+                        ++_i;
+                        return *this;
+                    }
+
+                    const_iterator operator++(int) noexcept {
+                        const_iterator previous = *this;
+                        ++_i;
+                        return previous;
+                    }
+
+                    bool operator==(const const_iterator& other) const noexcept {
+                        return _i == other._i;
+                    }
+
+                    bool operator!=(const const_iterator& other) const noexcept {
+                        return _i != other._i;
+                    }
+                };
+
+                const bool* first = nullptr;
+                const std::vector<bool>* packed = nullptr;
+                std::size_t count = 0;
+
+                message_range() = default;
+
+                message_range(const bool* first, const bool* last) : first(first), count(last - first) {}
+
+                template<typename BAG>
+                explicit message_range(const BAG& messages) : count(messages.size()) {
+                    if constexpr (std::is_same<BAG, std::vector<bool>>::value) {
+                        packed = &messages;
+                    } else {
+                        first = messages.data();
+                    }
+                }
+
+                const_iterator begin() const noexcept {
+                    return const_iterator(first, packed, 0);
+                }
+
+                const_iterator end() const noexcept {
+                    return const_iterator(first, packed, count);
+                }
+
+                bool empty() const noexcept {
+                    return count == 0;
+                }
+
+                std::size_t size() const noexcept {
+                    return count;
+                }
+
+                bool operator[](std::size_t i) const noexcept {
+                    return packed != nullptr ? (*packed)[i] : first[i];
+                }
+            };
+
+            /**
+             * @brief Links routing messages of type MSG, regardless of their ports. Allows reading and writing
+             * the bags of the link ports without knowing the ports.
+             */
+            template<typename MSG>
+            class typed_link : public link_abstract {
+            public:
+                /**
+                 * @brief Reads the messages in the from port of bags_from.
+                 * @return false if the port is not defined.
+                 */
+                virtual bool messages_from(const cadmium::dynamic::message_bags& bags_from, message_range<MSG>& messages) const = 0;
+
+                /**
+                 * @return The messages in the from port at from, empty if the port is not defined.
+                 */
+                virtual message_range<MSG> messages_from(const cadmium::dynamic::port_endpoint& from) const = 0;
+
+                /**
+                 * @brief Reads the messages in the to port at to.
+                 * @return false if the port is not defined.
+                 */
+                virtual bool messages_to(const cadmium::dynamic::port_endpoint& to, message_range<MSG>& messages) const = 0;
+
+                /**
+                 * @brief Appends messages to the to port at to, defining it with an empty bag if it is not defined.
+                 */
+                virtual void append_messages_to(const cadmium::dynamic::port_endpoint& to, message_range<MSG> messages) const = 0;
+
+                /**
+                 * @return true if the to port folds the messages routed to it with a combiner.
+                 */
+                virtual bool combines_to_messages() const = 0;
+
+                virtual std::string from_port_name() const = 0;
+
+                virtual std::string to_port_name() const = 0;
+
+                std::shared_ptr<link_abstract> chain(const std::shared_ptr<link_abstract>& next) const override;
+
+                void route(const cadmium::dynamic::port_endpoint& from, const cadmium::dynamic::port_endpoint& to) const override {
+                    message_range<MSG> from_messages = this->messages_from(from);
+                    if (!from_messages.empty()) {
+                        this->append_messages_to(to, from_messages);
+                    }
+                }
+
+                bool has_messages(const cadmium::dynamic::port_endpoint& from) const override {
+                    return !this->messages_from(from).empty();
+                }
+
+                void encode_messages(const cadmium::dynamic::port_endpoint& from, std::string& out) const override {
+                    if constexpr (cadmium::dynamic::message_codec<MSG>::defined) {
+                        message_range<MSG> from_messages = this->messages_from(from);
+                        std::uint64_t count = from_messages.size();
+                        cadmium::dynamic::message_codec<std::uint64_t>::encode(count, out);
+                        for (const MSG& m : from_messages) {
+                            cadmium::dynamic::message_codec<MSG>::encode(m, out);
+                        }
+                    } else {
+                        throw std::domain_error("The messages of port " + this->from_port_name() + " have no message_codec");
+                    }
+                }
+
+                void decode_messages(const char* data, std::size_t size, const cadmium::dynamic::port_endpoint& to) const override {
+                    if constexpr (cadmium::dynamic::message_codec<MSG>::defined) {
+                        const char* end = data + size;
+                        std::uint64_t count = cadmium::dynamic::message_codec<std::uint64_t>::decode(data, end);
+                        for (std::uint64_t i = 0; i < count; i++) {
+                            MSG m = cadmium::dynamic::message_codec<MSG>::decode(data, end);
+                            this->append_messages_to(to, message_range<MSG>(&m, &m + 1));
+                        }
+                    } else {
+                        throw std::domain_error("The messages of port " + this->to_port_name() + " have no message_codec");
+                    }
+                }
+
+                cadmium::dynamic::logger::routed_messages
+                describe_route(const cadmium::dynamic::port_endpoint& from, const cadmium::dynamic::port_endpoint& to) const override {
+                    message_range<MSG> to_messages;
+                    if ((from.slot != nullptr || from.bags->count(this->from_port_type_index()) > 0) && this->messages_to(to, to_messages)) {
+                        return cadmium::dynamic::logger::routed_messages(
+                                cadmium::logger::messages_as_strings(this->messages_from(from)),
+                                cadmium::logger::messages_as_strings(to_messages),
+                                this->from_port_name(),
+                                this->to_port_name()
+                        );
+                    }
+                    return cadmium::dynamic::logger::routed_messages(this->from_port_name(), this->to_port_name());
+                }
+
+            protected:
+                /**
+                 * @brief Routes the messages reading from the from port of the reader link and writing in the to port
+                 * of the writer link. The to port bag is only created when there are messages to route.
+                 */
+                static cadmium::dynamic::logger::routed_messages
+                route_messages_between(const typed_link<MSG>& reader, const typed_link<MSG>& writer,
+                                       const cadmium::dynamic::message_bags& bags_from, cadmium::dynamic::message_bags& bags_to) {
+                    message_range<MSG> from;
+                    if (reader.messages_from(bags_from, from)) {
+                        cadmium::dynamic::port_endpoint to_endpoint{nullptr, &bags_to};
+                        if (!from.empty()) {
+                            writer.append_messages_to(to_endpoint, from);
+                        }
+                        message_range<MSG> to;
+                        if (writer.messages_to(to_endpoint, to)) {
+                            return cadmium::dynamic::logger::routed_messages(
+                                    cadmium::logger::messages_as_strings(from),
+                                    cadmium::logger::messages_as_strings(to),
+                                    reader.from_port_name(),
+                                    writer.to_port_name()
+                            );
+                        }
+                    }
+                    return cadmium::dynamic::logger::routed_messages(reader.from_port_name(), writer.to_port_name());
+                }
+            };
+
+            /**
+             * @brief Link resulting of chaining links, it routes directly from the from port of the first link
+             * to the to port of the last one.
+             */
+            template<typename MSG>
+            class chained_link : public typed_link<MSG> {
+                std::shared_ptr<const typed_link<MSG>> _first;
+                std::shared_ptr<const typed_link<MSG>> _last;
+
+            public:
+                chained_link(std::shared_ptr<const typed_link<MSG>> first, std::shared_ptr<const typed_link<MSG>> last)
+                        : _first(std::move(first)), _last(std::move(last)) {}
+
+                std::type_index from_type_index() const override {
+                    return _first->from_type_index();
+                }
+
+                std::type_index from_port_type_index() const override {
+                    return _first->from_port_type_index();
+                }
+
+                std::type_index to_type_index() const override {
+                    return _last->to_type_index();
+                }
+
+                std::type_index to_port_type_index() const override {
+                    return _last->to_port_type_index();
+                }
+
+                bool messages_from(const cadmium::dynamic::message_bags& bags_from, message_range<MSG>& messages) const override {
+                    return _first->messages_from(bags_from, messages);
+                }
+
+                message_range<MSG> messages_from(const cadmium::dynamic::port_endpoint& from) const override {
+                    return _first->messages_from(from);
+                }
+
+                bool messages_to(const cadmium::dynamic::port_endpoint& to, message_range<MSG>& messages) const override {
+                    return _last->messages_to(to, messages);
+                }
+
+                void append_messages_to(const cadmium::dynamic::port_endpoint& to, message_range<MSG> messages) const override {
+                    _last->append_messages_to(to, messages);
+                }
+
+                void clear_from_messages(cadmium::dynamic::message_bags& bags_from) const override {
+                    _first->clear_from_messages(bags_from);
+                }
+
+                void clear_to_messages(cadmium::dynamic::message_bags& bags_to) const override {
+                    _last->clear_to_messages(bags_to);
+                }
+
+                bool combines_to_messages() const override {
+                    return _last->combines_to_messages();
+                }
+
+                std::string from_port_name() const override {
+                    return _first->from_port_name();
+                }
+
+                std::string to_port_name() const override {
+                    return _last->to_port_name();
+                }
+
+                cadmium::dynamic::logger::routed_messages
+                route_messages(const cadmium::dynamic::message_bags& bags_from, cadmium::dynamic::message_bags& bags_to) const override {
+                    return typed_link<MSG>::route_messages_between(*_first, *_last, bags_from, bags_to);
+                }
+
+                /**
+                 * @throw std::domain_error if the to port of this link combines its messages, as the chained link
+                 * would route them without combining them with the messages of the other links to the port.
+                 */
+                std::shared_ptr<link_abstract> chain(const std::shared_ptr<link_abstract>& next) const override {
+                    auto typed_next = std::dynamic_pointer_cast<const typed_link<MSG>>(next);
+                    if (typed_next == nullptr) {
+                        throw std::domain_error("Chained links must route the same message type");
+                    }
+                    if (_last->combines_to_messages()) {
+                        throw std::domain_error("Links cannot be chained through port " + _last->to_port_name() + ", it combines its messages");
+                    }
+                    auto next_last = std::dynamic_pointer_cast<const chained_link<MSG>>(typed_next);
+                    return std::make_shared<chained_link<MSG>>(_first, next_last == nullptr ? typed_next : next_last->_last);
+                }
+            };
+
+            template<typename MSG>
+            std::shared_ptr<link_abstract> typed_link<MSG>::chain(const std::shared_ptr<link_abstract>& next) const {
+                auto self = std::static_pointer_cast<const typed_link<MSG>>(this->shared_from_this());
+                return chained_link<MSG>(self, self).chain(next);
+            }
+
             template<typename PORT_FROM, typename PORT_TO>
-            class link : public link_abstract {
+            class link : public typed_link<typename PORT_FROM::message_type> {
             public:
                 using from_message_type = typename PORT_FROM::message_type;
                 using from_message_bag_type = typename cadmium::message_bag<PORT_FROM>;
                 using to_message_type = typename PORT_TO::message_type;
                 using to_message_bag_type = typename cadmium::message_bag<PORT_TO>;
+                using from_bag_type = typename from_message_bag_type::bag_type;
+                using to_bag_type = typename to_message_bag_type::bag_type;
+
+            private:
+                // the messages of the from port, a typed slot holds the bag of PORT_FROM
+                const from_bag_type* from_bag(const cadmium::dynamic::port_endpoint& from) const {
+                    if (from.slot != nullptr) {
+                        return static_cast<const from_bag_type*>(from.slot);
+                    }
+                    auto it = from.bags->find(this->from_port_type_index());
+                    return it != from.bags->cend() ? &boost::any_cast<const from_message_bag_type&>(it->second).messages : nullptr;
+                }
+
+                // the messages of the to port, a typed slot holds the bag of PORT_TO
+                to_bag_type* to_bag(const cadmium::dynamic::port_endpoint& to, bool create) const {
+                    if (to.slot != nullptr) {
+                        return static_cast<to_bag_type*>(to.slot);
+                    }
+                    auto it = to.bags->find(this->to_port_type_index());
+                    if (it == to.bags->end()) {
+                        if (!create) {
+                            return nullptr;
+                        }
+                        // copied from an empty bag, moving a temporary small_vector makes GCC 12 warn of a false overread
+                        const to_message_bag_type empty_bag;
+                        it = to.bags->emplace(this->to_port_type_index(), empty_bag).first;
+                    }
+                    return &boost::any_cast<to_message_bag_type&>(it->second).messages;
+                }
+
+            public:
 
                 link() {
                   #ifndef RT_ARM_MBED
@@ -87,12 +510,76 @@ namespace cadmium {
                     return typeid(PORT_TO);
                 }
 
+                bool messages_from(const cadmium::dynamic::message_bags& bags_from, message_range<from_message_type>& messages) const override {
+                    auto it = bags_from.find(this->from_port_type_index());
+                    if (it == bags_from.cend()) {
+                        return false;
+                    }
+                    messages = message_range<from_message_type>(boost::any_cast<const from_message_bag_type&>(it->second).messages);
+                    return true;
+                }
+
+                message_range<from_message_type> messages_from(const cadmium::dynamic::port_endpoint& from) const override {
+                    const from_bag_type* from_messages = this->from_bag(from);
+                    return from_messages != nullptr ? message_range<from_message_type>(*from_messages) : message_range<from_message_type>();
+                }
+
+                bool messages_to(const cadmium::dynamic::port_endpoint& to, message_range<from_message_type>& messages) const override {
+                    const to_bag_type* to_messages = this->to_bag(to, false);
+                    if (to_messages == nullptr) {
+                        return false;
+                    }
+                    messages = message_range<from_message_type>(*to_messages);
+                    return true;
+                }
+
+                void append_messages_to(const cadmium::dynamic::port_endpoint& to, message_range<from_message_type> messages) const override {
+                    cadmium::append_messages<PORT_TO>(*this->to_bag(to, true), messages.begin(), messages.end());
+                }
+
+                void route(const cadmium::dynamic::port_endpoint& from, const cadmium::dynamic::port_endpoint& to) const override {
+                    const from_bag_type* from_messages = this->from_bag(from);
+                    if (from_messages != nullptr && !from_messages->empty()) {
+                        cadmium::append_messages<PORT_TO>(*this->to_bag(to, true), from_messages->begin(), from_messages->end());
+                    }
+                }
+
+                bool combines_to_messages() const override {
+                    return cadmium::port_combines<PORT_TO>::value;
+                }
+
+                bool has_messages(const cadmium::dynamic::port_endpoint& from) const override {
+                    const from_bag_type* from_messages = this->from_bag(from);
+                    return from_messages != nullptr && !from_messages->empty();
+                }
+
+                void clear_from_messages(cadmium::dynamic::message_bags& bags_from) const override {
+                    auto it = bags_from.find(this->from_port_type_index());
+                    if (it != bags_from.end()) {
+                        boost::any_cast<from_message_bag_type&>(it->second).messages.clear();
+                    }
+                }
+
+                void clear_to_messages(cadmium::dynamic::message_bags& bags_to) const override {
+                    to_bag_type* to_messages = this->to_bag(cadmium::dynamic::port_endpoint{nullptr, &bags_to}, false);
+                    if (to_messages != nullptr) {
+                        to_messages->clear();
+                    }
+                }
+
+                std::string from_port_name() const override {
+                    return boost::typeindex::type_id<PORT_FROM>().pretty_name();
+                }
+
+                std::string to_port_name() const override {
+                    return boost::typeindex::type_id<PORT_TO>().pretty_name();
+                }
+
                 cadmium::dynamic::logger::routed_messages
                 pass_messages(const boost::any& bag_from, boost::any& bag_to) const {
-                    from_message_bag_type b_from = boost::any_cast<from_message_bag_type>(bag_from);
+                    const from_message_bag_type& b_from = boost::any_cast<const from_message_bag_type&>(bag_from);
                     to_message_bag_type *b_to = boost::any_cast<to_message_bag_type>(&bag_to);
-                    b_to->messages.insert(b_to->messages.end(), b_from.messages.begin(),
-                                          b_from.messages.end());
+                    cadmium::append_messages<PORT_TO>(b_to->messages, b_from.messages.begin(), b_from.messages.end());
 
                     return cadmium::dynamic::logger::routed_messages(
                             cadmium::logger::messages_as_strings(b_from.messages),
@@ -105,10 +592,9 @@ namespace cadmium {
                 cadmium::dynamic::logger::routed_messages
                 pass_messages_to_new_bag(const boost::any& bag_from,
                                          cadmium::dynamic::message_bags& bags_to) const {
-                    from_message_bag_type b_from = boost::any_cast<from_message_bag_type>(bag_from);
+                    const from_message_bag_type& b_from = boost::any_cast<const from_message_bag_type&>(bag_from);
                     to_message_bag_type b_to;
-                    b_to.messages.insert(b_to.messages.end(), b_from.messages.begin(),
-                                         b_from.messages.end());
+                    cadmium::append_messages<PORT_TO>(b_to.messages, b_from.messages.begin(), b_from.messages.end());
                     bags_to[this->to_port_type_index()] = b_to;
 
                     return cadmium::dynamic::logger::routed_messages(
@@ -133,24 +619,8 @@ namespace cadmium {
 
                 cadmium::dynamic::logger::routed_messages
                 route_messages(const cadmium::dynamic::message_bags& bags_from, cadmium::dynamic::message_bags& bags_to) const override {
-                    if (bags_from.find(this->from_port_type_index()) != bags_from.cend()) {
-
-                        if (bags_to.find(this->to_port_type_index()) != bags_to.cend()) {
-                            return this->pass_messages(bags_from.at(this->from_port_type_index()),
-                                                       bags_to.at(this->to_port_type_index()));
-                        }
-
-                        if (this->is_there_messages_to_route(bags_from)) {
-                            return this->pass_messages_to_new_bag(
-                                    bags_from.at(this->from_port_type_index()), bags_to);
-                        }
-                    }
-
-                    cadmium::dynamic::logger::routed_messages empty_ret(
-                            boost::typeindex::type_id<PORT_FROM>().pretty_name(),
-                            boost::typeindex::type_id<PORT_TO>().pretty_name()
-                    );
-                    return empty_ret; // if no messages where routed, it returns an empty vector
+                    // if no messages where routed, it returns an empty vector
+                    return typed_link<from_message_type>::route_messages_between(*this, *this, bags_from, bags_to);
                 }
             };
         }
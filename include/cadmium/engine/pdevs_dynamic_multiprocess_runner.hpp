@@ -0,0 +1,379 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef CADMIUM_PDEVS_DYNAMIC_MULTIPROCESS_RUNNER_HPP
+#define CADMIUM_PDEVS_DYNAMIC_MULTIPROCESS_RUNNER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cadmium/engine/pdevs_dynamic_partitioned_model.hpp>
+#include <cadmium/engine/shared_memory_channels.hpp>
+
+/* capacity in bytes of each ring between two processes */
+#ifndef CADMIUM_SHM_RING_BYTES
+#define CADMIUM_SHM_RING_BYTES (1 << 16)
+#endif
+
+namespace cadmium {
+    namespace dynamic {
+        namespace engine {
+
+            /**
+             * @brief Runner simulating a partition of the top coupled model children in each of a set of
+             * forked worker processes.
+             *
+             * @details
+             * Each worker process owns the atomic models of its children, so it allocates their messages
+             * and states in its own heap. The workers simulate every imminent time together, separated
+             * by barriers in shared memory: they agree on the next time, collect the outputs of their
+             * imminent models and send the messages for other workers, then route all the messages
+             * in the order of the couplings and advance their models. Messages between workers are
+             * encoded with cadmium::dynamic::message_codec and go through a lock free single producer
+             * single consumer ring in POSIX shared memory for each pair of workers.
+             *
+             * The workers are forked by the constructor, so it must be called before starting other
+             * threads, and exit when the runner is destroyed. After forking, the models in the calling
+             * process are no longer simulated: results come from the logger of each worker, flushed
+             * at the end of run_until, or from model_states. Asynchronous atomic models are not supported.
+             *
+             * @param TIME Representation of time to be used to run the simulation, it must be trivially copyable
+             * @param LOGGER what, where and how to log from the simulation, logs of different workers interleave
+             * @param FEL future event list policy used by the workers, see pdevs_dynamic_fel.hpp
+             */
+            template<class TIME, typename LOGGER=default_logger<TIME>, template<typename> class FEL=binary_heap_fel>
+            class multiprocess_runner {
+                static_assert(std::is_trivially_copyable_v<TIME>, "The multiprocess runner shares TIME values between processes");
+
+                using model_type = partitioned_model<TIME, LOGGER, FEL>;
+
+                enum class command : int {
+                    none, run, states, exit
+                };
+
+                // state shared by all the processes
+                struct control_block {
+                    alignas(64) std::atomic<std::uint64_t> sequence{0};
+                    std::atomic<int> command{0};
+                    TIME until;
+                    alignas(64) std::atomic<std::uint32_t> done{0};
+                    std::atomic<bool> failed{false};
+                    char error[512];
+                    cadmium::concurrency::process_barrier barrier;
+                };
+
+                std::size_t _workers;
+                std::unique_ptr<model_type> _model;
+
+                std::unique_ptr<cadmium::concurrency::shared_memory_segment> _segment;
+                control_block* _control = nullptr;
+                TIME* _next_of = nullptr; // next time of each worker
+                std::vector<cadmium::concurrency::spsc_ring> _rings; // worker to worker, and worker to this process
+                std::vector<pid_t> _pids;
+                bool _broken = false;
+
+                // worker side state
+                std::size_t _me = 0;
+                std::uint64_t _sequence = 0;
+                std::vector<std::string> _staging; // bytes received from each worker
+
+                cadmium::concurrency::spsc_ring& ring(std::size_t from, std::size_t to) {
+                    return _rings[from * (_workers + 1) + to];
+                }
+
+                void create_shared_memory() {
+                    std::size_t rings = _workers * (_workers + 1);
+                    std::size_t control_size = ((sizeof(control_block) + 63) / 64) * 64;
+                    std::size_t next_size = ((sizeof(TIME) * _workers + 63) / 64) * 64;
+                    std::size_t ring_size = cadmium::concurrency::spsc_ring::footprint(CADMIUM_SHM_RING_BYTES);
+                    _segment = std::make_unique<cadmium::concurrency::shared_memory_segment>(control_size + next_size + rings * ring_size);
+
+                    char* memory = static_cast<char*>(_segment->data());
+                    _control = new (memory) control_block();
+                    _next_of = reinterpret_cast<TIME*>(memory + control_size);
+                    for (std::size_t w = 0; w < _workers; w++) {
+                        _next_of[w] = _model->next(w);
+                    }
+                    for (std::size_t r = 0; r < rings; r++) {
+                        _rings.emplace_back(memory + control_size + next_size + r * ring_size, CADMIUM_SHM_RING_BYTES, true);
+                    }
+                }
+
+                void fork_workers() {
+                    std::cout.flush();
+                    std::cerr.flush();
+                    for (std::size_t w = 0; w < _workers; w++) {
+                        pid_t pid = ::fork();
+                        if (pid < 0) {
+                            _broken = true;
+                            throw std::runtime_error("Unable to fork the worker processes");
+                        }
+                        if (pid == 0) {
+                            _me = w;
+                            worker_main();
+                        }
+                        _pids.push_back(pid);
+                    }
+                }
+
+                /*
+                 * Worker side
+                 */
+
+                [[noreturn]] void worker_main() {
+                    pid_t parent = ::getppid();
+                    _staging.resize(_workers);
+                    for (;;) {
+                        unsigned spins = 0;
+                        while (_control->sequence.load(std::memory_order_acquire) == _sequence) {
+                            if (++spins >= CADMIUM_SHM_SPIN_LIMIT) {
+                                if (::getppid() != parent) {
+                                    ::_exit(1);
+                                }
+                                ::usleep(50);
+                            }
+                        }
+                        _sequence++;
+                        command c = static_cast<command>(_control->command.load(std::memory_order_relaxed));
+                        if (c == command::exit) {
+                            std::cout.flush();
+                            ::_exit(0);
+                        }
+                        try {
+                            if (c == command::run) {
+                                run_worker(_control->until);
+                            } else if (c == command::states) {
+                                send_states();
+                            }
+                        } catch (const std::exception& e) {
+                            if (!_control->failed.exchange(true)) {
+                                std::strncpy(_control->error, e.what(), sizeof(_control->error) - 1);
+                            }
+                            _control->barrier.abort();
+                        }
+                        std::cout.flush();
+                        _control->done.fetch_add(1, std::memory_order_acq_rel);
+                    }
+                }
+
+                void poll() {
+                    for (std::size_t w = 0; w < _workers; w++) {
+                        if (w != _me) {
+                            ring(w, _me).read(_staging[w]);
+                        }
+                    }
+                }
+
+                void barrier() {
+                    _control->barrier.wait(static_cast<std::uint32_t>(_workers), [this]() { poll(); });
+                }
+
+                // the receiving ring is polled while waiting for room, as the receiver may be waiting on another ring
+                void send(std::size_t to, const std::string& bytes) {
+                    std::size_t written = 0;
+                    for (unsigned spins = 0; written < bytes.size(); spins++) {
+                        written += ring(_me, to).write(bytes.data() + written, bytes.size() - written);
+                        if (written < bytes.size()) {
+                            if (_control->barrier.aborted()) {
+                                throw std::runtime_error("Simulation aborted by another process");
+                            }
+                            if (to != _workers) {
+                                poll();
+                            }
+                            if (spins >= CADMIUM_SHM_SPIN_LIMIT) {
+                                ::sched_yield();
+                            }
+                        }
+                    }
+                }
+
+                void run_worker(const TIME& until) {
+                    for (;;) {
+                        _next_of[_me] = _model->next(_me);
+                        barrier();
+                        TIME t = *std::min_element(_next_of, _next_of + _workers);
+                        if (!(t < until)) {
+                            break;
+                        }
+                        _model->collect_outputs(_me, t, [this](std::size_t to, const std::string& record) { send(to, record); });
+                        // every message of the step was written once all the workers arrive
+                        barrier();
+                        poll();
+                        _model->advance_simulation(_me, t, _staging);
+                        for (auto& bytes : _staging) {
+                            bytes.clear();
+                        }
+                    }
+                }
+
+                void send_states() {
+                    send(_workers, _model->encode_states(_me));
+                }
+
+                /*
+                 * Calling process side
+                 */
+
+                // throws if a worker exited, as it will never finish the command
+                void check_workers() {
+                    for (std::size_t w = 0; w < _pids.size(); w++) {
+                        int status = 0;
+                        if (_pids[w] > 0 && ::waitpid(_pids[w], &status, WNOHANG) == _pids[w]) {
+                            _pids[w] = -1;
+                            _broken = true;
+                            // the other workers stop waiting for it at their barriers
+                            _control->barrier.abort();
+                            throw std::runtime_error("Worker process " + std::to_string(w) + (WIFSIGNALED(status)
+                                    ? " was killed by signal " + std::to_string(WTERMSIG(status))
+                                    : " exited with status " + std::to_string(WEXITSTATUS(status))));
+                        }
+                    }
+                }
+
+                void run_command(command c, std::vector<std::string>* received = nullptr) {
+                    if (_broken) {
+                        throw std::runtime_error("The multiprocess runner can not continue after a failure");
+                    }
+                    _control->done.store(0, std::memory_order_relaxed);
+                    _control->command.store(static_cast<int>(c), std::memory_order_relaxed);
+                    _control->sequence.fetch_add(1, std::memory_order_acq_rel);
+                    for (unsigned spins = 0; _control->done.load(std::memory_order_acquire) < _workers; spins++) {
+                        if (received != nullptr) {
+                            for (std::size_t w = 0; w < _workers; w++) {
+                                ring(w, _workers).read((*received)[w]);
+                            }
+                        }
+                        if (spins >= CADMIUM_SHM_SPIN_LIMIT) {
+                            check_workers();
+                            ::usleep(20);
+                        }
+                    }
+                    if (received != nullptr) {
+                        for (std::size_t w = 0; w < _workers; w++) {
+                            ring(w, _workers).read((*received)[w]);
+                        }
+                    }
+                    if (_control->failed.load(std::memory_order_acquire)) {
+                        _broken = true;
+                        throw std::runtime_error(std::string("Worker process failed: ") + _control->error);
+                    }
+                }
+
+                void start(std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> coupled_model, const std::vector<std::size_t>& worker_of_child, const TIME& init_time) {
+                    _model = std::make_unique<model_type>(coupled_model, worker_of_child, init_time);
+                    _workers = _model->parts();
+                    create_shared_memory();
+                    fork_workers();
+                }
+
+            public:
+                /**
+                 * @brief Splits the children of the top coupled model in contiguous blocks, one for each worker.
+                 * @param processes is the amount of worker processes.
+                 */
+                multiprocess_runner(std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> coupled_model, const TIME& init_time, std::size_t processes) {
+                    start(coupled_model, model_type::contiguous_parts(coupled_model->_models.size(), processes), init_time);
+                }
+
+                /**
+                 * @param worker_of_child is the worker process of each child of the top coupled model.
+                 */
+                multiprocess_runner(std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> coupled_model, const TIME& init_time, const std::vector<std::size_t>& worker_of_child) {
+                    start(coupled_model, worker_of_child, init_time);
+                }
+
+                multiprocess_runner(const multiprocess_runner&) = delete;
+                multiprocess_runner& operator=(const multiprocess_runner&) = delete;
+
+                ~multiprocess_runner() {
+                    if (_control != nullptr && !_pids.empty()) {
+                        _control->command.store(static_cast<int>(command::exit), std::memory_order_relaxed);
+                        _control->sequence.fetch_add(1, std::memory_order_acq_rel);
+                        for (pid_t pid : _pids) {
+                            if (pid > 0) {
+                                ::waitpid(pid, nullptr, 0);
+                            }
+                        }
+                    }
+                }
+
+                /**
+                 * @brief runUntil starts the simulation and stops when the next event is scheduled after t.
+                 * @param t is the limit time for the simulation.
+                 * @return the TIME of the next event to happen when simulation stopped.
+                 */
+                TIME run_until(const TIME& t) {
+                    LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::run_info>("Starting run");
+                    _control->until = t;
+                    run_command(command::run);
+                    LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::run_info>("Finished run");
+                    return *std::min_element(_next_of, _next_of + _workers);
+                }
+
+                /**
+                 * @brief runUntilPassivate starts the simulation and stops when there is no next internal event to happen.
+                 */
+                void run_until_passivate() {
+                    run_until(std::numeric_limits<TIME>::infinity());
+                }
+
+                std::size_t processes() const noexcept {
+                    return _workers;
+                }
+
+                /**
+                 * @return The state of each atomic model in the worker processes, as logged, in the order
+                 * of the flattened coupled model.
+                 */
+                std::vector<std::string> model_states() {
+                    std::vector<std::string> received(_workers);
+                    run_command(command::states, &received);
+                    std::vector<std::string> states(_model->models());
+                    for (const auto& bytes : received) {
+                        decode_partitioned_states(bytes, states);
+                    }
+                    return states;
+                }
+            };
+        }
+    }
+}
+
+#endif //CADMIUM_PDEVS_DYNAMIC_MULTIPROCESS_RUNNER_HPP
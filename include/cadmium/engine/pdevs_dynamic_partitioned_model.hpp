@@ -0,0 +1,266 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef CADMIUM_PDEVS_DYNAMIC_PARTITIONED_MODEL_HPP
+#define CADMIUM_PDEVS_DYNAMIC_PARTITIONED_MODEL_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cadmium/modeling/dynamic_coupled.hpp>
+#include <cadmium/modeling/dynamic_flattened_coupled.hpp>
+#include <cadmium/modeling/message_codec.hpp>
+#include <cadmium/engine/pdevs_dynamic_conservative_runner.hpp>
+
+namespace cadmium {
+    namespace dynamic {
+        namespace engine {
+
+            /**
+             * @brief Coupled model split in parts, each one simulating the atomic models of some children
+             * of the top coupled model, for the runners simulating each part in a different process.
+             *
+             * @details
+             * All the parts simulate each imminent time together. First each part collects the outputs
+             * of its imminent models and encodes the messages for other parts as records, then the
+             * runner exchanges the records and each part routes all the messages it receives in the
+             * order of the couplings and advances its models. A record is the index of the coupling in
+             * the flattened model and the size of the encoded messages, both as 64 bits integers,
+             * followed by the messages encoded by the link of the coupling.
+             *
+             * Every process builds the whole partitioned model, but only simulates its part.
+             */
+            template<typename TIME, typename LOGGER, template<typename> class FEL=binary_heap_fel>
+            class partitioned_model {
+                using process_type = logical_process<TIME, LOGGER, FEL>;
+
+                struct route_entry {
+                    std::size_t to_part;
+                    std::size_t to; // local index in to_part
+                    bound_route route;
+                };
+
+                // message routed on a step, data is null for the routes inside the part
+                struct delivery {
+                    std::size_t route;
+                    const char* data;
+                    std::size_t size;
+
+                    bool operator<(const delivery& other) const noexcept {
+                        return route < other.route;
+                    }
+                };
+
+                struct part {
+                    process_type process;
+                    std::vector<std::size_t> atomics; // flattened atomic indexes
+                    std::vector<std::vector<std::size_t>> routes_by_source; // by local index
+                    std::vector<delivery> deliveries;
+                    std::string record;
+                };
+
+                std::vector<std::shared_ptr<cadmium::dynamic::modeling::atomic_abstract<TIME>>> _models; // flattened atomic models
+                std::vector<route_entry> _routes;
+                std::vector<std::unique_ptr<part>> _parts;
+
+            public:
+                /**
+                 * @brief Assigns the children of the top coupled model to parts in contiguous blocks.
+                 */
+                static std::vector<std::size_t> contiguous_parts(std::size_t children, std::size_t parts) {
+                    parts = std::max<std::size_t>(1, std::min(parts, children));
+                    std::vector<std::size_t> part_of_child(children);
+                    for (std::size_t c = 0; c < children; c++) {
+                        part_of_child[c] = c * parts / children;
+                    }
+                    return part_of_child;
+                }
+
+                /**
+                 * @param part_of_child is the part of each child of the top coupled model.
+                 */
+                partitioned_model(std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> coupled_model, const std::vector<std::size_t>& part_of_child, const TIME& init_time) {
+                    if (part_of_child.size() != coupled_model->_models.size()) {
+                        throw std::domain_error("Every child of the coupled model must be assigned to a part");
+                    }
+                    std::size_t parts = part_of_child.empty() ? 1 : *std::max_element(part_of_child.begin(), part_of_child.end()) + 1;
+                    cadmium::dynamic::modeling::flattened_coupled<TIME> flat = cadmium::dynamic::modeling::flatten<TIME>(coupled_model);
+                    if (!flat.eic.empty() || !flat.eoc.empty()) {
+                        throw std::domain_error("Only coupled models without external couplings can be partitioned");
+                    }
+
+                    // the flattened atomic models keep the order of the children they belong to
+                    std::vector<std::size_t> part_of;
+                    for (std::size_t c = 0; c < part_of_child.size(); c++) {
+                        part_of.insert(part_of.end(), cadmium::dynamic::modeling::count_atomics<TIME>(coupled_model->_models[c]), part_of_child[c]);
+                    }
+
+                    for (std::size_t p = 0; p < parts; p++) {
+                        _parts.push_back(std::make_unique<part>());
+                    }
+                    std::vector<std::size_t> local(flat.atomics.size());
+                    for (std::size_t a = 0; a < flat.atomics.size(); a++) {
+                        auto m = std::dynamic_pointer_cast<cadmium::dynamic::modeling::atomic_abstract<TIME>>(flat.atomics[a]);
+                        if (m == nullptr) {
+                            throw std::domain_error("Only atomic models are supported in a partitioned model");
+                        }
+                        part& p = *_parts[part_of[a]];
+                        _models.push_back(m);
+                        local[a] = p.process.add_model(m);
+                        p.atomics.push_back(a);
+                        p.routes_by_source.emplace_back();
+                    }
+                    for (const auto& ic : flat.ic) {
+                        part& from = *_parts[part_of[ic.from]];
+                        part& to = *_parts[part_of[ic.to]];
+                        bound_route r{from.process.model(local[ic.from]).output_endpoint(ic.link->from_port_type_index()), to.process.model(local[ic.to]).input_endpoint(ic.link->to_port_type_index()), ic.link};
+                        _routes.push_back({part_of[ic.to], local[ic.to], r});
+                        from.routes_by_source[local[ic.from]].push_back(_routes.size() - 1);
+                    }
+                    LOGGER::template log<cadmium::logger::logger_global_time, cadmium::logger::run_global_time>(init_time);
+                    LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::run_info>("Preparing model");
+                    for (auto& p : _parts) {
+                        p->process.init(init_time);
+                    }
+                }
+
+                partitioned_model(const partitioned_model&) = delete;
+                partitioned_model& operator=(const partitioned_model&) = delete;
+
+                std::size_t parts() const noexcept {
+                    return _parts.size();
+                }
+
+                std::size_t models() const noexcept {
+                    return _models.size();
+                }
+
+                TIME next(std::size_t p) const {
+                    return _parts[p]->process.next();
+                }
+
+                /**
+                 * @brief Collects the outputs of the imminent models of the part at t and calls
+                 * send(to_part, record) with the record of each coupling to another part with messages.
+                 */
+                template<typename SEND>
+                void collect_outputs(std::size_t p, const TIME& t, SEND&& send) {
+                    part& pt = *_parts[p];
+                    pt.process.collect_outputs(t);
+                    pt.deliveries.clear();
+                    for (std::size_t i : pt.process.imminent()) {
+                        for (std::size_t r : pt.routes_by_source[i]) {
+                            const route_entry& e = _routes[r];
+                            if (e.to_part == p) {
+                                pt.deliveries.push_back({r, nullptr, 0});
+                            } else if (e.route.link->has_messages(e.route.from)) {
+                                pt.record.assign(2 * sizeof(std::uint64_t), '\0');
+                                e.route.link->encode_messages(e.route.from, pt.record);
+                                std::uint64_t header[2] = {r, pt.record.size() - 2 * sizeof(std::uint64_t)};
+                                std::memcpy(&pt.record[0], header, sizeof(header));
+                                send(e.to_part, static_cast<const std::string&>(pt.record));
+                            }
+                        }
+                    }
+                }
+
+                /**
+                 * @brief Routes the messages of the part and the records received from other parts, each
+                 * buffer holding whole records, and advances the models of the part to t.
+                 * collect_outputs(p, t, send) must be called before.
+                 */
+                template<typename BUFFERS>
+                void advance_simulation(std::size_t p, const TIME& t, const BUFFERS& received) {
+                    part& pt = *_parts[p];
+                    for (const std::string& bytes : received) {
+                        std::size_t offset = 0;
+                        while (offset < bytes.size()) {
+                            if (bytes.size() - offset < 2 * sizeof(std::uint64_t)) {
+                                throw std::domain_error("Truncated message record");
+                            }
+                            std::uint64_t header[2];
+                            std::memcpy(header, bytes.data() + offset, sizeof(header));
+                            offset += sizeof(header);
+                            if (header[0] >= _routes.size() || _routes[header[0]].to_part != p || bytes.size() - offset < header[1]) {
+                                throw std::domain_error("Invalid message record");
+                            }
+                            pt.deliveries.push_back({header[0], bytes.data() + offset, header[1]});
+                            offset += header[1];
+                        }
+                    }
+                    std::sort(pt.deliveries.begin(), pt.deliveries.end());
+                    for (const delivery& d : pt.deliveries) {
+                        const route_entry& e = _routes[d.route];
+                        if (d.data == nullptr) {
+                            route_link_messages<LOGGER>(*e.route.link, e.route.from, e.route.to);
+                        } else {
+                            e.route.link->decode_messages(d.data, d.size, e.route.to);
+                        }
+                        if (!pt.process.model(e.to).inbox_empty()) {
+                            pt.process.received(e.to);
+                        }
+                    }
+                    pt.deliveries.clear();
+                    pt.process.advance_models(t);
+                }
+
+                /**
+                 * @brief Encodes the state of the models of the part, as logged, with their flattened index.
+                 */
+                std::string encode_states(std::size_t p) const {
+                    std::string bytes;
+                    for (std::size_t a : _parts[p]->atomics) {
+                        cadmium::dynamic::message_codec<std::uint64_t>::encode(a, bytes);
+                        cadmium::dynamic::message_codec<std::string>::encode(_models[a]->model_state_as_string(), bytes);
+                    }
+                    return bytes;
+                }
+            };
+
+            /**
+             * @brief Stores in states, indexed by flattened index, the states encoded by partitioned_model::encode_states.
+             */
+            inline void decode_partitioned_states(const std::string& bytes, std::vector<std::string>& states) {
+                const char* data = bytes.data();
+                const char* end = data + bytes.size();
+                while (data < end) {
+                    std::uint64_t a = cadmium::dynamic::message_codec<std::uint64_t>::decode(data, end);
+                    if (a >= states.size()) {
+                        states.resize(a + 1);
+                    }
+                    states[a] = cadmium::dynamic::message_codec<std::string>::decode(data, end);
+                }
+            }
+        }
+    }
+}
+
+#endif //CADMIUM_PDEVS_DYNAMIC_PARTITIONED_MODEL_HPP
@@ -32,11 +32,22 @@
 
 #include <cadmium/engine/pdevs_dynamic_coordinator.hpp>
 #include<limits>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <stdexcept>
+#include <string>
 
 #ifdef CADMIUM_EXECUTE_CONCURRENT
-#include <boost/thread/executors/basic_thread_pool.hpp>
+#include <cadmium/engine/work_stealing_executor.hpp>
 #endif //CADMIUM_EXECUTE_CONCURRENT
 
+#ifdef CADMIUM_EXECUTE_TEAM
+#include <cadmium/engine/worker_team.hpp>
+#endif //CADMIUM_EXECUTE_TEAM
+
 //SET RT_DEVS and load load the correct clock
 #ifdef RT_ARM_MBED 
     #include <cadmium/real_time/arm_mbed/rt_clock.hpp>
@@ -71,30 +82,52 @@ namespace cadmium {
              * @param Model The model to be simulated
              * @param Time Representation of time to be used to run the simualtion
              * @param Logger what, where and how to log from the simulation
+             * @param FEL future event list policy used by the coordinators, see pdevs_dynamic_fel.hpp
              */
 
             //by default state changes get verbatim formatted and logged to cout
             template<typename TIME>
             using default_logger=cadmium::logger::logger<cadmium::logger::logger_state, cadmium::dynamic::logger::formatter<TIME>, cadmium::logger::cout_sink_provider>;
 
-            //TODO: migrate specialization FEL behavior from CDBoost. At this point, there is no parametrized FEL.
-            template<class TIME, typename LOGGER=default_logger<TIME>>
+            /**
+             * @brief Tag requesting the runner to flatten the coupled model hierarchy and simulate all
+             * the atomic models under a single coordinator, routing messages directly between them.
+             */
+            struct flatten_hierarchy_t {
+                explicit flatten_hierarchy_t() = default;
+            };
+
+            inline constexpr flatten_hierarchy_t flatten_hierarchy{};
+
+            template<class TIME, typename LOGGER=default_logger<TIME>, template<typename> class FEL=binary_heap_fel>
             class runner {
                 TIME _last;
                 TIME _next; //next scheduled event
 
                 bool progress_bar = false;
 
-                cadmium::dynamic::engine::coordinator<TIME, LOGGER> _top_coordinator; //this only works for coupled models.
+                cadmium::dynamic::engine::coordinator<TIME, LOGGER, FEL> _top_coordinator; //this only works for coupled models.
 
                 #ifdef CADMIUM_EXECUTE_CONCURRENT
-                boost::basic_thread_pool _threadpool;
+                cadmium::concurrency::work_stealing_executor _threadpool;
                 #endif //CADMIUM_EXECUTE_CONCURRENT
 
                 #ifdef CPU_PARALLEL
                 size_t _thread_number;
                 #endif//CPU_PARALLEL
 
+                #ifdef CADMIUM_EXECUTE_TEAM
+                cadmium::concurrency::worker_team _team;
+                #endif //CADMIUM_EXECUTE_TEAM
+
+                // checkpoint frames are written by a task while the simulation continues
+                std::ofstream _checkpoint_file;
+                std::size_t _checkpoint_interval = 0;
+                std::size_t _steps_since_checkpoint = 0;
+                std::future<void> _checkpoint_write;
+
+                enum : std::uint8_t { delta_frame = 0, full_frame = 1 };
+
             public:
                 //contructors
                 /**
@@ -103,7 +136,7 @@ namespace cadmium {
                  */
 
                 #ifdef CADMIUM_EXECUTE_CONCURRENT
-                explicit runner(std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> coupled_model, const TIME &init_time, unsigned const thread_count = boost::thread::hardware_concurrency())
+                explicit runner(std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> coupled_model, const TIME &init_time, unsigned const thread_count = std::thread::hardware_concurrency())
                 : _top_coordinator(coupled_model),
                 _threadpool(thread_count){
                     LOGGER::template log<cadmium::logger::logger_global_time, cadmium::logger::run_global_time>(init_time);
@@ -111,6 +144,28 @@ namespace cadmium {
                     _top_coordinator.init(init_time, &_threadpool);
                     _next = _top_coordinator.next();
                 }
+
+                explicit runner(std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> coupled_model, const TIME &init_time, flatten_hierarchy_t, unsigned const thread_count = std::thread::hardware_concurrency())
+                : _top_coordinator(cadmium::dynamic::modeling::flatten<TIME>(coupled_model)),
+                _threadpool(thread_count){
+                    LOGGER::template log<cadmium::logger::logger_global_time, cadmium::logger::run_global_time>(init_time);
+                    LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::run_info>("Preparing model");
+                    _top_coordinator.init(init_time, &_threadpool);
+                    _next = _top_coordinator.next();
+                }
+
+                /**
+                 * @brief Flattens the model hierarchy and groups the atomic models by part, see partition_atomics.
+                 * @param part_of is the part of each atomic model of the flattened hierarchy.
+                 */
+                explicit runner(std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> coupled_model, const TIME &init_time, const std::vector<std::size_t>& part_of, unsigned const thread_count = std::thread::hardware_concurrency())
+                : _top_coordinator(cadmium::dynamic::modeling::flatten<TIME>(coupled_model), part_of),
+                _threadpool(thread_count){
+                    LOGGER::template log<cadmium::logger::logger_global_time, cadmium::logger::run_global_time>(init_time);
+                    LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::run_info>("Preparing model");
+                    _top_coordinator.init(init_time, &_threadpool);
+                    _next = _top_coordinator.next();
+                }
                 #else
                     #if defined CPU_PARALLEL
                     explicit runner(std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> coupled_model, const TIME &init_time, unsigned const thread_number = std::thread::hardware_concurrency())
@@ -121,6 +176,62 @@ namespace cadmium {
                         _top_coordinator.init(init_time, _thread_number);
                         _next = _top_coordinator.next();
                     }
+
+                    explicit runner(std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> coupled_model, const TIME &init_time, flatten_hierarchy_t, unsigned const thread_number = std::thread::hardware_concurrency())
+                    : _top_coordinator(cadmium::dynamic::modeling::flatten<TIME>(coupled_model)){
+                        _thread_number = thread_number;
+                        LOGGER::template log<cadmium::logger::logger_global_time, cadmium::logger::run_global_time>(init_time);
+                        LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::run_info>("Preparing model");
+                        _top_coordinator.init(init_time, _thread_number);
+                        _next = _top_coordinator.next();
+                    }
+
+                    /**
+                     * @brief Flattens the model hierarchy and groups the atomic models by part, see partition_atomics.
+                     * @param part_of is the part of each atomic model of the flattened hierarchy.
+                     */
+                    explicit runner(std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> coupled_model, const TIME &init_time, const std::vector<std::size_t>& part_of, unsigned const thread_number = std::thread::hardware_concurrency())
+                    : _top_coordinator(cadmium::dynamic::modeling::flatten<TIME>(coupled_model), part_of){
+                        _thread_number = thread_number;
+                        LOGGER::template log<cadmium::logger::logger_global_time, cadmium::logger::run_global_time>(init_time);
+                        LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::run_info>("Preparing model");
+                        _top_coordinator.init(init_time, _thread_number);
+                        _next = _top_coordinator.next();
+                    }
+                    #elif defined CADMIUM_EXECUTE_TEAM
+                    explicit runner(std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> coupled_model, const TIME &init_time, unsigned const thread_count = std::thread::hardware_concurrency())
+                    : _top_coordinator(coupled_model),
+                    _team(thread_count){
+                        LOGGER::template log<cadmium::logger::logger_global_time, cadmium::logger::run_global_time>(init_time);
+                        LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::run_info>("Preparing model");
+                        _top_coordinator.set_rebalance_interval(CADMIUM_TEAM_REBALANCE_STEPS);
+                        _top_coordinator.init(init_time, &_team);
+                        _next = _top_coordinator.next();
+                    }
+
+                    explicit runner(std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> coupled_model, const TIME &init_time, flatten_hierarchy_t, unsigned const thread_count = std::thread::hardware_concurrency())
+                    : _top_coordinator(cadmium::dynamic::modeling::flatten<TIME>(coupled_model)),
+                    _team(thread_count){
+                        LOGGER::template log<cadmium::logger::logger_global_time, cadmium::logger::run_global_time>(init_time);
+                        LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::run_info>("Preparing model");
+                        _top_coordinator.set_rebalance_interval(CADMIUM_TEAM_REBALANCE_STEPS);
+                        _top_coordinator.init(init_time, &_team);
+                        _next = _top_coordinator.next();
+                    }
+
+                    /**
+                     * @brief Flattens the model hierarchy and groups the atomic models by part, see partition_atomics.
+                     * @param part_of is the part of each atomic model of the flattened hierarchy.
+                     */
+                    explicit runner(std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> coupled_model, const TIME &init_time, const std::vector<std::size_t>& part_of, unsigned const thread_count = std::thread::hardware_concurrency())
+                    : _top_coordinator(cadmium::dynamic::modeling::flatten<TIME>(coupled_model), part_of),
+                    _team(thread_count){
+                        LOGGER::template log<cadmium::logger::logger_global_time, cadmium::logger::run_global_time>(init_time);
+                        LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::run_info>("Preparing model");
+                        _top_coordinator.set_rebalance_interval(CADMIUM_TEAM_REBALANCE_STEPS);
+                        _top_coordinator.init(init_time, &_team);
+                        _next = _top_coordinator.next();
+                    }
                     #else
                     explicit runner(std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> coupled_model, const TIME &init_time)
                     : _top_coordinator(coupled_model){
@@ -129,6 +240,26 @@ namespace cadmium {
                         _top_coordinator.init(init_time);
                         _next = _top_coordinator.next();
                     }
+
+                    explicit runner(std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> coupled_model, const TIME &init_time, flatten_hierarchy_t)
+                    : _top_coordinator(cadmium::dynamic::modeling::flatten<TIME>(coupled_model)){
+                        LOGGER::template log<cadmium::logger::logger_global_time, cadmium::logger::run_global_time>(init_time);
+                        LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::run_info>("Preparing model");
+                        _top_coordinator.init(init_time);
+                        _next = _top_coordinator.next();
+                    }
+
+                    /**
+                     * @brief Flattens the model hierarchy and groups the atomic models by part, see partition_atomics.
+                     * @param part_of is the part of each atomic model of the flattened hierarchy.
+                     */
+                    explicit runner(std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> coupled_model, const TIME &init_time, const std::vector<std::size_t>& part_of)
+                    : _top_coordinator(cadmium::dynamic::modeling::flatten<TIME>(coupled_model), part_of){
+                        LOGGER::template log<cadmium::logger::logger_global_time, cadmium::logger::run_global_time>(init_time);
+                        LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::run_info>("Preparing model");
+                        _top_coordinator.init(init_time);
+                        _next = _top_coordinator.next();
+                    }
                     #endif //CPU_PARALLEL
                 #endif //CADMIUM_EXECUTE_CONCURRENT
 
@@ -161,8 +292,7 @@ namespace cadmium {
                                 }
                             }
                             LOGGER::template log<cadmium::logger::logger_global_time, cadmium::logger::run_global_time>(_last);
-                            _top_coordinator.collect_outputs(_last);
-                            _top_coordinator.advance_simulation(_last);
+                            _top_coordinator.step(_last);
                             _next = _top_coordinator.next();
                             if(serviceInterrupts) {
                                 serviceInterrupts = false;
@@ -175,15 +305,23 @@ namespace cadmium {
                 #else
                     TIME run_until(const TIME &t) {
                     LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::run_info>("Starting run");
+                    #ifdef CADMIUM_EXECUTE_TEAM
+                    // workers wait for the phases of each step busy, instead of sleeping
+                    cadmium::concurrency::worker_team::active_scope active_team(_team);
+                    #endif //CADMIUM_EXECUTE_TEAM
                     while (_next < t) {
                         LOGGER::template log<cadmium::logger::logger_global_time, cadmium::logger::run_global_time>(_next);
-                        _top_coordinator.collect_outputs(_next);
-                        _top_coordinator.advance_simulation(_next);
+                        _top_coordinator.step(_next);
                         _next = _top_coordinator.next();
 
+                        if (_checkpoint_interval > 0 && ++_steps_since_checkpoint >= _checkpoint_interval) {
+                            write_checkpoint(delta_frame);
+                        }
+
                         if (progress_bar)
                             progress_bar_meter(_next, t);
                     }
+                    wait_checkpoint_write();
 
                     turn_progress_off();
                     LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::run_info>("Finished run");
@@ -199,6 +337,124 @@ namespace cadmium {
                     run_until(std::numeric_limits<TIME>::infinity());
                 }
 
+                /**
+                 * @brief Writes checkpoints of the simulation to the file at path, replacing it: the whole
+                 * simulation now, and every given amount of steps of run_until the models advanced since the
+                 * previous checkpoint. Each frame is the size of the rest of the frame as a 64 bits integer,
+                 * a byte telling if it is full or a delta and the states encoded by the coordinators. Frames
+                 * are encoded between steps and written while the simulation continues.
+                 * @param steps between checkpoints, 0 only writes the full one.
+                 * @note Models must support encoding their state, see cadmium::dynamic::state_codec.
+                 */
+                void checkpoint_every(const std::string& path, std::size_t steps) {
+                    wait_checkpoint_write();
+                    _checkpoint_file = std::ofstream(path, std::ios::binary | std::ios::trunc);
+                    if (!_checkpoint_file) {
+                        throw std::runtime_error("Unable to open the checkpoint file " + path);
+                    }
+                    _checkpoint_interval = steps;
+                    write_checkpoint(full_frame);
+                    wait_checkpoint_write();
+                }
+
+                /**
+                 * @brief Writes a checkpoint with the models advanced since the previous one, to the file
+                 * set by checkpoint_every, and waits until it is written.
+                 */
+                void checkpoint() {
+                    if (!_checkpoint_file.is_open()) {
+                        throw std::domain_error("No checkpoint file was set, see checkpoint_every");
+                    }
+                    write_checkpoint(delta_frame);
+                    wait_checkpoint_write();
+                }
+
+                /**
+                 * @brief Restores the simulation from a file written by checkpoint_every, for a runner built
+                 * with the same model. The last frame is ignored if it was not completely written.
+                 * @return the TIME of the next event to happen after the last checkpoint.
+                 */
+                TIME restore_checkpoint(const std::string& path) {
+                    std::ifstream file(path, std::ios::binary);
+                    if (!file) {
+                        throw std::runtime_error("Unable to open the checkpoint file " + path);
+                    }
+                    std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+                    const char* data = bytes.data();
+                    const char* end = data + bytes.size();
+                    bool restored = false;
+                    while (static_cast<std::size_t>(end - data) >= sizeof(std::uint64_t)) {
+                        const char* header = data;
+                        std::uint64_t size = cadmium::dynamic::message_codec<std::uint64_t>::decode(header, end);
+                        if (size == 0 || static_cast<std::uint64_t>(end - header) < size) {
+                            break;
+                        }
+                        const char* frame_end = header + size;
+                        bool full = cadmium::dynamic::message_codec<std::uint8_t>::decode(header, frame_end) == full_frame;
+                        if (!full && !restored) {
+                            throw std::domain_error("The checkpoint file does not start with a full checkpoint");
+                        }
+                        _top_coordinator.load_checkpoint(header, frame_end, full);
+                        if (header != frame_end) {
+                            throw std::domain_error("The checkpoint does not match the model");
+                        }
+                        restored = true;
+                        data = frame_end;
+                    }
+                    if (!restored) {
+                        throw std::domain_error("The checkpoint file has no complete checkpoint");
+                    }
+                    _next = _top_coordinator.next();
+                    #if defined CADMIUM_EXECUTE_TEAM && CADMIUM_TEAM_FIRST_TOUCH
+                    _top_coordinator.place_models();
+                    #endif
+                    return _next;
+                }
+
+                #ifdef CADMIUM_EXECUTE_TEAM
+                /**
+                 * @brief Rebalances the models owned by each thread of the team every given amount of
+                 * steps, 0 keeps them fixed. Defaults to CADMIUM_TEAM_REBALANCE_STEPS.
+                 */
+                void set_rebalance_interval(std::size_t steps) noexcept {
+                    _top_coordinator.set_rebalance_interval(steps);
+                }
+
+                /**
+                 * @brief Time each thread of the team was busy running its models, in microseconds.
+                 */
+                const std::vector<double>& busy_times() const noexcept {
+                    return _top_coordinator.busy_times();
+                }
+
+                /**
+                 * @brief Amount of models moved to another thread by rebalances.
+                 */
+                std::size_t migrations() const noexcept {
+                    return _top_coordinator.migrations();
+                }
+
+                /**
+                 * @brief Relocates the models run by each thread of the team from that thread, placing
+                 * them on its NUMA node. The runner does it on construction unless
+                 * CADMIUM_TEAM_FIRST_TOUCH is 0.
+                 */
+                void place_models() {
+                    _top_coordinator.place_models();
+                }
+
+                /**
+                 * @brief NUMA node of each thread of the team, the last one is the thread calling run_until.
+                 */
+                std::vector<std::size_t> thread_nodes() const {
+                    std::vector<std::size_t> nodes;
+                    for (std::size_t p = 0; p < _team.size(); p++) {
+                        nodes.push_back(_team.node_of(p));
+                    }
+                    return nodes;
+                }
+                #endif //CADMIUM_EXECUTE_TEAM
+
                 /**
                  * @brief Displays current progress of simulation
                  *  e.g., [50/500]
@@ -218,8 +474,39 @@ namespace cadmium {
                     std::cout << std::flush;
                 }
 
+                ~runner() {
+                    if (_checkpoint_write.valid()) {
+                        _checkpoint_write.wait();
+                    }
+                }
+
                 void turn_progress_on()  { progress_bar = true;  std::cout << "\033[33m" << std::flush;  }
                 void turn_progress_off() { progress_bar = false; std::cout << "\033[0m"  << std::flush;  }
+
+            private:
+                // encodes a frame and writes it once the previous one was written
+                void write_checkpoint(std::uint8_t kind) {
+                    std::string frame(sizeof(std::uint64_t), '\0');
+                    cadmium::dynamic::message_codec<std::uint8_t>::encode(kind, frame);
+                    _top_coordinator.save_checkpoint(frame, kind == full_frame);
+                    std::uint64_t size = frame.size() - sizeof(std::uint64_t);
+                    std::memcpy(&frame[0], &size, sizeof(size));
+                    _steps_since_checkpoint = 0;
+                    wait_checkpoint_write();
+                    _checkpoint_write = std::async(std::launch::async, [this, frame = std::move(frame)]() {
+                        _checkpoint_file.write(frame.data(), frame.size());
+                        _checkpoint_file.flush();
+                        if (!_checkpoint_file) {
+                            throw std::runtime_error("Unable to write the checkpoint file");
+                        }
+                    });
+                }
+
+                void wait_checkpoint_write() {
+                    if (_checkpoint_write.valid()) {
+                        _checkpoint_write.get();
+                    }
+                }
             };
         }
     }
@@ -27,8 +27,11 @@
 #ifndef CADMIUM_PDEVS_DYNAMIC_SIMULATOR_HPP
 #define CADMIUM_PDEVS_DYNAMIC_SIMULATOR_HPP
 
+#include <algorithm>
+#include <iterator>
 #include <cadmium/modeling/dynamic_model.hpp>
 #include <cadmium/modeling/dynamic_message_bag.hpp>
+#include <cadmium/modeling/state_codec.hpp>
 #include <cadmium/engine/pdevs_dynamic_engine.hpp>
 #include <cadmium/logger/dynamic_common_loggers.hpp>
 #include <cadmium/logger/common_loggers.hpp>
@@ -49,18 +52,39 @@ namespace cadmium {
                 using model_type=typename cadmium::dynamic::modeling::atomic_abstract<TIME>;
 
                 std::shared_ptr<cadmium::dynamic::modeling::atomic_abstract<TIME>> _model;
+                cadmium::dynamic::modeling::Ports _input_ports;
+                cadmium::dynamic::modeling::Ports _output_ports;
                 TIME _last;
                 TIME _next;
+                // the model output is translated to _outbox only if it is requested
+                bool _outbox_pending = false;
+
+                static std::size_t port_index(const cadmium::dynamic::modeling::Ports& ports, std::type_index port) {
+                    auto it = std::find(ports.cbegin(), ports.cend(), port);
+                    if (it == ports.cend()) {
+                        throw std::domain_error("The port is not defined in the model");
+                    }
+                    return std::distance(ports.cbegin(), it);
+                }
 
             public:
 
                 cadmium::dynamic::message_bags _outbox;
                 cadmium::dynamic::message_bags _inbox;
 
+                /**
+                 * @brief State of the simulator and its model between two steps, see save_state.
+                 */
+                struct saved_state {
+                    boost::any model_state;
+                    TIME last;
+                    TIME next;
+                };
+
                 simulator() = delete;
 
                 simulator(std::shared_ptr<cadmium::dynamic::modeling::atomic_abstract<TIME>> model)
-                : _model(model) {}
+                : _model(model), _input_ports(model->get_input_ports()), _output_ports(model->get_output_ports()) {}
 
                 /**
                  * @brief sets the last and next times according to the initial_time parameter.
@@ -73,11 +97,13 @@ namespace cadmium {
                     _last = initial_time;
                     _next = initial_time + _model->time_advance();
 
-                    LOGGER::template log<cadmium::logger::logger_state, cadmium::logger::sim_state>(initial_time, _model->get_id(), _model->model_state_as_string());
+                    if constexpr (cadmium::logger::logs_source_v<LOGGER, cadmium::logger::logger_state>) {
+                        LOGGER::template log<cadmium::logger::logger_state, cadmium::logger::sim_state>(initial_time, _model->get_id(), _model->model_state_as_string());
+                    }
                 }
 
                 #ifdef CADMIUM_EXECUTE_CONCURRENT
-                void init(TIME initial_time, boost::basic_thread_pool* threadpool) override {
+                void init(TIME initial_time, cadmium::concurrency::work_stealing_executor* threadpool) override {
                     this->init(initial_time);
                 }
                 #endif //CADMIUM_EXECUTE_CONCURRENT
@@ -88,6 +114,12 @@ namespace cadmium {
                 }
                 #endif //CPU_PARALLEL
 
+                #ifdef CADMIUM_EXECUTE_TEAM
+                void init(TIME initial_time, cadmium::concurrency::worker_team* team) override {
+                    this->init(initial_time);
+                }
+                #endif //CADMIUM_EXECUTE_TEAM
+
                 std::string get_model_id() const override {
                     return _model->get_id();
                 }
@@ -97,19 +129,27 @@ namespace cadmium {
                 }
 
                 void collect_outputs(const TIME &t) override {
-                    LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::sim_info_collect>(t, _model->get_id());
+                    // the model id is a copy, it is only built when it is logged
+                    if constexpr (cadmium::logger::logs_source_v<LOGGER, cadmium::logger::logger_info>) {
+                        LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::sim_info_collect>(t, _model->get_id());
+                    }
 
                     // Cleaning the inbox and producing outbox
-                    _inbox = cadmium::dynamic::message_bags();
+                    _inbox.clear();
+                    _model->clear_inbox();
+                    _outbox.clear();
 
                     if (_next < t) {
                         throw std::domain_error("Trying to obtain output in a higher time than the next scheduled internal event");
                     } else if (_next == t) {
-                        _outbox = _model->output();
-                        std::string messages_by_port = _model->messages_by_port_as_string(_outbox);
-                        LOGGER::template log<cadmium::logger::logger_messages, cadmium::logger::sim_messages_collect>(t, _model->get_id(), messages_by_port);
+                        _model->collect_output();
+                        _outbox_pending = true;
+                        if constexpr (cadmium::logger::logs_source_v<LOGGER, cadmium::logger::logger_messages>) {
+                            LOGGER::template log<cadmium::logger::logger_messages, cadmium::logger::sim_messages_collect>(t, _model->get_id(), _model->outbox_as_string());
+                        }
                     } else {
-                        _outbox = cadmium::dynamic::message_bags();
+                        _model->clear_outbox();
+                        _outbox_pending = false;
                     }
 
                 }
@@ -118,6 +158,10 @@ namespace cadmium {
                  * @brief outbox keeps the output generated by the last call to collect_outputs
                  */
                 cadmium::dynamic::message_bags& outbox() override {
+                    if (_outbox_pending) {
+                        _outbox = _model->outbox_as_map();
+                        _outbox_pending = false;
+                    }
                     return _outbox;
                 }
 
@@ -129,32 +173,108 @@ namespace cadmium {
                     return _inbox;
                 }
 
+                /**
+                 * @brief input messages are routed directly to the model typed inbox.
+                 */
+                cadmium::dynamic::port_endpoint input_endpoint(std::type_index port) override {
+                    return cadmium::dynamic::port_endpoint{_model->input_slot(port_index(_input_ports, port)), &_inbox};
+                }
+
+                /**
+                 * @brief output messages are routed directly from the model typed outbox.
+                 */
+                cadmium::dynamic::port_endpoint output_endpoint(std::type_index port) override {
+                    return cadmium::dynamic::port_endpoint{_model->output_slot(port_index(_output_ports, port)), &_outbox};
+                }
+
+                /**
+                 * @brief Copies the model state and the last and next times, to return to them later.
+                 * @note Only valid between steps, when the inbox and outbox are not in use.
+                 */
+                saved_state save_state() const {
+                    return saved_state{_model->save_state(), _last, _next};
+                }
+
+                void restore_state(const saved_state& saved) {
+                    _model->restore_state(saved.model_state);
+                    _last = saved.last;
+                    _next = saved.next;
+                }
+
+                /**
+                 * @brief Encodes the last and next times and the model state, see
+                 * cadmium::dynamic::modeling::atomic_abstract::encode_state.
+                 * @note Only valid between steps, when the inbox and outbox are empty.
+                 */
+                void save_checkpoint(std::string& out, bool full) override {
+                    if constexpr (cadmium::dynamic::state_codec<TIME>::defined) {
+                        if (!this->inbox_empty()) {
+                            throw std::domain_error("Checkpoints are only taken between steps");
+                        }
+                        cadmium::dynamic::state_codec<TIME>::encode(_last, out);
+                        cadmium::dynamic::state_codec<TIME>::encode(_next, out);
+                        _model->encode_state(out);
+                    } else {
+                        engine<TIME>::save_checkpoint(out, full);
+                    }
+                }
+
+                void load_checkpoint(const char*& data, const char* end, bool full) override {
+                    if constexpr (cadmium::dynamic::state_codec<TIME>::defined) {
+                        cadmium::dynamic::state_codec<TIME>::decode(_last, data, end);
+                        cadmium::dynamic::state_codec<TIME>::decode(_next, data, end);
+                        _model->decode_state(data, end);
+                        _inbox.clear();
+                        _model->clear_inbox();
+                        _outbox.clear();
+                        _outbox_pending = false;
+                        _model->clear_outbox();
+                    } else {
+                        engine<TIME>::load_checkpoint(data, end, full);
+                    }
+                }
+
+                bool inbox_empty() override {
+                    return _inbox.empty() && _model->inbox_empty();
+                }
+
                 /**
                  * @brief advanceSimulation advances the execution to t, at t introduces the messages into the system (if any).
                  * @param t is the time the transition is expected to be run.
                 */
                 void advance_simulation(const TIME &t) override {
                     //clean outbox because messages are routed before calling this function at a higher level
-                    _outbox = cadmium::dynamic::message_bags();
+                    _outbox.clear();
+                    _outbox_pending = false;
+                    _model->clear_outbox();
 
-                    LOGGER::template log<cadmium::logger::logger_info,cadmium::logger::sim_info_advance>(_last, t, _model->get_id());
-                    LOGGER::template log<cadmium::logger::logger_local_time,cadmium::logger::sim_local_time>(_last, t, _model->get_id());
+                    if constexpr (cadmium::logger::logs_source_v<LOGGER, cadmium::logger::logger_info>) {
+                        LOGGER::template log<cadmium::logger::logger_info,cadmium::logger::sim_info_advance>(_last, t, _model->get_id());
+                    }
+                    if constexpr (cadmium::logger::logs_source_v<LOGGER, cadmium::logger::logger_local_time>) {
+                        LOGGER::template log<cadmium::logger::logger_local_time,cadmium::logger::sim_local_time>(_last, t, _model->get_id());
+                    }
 
                     if (t < _last) {
                         throw std::domain_error("Event received for executing in the past of current simulation time");
                     } else if (_next < t) {
                         throw std::domain_error("Event received for executing after next internal event");
                     } else {
-                        if (!_inbox.empty()) { //input available
+                        if (!this->inbox_empty()) { //input available
+                            // messages routed by port type are merged with the ones routed to the typed inbox
+                            if (!_inbox.empty()) {
+                                _model->add_to_inbox(_inbox);
+                            }
                             if (t == _next) { //confluence
-                                _model->confluence_transition(t - _last, _inbox);
+                                _model->confluence_transition_from_inbox(t - _last);
                             } else { //external
-                                _model->external_transition(t - _last, _inbox);
+                                _model->external_transition_from_inbox(t - _last);
                             }
                             _last = t;
                             _next = _last + _model->time_advance();
                             //clean inbox because they were processed already
-                            _inbox = cadmium::dynamic::message_bags();
+                            _inbox.clear();
+                            _model->clear_inbox();
                         } else { //no input available
                             if (t != _next) {
                                 //throw std::domain_error("Trying to execute internal transition at wrong time");
@@ -169,7 +289,13 @@ namespace cadmium {
                         }
                     }
 
-                    LOGGER::template log<cadmium::logger::logger_state,cadmium::logger::sim_state>(t, _model->get_id(), _model->model_state_as_string());
+                    if constexpr (cadmium::logger::logs_source_v<LOGGER, cadmium::logger::logger_state>) {
+                        LOGGER::template log<cadmium::logger::logger_state,cadmium::logger::sim_state>(t, _model->get_id(), _model->model_state_as_string());
+                    }
+                }
+
+                void relocate() override {
+                    _model->relocate();
                 }
             };
         }
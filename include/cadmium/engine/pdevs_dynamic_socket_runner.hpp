@@ -0,0 +1,432 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef CADMIUM_PDEVS_DYNAMIC_SOCKET_RUNNER_HPP
+#define CADMIUM_PDEVS_DYNAMIC_SOCKET_RUNNER_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cadmium/modeling/message_codec.hpp>
+#include <cadmium/engine/pdevs_dynamic_partitioned_model.hpp>
+#include <cadmium/engine/socket_channels.hpp>
+
+namespace cadmium {
+    namespace dynamic {
+        namespace engine {
+
+            /**
+             * @brief Frames of the protocol between the socket coordinator and its nodes, the first
+             * byte of each frame is its kind.
+             *
+             * @details
+             * - hello, node to coordinator: node index, number of parts and models, and next time.
+             * - collect, coordinator to node: time to collect the outputs of the imminent models.
+             * - outputs, node to coordinator: for each destination node with messages, its index, the
+             *   size of its records and the records, as built by partitioned_model::collect_outputs.
+             * - advance, coordinator to node: time to advance and the records sent to the node.
+             * - next, node to coordinator: next time of the node after advancing.
+             * - states, both ways: request and answer with partitioned_model::encode_states.
+             * - exit, coordinator to node: ends the node.
+             * - error, node to coordinator: message of the exception that stopped the node.
+             *
+             * Integers are 64 bits and times are encoded with message_codec<TIME>, in the byte order
+             * of the machines, so all the nodes must share their architecture.
+             */
+            enum class socket_frame : std::uint8_t {
+                hello, collect, outputs, advance, next, states, exit, error
+            };
+
+            namespace socket_protocol {
+                inline std::string& start_frame(std::string& bytes, socket_frame kind) {
+                    bytes.assign(1, static_cast<char>(kind));
+                    return bytes;
+                }
+
+                inline socket_frame frame_kind(const std::string& bytes) {
+                    if (bytes.empty() || static_cast<std::uint8_t>(bytes[0]) > static_cast<std::uint8_t>(socket_frame::error)) {
+                        throw std::domain_error("Invalid frame");
+                    }
+                    return static_cast<socket_frame>(bytes[0]);
+                }
+            }
+
+            /**
+             * @brief Process simulating a part of a coupled model for a socket_coordinator.
+             *
+             * @details
+             * Every node, and the coordinator, build the same coupled model and assignment of its
+             * top level children to parts, and node i simulates the part i, as in the
+             * partitioned_model. The node connects to the coordinator on construction and serve
+             * answers its requests until it sends exit.
+             *
+             * @param TIME Representation of time to be used to run the simulation, with a message_codec
+             * @param LOGGER what, where and how to log from the simulation of this node
+             * @param FEL future event list policy used by the node, see pdevs_dynamic_fel.hpp
+             */
+            template<class TIME, typename LOGGER=default_logger<TIME>, template<typename> class FEL=binary_heap_fel>
+            class socket_node {
+                static_assert(cadmium::dynamic::message_codec<TIME>::defined, "The socket runner sends TIME values through sockets");
+
+                using model_type = partitioned_model<TIME, LOGGER, FEL>;
+                using codec = cadmium::dynamic::message_codec<TIME>;
+
+                model_type _model;
+                std::size_t _me;
+                cadmium::concurrency::socket_connection _coordinator;
+                std::vector<std::string> _outputs; // records for each node
+                std::vector<std::string> _received{1};
+                TIME _collected;
+                bool _has_collected = false;
+
+                void collect(const TIME& t) {
+                    for (auto& records : _outputs) {
+                        records.clear();
+                    }
+                    _model.collect_outputs(_me, t, [this](std::size_t to, const std::string& record) { _outputs[to] += record; });
+                    _collected = t;
+                    _has_collected = true;
+                }
+
+                void answer(std::string& frame) {
+                    const char* data = frame.data() + 1;
+                    const char* end = frame.data() + frame.size();
+                    switch (socket_protocol::frame_kind(frame)) {
+                        case socket_frame::collect: {
+                            collect(codec::decode(data, end));
+                            socket_protocol::start_frame(frame, socket_frame::outputs);
+                            for (std::size_t n = 0; n < _outputs.size(); n++) {
+                                if (!_outputs[n].empty()) {
+                                    cadmium::dynamic::message_codec<std::uint64_t>::encode(n, frame);
+                                    cadmium::dynamic::message_codec<std::uint64_t>::encode(_outputs[n].size(), frame);
+                                    frame += _outputs[n];
+                                }
+                            }
+                            break;
+                        }
+                        case socket_frame::advance: {
+                            TIME t = codec::decode(data, end);
+                            // nodes without imminent models only learn the time when receiving messages
+                            if (!_has_collected || _collected != t) {
+                                collect(t);
+                            }
+                            _received[0].assign(data, end);
+                            _model.advance_simulation(_me, t, _received);
+                            _has_collected = false;
+                            socket_protocol::start_frame(frame, socket_frame::next);
+                            codec::encode(_model.next(_me), frame);
+                            break;
+                        }
+                        case socket_frame::states:
+                            socket_protocol::start_frame(frame, socket_frame::states) += _model.encode_states(_me);
+                            break;
+                        default:
+                            throw std::domain_error("Unexpected frame received by a node");
+                    }
+                }
+
+            public:
+                /**
+                 * @param part_of_child is the part of each child of the top coupled model, there must be a node for each part.
+                 * @param node is the part simulated by this node.
+                 * @param coordinator is the address the socket_coordinator listens on.
+                 */
+                socket_node(std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> coupled_model, const TIME& init_time,
+                            const std::vector<std::size_t>& part_of_child, std::size_t node, const cadmium::concurrency::socket_address& coordinator)
+                        : _model(coupled_model, part_of_child, init_time), _me(node) {
+                    if (node >= _model.parts()) {
+                        throw std::domain_error("There is no part for node " + std::to_string(node));
+                    }
+                    _outputs.resize(_model.parts());
+                    _coordinator = cadmium::concurrency::socket_connection::connect(coordinator);
+                    std::string frame;
+                    socket_protocol::start_frame(frame, socket_frame::hello);
+                    cadmium::dynamic::message_codec<std::uint64_t>::encode(_me, frame);
+                    cadmium::dynamic::message_codec<std::uint64_t>::encode(_model.parts(), frame);
+                    cadmium::dynamic::message_codec<std::uint64_t>::encode(_model.models(), frame);
+                    codec::encode(_model.next(_me), frame);
+                    _coordinator.send_frame(frame);
+                }
+
+                socket_node(const socket_node&) = delete;
+                socket_node& operator=(const socket_node&) = delete;
+
+                /**
+                 * @brief Simulates the part as requested by the coordinator, until it sends exit. Errors are
+                 * reported to the coordinator before being thrown.
+                 */
+                void serve() {
+                    std::string frame;
+                    for (;;) {
+                        _coordinator.receive_frame(frame);
+                        if (socket_protocol::frame_kind(frame) == socket_frame::exit) {
+                            return;
+                        }
+                        try {
+                            answer(frame);
+                        } catch (const std::exception& e) {
+                            socket_protocol::start_frame(frame, socket_frame::error) += e.what();
+                            _coordinator.send_frame(frame);
+                            throw;
+                        }
+                        _coordinator.send_frame(frame);
+                    }
+                }
+
+                std::size_t node() const noexcept {
+                    return _me;
+                }
+            };
+
+            /**
+             * @brief Coordinator of a simulation distributed among socket_node processes, connected to
+             * it with TCP or Unix domain sockets.
+             *
+             * @details
+             * The coordinator drives the nodes through each imminent time: it asks the imminent nodes
+             * to collect their outputs, gathers the messages for other nodes, batched per step in one
+             * frame for each node, then asks the imminent nodes and the ones receiving messages to
+             * advance, forwarding the messages to them, and gathers their next times. The nodes only
+             * talk with the coordinator, and the messages are encoded by the links of the couplings,
+             * with cadmium::dynamic::message_codec.
+             *
+             * Nodes may start before or after the coordinator, they retry to connect until the
+             * coordinator listens, and they are accepted by the first run.
+             *
+             * @param TIME Representation of time to be used to run the simulation, with a message_codec
+             */
+            template<class TIME>
+            class socket_coordinator {
+                static_assert(cadmium::dynamic::message_codec<TIME>::defined, "The socket runner sends TIME values through sockets");
+
+                using codec = cadmium::dynamic::message_codec<TIME>;
+
+                cadmium::concurrency::socket_listener _listener;
+                std::vector<cadmium::concurrency::socket_connection> _nodes;
+                std::vector<TIME> _next_of;
+                std::size_t _models = 0;
+                bool _broken = false;
+                std::size_t _steps = 0;
+
+                std::string _frame;
+                std::vector<std::string> _inbound; // records for each node on a step
+                std::vector<std::size_t> _involved;
+
+                void receive(std::size_t node, socket_frame expected) {
+                    _nodes[node].receive_frame(_frame);
+                    socket_frame kind = socket_protocol::frame_kind(_frame);
+                    if (kind == socket_frame::error) {
+                        _broken = true;
+                        throw std::runtime_error("Node " + std::to_string(node) + " failed: " + _frame.substr(1));
+                    }
+                    if (kind != expected) {
+                        _broken = true;
+                        throw std::domain_error("Unexpected frame received from node " + std::to_string(node));
+                    }
+                }
+
+                void check_usable() const {
+                    if (_broken) {
+                        throw std::runtime_error("The socket coordinator can not continue after a failure");
+                    }
+                }
+
+                void step(const TIME& t) {
+                    _involved.clear();
+                    socket_protocol::start_frame(_frame, socket_frame::collect);
+                    codec::encode(t, _frame);
+                    for (std::size_t n = 0; n < _nodes.size(); n++) {
+                        if (_next_of[n] == t) {
+                            _nodes[n].send_frame(_frame);
+                            _involved.push_back(n);
+                        }
+                    }
+                    std::size_t imminent = _involved.size();
+                    for (std::size_t i = 0; i < imminent; i++) {
+                        receive(_involved[i], socket_frame::outputs);
+                        const char* data = _frame.data() + 1;
+                        const char* end = _frame.data() + _frame.size();
+                        while (data < end) {
+                            std::uint64_t to = cadmium::dynamic::message_codec<std::uint64_t>::decode(data, end);
+                            std::uint64_t size = cadmium::dynamic::message_codec<std::uint64_t>::decode(data, end);
+                            if (to >= _nodes.size() || static_cast<std::size_t>(end - data) < size) {
+                                _broken = true;
+                                throw std::domain_error("Invalid outputs received from node " + std::to_string(_involved[i]));
+                            }
+                            if (_next_of[to] != t && _inbound[to].empty()) {
+                                _involved.push_back(to);
+                            }
+                            _inbound[to].append(data, size);
+                            data += size;
+                        }
+                    }
+                    for (std::size_t n : _involved) {
+                        socket_protocol::start_frame(_frame, socket_frame::advance);
+                        codec::encode(t, _frame);
+                        _frame += _inbound[n];
+                        _inbound[n].clear();
+                        _nodes[n].send_frame(_frame);
+                    }
+                    for (std::size_t n : _involved) {
+                        receive(n, socket_frame::next);
+                        const char* data = _frame.data() + 1;
+                        _next_of[n] = codec::decode(data, _frame.data() + _frame.size());
+                    }
+                    _steps++;
+                }
+
+            public:
+                /**
+                 * @param address to listen on for the nodes, port 0 chooses a free port, see address().
+                 * @param nodes is the amount of nodes, one for each part of the model.
+                 */
+                socket_coordinator(const cadmium::concurrency::socket_address& address, std::size_t nodes)
+                        : _listener(address), _next_of(nodes, std::numeric_limits<TIME>::infinity()), _inbound(nodes) {
+                    if (nodes == 0) {
+                        throw std::domain_error("The socket coordinator needs at least one node");
+                    }
+                }
+
+                socket_coordinator(const socket_coordinator&) = delete;
+                socket_coordinator& operator=(const socket_coordinator&) = delete;
+
+                ~socket_coordinator() {
+                    std::string frame;
+                    socket_protocol::start_frame(frame, socket_frame::exit);
+                    for (auto& node : _nodes) {
+                        try {
+                            if (node.is_open()) {
+                                node.send_frame(frame);
+                            }
+                        } catch (const std::exception&) {
+                            // the node is already gone
+                        }
+                    }
+                }
+
+                const cadmium::concurrency::socket_address& address() const noexcept {
+                    return _listener.address();
+                }
+
+                /**
+                 * @brief Waits for every node to connect, called by the first run if not called before.
+                 */
+                void accept_nodes() {
+                    if (!_nodes.empty()) {
+                        return;
+                    }
+                    // every node is accepted before checking them, so all of them learn about a mismatch
+                    std::vector<cadmium::concurrency::socket_connection> connections;
+                    std::vector<std::string> hellos(_next_of.size());
+                    for (auto& hello : hellos) {
+                        connections.push_back(_listener.accept());
+                        connections.back().receive_frame(hello);
+                    }
+                    std::vector<cadmium::concurrency::socket_connection> nodes(_next_of.size());
+                    for (std::size_t c = 0; c < connections.size(); c++) {
+                        if (socket_protocol::frame_kind(hellos[c]) != socket_frame::hello) {
+                            throw std::domain_error("Unexpected frame received from a connecting node");
+                        }
+                        const char* data = hellos[c].data() + 1;
+                        const char* end = hellos[c].data() + hellos[c].size();
+                        std::uint64_t node = cadmium::dynamic::message_codec<std::uint64_t>::decode(data, end);
+                        std::uint64_t parts = cadmium::dynamic::message_codec<std::uint64_t>::decode(data, end);
+                        std::uint64_t models = cadmium::dynamic::message_codec<std::uint64_t>::decode(data, end);
+                        if (parts != nodes.size() || node >= nodes.size() || nodes[node].is_open() || (c > 0 && models != _models)) {
+                            throw std::domain_error("Node " + std::to_string(node) + " does not match the partition of the coordinator");
+                        }
+                        _models = models;
+                        _next_of[node] = codec::decode(data, end);
+                        nodes[node] = std::move(connections[c]);
+                    }
+                    _nodes = std::move(nodes);
+                }
+
+                /**
+                 * @brief runUntil starts the simulation and stops when the next event is scheduled after t.
+                 * @param t is the limit time for the simulation.
+                 * @return the TIME of the next event to happen when simulation stopped.
+                 */
+                TIME run_until(const TIME& t) {
+                    check_usable();
+                    accept_nodes();
+                    for (;;) {
+                        TIME next = *std::min_element(_next_of.begin(), _next_of.end());
+                        if (!(next < t)) {
+                            return next;
+                        }
+                        step(next);
+                    }
+                }
+
+                /**
+                 * @brief runUntilPassivate starts the simulation and stops when there is no next internal event to happen.
+                 */
+                void run_until_passivate() {
+                    run_until(std::numeric_limits<TIME>::infinity());
+                }
+
+                std::size_t nodes() const noexcept {
+                    return _next_of.size();
+                }
+
+                /**
+                 * @return The number of simulated imminent times.
+                 */
+                std::size_t steps() const noexcept {
+                    return _steps;
+                }
+
+                /**
+                 * @return The state of each atomic model in the nodes, as logged, in the order of the
+                 * flattened coupled model.
+                 */
+                std::vector<std::string> model_states() {
+                    check_usable();
+                    accept_nodes();
+                    socket_protocol::start_frame(_frame, socket_frame::states);
+                    for (auto& node : _nodes) {
+                        node.send_frame(_frame);
+                    }
+                    std::vector<std::string> states(_models);
+                    for (std::size_t n = 0; n < _nodes.size(); n++) {
+                        receive(n, socket_frame::states);
+                        decode_partitioned_states(_frame.substr(1), states);
+                    }
+                    return states;
+                }
+            };
+        }
+    }
+}
+
+#endif //CADMIUM_PDEVS_DYNAMIC_SOCKET_RUNNER_HPP
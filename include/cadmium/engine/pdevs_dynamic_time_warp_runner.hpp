@@ -0,0 +1,657 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef CADMIUM_PDEVS_DYNAMIC_TIME_WARP_RUNNER_HPP
+#define CADMIUM_PDEVS_DYNAMIC_TIME_WARP_RUNNER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <cadmium/modeling/dynamic_coupled.hpp>
+#include <cadmium/modeling/dynamic_flattened_coupled.hpp>
+#include <cadmium/engine/pdevs_dynamic_simulator.hpp>
+#include <cadmium/engine/pdevs_dynamic_engine_helpers.hpp>
+#include <cadmium/engine/pdevs_dynamic_fel.hpp>
+#include <cadmium/engine/pdevs_dynamic_runner.hpp>
+#include <cadmium/engine/work_stealing_executor.hpp>
+
+/**
+ * Maximum amount of steps a process simulates optimistically between two GVT computations.
+ */
+#ifndef CADMIUM_TIME_WARP_ROUND_STEPS
+#define CADMIUM_TIME_WARP_ROUND_STEPS 64
+#endif
+
+namespace cadmium {
+    namespace dynamic {
+        namespace engine {
+
+            /**
+             * @brief Message sent from a Time Warp process to another one. Messages without bags are
+             * anti-messages, cancelling the message of the same sender and id.
+             */
+            template<typename TIME>
+            struct time_warp_event {
+                TIME time;
+                std::size_t route; // index of the IC in the flattened model
+                std::size_t sender;
+                std::size_t id; // unique among the messages of the sender
+                std::shared_ptr<const cadmium::dynamic::message_bags> bags;
+            };
+
+            /**
+             * @brief Group of atomic models of a flattened model that the Time Warp runner simulates
+             * optimistically, without waiting for the messages of other processes.
+             *
+             * @details
+             * Before each step the process saves the state of the models it is going to advance. When a
+             * message arrives for a time it has already simulated, the straggler, the process rolls back
+             * the steps from that time on, restoring the saved states and sending anti-messages to cancel
+             * the messages those steps sent. Steps before the GVT can no longer be rolled back, so their
+             * saved states and messages are released by fossil_collect.
+             */
+            template<typename TIME, typename LOGGER, template<typename> class FEL=binary_heap_fel>
+            class time_warp_process {
+                using simulator_type = cadmium::dynamic::engine::simulator<TIME, LOGGER>;
+                using event_type = time_warp_event<TIME>;
+
+                struct outgoing_route {
+                    std::size_t route;
+                    std::size_t to_process;
+                    cadmium::dynamic::port_endpoint from;
+                    std::shared_ptr<link_abstract> link;
+                };
+
+                struct incoming_route {
+                    std::size_t to;
+                    cadmium::dynamic::port_endpoint to_endpoint;
+                    std::shared_ptr<link_abstract> link;
+                };
+
+                struct step_record {
+                    TIME time;
+                    std::vector<std::pair<std::size_t, typename simulator_type::saved_state>> states;
+                    std::vector<std::pair<std::size_t, event_type>> sent; // destination process and message
+                };
+
+                std::size_t _index;
+                std::vector<time_warp_process*> _peers;
+                std::vector<std::shared_ptr<simulator_type>> _simulators;
+                FEL<TIME> _fel;
+
+                // routes between models of the process
+                bound_routes _routes;
+                std::vector<std::size_t> _route_order;
+                std::vector<std::size_t> _route_destination;
+                std::vector<std::vector<std::size_t>> _routes_by_source;
+                // routes between processes
+                std::vector<std::vector<outgoing_route>> _outgoing_by_source;
+                std::map<std::size_t, incoming_route> _incoming;
+
+                std::mutex _mailbox_mutex;
+                std::vector<event_type> _mailbox;
+                std::atomic<bool> _has_mail{false};
+                std::vector<event_type> _delivered;
+
+                // messages from other processes sorted by time, the first _processed ones were simulated
+                std::vector<event_type> _inputs;
+                std::size_t _processed = 0;
+                std::deque<step_record> _steps;
+                std::size_t _sent = 0;
+                // messages sent by a rolled back step at the time the process was rolled back to
+                std::vector<std::pair<std::size_t, event_type>> _kept;
+                TIME _kept_time;
+
+                std::vector<std::size_t> _imminent;
+                std::vector<std::size_t> _active;
+                std::vector<bool> _is_active;
+                std::vector<std::pair<std::size_t, std::size_t>> _deliveries; // route order and reference
+
+                std::size_t _rollbacks = 0;
+                std::size_t _rolled_back_steps = 0;
+
+                void activate(std::size_t i) {
+                    if (!_is_active[i]) {
+                        _is_active[i] = true;
+                        _active.push_back(i);
+                    }
+                }
+
+                void cancel(std::vector<std::pair<std::size_t, event_type>>& sent) {
+                    for (auto& s : sent) {
+                        _peers[s.first]->receive(std::move(s.second));
+                    }
+                    sent.clear();
+                }
+
+                /**
+                 * Outputs at t only depend on the states before t, so the messages sent by the step at t
+                 * are kept, and not sent again when the step is simulated again. Cancelling them would roll
+                 * back the receivers to t as well, and with couplings in a cycle the processes would never
+                 * stop rolling back each other.
+                 */
+                void rollback(const TIME& t) {
+                    std::size_t kept = _steps.size();
+                    while (kept > 0 && !(_steps[kept - 1].time < t)) {
+                        kept--;
+                        for (auto& saved : _steps[kept].states) {
+                            _simulators[saved.first]->restore_state(saved.second);
+                            _fel.update(saved.first, _simulators[saved.first]->next());
+                        }
+                    }
+                    if (kept < _steps.size()) {
+                        // anti-messages are sent in the order of their messages, so each receiver
+                        // rolls back once, to the earliest of them
+                        bool keep_first = _steps[kept].time == t;
+                        for (std::size_t s = keep_first ? kept + 1 : kept; s < _steps.size(); s++) {
+                            cancel(_steps[s].sent);
+                        }
+                        cancel(_kept);
+                        if (keep_first) {
+                            _kept = std::move(_steps[kept].sent);
+                            _kept_time = t;
+                        }
+                        _rolled_back_steps += _steps.size() - kept;
+                        _rollbacks++;
+                        _steps.erase(_steps.begin() + kept, _steps.end());
+                    } else if (!_kept.empty() && t < _kept_time) {
+                        cancel(_kept);
+                    }
+                    auto first_not_processed = std::lower_bound(_inputs.begin(), _inputs.end(), t, [](const event_type& e, const TIME& t) { return e.time < t; });
+                    _processed = std::min<std::size_t>(_processed, std::distance(_inputs.begin(), first_not_processed));
+                }
+
+                bool simulated(const TIME& t) const {
+                    return !_steps.empty() && !(_steps.back().time < t);
+                }
+
+                void deliver_mailbox() {
+                    if (!_has_mail.load(std::memory_order_acquire)) {
+                        return;
+                    }
+                    _delivered.clear();
+                    {
+                        std::lock_guard<std::mutex> lock(_mailbox_mutex);
+                        std::swap(_delivered, _mailbox);
+                        _has_mail.store(false, std::memory_order_relaxed);
+                    }
+                    // messages of each sender are handled in the order they were sent, so the
+                    // anti-messages always find the message they cancel
+                    for (auto& e : _delivered) {
+                        if (simulated(e.time)) {
+                            rollback(e.time);
+                        }
+                        if (e.bags != nullptr) {
+                            auto it = std::upper_bound(_inputs.begin(), _inputs.end(), e.time, [](const TIME& t, const event_type& e) { return t < e.time; });
+                            _inputs.insert(it, std::move(e));
+                        } else {
+                            auto it = std::find_if(_inputs.begin(), _inputs.end(), [&e](const event_type& i) { return i.sender == e.sender && i.id == e.id; });
+                            if (it == _inputs.end()) {
+                                throw std::domain_error("Anti-message received for an unknown message");
+                            }
+                            _inputs.erase(it);
+                        }
+                    }
+                }
+
+                void send_outputs(const TIME& t, step_record& record) {
+                    for (std::size_t i : _imminent) {
+                        std::shared_ptr<const cadmium::dynamic::message_bags> bags;
+                        for (const outgoing_route& r : _outgoing_by_source[i]) {
+                            if (r.link->has_messages(r.from)) {
+                                if (bags == nullptr) {
+                                    bags = std::make_shared<const cadmium::dynamic::message_bags>(_simulators[i]->outbox());
+                                }
+                                event_type e{t, r.route, _index, _sent++, bags};
+                                record.sent.emplace_back(r.to_process, event_type{t, r.route, _index, e.id, nullptr});
+                                _peers[r.to_process]->receive(std::move(e));
+                            }
+                        }
+                    }
+                }
+
+                void step(const TIME& t) {
+                    _imminent.clear();
+                    if (!_fel.empty() && _fel.min() == t) {
+                        _fel.imminent(t, _imminent);
+                        std::sort(_imminent.begin(), _imminent.end());
+                    }
+                    for (std::size_t i : _imminent) {
+                        _simulators[i]->collect_outputs(t);
+                    }
+
+                    // messages of the process and from other processes are routed in the order of the
+                    // ICs, so each model receives them in the same order of a sequential simulation
+                    _deliveries.clear();
+                    for (std::size_t i : _imminent) {
+                        for (std::size_t r : _routes_by_source[i]) {
+                            _deliveries.emplace_back(_route_order[r], r);
+                        }
+                    }
+                    std::size_t last = _processed;
+                    for (; last < _inputs.size() && _inputs[last].time == t; last++) {
+                        _deliveries.emplace_back(_inputs[last].route, _routes.size() + last);
+                    }
+                    std::sort(_deliveries.begin(), _deliveries.end());
+                    for (const auto& d : _deliveries) {
+                        std::size_t to;
+                        if (d.second < _routes.size()) {
+                            const bound_route& r = _routes[d.second];
+                            route_link_messages<LOGGER>(*r.link, r.from, r.to);
+                            to = _route_destination[d.second];
+                        } else {
+                            const event_type& e = _inputs[d.second - _routes.size()];
+                            const incoming_route& r = _incoming.at(e.route);
+                            cadmium::dynamic::port_endpoint from{nullptr, const_cast<cadmium::dynamic::message_bags*>(e.bags.get())};
+                            route_link_messages<LOGGER>(*r.link, from, r.to_endpoint);
+                            to = r.to;
+                        }
+                        if (!_is_active[to] && !_simulators[to]->inbox_empty()) {
+                            activate(to);
+                        }
+                    }
+                    _processed = last;
+                    for (std::size_t i : _imminent) {
+                        activate(i);
+                    }
+
+                    step_record record{t, {}, {}};
+                    for (std::size_t i : _active) {
+                        record.states.emplace_back(i, _simulators[i]->save_state());
+                    }
+                    // the outputs are sent before the transitions clear the outboxes, unless they were
+                    // kept when the step was rolled back
+                    if (!_kept.empty()) {
+                        if (_kept_time != t) {
+                            throw std::domain_error("Messages kept on rollback were not sent again");
+                        }
+                        std::swap(record.sent, _kept);
+                    } else {
+                        send_outputs(t, record);
+                    }
+
+                    std::sort(_active.begin(), _active.end());
+                    for (std::size_t i : _active) {
+                        _simulators[i]->advance_simulation(t);
+                        _fel.update(i, _simulators[i]->next());
+                        _is_active[i] = false;
+                    }
+                    _active.clear();
+                    _steps.push_back(std::move(record));
+                }
+
+            public:
+                explicit time_warp_process(std::size_t index) : _index(index) {}
+
+                time_warp_process(const time_warp_process&) = delete;
+                time_warp_process& operator=(const time_warp_process&) = delete;
+
+                /**
+                 * @return The local index of the model in the process.
+                 */
+                std::size_t add_model(const std::shared_ptr<cadmium::dynamic::modeling::atomic_abstract<TIME>>& m) {
+                    _simulators.push_back(std::make_shared<simulator_type>(m));
+                    _routes_by_source.emplace_back();
+                    _outgoing_by_source.emplace_back();
+                    _is_active.push_back(false);
+                    return _simulators.size() - 1;
+                }
+
+                engine<TIME>& model(std::size_t i) {
+                    return *_simulators[i];
+                }
+
+                void connect(const std::vector<time_warp_process*>& peers) {
+                    _peers = peers;
+                }
+
+                /**
+                 * @brief Adds the route of the IC with index route between two models of the process.
+                 */
+                void add_route(std::size_t route, std::size_t from, std::size_t to, const std::shared_ptr<link_abstract>& l) {
+                    _routes.push_back({_simulators[from]->output_endpoint(l->from_port_type_index()), _simulators[to]->input_endpoint(l->to_port_type_index()), l});
+                    _route_order.push_back(route);
+                    _route_destination.push_back(to);
+                    _routes_by_source[from].push_back(_routes.size() - 1);
+                }
+
+                /**
+                 * @brief Adds the route of the IC with index route from a model of the process to a model of another one.
+                 */
+                void add_outgoing_route(std::size_t route, std::size_t from, std::size_t to_process, const std::shared_ptr<link_abstract>& l) {
+                    _outgoing_by_source[from].push_back({route, to_process, _simulators[from]->output_endpoint(l->from_port_type_index()), l});
+                }
+
+                /**
+                 * @brief Adds the route of the IC with index route from a model of another process to a model of the process.
+                 */
+                void add_incoming_route(std::size_t route, std::size_t to, const std::shared_ptr<link_abstract>& l) {
+                    _incoming.emplace(route, incoming_route{to, _simulators[to]->input_endpoint(l->to_port_type_index()), l});
+                }
+
+                void init(const TIME& initial_time) {
+                    std::vector<TIME> next_times;
+                    for (auto& s : _simulators) {
+                        s->init(initial_time);
+                        next_times.push_back(s->next());
+                    }
+                    _fel.assign(next_times);
+                }
+
+                /**
+                 * @brief Queues a message or anti-message from another process, it can be called from any thread.
+                 */
+                void receive(event_type e) {
+                    std::lock_guard<std::mutex> lock(_mailbox_mutex);
+                    _mailbox.push_back(std::move(e));
+                    _has_mail.store(true, std::memory_order_release);
+                }
+
+                /**
+                 * @return The time of the next step of the process, ignoring the messages not delivered yet.
+                 */
+                TIME next() const {
+                    TIME next = _fel.empty() ? std::numeric_limits<TIME>::infinity() : _fel.min();
+                    if (_processed < _inputs.size()) {
+                        next = std::min(next, _inputs[_processed].time);
+                    }
+                    return next;
+                }
+
+                /**
+                 * @return The earliest time of the messages not delivered yet.
+                 * @note Only valid while no other process is running.
+                 */
+                TIME earliest_undelivered() {
+                    std::lock_guard<std::mutex> lock(_mailbox_mutex);
+                    TIME earliest = std::numeric_limits<TIME>::infinity();
+                    for (const auto& e : _mailbox) {
+                        earliest = std::min(earliest, e.time);
+                    }
+                    return earliest;
+                }
+
+                /**
+                 * @brief Simulates optimistically up to max_steps steps before t, handling the messages
+                 * of the other processes as they arrive.
+                 */
+                void run(const TIME& t, std::size_t max_steps) {
+                    deliver_mailbox();
+                    for (std::size_t steps = 0; steps < max_steps; steps++) {
+                        TIME next = this->next();
+                        if (!(next < t)) {
+                            break;
+                        }
+                        step(next);
+                        deliver_mailbox();
+                    }
+                }
+
+                /**
+                 * @brief Releases the saved states and messages of the steps before gvt, they will not
+                 * be rolled back anymore.
+                 */
+                void fossil_collect(const TIME& gvt) {
+                    while (!_steps.empty() && _steps.front().time < gvt) {
+                        _steps.pop_front();
+                    }
+                    std::size_t committed = 0;
+                    while (committed < _processed && _inputs[committed].time < gvt) {
+                        committed++;
+                    }
+                    _inputs.erase(_inputs.begin(), _inputs.begin() + committed);
+                    _processed -= committed;
+                }
+
+                std::size_t rollbacks() const noexcept {
+                    return _rollbacks;
+                }
+
+                std::size_t rolled_back_steps() const noexcept {
+                    return _rolled_back_steps;
+                }
+
+                /**
+                 * @brief Amount of steps that can still be rolled back.
+                 */
+                std::size_t uncommitted_steps() const noexcept {
+                    return _steps.size();
+                }
+            };
+
+            /**
+             * @brief Optimistic parallel runner, using Time Warp.
+             *
+             * @details
+             * The atomic models of the flattened coupled model are split in logical processes, which
+             * simulate their events in parallel without waiting for each other, rolling back when a
+             * message arrives late (see time_warp_process). The simulation runs in rounds: on each one
+             * the processes simulate up to CADMIUM_TIME_WARP_ROUND_STEPS steps and, between rounds,
+             * the runner computes the GVT, the earliest time any process may still be rolled back to,
+             * and releases the memory used by the steps before it.
+             *
+             * Atomic models must support saving their state, the default wrapper copies their state
+             * member. Asynchronous atomic models are not supported. The logger records the steps
+             * that are later rolled back as well, so not_logger is the usual choice.
+             *
+             * @param TIME Representation of time to be used to run the simulation
+             * @param LOGGER what, where and how to log from the simulation, logs of different processes interleave
+             * @param FEL future event list policy used by the processes, see pdevs_dynamic_fel.hpp
+             */
+            template<class TIME, typename LOGGER=default_logger<TIME>, template<typename> class FEL=binary_heap_fel>
+            class time_warp_runner {
+                using process_type = time_warp_process<TIME, LOGGER, FEL>;
+
+                std::vector<std::unique_ptr<process_type>> _processes;
+                cadmium::concurrency::work_stealing_executor _executor;
+
+                TIME _gvt;
+                std::size_t _rounds = 0;
+
+                void build(const cadmium::dynamic::modeling::flattened_coupled<TIME>& flat, const std::vector<std::size_t>& process_of, std::size_t processes) {
+                    if (process_of.size() != flat.atomics.size()) {
+                        throw std::domain_error("Every atomic model must be assigned to a logical process");
+                    }
+                    std::vector<process_type*> peers;
+                    for (std::size_t p = 0; p < processes; p++) {
+                        _processes.push_back(std::make_unique<process_type>(p));
+                        peers.push_back(_processes.back().get());
+                    }
+                    for (auto& p : _processes) {
+                        p->connect(peers);
+                    }
+
+                    std::vector<std::size_t> local(flat.atomics.size());
+                    for (std::size_t a = 0; a < flat.atomics.size(); a++) {
+                        auto m = std::dynamic_pointer_cast<cadmium::dynamic::modeling::atomic_abstract<TIME>>(flat.atomics[a]);
+                        if (m == nullptr) {
+                            throw std::domain_error("The Time Warp runner only supports atomic models");
+                        }
+                        if (process_of[a] >= processes) {
+                            throw std::domain_error("Atomic model assigned to an invalid logical process");
+                        }
+                        local[a] = _processes[process_of[a]]->add_model(m);
+                    }
+
+                    for (std::size_t r = 0; r < flat.ic.size(); r++) {
+                        const auto& ic = flat.ic[r];
+                        std::size_t from_process = process_of[ic.from];
+                        std::size_t to_process = process_of[ic.to];
+                        if (from_process == to_process) {
+                            _processes[from_process]->add_route(r, local[ic.from], local[ic.to], ic.link);
+                        } else {
+                            _processes[from_process]->add_outgoing_route(r, local[ic.from], to_process, ic.link);
+                            _processes[to_process]->add_incoming_route(r, local[ic.to], ic.link);
+                        }
+                    }
+                }
+
+                void init(const TIME& init_time) {
+                    LOGGER::template log<cadmium::logger::logger_global_time, cadmium::logger::run_global_time>(init_time);
+                    LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::run_info>("Preparing model");
+                    auto init_process = [this, &init_time](std::size_t p) { _processes[p]->init(init_time); };
+                    _executor.parallel_for(_processes.size(), init_process);
+                    _gvt = compute_gvt();
+                }
+
+                /**
+                 * Between rounds no message is in transit: they are either delivered or in a mailbox.
+                 */
+                TIME compute_gvt() {
+                    TIME gvt = std::numeric_limits<TIME>::infinity();
+                    for (auto& p : _processes) {
+                        gvt = std::min({gvt, p->next(), p->earliest_undelivered()});
+                    }
+                    return gvt;
+                }
+
+            public:
+                /**
+                 * @brief Splits the atomic models of the flattened coupled model in contiguous blocks of
+                 * the depth-first order, so models of the same coupled model tend to share their process.
+                 * @param processes is the amount of logical processes.
+                 * @param thread_count is the amount of threads simulating the processes.
+                 */
+                time_warp_runner(std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> coupled_model, const TIME& init_time,
+                                 std::size_t processes = std::thread::hardware_concurrency(), unsigned thread_count = std::thread::hardware_concurrency())
+                : _executor(thread_count) {
+                    cadmium::dynamic::modeling::flattened_coupled<TIME> flat = cadmium::dynamic::modeling::flatten<TIME>(coupled_model);
+                    processes = std::max<std::size_t>(1, std::min(processes, flat.atomics.size()));
+                    std::vector<std::size_t> process_of(flat.atomics.size());
+                    for (std::size_t a = 0; a < process_of.size(); a++) {
+                        process_of[a] = a * processes / process_of.size();
+                    }
+                    build(flat, process_of, processes);
+                    init(init_time);
+                }
+
+                /**
+                 * @param process_of is the logical process of each atomic model, in the order of the
+                 * flattened coupled model, see cadmium::dynamic::modeling::flatten.
+                 * @param thread_count is the amount of threads simulating the processes.
+                 */
+                time_warp_runner(std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> coupled_model, const TIME& init_time,
+                                 const std::vector<std::size_t>& process_of, unsigned thread_count = std::thread::hardware_concurrency())
+                : _executor(thread_count) {
+                    std::size_t processes = process_of.empty() ? 1 : *std::max_element(process_of.begin(), process_of.end()) + 1;
+                    build(cadmium::dynamic::modeling::flatten<TIME>(coupled_model), process_of, processes);
+                    init(init_time);
+                }
+
+                time_warp_runner(const time_warp_runner&) = delete;
+                time_warp_runner& operator=(const time_warp_runner&) = delete;
+
+                /**
+                 * @brief runUntil starts the simulation and stops when the next event is scheduled after t.
+                 * When it returns, every step before t is committed.
+                 * @param t is the limit time for the simulation.
+                 * @return the TIME of the next event to happen when simulation stopped.
+                 */
+                TIME run_until(const TIME& t) {
+                    LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::run_info>("Starting run");
+                    for (;;) {
+                        bool finished = !(_gvt < t);
+                        auto round = [this, &t, finished](std::size_t p) {
+                            _processes[p]->fossil_collect(_gvt);
+                            if (!finished) {
+                                _processes[p]->run(t, CADMIUM_TIME_WARP_ROUND_STEPS);
+                            }
+                        };
+                        _executor.parallel_for(_processes.size(), round);
+                        if (finished) {
+                            break;
+                        }
+                        _rounds++;
+                        _gvt = compute_gvt();
+                        LOGGER::template log<cadmium::logger::logger_global_time, cadmium::logger::run_global_time>(_gvt);
+                    }
+                    LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::run_info>("Finished run");
+                    return _gvt;
+                }
+
+                /**
+                 * @brief runUntilPassivate starts the simulation and stops when there is no next internal event to happen.
+                 */
+                void run_until_passivate() {
+                    run_until(std::numeric_limits<TIME>::infinity());
+                }
+
+                std::size_t processes() const noexcept {
+                    return _processes.size();
+                }
+
+                /**
+                 * @brief Global virtual time, no process will be rolled back before it.
+                 */
+                TIME gvt() const noexcept {
+                    return _gvt;
+                }
+
+                std::size_t rounds() const noexcept {
+                    return _rounds;
+                }
+
+                std::size_t rollbacks() const noexcept {
+                    std::size_t total = 0;
+                    for (const auto& p : _processes) {
+                        total += p->rollbacks();
+                    }
+                    return total;
+                }
+
+                std::size_t rolled_back_steps() const noexcept {
+                    std::size_t total = 0;
+                    for (const auto& p : _processes) {
+                        total += p->rolled_back_steps();
+                    }
+                    return total;
+                }
+
+                /**
+                 * @brief Amount of steps kept to be rolled back, bounded by the fossil collection.
+                 */
+                std::size_t uncommitted_steps() const noexcept {
+                    std::size_t total = 0;
+                    for (const auto& p : _processes) {
+                        total += p->uncommitted_steps();
+                    }
+                    return total;
+                }
+            };
+        }
+    }
+}
+
+#endif //CADMIUM_PDEVS_DYNAMIC_TIME_WARP_RUNNER_HPP
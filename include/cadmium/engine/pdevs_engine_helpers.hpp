@@ -33,6 +33,7 @@
 #include <algorithm>
 #include <iostream>
 #include <numeric>
+#include <iterator>
 #include <boost/type_index.hpp>
 
 #include <cadmium/concept/concept_helpers.hpp>
@@ -135,55 +136,106 @@ namespace cadmium {
             return std::get<typename get_engine_type_by_model<TIMED_MODEL, CST>::type>(cst);
         }
 
+        //count the couplings reading the messages of the output port FROM_PORT of the submodel FROM_MODEL
+        template<typename TIME, typename FROM_MODEL, typename FROM_PORT, typename EOCs, typename ICs>
+        struct output_port_consumers;
+
+        template<typename TIME, typename FROM_MODEL, typename FROM_PORT, typename... EOC, typename... IC>
+        struct output_port_consumers<TIME, FROM_MODEL, FROM_PORT, std::tuple<EOC...>, std::tuple<IC...>> {
+            static constexpr std::size_t value =
+                    (std::size_t{0} + ... + ((std::is_same<typename EOC::template submodel<TIME>, FROM_MODEL>::value && std::is_same<typename EOC::submodel_output_port, FROM_PORT>::value) ? 1 : 0)) +
+                    (std::size_t{0} + ... + ((std::is_same<typename IC::template from_model<TIME>, FROM_MODEL>::value && std::is_same<typename IC::from_model_output_port, FROM_PORT>::value) ? 1 : 0));
+        };
+
+        //count the couplings reading the messages of the input port FROM_PORT of the coupled model
+        template<typename FROM_PORT, typename EICs>
+        struct input_port_consumers;
+
+        template<typename FROM_PORT, typename... EIC>
+        struct input_port_consumers<FROM_PORT, std::tuple<EIC...>> {
+            static constexpr std::size_t value = (std::size_t{0} + ... + (std::is_same<typename EIC::external_input_port, FROM_PORT>::value ? 1 : 0));
+        };
+
+        //append the messages of from to the messages of TO_PORT in to, when MOVE is true they are moved out of from
+        //the bags may keep different amounts of messages inside, then they are not swapped
+        template<bool MOVE, typename TO_PORT, typename FROM_MSGS, typename TO_MSGS>
+        void pass_messages(FROM_MSGS& from, TO_MSGS& to) {
+            if constexpr (MOVE) {
+                if constexpr (std::is_same<FROM_MSGS, TO_MSGS>::value && !port_combines<TO_PORT>::value) {
+                    if (to.empty()) {
+                        to.swap(from);
+                        return;
+                    }
+                }
+                append_messages<TO_PORT>(to, std::make_move_iterator(from.begin()), std::make_move_iterator(from.end()));
+                from.clear();
+            } else {
+                append_messages<TO_PORT>(to, from.begin(), from.end());
+            }
+        }
+
+        //remove all the messages of the bags keeping their allocated memory for next uses
+        template<class BOX>
+        void clear_bags(BOX& box) {
+            auto clear_bag = [](auto& b) -> void { b.messages.clear(); };
+            cadmium::helper::for_each<BOX>(box, clear_bag);
+        }
+
         //map the messages in the outboxes of subengines to the messages in the outbox of current coordinator
-        template<typename TIME, typename EOC, std::size_t S, typename OUT_BAG, typename CST, typename LOGGER>
+        template<typename TIME, typename EOC, std::size_t S, typename OUT_BAG, typename CST, typename LOGGER, typename ICs>
         struct collect_messages_by_eoc_impl{
             using external_output_port=typename std::tuple_element<S-1, EOC>::type::external_output_port;
             using submodel_from = typename std::tuple_element<S-1, EOC>::type::template submodel<TIME>;
             using submodel_output_port=typename std::tuple_element<S-1, EOC>::type::submodel_output_port;
             using submodel_out_messages_type=typename make_message_bags<typename std::tuple<submodel_output_port>>::type;
 
+            //messages are moved if this is their only consumer and they are not needed for logging
+            static constexpr bool move_messages =
+                    output_port_consumers<TIME, submodel_from, submodel_output_port, EOC, ICs>::value == 1 &&
+                    !cadmium::logger::logs_source_v<LOGGER, cadmium::logger::logger_message_routing>;
+
             static void fill(OUT_BAG& messages, CST& cst){
                 //process one coupling
-                auto from_bag = get_engine_by_model<submodel_from, CST>(cst).outbox();
-                auto& from_messages = get_messages<submodel_output_port>(from_bag);
+                auto& from_messages = get_messages<submodel_output_port>(get_engine_by_model<submodel_from, CST>(cst)._outbox);
                 auto& to_messages = get_messages<external_output_port>(messages);
-                to_messages.insert(to_messages.end(), from_messages.begin(), from_messages.end());
+                pass_messages<move_messages, external_output_port>(from_messages, to_messages);
 
-                //logging data
-                std::ostringstream oss;
-                logger::implode(oss, from_messages);
-                std::string from_messages_str = oss.str();
-                std::string from_port_str = boost::typeindex::type_id<submodel_output_port >().pretty_name();
+                if constexpr (cadmium::logger::logs_source_v<LOGGER, cadmium::logger::logger_message_routing>) {
+                    //logging data
+                    std::ostringstream oss;
+                    logger::implode(oss, from_messages);
+                    std::string from_messages_str = oss.str();
+                    std::string from_port_str = boost::typeindex::type_id<submodel_output_port >().pretty_name();
 
-                oss.clear();
-                oss.str("");
-                logger::implode(oss, to_messages);
-                std::string to_messages_str = oss.str();
-                std::string to_port_str = boost::typeindex::type_id<external_output_port>().pretty_name();
+                    oss.clear();
+                    oss.str("");
+                    logger::implode(oss, to_messages);
+                    std::string to_messages_str = oss.str();
+                    std::string to_port_str = boost::typeindex::type_id<external_output_port>().pretty_name();
 
-                std::string from_model_str = boost::typeindex::type_id<submodel_from>().pretty_name();
+                    std::string from_model_str = boost::typeindex::type_id<submodel_from>().pretty_name();
 
-                LOGGER::template log<
-                        cadmium::logger::logger_message_routing,
-                        cadmium::logger::coor_routing_collect_eoc
-                >(from_messages_str, to_messages_str, from_port_str, to_port_str, from_model_str);
+                    LOGGER::template log<
+                            cadmium::logger::logger_message_routing,
+                            cadmium::logger::coor_routing_collect_eoc
+                    >(from_messages_str, to_messages_str, from_port_str, to_port_str, from_model_str);
+                }
 
                 //iterate
-                collect_messages_by_eoc_impl<TIME, EOC, S-1, OUT_BAG, CST, LOGGER>::fill(messages, cst);
+                collect_messages_by_eoc_impl<TIME, EOC, S-1, OUT_BAG, CST, LOGGER, ICs>::fill(messages, cst);
             }
         };
 
-        template<typename TIME, typename EOC, typename OUT_BAG, typename CST, typename LOGGER>
-        struct collect_messages_by_eoc_impl<TIME, EOC, 0, OUT_BAG, CST, LOGGER>{
+        template<typename TIME, typename EOC, typename OUT_BAG, typename CST, typename LOGGER, typename ICs>
+        struct collect_messages_by_eoc_impl<TIME, EOC, 0, OUT_BAG, CST, LOGGER, ICs>{
             static void fill(OUT_BAG& messages, CST& cst){} //nothing to do here
         };
 
-        template<typename TIME, typename EOC, typename OUT_BAG, typename CST,typename LOGGER>
-        OUT_BAG collect_messages_by_eoc(CST& cst){
-            OUT_BAG ret;//if the subcoordinators active are not connected by EOC, no output is generated
-            collect_messages_by_eoc_impl<TIME, EOC, std::tuple_size<EOC>::value, OUT_BAG, CST, LOGGER>::fill(ret, cst);
-            return ret;
+        //fill the messages, expected to be empty, with the outputs of the subcoordinators following the EOCs.
+        //ICs are the couplings also reading the subcoordinator outboxes.
+        template<typename TIME, typename EOC, typename OUT_BAG, typename CST, typename LOGGER, typename ICs>
+        void collect_messages_by_eoc(OUT_BAG& messages, CST& cst){
+            collect_messages_by_eoc_impl<TIME, EOC, std::tuple_size<EOC>::value, OUT_BAG, CST, LOGGER, ICs>::fill(messages, cst);
         }
 
         //advance the simulation in every subengine
@@ -195,7 +247,7 @@ namespace cadmium {
 
 
         //route messages following ICs
-        template<typename TIME, typename CST, typename ICs, std::size_t S, typename LOGGER>
+        template<typename TIME, typename CST, typename ICs, std::size_t S, typename LOGGER, typename EOCs>
         struct route_internal_coupled_messages_on_subcoordinators_impl{
             using current_IC=typename std::tuple_element<S-1, ICs>::type;
             using from_model=typename current_IC::template from_model<TIME>;
@@ -205,6 +257,12 @@ namespace cadmium {
 
             using from_model_type=typename get_engine_type_by_model<from_model, CST>::type;
             using to_model_type=typename get_engine_type_by_model<to_model, CST>::type;
+
+            //messages are moved if this is their only consumer and they are not needed for logging
+            static constexpr bool move_messages =
+                    output_port_consumers<TIME, from_model, from_port, EOCs, ICs>::value == 1 &&
+                    !cadmium::logger::logs_source_v<LOGGER, cadmium::logger::logger_message_routing>;
+
             static void route(const TIME& t, CST& engines){
                 //route messages for 1 coupling
                 from_model_type& from_engine = get_engine_by_model<from_model, CST>(engines);
@@ -213,78 +271,88 @@ namespace cadmium {
                 //add the messages
                 auto& from_messages = cadmium::get_messages<from_port>(from_engine._outbox);
                 auto& to_messages = cadmium::get_messages<to_port>(to_engine._inbox);
-                to_messages.insert(to_messages.end(), from_messages.begin(), from_messages.end());
-
-                //logging data
-                std::ostringstream oss;
-                logger::implode(oss, from_messages);
-                std::string from_messages_str = oss.str();
-                std::string from_port_str = boost::typeindex::type_id<from_port>().pretty_name();
-                std::string from_model_str = boost::typeindex::type_id<from_model>().pretty_name();
-
-                oss.clear();
-                oss.str("");
-                logger::implode(oss, to_messages);
-                std::string to_messages_str = oss.str();
-                std::string to_port_str = boost::typeindex::type_id<to_port>().pretty_name();
-                std::string to_model_str = boost::typeindex::type_id<to_model>().pretty_name();
-
-                LOGGER::template log<
-                        cadmium::logger::logger_message_routing,
-                        cadmium::logger::coor_routing_collect_ic
-                >(from_messages_str, to_messages_str, from_port_str, from_model_str, to_port_str, to_model_str);
+                pass_messages<move_messages, to_port>(from_messages, to_messages);
+
+                if constexpr (cadmium::logger::logs_source_v<LOGGER, cadmium::logger::logger_message_routing>) {
+                    //logging data
+                    std::ostringstream oss;
+                    logger::implode(oss, from_messages);
+                    std::string from_messages_str = oss.str();
+                    std::string from_port_str = boost::typeindex::type_id<from_port>().pretty_name();
+                    std::string from_model_str = boost::typeindex::type_id<from_model>().pretty_name();
+
+                    oss.clear();
+                    oss.str("");
+                    logger::implode(oss, to_messages);
+                    std::string to_messages_str = oss.str();
+                    std::string to_port_str = boost::typeindex::type_id<to_port>().pretty_name();
+                    std::string to_model_str = boost::typeindex::type_id<to_model>().pretty_name();
+
+                    LOGGER::template log<
+                            cadmium::logger::logger_message_routing,
+                            cadmium::logger::coor_routing_collect_ic
+                    >(from_messages_str, to_messages_str, from_port_str, from_model_str, to_port_str, to_model_str);
+                }
 
                 //iterate
-                route_internal_coupled_messages_on_subcoordinators_impl<TIME, CST, ICs, S-1, LOGGER>::route(t, engines);
+                route_internal_coupled_messages_on_subcoordinators_impl<TIME, CST, ICs, S-1, LOGGER, EOCs>::route(t, engines);
             }
         };
 
-        template<typename TIME, typename CST, typename ICs, typename LOGGER>
-        struct route_internal_coupled_messages_on_subcoordinators_impl<TIME, CST, ICs, 0, LOGGER>{
+        template<typename TIME, typename CST, typename ICs, typename LOGGER, typename EOCs>
+        struct route_internal_coupled_messages_on_subcoordinators_impl<TIME, CST, ICs, 0, LOGGER, EOCs>{
             static void route(const TIME& t, CST& subcoordinators){
             //nothing to do here
             }
         };
 
-        template <typename TIME, typename CST, typename ICs, typename LOGGER >
+        //EOCs are the couplings also reading the subcoordinator outboxes
+        template <typename TIME, typename CST, typename ICs, typename LOGGER, typename EOCs>
         void route_internal_coupled_messages_on_subcoordinators(const TIME& t, CST& cst){
-            route_internal_coupled_messages_on_subcoordinators_impl<TIME, CST, ICs, std::tuple_size<ICs>::value, LOGGER>::route(t, cst);
+            route_internal_coupled_messages_on_subcoordinators_impl<TIME, CST, ICs, std::tuple_size<ICs>::value, LOGGER, EOCs>::route(t, cst);
             return;
         }
 
         template<typename TIME, typename INBAGS, typename CST, typename EICs, size_t S, typename LOGGER>
         struct route_external_input_coupled_messages_on_subcoordinators_impl{
             
-            static void route(TIME t, const INBAGS& inbox, CST& engines){
+            static void route(TIME t, INBAGS& inbox, CST& engines){
                 if constexpr (S != 0) {
                     using current_EIC=typename std::tuple_element<S-1, EICs>::type;
                     using from_port=typename current_EIC::external_input_port;
                     using to_model=typename current_EIC::template submodel<TIME>;
                     using to_port=typename current_EIC::submodel_input_port;
 
+                    //messages are moved if this is their only consumer and they are not needed for logging
+                    constexpr bool move_messages =
+                            input_port_consumers<from_port, EICs>::value == 1 &&
+                            !cadmium::logger::logs_source_v<LOGGER, cadmium::logger::logger_message_routing>;
+
                     auto& to_engine=get_engine_by_model<to_model, CST>(engines);
                     auto& from_messages = cadmium::get_messages<from_port>(inbox);
                     auto& to_messages = cadmium::get_messages<to_port>(to_engine._inbox);
-                    to_messages.insert(to_messages.end(), from_messages.begin(), from_messages.end());
+                    pass_messages<move_messages, to_port>(from_messages, to_messages);
 
-                    //logging data
-                    std::ostringstream oss;
-                    logger::implode(oss, from_messages);
-                    std::string from_messages_str = oss.str();
-                    std::string from_port_str = boost::typeindex::type_id<from_port>().pretty_name();
+                    if constexpr (cadmium::logger::logs_source_v<LOGGER, cadmium::logger::logger_message_routing>) {
+                        //logging data
+                        std::ostringstream oss;
+                        logger::implode(oss, from_messages);
+                        std::string from_messages_str = oss.str();
+                        std::string from_port_str = boost::typeindex::type_id<from_port>().pretty_name();
 
-                    oss.clear();
-                    oss.str("");
-                    logger::implode(oss, to_messages);
-                    std::string to_messages_str = oss.str();
-                    std::string to_port_str = boost::typeindex::type_id<to_port>().pretty_name();
+                        oss.clear();
+                        oss.str("");
+                        logger::implode(oss, to_messages);
+                        std::string to_messages_str = oss.str();
+                        std::string to_port_str = boost::typeindex::type_id<to_port>().pretty_name();
 
-                    std::string to_model_str = boost::typeindex::type_id<to_model>().pretty_name();
+                        std::string to_model_str = boost::typeindex::type_id<to_model>().pretty_name();
 
-                    LOGGER::template log<
-                            cadmium::logger::logger_message_routing,
-                            cadmium::logger::coor_routing_collect_eic
-                    >(from_messages_str, to_messages_str, to_port_str, to_model_str, from_port_str);
+                        LOGGER::template log<
+                                cadmium::logger::logger_message_routing,
+                                cadmium::logger::coor_routing_collect_eic
+                        >(from_messages_str, to_messages_str, to_port_str, to_model_str, from_port_str);
+                    }
 
                     //iterate
                     route_external_input_coupled_messages_on_subcoordinators_impl<TIME, INBAGS, CST, EICs, S-1, LOGGER>::route(t, inbox, engines);
@@ -294,7 +362,7 @@ namespace cadmium {
         };
 
         template <typename TIME, typename INBAGS, typename CST, typename EICs, typename LOGGER >
-        void route_external_input_coupled_messages_on_subcoordinators(const TIME& t, const INBAGS& inbox, CST& cst){
+        void route_external_input_coupled_messages_on_subcoordinators(const TIME& t, INBAGS& inbox, CST& cst){
                 route_external_input_coupled_messages_on_subcoordinators_impl<TIME, INBAGS, CST, EICs, std::tuple_size<EICs>::value, LOGGER>::route(t, inbox, cst);
             return;
         }
@@ -80,8 +80,7 @@ namespace cadmium {
                 LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::run_info>("Starting run");
                 while (_next < t){
                     LOGGER::template log<cadmium::logger::logger_global_time, cadmium::logger::run_global_time>(_next);
-                    top_coordinator.collect_outputs(_next);
-                    top_coordinator.advance_simulation(_next);
+                    top_coordinator.step(_next);
                     _next = top_coordinator.next();
                 }
                 LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::run_info>("Finished run");
@@ -79,11 +79,6 @@ namespace cadmium {
 
                 //logging data
                 std::ostringstream oss;
-                oss << _model.state;
-                std::string model_state = oss.str();
-
-                oss.clear();
-                oss.str("");
                 oss << boost::typeindex::type_id<model_type>().pretty_name();
                 _model_id = oss.str();
 
@@ -93,7 +88,11 @@ namespace cadmium {
                 concept::pdevs::atomic_model_assert<MODEL>();
                 _next = initial_time + _model.time_advance();
 
-                LOGGER::template log<cadmium::logger::logger_state, cadmium::logger::sim_state>(model_state, _model_id);
+                if constexpr (cadmium::logger::logs_source_v<LOGGER, cadmium::logger::logger_state>) {
+                    std::ostringstream state_oss;
+                    state_oss << _model.state;
+                    LOGGER::template log<cadmium::logger::logger_state, cadmium::logger::sim_state>(state_oss.str(), _model_id);
+                }
             }
 
 
@@ -106,26 +105,33 @@ namespace cadmium {
                 LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::sim_info_collect>(t, _model_id);
 
                 //cleanning the inbox and producing outbox
-                _inbox = in_bags_type{};
+                cadmium::engine::clear_bags(_inbox);
 
                 
                 if (_next < t){
                     throw std::domain_error("Trying to obtain output when not internal event is scheduled");
                 } else if (_next == t) {
-                    _outbox = _model.output();
+                    if constexpr (cadmium::concept::declares_output_in_place<MODEL<TIME>, out_bags_type>::value) {
+                        cadmium::engine::clear_bags(_outbox);
+                        _model.output(_outbox);
+                    } else {
+                        _outbox = _model.output();
+                    }
                 } else {
-                    _outbox = out_bags_type();
+                    cadmium::engine::clear_bags(_outbox);
                 }
                 //logging data
-                std::ostringstream oss;
-                cadmium::logger::print_messages_by_port(oss, _outbox);
-                LOGGER::template log<cadmium::logger::logger_messages, cadmium::logger::sim_messages_collect>(oss.str(), _model_id);
+                if constexpr (cadmium::logger::logs_source_v<LOGGER, cadmium::logger::logger_messages>) {
+                    std::ostringstream oss;
+                    cadmium::logger::print_messages_by_port(oss, _outbox);
+                    LOGGER::template log<cadmium::logger::logger_messages, cadmium::logger::sim_messages_collect>(oss.str(), _model_id);
+                }
             }
 
             /**
              * @brief outbox keeps the output generated by the last call to collect_outputs
              */
-            out_bags_type outbox() const noexcept{
+            const out_bags_type& outbox() const noexcept{
                 return _outbox;
             }
 
@@ -143,7 +149,7 @@ namespace cadmium {
             */
             void advance_simulation(TIME t) {
                 //clean outbox because messages are routed before calling this funtion at a higher level
-                _outbox = out_bags_type{};
+                cadmium::engine::clear_bags(_outbox);
 
                 LOGGER::template log<cadmium::logger::logger_info, cadmium::logger::sim_info_advance>(_last, t, _model_id);
                 LOGGER::template log<cadmium::logger::logger_local_time, cadmium::logger::sim_local_time>(_last, t, _model_id);
@@ -162,7 +168,7 @@ namespace cadmium {
                         _last = t;
                         _next = _last + _model.time_advance();
                         //clean inbox because they were processed already
-                        _inbox = in_bags_type{};
+                        cadmium::engine::clear_bags(_inbox);
                     } else { //no input available
                         if (t != _next) {
                             //throw std::domain_error("Trying to execute internal transition at wrong time");
@@ -178,9 +184,11 @@ namespace cadmium {
                 }
 
                 //logging data
-                std::ostringstream oss;
-                oss << _model.state;
-                LOGGER::template log<cadmium::logger::logger_state, cadmium::logger::sim_state>(oss.str(), _model_id);
+                if constexpr (cadmium::logger::logs_source_v<LOGGER, cadmium::logger::logger_state>) {
+                    std::ostringstream oss;
+                    oss << _model.state;
+                    LOGGER::template log<cadmium::logger::logger_state, cadmium::logger::sim_state>(oss.str(), _model_id);
+                }
             }
     //TODO: use enable_if functions to give access to read state and messages in debug mode
         };
@@ -0,0 +1,223 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CADMIUM_SHARED_MEMORY_CHANNELS_HPP
+#define CADMIUM_SHARED_MEMORY_CHANNELS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/* busy waiting iterations before yielding the processor while waiting for other processes */
+#ifndef CADMIUM_SHM_SPIN_LIMIT
+#define CADMIUM_SHM_SPIN_LIMIT 1024
+#endif
+
+namespace cadmium {
+    namespace concurrency {
+
+        static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Shared memory channels need lock free 64 bits atomics");
+        static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "Shared memory channels need lock free 32 bits atomics");
+
+        /**
+         * @brief Anonymous POSIX shared memory mapping, shared with the processes forked after creating it.
+         *
+         * @details
+         * The memory is created with shm_open and mapped with mmap, then its name is unlinked right
+         * away, so it is released when the last process using it unmaps it or exits.
+         */
+        class shared_memory_segment {
+            void* _data = MAP_FAILED;
+            std::size_t _size = 0;
+
+        public:
+            explicit shared_memory_segment(std::size_t size) : _size(size) {
+                static std::atomic<unsigned> created{0};
+                std::string name = "/cadmium-" + std::to_string(::getpid()) + "-" + std::to_string(created++);
+                int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+                if (fd < 0) {
+                    throw std::system_error(errno, std::generic_category(), "shm_open");
+                }
+                ::shm_unlink(name.c_str());
+                if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+                    int error = errno;
+                    ::close(fd);
+                    throw std::system_error(error, std::generic_category(), "ftruncate");
+                }
+                _data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                int error = errno;
+                ::close(fd);
+                if (_data == MAP_FAILED) {
+                    throw std::system_error(error, std::generic_category(), "mmap");
+                }
+            }
+
+            shared_memory_segment(const shared_memory_segment&) = delete;
+            shared_memory_segment& operator=(const shared_memory_segment&) = delete;
+
+            ~shared_memory_segment() {
+                if (_data != MAP_FAILED) {
+                    ::munmap(_data, _size);
+                }
+            }
+
+            void* data() const noexcept {
+                return _data;
+            }
+
+            std::size_t size() const noexcept {
+                return _size;
+            }
+        };
+
+        /**
+         * @brief Lock free single producer single consumer byte stream, placed in memory shared by
+         * the producer and the consumer processes.
+         *
+         * @details
+         * The ring is a view over footprint(capacity) bytes, initialized once before the processes
+         * share it. Writes and reads move as many bytes as fit, so records of any size go through
+         * the ring in pieces while the consumer keeps reading.
+         */
+        class spsc_ring {
+            struct header {
+                alignas(64) std::atomic<std::uint64_t> head; // bytes read
+                alignas(64) std::atomic<std::uint64_t> tail; // bytes written
+            };
+
+            header* _header = nullptr;
+            char* _bytes = nullptr;
+            std::size_t _capacity = 0;
+
+        public:
+            static constexpr std::size_t footprint(std::size_t capacity) noexcept {
+                return sizeof(header) + ((capacity + 63) / 64) * 64;
+            }
+
+            spsc_ring() = default;
+
+            /**
+             * @param memory is footprint(capacity) bytes aligned to 64 bytes.
+             * @param initialize is true only the first time a view of the memory is created.
+             */
+            spsc_ring(void* memory, std::size_t capacity, bool initialize)
+            : _header(static_cast<header*>(memory)), _bytes(static_cast<char*>(memory) + sizeof(header)), _capacity(capacity) {
+                if (initialize) {
+                    new (_header) header();
+                    _header->head.store(0, std::memory_order_relaxed);
+                    _header->tail.store(0, std::memory_order_relaxed);
+                }
+            }
+
+            /**
+             * @brief Producer side, writes the first bytes of data that fit in the ring.
+             * @return The amount of bytes written.
+             */
+            std::size_t write(const char* data, std::size_t size) noexcept {
+                std::uint64_t tail = _header->tail.load(std::memory_order_relaxed);
+                std::uint64_t head = _header->head.load(std::memory_order_acquire);
+                std::size_t n = std::min<std::size_t>(size, _capacity - (tail - head));
+                std::size_t offset = tail % _capacity;
+                std::size_t first = std::min(n, _capacity - offset);
+                std::memcpy(_bytes + offset, data, first);
+                std::memcpy(_bytes, data + first, n - first);
+                _header->tail.store(tail + n, std::memory_order_release);
+                return n;
+            }
+
+            /**
+             * @brief Consumer side, appends to out all the bytes written so far.
+             * @return The amount of bytes read.
+             */
+            std::size_t read(std::string& out) {
+                std::uint64_t head = _header->head.load(std::memory_order_relaxed);
+                std::uint64_t tail = _header->tail.load(std::memory_order_acquire);
+                std::size_t n = tail - head;
+                std::size_t offset = head % _capacity;
+                std::size_t first = std::min(n, _capacity - offset);
+                out.append(_bytes + offset, first);
+                out.append(_bytes, n - first);
+                _header->head.store(head + n, std::memory_order_release);
+                return n;
+            }
+        };
+
+        /**
+         * @brief Reusable barrier placed in memory shared by the processes waiting on it.
+         *
+         * @details
+         * While waiting, processes call the poll function, so they keep consuming the rings other
+         * processes may be blocked writing to. Waiting stops throwing std::runtime_error when the
+         * abort flag is set.
+         */
+        class process_barrier {
+            alignas(64) std::atomic<std::uint32_t> _arrived{0};
+            alignas(64) std::atomic<std::uint32_t> _generation{0};
+            std::atomic<bool> _aborted{false};
+
+        public:
+            template<typename POLL>
+            void wait(std::uint32_t participants, POLL&& poll) {
+                std::uint32_t generation = _generation.load(std::memory_order_acquire);
+                if (_arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == participants) {
+                    _arrived.store(0, std::memory_order_relaxed);
+                    _generation.store(generation + 1, std::memory_order_release);
+                    return;
+                }
+                for (unsigned spins = 0; _generation.load(std::memory_order_acquire) == generation; spins++) {
+                    if (_aborted.load(std::memory_order_relaxed)) {
+                        throw std::runtime_error("Barrier aborted by another process");
+                    }
+                    poll();
+                    if (spins >= CADMIUM_SHM_SPIN_LIMIT) {
+                        ::sched_yield();
+                    }
+                }
+            }
+
+            void abort() noexcept {
+                _aborted.store(true, std::memory_order_release);
+            }
+
+            bool aborted() const noexcept {
+                return _aborted.load(std::memory_order_acquire);
+            }
+        };
+    }
+}
+
+#endif //CADMIUM_SHARED_MEMORY_CHANNELS_HPP
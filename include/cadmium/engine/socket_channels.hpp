@@ -0,0 +1,353 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef CADMIUM_SOCKET_CHANNELS_HPP
+#define CADMIUM_SOCKET_CHANNELS_HPP
+
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/* largest frame a connection accepts by default, so a corrupt size does not allocate without bound */
+#ifndef CADMIUM_SOCKET_MAX_FRAME_BYTES
+#define CADMIUM_SOCKET_MAX_FRAME_BYTES (std::uint64_t(1) << 30)
+#endif
+
+namespace cadmium {
+    namespace concurrency {
+
+        /**
+         * @brief Address of a stream socket, a TCP host and port or the path of a Unix domain socket.
+         */
+        class socket_address {
+            bool _unix = false;
+            std::string _host; // or the path of the Unix domain socket
+            std::uint16_t _port = 0;
+
+            socket_address(bool is_unix, std::string host, std::uint16_t port) : _unix(is_unix), _host(std::move(host)), _port(port) {}
+
+        public:
+            /**
+             * @param port 0 lets the listener choose a free port, see socket_listener::address.
+             */
+            static socket_address tcp(const std::string& host, std::uint16_t port) {
+                return socket_address(false, host, port);
+            }
+
+            static socket_address unix_domain(const std::string& path) {
+                if (path.size() >= sizeof(sockaddr_un::sun_path)) {
+                    throw std::domain_error("Unix domain socket path too long: " + path);
+                }
+                return socket_address(true, path, 0);
+            }
+
+            bool is_unix_domain() const noexcept {
+                return _unix;
+            }
+
+            const std::string& host() const noexcept {
+                return _host;
+            }
+
+            const std::string& path() const noexcept {
+                return _host;
+            }
+
+            std::uint16_t port() const noexcept {
+                return _port;
+            }
+
+            std::string to_string() const {
+                return _unix ? "unix:" + _host : _host + ":" + std::to_string(_port);
+            }
+
+            /**
+             * @brief Calls f(family, address, length) for each resolved address until one returns true.
+             * @return if any call returned true.
+             */
+            template<typename F>
+            bool for_each_resolved(F&& f) const {
+                if (_unix) {
+                    sockaddr_un address{};
+                    address.sun_family = AF_UNIX;
+                    std::memcpy(address.sun_path, _host.c_str(), _host.size() + 1);
+                    return f(AF_UNIX, reinterpret_cast<const sockaddr*>(&address), static_cast<socklen_t>(sizeof(address)));
+                }
+                addrinfo hints{};
+                hints.ai_family = AF_UNSPEC;
+                hints.ai_socktype = SOCK_STREAM;
+                hints.ai_flags = AI_NUMERICSERV;
+                addrinfo* resolved = nullptr;
+                int error = ::getaddrinfo(_host.empty() ? nullptr : _host.c_str(), std::to_string(_port).c_str(), &hints, &resolved);
+                if (error != 0) {
+                    throw std::runtime_error("Unable to resolve " + to_string() + ": " + ::gai_strerror(error));
+                }
+                bool done = false;
+                for (addrinfo* a = resolved; a != nullptr && !done; a = a->ai_next) {
+                    done = f(a->ai_family, a->ai_addr, a->ai_addrlen);
+                }
+                ::freeaddrinfo(resolved);
+                return done;
+            }
+        };
+
+        /**
+         * @brief Connected stream socket exchanging frames, each one a 64 bits length and its bytes.
+         */
+        class socket_connection {
+            int _fd = -1;
+            std::uint64_t _max_frame_bytes = CADMIUM_SOCKET_MAX_FRAME_BYTES;
+
+            void write_all(const char* data, std::size_t size) {
+                while (size > 0) {
+                    ssize_t written = ::send(_fd, data, size, MSG_NOSIGNAL);
+                    if (written < 0) {
+                        if (errno == EINTR) {
+                            continue;
+                        }
+                        throw std::system_error(errno, std::generic_category(), "send");
+                    }
+                    data += written;
+                    size -= static_cast<std::size_t>(written);
+                }
+            }
+
+            void read_all(char* data, std::size_t size) {
+                while (size > 0) {
+                    ssize_t read = ::recv(_fd, data, size, 0);
+                    if (read < 0) {
+                        if (errno == EINTR) {
+                            continue;
+                        }
+                        throw std::system_error(errno, std::generic_category(), "recv");
+                    }
+                    if (read == 0) {
+                        throw std::runtime_error("Connection closed by the peer");
+                    }
+                    data += read;
+                    size -= static_cast<std::size_t>(read);
+                }
+            }
+
+        public:
+            socket_connection() = default;
+
+            explicit socket_connection(int fd) : _fd(fd) {
+                int one = 1;
+                // frames are sent whole, so there is nothing to gain from delaying them
+                ::setsockopt(_fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            }
+
+            socket_connection(socket_connection&& other) noexcept
+                    : _fd(std::exchange(other._fd, -1)), _max_frame_bytes(other._max_frame_bytes) {}
+
+            socket_connection& operator=(socket_connection&& other) noexcept {
+                if (this != &other) {
+                    close();
+                    _fd = std::exchange(other._fd, -1);
+                    _max_frame_bytes = other._max_frame_bytes;
+                }
+                return *this;
+            }
+
+            ~socket_connection() {
+                close();
+            }
+
+            /**
+             * @brief Connects to a listener, retrying while it is not listening yet.
+             */
+            static socket_connection connect(const socket_address& address, unsigned attempts = 200, std::chrono::milliseconds retry_delay = std::chrono::milliseconds(25)) {
+                int last_error = 0;
+                for (unsigned attempt = 0; attempt < attempts; attempt++) {
+                    int fd = -1;
+                    bool connected = address.for_each_resolved([&fd, &last_error](int family, const sockaddr* a, socklen_t length) {
+                        fd = ::socket(family, SOCK_STREAM | SOCK_CLOEXEC, 0);
+                        if (fd < 0) {
+                            last_error = errno;
+                            return false;
+                        }
+                        if (::connect(fd, a, length) == 0) {
+                            return true;
+                        }
+                        last_error = errno;
+                        ::close(fd);
+                        fd = -1;
+                        return false;
+                    });
+                    if (connected) {
+                        return socket_connection(fd);
+                    }
+                    std::this_thread::sleep_for(retry_delay);
+                }
+                throw std::system_error(last_error, std::generic_category(), "Unable to connect to " + address.to_string());
+            }
+
+            bool is_open() const noexcept {
+                return _fd >= 0;
+            }
+
+            void close() noexcept {
+                if (_fd >= 0) {
+                    ::close(_fd);
+                    _fd = -1;
+                }
+            }
+
+            void send_frame(const std::string& payload) {
+                std::uint64_t size = payload.size();
+                write_all(reinterpret_cast<const char*>(&size), sizeof(size));
+                write_all(payload.data(), payload.size());
+            }
+
+            /**
+             * @brief Sets the largest frame receive_frame accepts, CADMIUM_SOCKET_MAX_FRAME_BYTES by default.
+             */
+            void set_max_frame_bytes(std::uint64_t bytes) noexcept {
+                _max_frame_bytes = bytes;
+            }
+
+            std::uint64_t max_frame_bytes() const noexcept {
+                return _max_frame_bytes;
+            }
+
+            /**
+             * @brief Receives the next frame in payload, replacing its content.
+             * @throw std::runtime_error if the frame is larger than max_frame_bytes.
+             */
+            void receive_frame(std::string& payload) {
+                std::uint64_t size;
+                read_all(reinterpret_cast<char*>(&size), sizeof(size));
+                if (size > _max_frame_bytes) {
+                    throw std::runtime_error("Frame of " + std::to_string(size) + " bytes exceeds the limit of " +
+                                             std::to_string(_max_frame_bytes) + " bytes");
+                }
+                payload.resize(size);
+                if (size > 0) {
+                    read_all(&payload[0], size);
+                }
+            }
+        };
+
+        /**
+         * @brief Stream socket listening for connections, the path of a Unix domain socket is
+         * removed when the listener is destroyed.
+         */
+        class socket_listener {
+            int _fd = -1;
+            socket_address _address;
+
+        public:
+            explicit socket_listener(const socket_address& address, int backlog = 64) : _address(address) {
+                if (address.is_unix_domain()) {
+                    ::unlink(address.path().c_str());
+                }
+                int last_error = 0;
+                bool bound = address.for_each_resolved([this, &last_error](int family, const sockaddr* a, socklen_t length) {
+                    _fd = ::socket(family, SOCK_STREAM | SOCK_CLOEXEC, 0);
+                    if (_fd < 0) {
+                        last_error = errno;
+                        return false;
+                    }
+                    int one = 1;
+                    ::setsockopt(_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+                    if (::bind(_fd, a, length) == 0) {
+                        return true;
+                    }
+                    last_error = errno;
+                    ::close(_fd);
+                    _fd = -1;
+                    return false;
+                });
+                if (!bound) {
+                    throw std::system_error(last_error, std::generic_category(), "Unable to bind " + address.to_string());
+                }
+                if (::listen(_fd, backlog) != 0) {
+                    int error = errno;
+                    ::close(_fd);
+                    throw std::system_error(error, std::generic_category(), "listen");
+                }
+                if (!address.is_unix_domain() && address.port() == 0) {
+                    sockaddr_storage bound_address{};
+                    socklen_t length = sizeof(bound_address);
+                    ::getsockname(_fd, reinterpret_cast<sockaddr*>(&bound_address), &length);
+                    std::uint16_t port = bound_address.ss_family == AF_INET6
+                            ? ntohs(reinterpret_cast<sockaddr_in6*>(&bound_address)->sin6_port)
+                            : ntohs(reinterpret_cast<sockaddr_in*>(&bound_address)->sin_port);
+                    _address = socket_address::tcp(address.host(), port);
+                }
+            }
+
+            socket_listener(const socket_listener&) = delete;
+            socket_listener& operator=(const socket_listener&) = delete;
+
+            ~socket_listener() {
+                if (_fd >= 0) {
+                    ::close(_fd);
+                    if (_address.is_unix_domain()) {
+                        ::unlink(_address.path().c_str());
+                    }
+                }
+            }
+
+            /**
+             * @return The address the listener is bound to, with the chosen port when created with port 0.
+             */
+            const socket_address& address() const noexcept {
+                return _address;
+            }
+
+            socket_connection accept() {
+                for (;;) {
+                    int fd = ::accept(_fd, nullptr, nullptr);
+                    if (fd >= 0) {
+                        return socket_connection(fd);
+                    }
+                    if (errno != EINTR) {
+                        throw std::system_error(errno, std::generic_category(), "accept");
+                    }
+                }
+            }
+        };
+    }
+}
+
+#endif //CADMIUM_SOCKET_CHANNELS_HPP
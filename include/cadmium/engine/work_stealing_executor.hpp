@@ -0,0 +1,288 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CADMIUM_WORK_STEALING_EXECUTOR_HPP
+#define CADMIUM_WORK_STEALING_EXECUTOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cadmium {
+    namespace concurrency {
+
+        /**
+         * @brief Counter that blocks waiting threads until it is decremented to zero.
+         */
+        class latch {
+            std::size_t _count = 0;
+            std::mutex _mutex;
+            std::condition_variable _zero;
+
+        public:
+            void reset(std::size_t count) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _count = count;
+            }
+
+            void count_down() {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (--_count == 0) {
+                    _zero.notify_all();
+                }
+            }
+
+            void wait() {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _zero.wait(lock, [this]() { return _count == 0; });
+            }
+        };
+
+        /**
+         * @brief Executor running parallel loops in a fixed set of std::threads.
+         *
+         * @details
+         * Each loop is split in chunks of consecutive indexes, and every participant starts with a
+         * contiguous range of chunks. Ranges are lock-free deques: the owner takes chunks from the front
+         * and, once its range is empty, it steals chunks from the back of the ranges of the other
+         * participants. The thread calling parallel_for participates in the loop, and it returns
+         * when every worker arrived to the join latch. Running a loop allocates no memory.
+         *
+         * A parallel_for called while another one is running in the same executor, as it happens
+         * with nested coordinators, runs sequentially in the calling thread.
+         */
+        class work_stealing_executor {
+            // chunks to split the loop in for each participant, allows balancing uneven costs
+            static constexpr std::size_t chunks_by_participant = 4;
+
+            // range of chunks [begin, end) packed in a word to update both ends atomically
+            struct alignas(64) chunk_range {
+                std::atomic<std::uint64_t> bounds{0};
+
+                static std::uint64_t pack(std::uint32_t begin, std::uint32_t end) {
+                    return (static_cast<std::uint64_t>(end) << 32) | begin;
+                }
+
+                void assign(std::uint32_t begin, std::uint32_t end) {
+                    bounds.store(pack(begin, end), std::memory_order_relaxed);
+                }
+
+                bool pop_front(std::uint32_t& chunk) {
+                    std::uint64_t current = bounds.load(std::memory_order_relaxed);
+                    while (true) {
+                        std::uint32_t begin = static_cast<std::uint32_t>(current);
+                        std::uint32_t end = static_cast<std::uint32_t>(current >> 32);
+                        if (begin >= end) {
+                            return false;
+                        }
+                        if (bounds.compare_exchange_weak(current, pack(begin + 1, end), std::memory_order_acq_rel)) {
+                            chunk = begin;
+                            return true;
+                        }
+                    }
+                }
+
+                bool steal_back(std::uint32_t& chunk) {
+                    std::uint64_t current = bounds.load(std::memory_order_relaxed);
+                    while (true) {
+                        std::uint32_t begin = static_cast<std::uint32_t>(current);
+                        std::uint32_t end = static_cast<std::uint32_t>(current >> 32);
+                        if (begin >= end) {
+                            return false;
+                        }
+                        if (bounds.compare_exchange_weak(current, pack(begin, end - 1), std::memory_order_acq_rel)) {
+                            chunk = end - 1;
+                            return true;
+                        }
+                    }
+                }
+            };
+
+            std::vector<std::thread> _workers;
+            std::vector<chunk_range> _ranges; // one by participant, the caller uses the last one
+
+            // current loop, type erased to avoid allocating it
+            void (*_body)(void*, std::size_t) = nullptr;
+            void* _context = nullptr;
+            std::size_t _size = 0;
+            std::size_t _chunk_size = 1;
+
+            std::mutex _mutex;
+            std::condition_variable _start;
+            std::uint64_t _generation = 0;
+            bool _stop = false;
+            latch _join;
+
+            std::atomic<bool> _running{false};
+            std::mutex _error_mutex;
+            std::exception_ptr _error;
+
+            template<typename FUNC>
+            static void invoke(void* context, std::size_t i) {
+                (*static_cast<FUNC*>(context))(i);
+            }
+
+            void run_chunk(std::uint32_t chunk) {
+                std::size_t first = chunk * _chunk_size;
+                std::size_t last = std::min(_size, first + _chunk_size);
+                for (std::size_t i = first; i < last; i++) {
+                    _body(_context, i);
+                }
+            }
+
+            void work(std::size_t participant) {
+                std::uint32_t chunk;
+                try {
+                    while (_ranges[participant].pop_front(chunk)) {
+                        run_chunk(chunk);
+                    }
+                    for (std::size_t offset = 1; offset < _ranges.size(); offset++) {
+                        chunk_range& victim = _ranges[(participant + offset) % _ranges.size()];
+                        while (victim.steal_back(chunk)) {
+                            run_chunk(chunk);
+                        }
+                    }
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(_error_mutex);
+                    if (!_error) {
+                        _error = std::current_exception();
+                    }
+                    // the remaining chunks are discarded
+                    for (auto& r : _ranges) {
+                        while (r.steal_back(chunk)) {}
+                    }
+                }
+            }
+
+            void worker_loop(std::size_t participant) {
+                std::uint64_t seen = 0;
+                while (true) {
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        _start.wait(lock, [this, seen]() { return _stop || _generation != seen; });
+                        if (_stop) {
+                            return;
+                        }
+                        seen = _generation;
+                    }
+                    work(participant);
+                    _join.count_down();
+                }
+            }
+
+        public:
+            /**
+             * @param thread_count is the number of threads running each loop, including the caller.
+             */
+            explicit work_stealing_executor(std::size_t thread_count = std::thread::hardware_concurrency())
+            : _ranges(thread_count == 0 ? 1 : thread_count) {
+                for (std::size_t i = 0; i + 1 < _ranges.size(); i++) {
+                    _workers.emplace_back(&work_stealing_executor::worker_loop, this, i);
+                }
+            }
+
+            work_stealing_executor(const work_stealing_executor&) = delete;
+            work_stealing_executor& operator=(const work_stealing_executor&) = delete;
+
+            ~work_stealing_executor() {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _stop = true;
+                }
+                _start.notify_all();
+                for (auto& w : _workers) {
+                    w.join();
+                }
+            }
+
+            std::size_t thread_count() const noexcept {
+                return _ranges.size();
+            }
+
+            /**
+             * @brief Runs f(i) for every i in [0, size) and returns when all of them finished.
+             * The first exception thrown by f is rethrown once the loop is joined.
+             */
+            template<typename FUNC>
+            void parallel_for(std::size_t size, FUNC& f) {
+                if (size == 0) {
+                    return;
+                }
+                if (_workers.empty() || size == 1 || _running.exchange(true, std::memory_order_acquire)) {
+                    for (std::size_t i = 0; i < size; i++) {
+                        f(i);
+                    }
+                    return;
+                }
+
+                std::size_t participants = _ranges.size();
+                std::size_t chunks = std::min(size, participants * chunks_by_participant);
+                _body = &work_stealing_executor::invoke<FUNC>;
+                _context = &f;
+                _size = size;
+                _chunk_size = (size + chunks - 1) / chunks;
+                chunks = (size + _chunk_size - 1) / _chunk_size;
+                for (std::size_t p = 0; p < participants; p++) {
+                    _ranges[p].assign(static_cast<std::uint32_t>(chunks * p / participants), static_cast<std::uint32_t>(chunks * (p + 1) / participants));
+                }
+                _error = nullptr;
+                _join.reset(_workers.size());
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _generation++;
+                }
+                _start.notify_all();
+
+                work(participants - 1);
+                _join.wait();
+
+                std::exception_ptr error = _error;
+                _running.store(false, std::memory_order_release);
+                if (error) {
+                    std::rethrow_exception(error);
+                }
+            }
+        };
+
+        /*
+         * for_each that runs using a work stealing executor, and waits for all elements to be processed
+         * until it returns
+         */
+        template<typename ITERATOR, typename FUNC>
+        void concurrent_for_each(work_stealing_executor& executor, ITERATOR first, ITERATOR last, FUNC& f) {
+            auto process_element = [&first, &f](std::size_t i) -> void { f(*std::next(first, i)); };
+            executor.parallel_for(std::distance(first, last), process_element);
+        }
+    }
+}
+
+#endif //CADMIUM_WORK_STEALING_EXECUTOR_HPP
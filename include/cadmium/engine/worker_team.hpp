@@ -0,0 +1,498 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CADMIUM_WORKER_TEAM_HPP
+#define CADMIUM_WORKER_TEAM_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <cctype>
+#include <cstdlib>
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#endif //__linux__
+
+/* below this amount of selected elements a phase runs in the calling thread */
+#ifndef CADMIUM_TEAM_SEQUENTIAL_THRESHOLD
+#define CADMIUM_TEAM_SEQUENTIAL_THRESHOLD 8
+#endif
+
+/* busy waiting iterations before yielding the processor while waiting for a phase */
+#ifndef CADMIUM_TEAM_SPIN_LIMIT
+#define CADMIUM_TEAM_SPIN_LIMIT 4096
+#endif
+
+/* reallocates the models owned by each participant from its thread, placing them on its NUMA node */
+#ifndef CADMIUM_TEAM_FIRST_TOUCH
+#define CADMIUM_TEAM_FIRST_TOUCH 1
+#endif
+
+/* steps between rebalances of the models owned by each participant, 0 keeps the owners fixed */
+#ifndef CADMIUM_TEAM_REBALANCE_STEPS
+#define CADMIUM_TEAM_REBALANCE_STEPS 0
+#endif
+
+/* ratio between the busiest participant and the average that triggers a rebalance */
+#ifndef CADMIUM_TEAM_REBALANCE_THRESHOLD
+#define CADMIUM_TEAM_REBALANCE_THRESHOLD 1.1
+#endif
+
+namespace cadmium {
+    namespace concurrency {
+
+        /**
+         * @brief NUMA node of a processor, 0 when the system does not tell it.
+         */
+        inline std::size_t numa_node_of_cpu(int cpu) {
+            std::size_t node = 0;
+            #ifdef __linux__
+            std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+            if (DIR* dir = opendir(path.c_str())) {
+                while (dirent* entry = readdir(dir)) {
+                    if (std::string(entry->d_name).compare(0, 4, "node") == 0 && std::isdigit(static_cast<unsigned char>(entry->d_name[4]))) {
+                        node = std::strtoul(entry->d_name + 4, nullptr, 10);
+                        break;
+                    }
+                }
+                closedir(dir);
+            }
+            #endif //__linux__
+            return node;
+        }
+
+        /**
+         * @brief Processors allowed to the process sorted by NUMA node, so consecutive slots share
+         * a node. Empty when the affinity is unknown or there is a single processor.
+         */
+        inline std::vector<int> cpus_by_numa_node() {
+            std::vector<std::pair<std::size_t, int>> sorted;
+            #ifdef __linux__
+            cpu_set_t allowed;
+            CPU_ZERO(&allowed);
+            if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0 && CPU_COUNT(&allowed) > 1) {
+                for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+                    if (CPU_ISSET(cpu, &allowed)) {
+                        sorted.emplace_back(numa_node_of_cpu(cpu), cpu);
+                    }
+                }
+            }
+            #endif //__linux__
+            std::stable_sort(sorted.begin(), sorted.end());
+            std::vector<int> cpus;
+            for (const auto& s : sorted) {
+                cpus.push_back(s.second);
+            }
+            return cpus;
+        }
+
+        /**
+         * @brief Persistent team of threads running the phases of a simulation step.
+         *
+         * @details
+         * A phase runs f(p) once for every participant p, the thread calling run_phase is the last
+         * participant. While the team is active workers busy wait for the next phase instead of
+         * sleeping, and the caller busy waits for the workers to arrive at the end of the phase,
+         * so a phase costs a couple of cache line transfers by worker. Otherwise workers sleep
+         * and are notified of each phase. Runners keep the team active during run_until.
+         *
+         * On Linux workers are pinned, each one to a different processor allowed to the process,
+         * leaving the first one to the calling thread, which is pinned to it while an active_scope
+         * or a caller_scope lives and gets its previous affinity back after. Processors are taken node by node, so
+         * participants with consecutive indexes, which own neighbor blocks of models, share their
+         * NUMA node as much as possible.
+         *
+         * A run_phase called while another one is running in the same team, as it happens with
+         * nested coordinators, runs every participant sequentially in the calling thread.
+         */
+        class worker_team {
+            std::vector<std::thread> _workers;
+
+            // current phase, type erased to avoid allocating it
+            void (*_body)(void*, std::size_t) = nullptr;
+            void* _context = nullptr;
+
+            alignas(64) std::atomic<std::uint64_t> _phase{0};
+            alignas(64) std::atomic<std::size_t> _pending{0};
+            alignas(64) std::atomic<bool> _active{false};
+            std::atomic<bool> _running{false};
+
+            std::mutex _mutex;
+            std::condition_variable _wake;
+            bool _stop = false;
+
+            std::mutex _error_mutex;
+            std::exception_ptr _error;
+
+            // NUMA node of the processor of each participant
+            std::vector<std::size_t> _nodes;
+
+            // processor of the calling thread, negative when not pinned, and the affinity it had
+            int _caller_cpu = -1;
+            std::size_t _caller_pins = 0;
+            #ifdef __linux__
+            cpu_set_t _caller_affinity;
+            #endif //__linux__
+
+            template<typename FUNC>
+            static void invoke(void* context, std::size_t participant) {
+                (*static_cast<FUNC*>(context))(participant);
+            }
+
+            static void relax(unsigned& spins) {
+                if (++spins >= CADMIUM_TEAM_SPIN_LIMIT) {
+                    spins = 0;
+                    std::this_thread::yield();
+                }
+            }
+
+            void work(std::size_t participant) {
+                try {
+                    _body(_context, participant);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(_error_mutex);
+                    if (!_error) {
+                        _error = std::current_exception();
+                    }
+                }
+            }
+
+            void worker_loop(std::size_t participant) {
+                std::uint64_t seen = 0;
+                unsigned spins = 0;
+                while (true) {
+                    std::uint64_t phase = _phase.load(std::memory_order_acquire);
+                    if (phase == seen) {
+                        if (_active.load(std::memory_order_relaxed)) {
+                            relax(spins);
+                        } else {
+                            std::unique_lock<std::mutex> lock(_mutex);
+                            _wake.wait(lock, [this, seen]() {
+                                return _stop || _active.load(std::memory_order_relaxed) || _phase.load(std::memory_order_relaxed) != seen;
+                            });
+                            if (_stop) {
+                                return;
+                            }
+                        }
+                        continue;
+                    }
+                    seen = phase;
+                    work(participant);
+                    _pending.fetch_sub(1, std::memory_order_acq_rel);
+                }
+            }
+
+            static void pin(std::thread& t, int cpu) {
+                #ifdef __linux__
+                cpu_set_t pinned;
+                CPU_ZERO(&pinned);
+                CPU_SET(cpu, &pinned);
+                pthread_setaffinity_np(t.native_handle(), sizeof(pinned), &pinned);
+                #endif //__linux__
+            }
+
+            void pin_caller() {
+                if (_caller_cpu < 0 || _caller_pins++ > 0) {
+                    return;
+                }
+                #ifdef __linux__
+                pthread_getaffinity_np(pthread_self(), sizeof(_caller_affinity), &_caller_affinity);
+                cpu_set_t pinned;
+                CPU_ZERO(&pinned);
+                CPU_SET(_caller_cpu, &pinned);
+                pthread_setaffinity_np(pthread_self(), sizeof(pinned), &pinned);
+                #endif //__linux__
+            }
+
+            void unpin_caller() {
+                if (_caller_cpu < 0 || --_caller_pins > 0) {
+                    return;
+                }
+                #ifdef __linux__
+                pthread_setaffinity_np(pthread_self(), sizeof(_caller_affinity), &_caller_affinity);
+                #endif //__linux__
+            }
+
+        public:
+            /**
+             * @param thread_count is the number of participants of each phase, including the caller.
+             * @param pin_threads pins each worker to a processor when supported.
+             */
+            explicit worker_team(std::size_t thread_count = std::thread::hardware_concurrency(), bool pin_threads = true) {
+                std::size_t participants = thread_count == 0 ? 1 : thread_count;
+                std::vector<int> cpus;
+                if (pin_threads) {
+                    cpus = cpus_by_numa_node();
+                }
+                _nodes.assign(participants, 0);
+                for (std::size_t p = 0; p + 1 < participants; p++) {
+                    _workers.emplace_back(&worker_team::worker_loop, this, p);
+                    if (!cpus.empty()) {
+                        int cpu = cpus[(p + 1) % cpus.size()];
+                        pin(_workers.back(), cpu);
+                        _nodes[p] = numa_node_of_cpu(cpu);
+                    }
+                }
+                if (!cpus.empty() && !_workers.empty()) {
+                    _caller_cpu = cpus[0];
+                    _nodes[participants - 1] = numa_node_of_cpu(_caller_cpu);
+                }
+            }
+
+            worker_team(const worker_team&) = delete;
+            worker_team& operator=(const worker_team&) = delete;
+
+            ~worker_team() {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _stop = true;
+                    _active.store(false, std::memory_order_relaxed);
+                }
+                _wake.notify_all();
+                for (auto& w : _workers) {
+                    w.join();
+                }
+            }
+
+            std::size_t size() const noexcept {
+                return _workers.size() + 1;
+            }
+
+            /**
+             * @brief NUMA node of the processor the participant is pinned to, 0 when not pinned. The
+             * calling thread is the last participant, pinned to the first processor by active_scope
+             * and caller_scope.
+             */
+            std::size_t node_of(std::size_t participant) const {
+                return _nodes[participant];
+            }
+
+            /**
+             * @brief Makes the workers busy wait for phases until deactivate is called.
+             */
+            void activate() {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _active.store(true, std::memory_order_relaxed);
+                }
+                _wake.notify_all();
+            }
+
+            /**
+             * @brief Lets the workers sleep between phases.
+             */
+            void deactivate() {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _active.store(false, std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief Pins the calling thread to the processor of the last participant during its
+             * lifetime, restoring its previous affinity after. Scopes can be nested.
+             */
+            class caller_scope {
+                worker_team& _team;
+
+            public:
+                explicit caller_scope(worker_team& team) : _team(team) {
+                    _team.pin_caller();
+                }
+
+                caller_scope(const caller_scope&) = delete;
+                caller_scope& operator=(const caller_scope&) = delete;
+
+                ~caller_scope() {
+                    _team.unpin_caller();
+                }
+            };
+
+            /**
+             * @brief Keeps a team active, and the calling thread pinned, during its lifetime.
+             */
+            class active_scope {
+                worker_team& _team;
+                caller_scope _pinned;
+
+            public:
+                explicit active_scope(worker_team& team) : _team(team), _pinned(team) {
+                    _team.activate();
+                }
+
+                active_scope(const active_scope&) = delete;
+                active_scope& operator=(const active_scope&) = delete;
+
+                ~active_scope() {
+                    _team.deactivate();
+                }
+            };
+
+            /**
+             * @brief Runs f(p) for every participant p in [0, size()) and returns when all of them finished.
+             * The first exception thrown by f is rethrown once the phase is joined.
+             */
+            template<typename FUNC>
+            void run_phase(FUNC& f) {
+                if (_workers.empty() || _running.exchange(true, std::memory_order_acquire)) {
+                    for (std::size_t p = 0; p < size(); p++) {
+                        f(p);
+                    }
+                    return;
+                }
+
+                _body = &worker_team::invoke<FUNC>;
+                _context = &f;
+                _error = nullptr;
+                _pending.store(_workers.size(), std::memory_order_relaxed);
+                if (_active.load(std::memory_order_relaxed)) {
+                    _phase.fetch_add(1, std::memory_order_release);
+                } else {
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        _phase.fetch_add(1, std::memory_order_release);
+                    }
+                    _wake.notify_all();
+                }
+
+                work(_workers.size());
+                unsigned spins = 0;
+                while (_pending.load(std::memory_order_acquire) != 0) {
+                    relax(spins);
+                }
+
+                std::exception_ptr error = _error;
+                _running.store(false, std::memory_order_release);
+                if (error) {
+                    std::rethrow_exception(error);
+                }
+            }
+        };
+
+        /**
+         * @brief Indexes selected for a phase, split by the participant owning each of them.
+         */
+        class team_selection {
+            std::vector<std::vector<std::size_t>> _by_participant;
+            std::size_t _size = 0;
+
+        public:
+            /**
+             * @brief Empties the selection, keeping the memory of the previous ones.
+             */
+            void reset(std::size_t participants) {
+                _by_participant.resize(participants);
+                for (auto& s : _by_participant) {
+                    s.clear();
+                }
+                _size = 0;
+            }
+
+            void add(std::size_t participant, std::size_t index) {
+                _by_participant[participant].push_back(index);
+                _size++;
+            }
+
+            const std::vector<std::size_t>& of(std::size_t participant) const {
+                return _by_participant[participant];
+            }
+
+            std::size_t participants() const noexcept {
+                return _by_participant.size();
+            }
+
+            std::size_t size() const noexcept {
+                return _size;
+            }
+        };
+
+        /**
+         * @brief Owners of n indexes for a team of the given size, in contiguous blocks of similar size.
+         */
+        inline std::vector<std::size_t> contiguous_owners(std::size_t n, std::size_t participants) {
+            std::vector<std::size_t> owners(n);
+            for (std::size_t i = 0; i < n; i++) {
+                owners[i] = i * participants / n;
+            }
+            return owners;
+        }
+
+        /**
+         * @brief Owners of the indexes with the given costs for a team of the given size, in contiguous
+         * blocks of similar total cost. Each index goes to the participant where the middle of its
+         * cost falls, so the owners only change where the costs moved.
+         */
+        inline std::vector<std::size_t> balanced_owners(const std::vector<double>& costs, std::size_t participants) {
+            double total = 0;
+            for (double c : costs) {
+                total += c;
+            }
+            if (!(total > 0)) {
+                return contiguous_owners(costs.size(), participants);
+            }
+            std::vector<std::size_t> owners(costs.size());
+            double accumulated = 0;
+            for (std::size_t i = 0; i < costs.size(); i++) {
+                double middle = accumulated + costs[i] / 2;
+                owners[i] = std::min(participants - 1, static_cast<std::size_t>(middle * participants / total));
+                accumulated += costs[i];
+            }
+            return owners;
+        }
+
+        /**
+         * @brief Runs f(i) for every selected index i, in a team phase where each participant runs the
+         * indexes it owns. Small selections run in the calling thread.
+         */
+        template<typename FUNC>
+        void for_each_selected(worker_team* team, const team_selection& selection, FUNC& f) {
+            auto run_owned = [&selection, &f](std::size_t p) -> void {
+                if (p < selection.participants()) {
+                    for (std::size_t i : selection.of(p)) {
+                        f(i);
+                    }
+                }
+            };
+            if (team == nullptr || selection.size() < CADMIUM_TEAM_SEQUENTIAL_THRESHOLD) {
+                for (std::size_t p = 0; p < selection.participants(); p++) {
+                    run_owned(p);
+                }
+            } else {
+                team->run_phase(run_owned);
+            }
+        }
+    }
+}
+
+#endif //CADMIUM_WORKER_TEAM_HPP
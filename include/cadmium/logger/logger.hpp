@@ -29,6 +29,7 @@
 
 #include <sstream>
 #include <iostream>
+#include <type_traits>
 
 /**
   * Logging concepts
@@ -224,6 +225,25 @@ namespace cadmium {
                 multilogger_impl<LS...>::template log<DECLARED_SOURCE, EVENT, PARAMs...>(ps...);
             }
         };
+
+        /**
+         * @brief Checks at compile time if LOGGER records the information of DECLARED_SOURCE. It allows
+         * skipping the construction of the information to log when it is going to be filtered out.
+         * Unknown loggers are assumed to log every source.
+         */
+        template<typename LOGGER, typename DECLARED_SOURCE>
+        struct logs_source : std::true_type {};
+
+        template<typename LOGGER_SOURCE, class FORMATTER, typename SINK_PROVIDER, typename DECLARED_SOURCE>
+        struct logs_source<logger<LOGGER_SOURCE, FORMATTER, SINK_PROVIDER>, DECLARED_SOURCE>
+                : std::is_same<LOGGER_SOURCE, DECLARED_SOURCE> {};
+
+        template<typename... LS, typename DECLARED_SOURCE>
+        struct logs_source<multilogger<LS...>, DECLARED_SOURCE>
+                : std::disjunction<logs_source<LS, DECLARED_SOURCE>...> {};
+
+        template<typename LOGGER, typename DECLARED_SOURCE>
+        constexpr bool logs_source_v = logs_source<LOGGER, DECLARED_SOURCE>::value;
     }
 }
 
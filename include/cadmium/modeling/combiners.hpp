@@ -0,0 +1,80 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef CADMIUM_COMBINERS_HPP
+#define CADMIUM_COMBINERS_HPP
+
+/**
+ * Combiners fold the messages routed to a port in a single message, so models only interested in an
+ * aggregate of their inputs receive one message per port and step. A port declares its combiner in
+ * its definition:
+ *
+ *     struct total : public cadmium::in_port<int> { using combiner = cadmium::sum_combiner; };
+ *
+ * A combiner is default constructible and folds message into combined with
+ * void operator()(MSG& combined, const MSG& message) const. In a step, the dynamic engine routes
+ * the messages to a port following its couplings in the order they are declared, the static engine
+ * in the reverse order, and the messages of each coupling in the order the sender output them.
+ * Only latest_combiner depends on that order.
+ */
+namespace cadmium {
+
+    struct sum_combiner {
+        template<typename MSG>
+        void operator()(MSG& combined, const MSG& message) const {
+            combined += message;
+        }
+    };
+
+    struct min_combiner {
+        template<typename MSG>
+        void operator()(MSG& combined, const MSG& message) const {
+            if (message < combined) {
+                combined = message;
+            }
+        }
+    };
+
+    struct max_combiner {
+        template<typename MSG>
+        void operator()(MSG& combined, const MSG& message) const {
+            if (combined < message) {
+                combined = message;
+            }
+        }
+    };
+
+    //keeps the last message routed: the last one output through the last coupling declared of the port
+    //in the dynamic engine, through the first one in the static engine
+    struct latest_combiner {
+        template<typename MSG>
+        void operator()(MSG& combined, const MSG& message) const {
+            combined = message;
+        }
+    };
+}
+
+#endif //CADMIUM_COMBINERS_HPP
@@ -28,17 +28,50 @@
 #define CADMIUM_DYNAMIC_ATOMIC_HPP
 
 #include <map>
+#include <type_traits>
+#include <utility>
 #include <boost/any.hpp>
 #include <cadmium/modeling/dynamic_model.hpp>
 #include <cadmium/modeling/dynamic_message_bag.hpp>
 #include <cadmium/concept/concept_helpers.hpp>
 #include <cadmium/concept/atomic_model_assert.hpp>
 #include <cadmium/modeling/dynamic_models_helpers.hpp>
+#include <cadmium/modeling/state_codec.hpp>
+#include <cadmium/logger/common_loggers_helpers.hpp>
 
 namespace cadmium {
     namespace dynamic {
         namespace modeling {
 
+            /**
+             * @brief Checks if MODEL declares its lookahead, as a const lookahead() method returning TIME.
+             */
+            template<typename MODEL, typename TIME, typename = void>
+            struct declares_lookahead : std::false_type {};
+
+            template<typename MODEL, typename TIME>
+            struct declares_lookahead<MODEL, TIME, std::void_t<decltype(std::declval<const MODEL&>().lookahead())>>
+                    : std::is_convertible<decltype(std::declval<const MODEL&>().lookahead()), TIME> {};
+
+            /**
+             * @brief Checks if MODEL encodes its own data for checkpoints, declaring the methods
+             * void encode_state(std::string&) const and void decode_state(const char*&, const char*).
+             */
+            template<typename MODEL, typename = void>
+            struct declares_state_encoding : std::false_type {};
+
+            template<typename MODEL>
+            struct declares_state_encoding<MODEL, std::void_t<
+                    decltype(std::declval<const MODEL&>().encode_state(std::declval<std::string&>())),
+                    decltype(std::declval<MODEL&>().decode_state(std::declval<const char*&>(), std::declval<const char*>()))>>
+                    : std::true_type {};
+
+            /**
+             * @brief Type of the state member of MODEL.
+             */
+            template<typename MODEL>
+            using model_state_type = std::remove_cv_t<std::remove_reference_t<decltype(std::declval<MODEL&>().state)>>;
+
             /**
              * @brief atomic is a derived class from the base classes atomic_bastract and ATOMIC<TIME>
              * this allow using any ATOMIC<TIME> valid class with pointers as an atomic_abstract
@@ -48,6 +81,8 @@ namespace cadmium {
              * Because ATOMIC<TIME> methods arity are template dependent, this wrapper class uses
              * cadmium::dynamic::message_bags as these methods parameter and it forwards a correct
              * translation to the corresponding type in the wrapped ATOMIC<TIME> base class method.
+             * For simulation, the wrapper also keeps the model inbox and outbox as typed message bags
+             * addressed by the port position, so engines route messages into them with no translation.
              *
              * @tparam ATOMIC a valid atomic model class
              * @tparam TIME a valid TIME class to use along with the atomic model class as ATOMIC<TIME>
@@ -69,6 +104,12 @@ namespace cadmium {
                 using output_bags = typename make_message_bags<output_ports>::type;
                 using input_bags = typename make_message_bags<input_ports>::type;
 
+            private:
+                input_bags _inbox;
+                output_bags _outbox;
+
+            public:
+
                 atomic() {
                     static_assert(cadmium::concept::is_atomic<ATOMIC>::value(), "This is not an atomic model");
                     cadmium::concept::pdevs::atomic_model_assert<ATOMIC>();
@@ -144,6 +185,141 @@ namespace cadmium {
                 TIME time_advance() const override {
                     return model_type::time_advance();
                 }
+
+                TIME lookahead() const override {
+                    if constexpr (declares_lookahead<model_type, TIME>::value) {
+                        return model_type::lookahead();
+                    } else {
+                        return TIME();
+                    }
+                }
+
+                /**
+                 * @brief Copies the state member of the model, models with a state that is not copyable
+                 * keep the default behavior of throwing.
+                 */
+                boost::any save_state() const override {
+                    if constexpr (std::is_copy_constructible_v<model_state_type<model_type>> && std::is_copy_assignable_v<model_state_type<model_type>>) {
+                        return boost::any(model_type::state);
+                    } else {
+                        return atomic_abstract<TIME>::save_state();
+                    }
+                }
+
+                void restore_state(const boost::any& saved) override {
+                    if constexpr (std::is_copy_constructible_v<model_state_type<model_type>> && std::is_copy_assignable_v<model_state_type<model_type>>) {
+                        model_type::state = boost::any_cast<const model_state_type<model_type>&>(saved);
+                    } else {
+                        atomic_abstract<TIME>::restore_state(saved);
+                    }
+                }
+
+                /**
+                 * @brief Moves a copy of the state member made by the calling thread into the model, and
+                 * empties the inbox releasing its memory. Models with a state that is not copyable only
+                 * reallocate their inbox.
+                 */
+                void relocate() override {
+                    if constexpr (std::is_copy_constructible_v<model_state_type<model_type>> && std::is_move_assignable_v<model_state_type<model_type>>) {
+                        model_state_type<model_type> copy(model_type::state);
+                        model_type::state = std::move(copy);
+                    }
+                    if (inbox_empty()) {
+                        _inbox = input_bags();
+                    }
+                }
+
+                /**
+                 * @brief Copies the model if it is copy constructible, otherwise it throws.
+                 */
+                std::shared_ptr<atomic_abstract<TIME>> clone() const override {
+                    if constexpr (std::is_copy_constructible_v<atomic>) {
+                        return std::make_shared<atomic>(*this);
+                    } else {
+                        return atomic_abstract<TIME>::clone();
+                    }
+                }
+
+                /**
+                 * @brief Encodes the model with its own encode_state method if it declares one, or its
+                 * state member with cadmium::dynamic::state_codec. Otherwise it throws.
+                 */
+                void encode_state(std::string& out) const override {
+                    if constexpr (declares_state_encoding<model_type>::value) {
+                        model_type::encode_state(out);
+                    } else if constexpr (cadmium::dynamic::state_codec<model_state_type<model_type>>::defined) {
+                        cadmium::dynamic::state_codec<model_state_type<model_type>>::encode(model_type::state, out);
+                    } else {
+                        atomic_abstract<TIME>::encode_state(out);
+                    }
+                }
+
+                void decode_state(const char*& data, const char* end) override {
+                    if constexpr (declares_state_encoding<model_type>::value) {
+                        model_type::decode_state(data, end);
+                    } else if constexpr (cadmium::dynamic::state_codec<model_state_type<model_type>>::defined) {
+                        cadmium::dynamic::state_codec<model_state_type<model_type>>::decode(model_type::state, data, end);
+                    } else {
+                        atomic_abstract<TIME>::decode_state(data, end);
+                    }
+                }
+
+                void* input_slot(std::size_t port) override {
+                    return cadmium::dynamic::modeling::message_bag_slot(_inbox, port);
+                }
+
+                void* output_slot(std::size_t port) override {
+                    return cadmium::dynamic::modeling::message_bag_slot(_outbox, port);
+                }
+
+                bool inbox_empty() const override {
+                    return cadmium::dynamic::modeling::message_bags_empty(_inbox);
+                }
+
+                void clear_inbox() override {
+                    cadmium::dynamic::modeling::clear_message_bags(_inbox);
+                }
+
+                void clear_outbox() override {
+                    cadmium::dynamic::modeling::clear_message_bags(_outbox);
+                }
+
+                void add_to_inbox(cadmium::dynamic::message_bags& bags) override {
+                    cadmium::dynamic::modeling::fill_bags_from_map(bags, _inbox);
+                }
+
+                /**
+                 * @brief Collects the model output in the outbox, models declaring output(bags&) write it in
+                 * the cleared outbox, reusing the memory of the previous outputs.
+                 */
+                void collect_output() override {
+                    if constexpr (cadmium::concept::declares_output_in_place<model_type, output_bags>::value) {
+                        cadmium::dynamic::modeling::clear_message_bags(_outbox);
+                        model_type::output(_outbox);
+                    } else {
+                        _outbox = model_type::output();
+                    }
+                }
+
+                cadmium::dynamic::message_bags outbox_as_map() const override {
+                    cadmium::dynamic::message_bags bags;
+                    cadmium::dynamic::modeling::fill_map_from_bags(_outbox, bags);
+                    return bags;
+                }
+
+                std::string outbox_as_string() const override {
+                    std::ostringstream oss;
+                    cadmium::logger::print_messages_by_port(oss, _outbox);
+                    return oss.str();
+                }
+
+                void external_transition_from_inbox(TIME e) override {
+                    model_type::external_transition(e, _inbox);
+                }
+
+                void confluence_transition_from_inbox(TIME e) override {
+                    model_type::confluence_transition(e, _inbox);
+                }
             };
         }
     }
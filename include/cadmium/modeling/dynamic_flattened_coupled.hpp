@@ -0,0 +1,296 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CADMIUM_DYNAMIC_FLATTENED_COUPLED_HPP
+#define CADMIUM_DYNAMIC_FLATTENED_COUPLED_HPP
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+#include <cadmium/modeling/dynamic_model.hpp>
+#include <cadmium/modeling/dynamic_coupled.hpp>
+
+namespace cadmium {
+    namespace dynamic {
+        namespace modeling {
+
+            /**
+             * @brief Single level view of a coupled model hierarchy.
+             *
+             * All the atomic models of the hierarchy are listed in depth-first order and the couplings
+             * crossing the coupled levels are replaced by links routing directly from the atomic model
+             * generating the messages to the atomic model receiving them. EICs and EOCs connect the ports
+             * of the top coupled model with the atomic models.
+             */
+            template<typename TIME>
+            struct flattened_coupled {
+                struct coupling {
+                    std::size_t from; // atomic model index
+                    std::size_t to; // atomic model index
+                    std::shared_ptr<cadmium::dynamic::engine::link_abstract> link;
+                };
+
+                struct external_coupling {
+                    std::size_t model; // atomic model index
+                    std::shared_ptr<cadmium::dynamic::engine::link_abstract> link;
+                };
+
+                std::string id;
+                Models atomics;
+                std::vector<coupling> ic;
+                std::vector<external_coupling> eic;
+                std::vector<external_coupling> eoc;
+            };
+
+            namespace flattening {
+                /*
+                 * Each step of a coupling path is identified by the kind of coupling (0 for ICs and EOCs, 1 for EICs)
+                 * and its index in the coupled model. Sorting the flattened couplings by these paths keeps the same
+                 * order the messages have when routed level by level in the hierarchy.
+                 */
+                using coupling_path = std::vector<std::pair<int, std::size_t>>;
+
+                struct endpoint {
+                    std::size_t atomic;
+                    std::shared_ptr<cadmium::dynamic::engine::link_abstract> link; // nullptr for the atomic ports
+                    coupling_path path;
+                };
+
+                using endpoints = std::vector<endpoint>;
+                using endpoints_by_port = std::map<std::type_index, endpoints>;
+
+                // endpoints reachable from the ports of a model
+                struct model_endpoints {
+                    bool is_atomic = false;
+                    std::size_t atomic = 0;
+                    endpoints_by_port sources; // by output port
+                    endpoints_by_port sinks; // by input port
+                };
+
+                struct route {
+                    std::size_t from;
+                    std::size_t to;
+                    std::shared_ptr<cadmium::dynamic::engine::link_abstract> link;
+                    coupling_path path;
+                };
+
+                inline std::shared_ptr<cadmium::dynamic::engine::link_abstract> chain_links(
+                        const std::shared_ptr<cadmium::dynamic::engine::link_abstract>& first,
+                        const std::shared_ptr<cadmium::dynamic::engine::link_abstract>& second) {
+                    if (first == nullptr) {
+                        return second;
+                    }
+                    if (second == nullptr) {
+                        return first;
+                    }
+                    return first->chain(second);
+                }
+
+                inline endpoints find_endpoints(const model_endpoints& m, const endpoints_by_port& by_port, std::type_index port) {
+                    if (m.is_atomic) {
+                        return endpoints{endpoint{m.atomic, nullptr, coupling_path()}};
+                    }
+                    auto it = by_port.find(port);
+                    return it == by_port.end() ? endpoints() : it->second;
+                }
+
+                template<typename TIME>
+                model_endpoints flatten_model(const std::shared_ptr<model>& m, flattened_coupled<TIME>& flat, std::vector<route>& routes) {
+                    model_endpoints ret;
+                    std::shared_ptr<coupled<TIME>> m_coupled = std::dynamic_pointer_cast<coupled<TIME>>(m);
+                    if (m_coupled == nullptr) {
+                        if (std::dynamic_pointer_cast<atomic_abstract<TIME>>(m) == nullptr && std::dynamic_pointer_cast<asynchronus_atomic_abstract<TIME>>(m) == nullptr) {
+                            throw std::domain_error("Invalid submodel is neither coupled nor atomic");
+                        }
+                        ret.is_atomic = true;
+                        ret.atomic = flat.atomics.size();
+                        flat.atomics.push_back(m);
+                        return ret;
+                    }
+
+                    std::map<std::string, model_endpoints> submodels;
+                    for (const auto& sub : m_coupled->_models) {
+                        submodels.insert(std::make_pair(sub->get_id(), flatten_model<TIME>(sub, flat, routes)));
+                    }
+
+                    for (std::size_t i = 0; i < m_coupled->_ic.size(); i++) {
+                        const auto& ic = m_coupled->_ic[i];
+                        if (submodels.find(ic._from) == submodels.end() || submodels.find(ic._to) == submodels.end()) {
+                            throw std::domain_error("Internal coupling to invalid model");
+                        }
+                        const auto& from = submodels.at(ic._from);
+                        const auto& to = submodels.at(ic._to);
+                        for (const auto& source : find_endpoints(from, from.sources, ic._link->from_port_type_index())) {
+                            for (const auto& sink : find_endpoints(to, to.sinks, ic._link->to_port_type_index())) {
+                                route r{source.atomic, sink.atomic, chain_links(chain_links(source.link, ic._link), sink.link), sink.path};
+                                r.path.emplace_back(0, i);
+                                r.path.insert(r.path.end(), source.path.begin(), source.path.end());
+                                routes.push_back(r);
+                            }
+                        }
+                    }
+
+                    for (std::size_t i = 0; i < m_coupled->_eic.size(); i++) {
+                        const auto& eic = m_coupled->_eic[i];
+                        if (submodels.find(eic._to) == submodels.end()) {
+                            throw std::domain_error("External input coupling to invalid model");
+                        }
+                        const auto& to = submodels.at(eic._to);
+                        for (const auto& sink : find_endpoints(to, to.sinks, eic._link->to_port_type_index())) {
+                            endpoint e{sink.atomic, chain_links(eic._link, sink.link), sink.path};
+                            e.path.emplace_back(1, i);
+                            ret.sinks[eic._link->from_port_type_index()].push_back(e);
+                        }
+                    }
+
+                    for (std::size_t i = 0; i < m_coupled->_eoc.size(); i++) {
+                        const auto& eoc = m_coupled->_eoc[i];
+                        if (submodels.find(eoc._from) == submodels.end()) {
+                            throw std::domain_error("External output coupling from invalid model");
+                        }
+                        const auto& from = submodels.at(eoc._from);
+                        for (const auto& source : find_endpoints(from, from.sources, eoc._link->from_port_type_index())) {
+                            endpoint e{source.atomic, chain_links(source.link, eoc._link), coupling_path{{0, i}}};
+                            e.path.insert(e.path.end(), source.path.begin(), source.path.end());
+                            ret.sources[eoc._link->to_port_type_index()].push_back(e);
+                        }
+                    }
+                    return ret;
+                }
+            }
+
+            /**
+             * @brief Flattens a coupled model hierarchy into direct couplings between its atomic models.
+             *
+             * @note The messages received by an atomic model in the same bag are kept in the order the
+             * hierarchical coordinators deliver them when they come from the same kind of coupling (internal
+             * or external input) of the top model.
+             *
+             * @param top_model is the coupled model to flatten.
+             * @return the flattened view of top_model, sharing its atomic models.
+             */
+            template<typename TIME>
+            flattened_coupled<TIME> flatten(const std::shared_ptr<coupled<TIME>>& top_model) {
+                flattened_coupled<TIME> flat;
+                flat.id = top_model->get_id();
+
+                std::vector<flattening::route> routes;
+                flattening::model_endpoints top = flattening::flatten_model<TIME>(top_model, flat, routes);
+
+                auto by_destination = [](const auto& a, const auto& b) {
+                    return std::tie(a.to, a.path) < std::tie(b.to, b.path);
+                };
+                std::stable_sort(routes.begin(), routes.end(), by_destination);
+                for (const auto& r : routes) {
+                    flat.ic.push_back({r.from, r.to, r.link});
+                }
+
+                std::vector<flattening::route> input_routes;
+                for (const auto& port : top.sinks) {
+                    for (const auto& sink : port.second) {
+                        input_routes.push_back({0, sink.atomic, sink.link, sink.path});
+                    }
+                }
+                std::stable_sort(input_routes.begin(), input_routes.end(), by_destination);
+                for (const auto& r : input_routes) {
+                    flat.eic.push_back({r.to, r.link});
+                }
+
+                std::vector<flattening::route> output_routes;
+                for (const auto& port : top.sources) {
+                    for (const auto& source : port.second) {
+                        output_routes.push_back({source.atomic, 0, source.link, source.path});
+                    }
+                }
+                std::stable_sort(output_routes.begin(), output_routes.end(), [](const auto& a, const auto& b) { return a.path < b.path; });
+                for (const auto& r : output_routes) {
+                    flat.eoc.push_back({r.from, r.link});
+                }
+                return flat;
+            }
+
+            /**
+             * @brief Amount of atomic models in the hierarchy of m, they are contiguous in its flattened view.
+             */
+            template<typename TIME>
+            std::size_t count_atomics(const std::shared_ptr<model>& m) {
+                auto c = std::dynamic_pointer_cast<coupled<TIME>>(m);
+                if (c == nullptr) {
+                    return 1;
+                }
+                std::size_t count = 0;
+                for (const auto& child : c->_models) {
+                    count += count_atomics<TIME>(child);
+                }
+                return count;
+            }
+
+            /**
+             * @brief Reorders the atomic models of a flattened coupled model so the models of each part are
+             * contiguous, keeping their relative order. Couplings keep their order, so messages are
+             * delivered in the same order, with the model indexes renumbered.
+             *
+             * @param part_of is the part of each atomic model of flat_model.
+             */
+            template<typename TIME>
+            flattened_coupled<TIME> group_by_part(const flattened_coupled<TIME>& flat_model, const std::vector<std::size_t>& part_of) {
+                if (part_of.size() != flat_model.atomics.size()) {
+                    throw std::domain_error("Every atomic model must be assigned to a part");
+                }
+                std::vector<std::size_t> order(part_of.size());
+                for (std::size_t a = 0; a < order.size(); a++) {
+                    order[a] = a;
+                }
+                std::stable_sort(order.begin(), order.end(), [&part_of](std::size_t a, std::size_t b) { return part_of[a] < part_of[b]; });
+                std::vector<std::size_t> position(order.size());
+                flattened_coupled<TIME> grouped;
+                grouped.id = flat_model.id;
+                for (std::size_t i = 0; i < order.size(); i++) {
+                    position[order[i]] = i;
+                    grouped.atomics.push_back(flat_model.atomics[order[i]]);
+                }
+                for (const auto& ic : flat_model.ic) {
+                    grouped.ic.push_back({position[ic.from], position[ic.to], ic.link});
+                }
+                for (const auto& eic : flat_model.eic) {
+                    grouped.eic.push_back({position[eic.model], eic.link});
+                }
+                for (const auto& eoc : flat_model.eoc) {
+                    grouped.eoc.push_back({position[eoc.model], eoc.link});
+                }
+                return grouped;
+            }
+        }
+    }
+}
+
+#endif //CADMIUM_DYNAMIC_FLATTENED_COUPLED_HPP
@@ -30,10 +30,43 @@
 #include <boost/any.hpp>
 #include <map>
 #include <typeindex>
+#include <utility>
 
 namespace cadmium {
     namespace dynamic {
         using message_bags = std::map<std::type_index, boost::any>;
+
+        /**
+         * @brief Location of the messages of a port. Ports of atomic models are stored in typed slots,
+         * the cadmium::bag of the port, while ports of coupled models are stored in message_bags.
+         * When slot is not null it is used, otherwise the port is looked up in bags.
+         */
+        struct port_endpoint {
+            void* slot = nullptr;
+            message_bags* bags = nullptr;
+        };
+
+        /**
+         * @brief Moves the bags to spare, keeping their entries and the memory of their messages.
+         * The bags must be emptied before, only their storage is kept.
+         */
+        inline void release_message_bags(message_bags& bags, message_bags& spare) {
+            spare.merge(bags);
+            bags.clear();
+        }
+
+        /**
+         * @brief Moves back the bag of port from spare to bags, if it was released before and bags
+         * does not define it, so messages routed to the port reuse its memory.
+         */
+        inline void reuse_message_bag(message_bags& bags, message_bags& spare, std::type_index port) {
+            if (bags.find(port) == bags.end()) {
+                auto node = spare.extract(port);
+                if (!node.empty()) {
+                    bags.insert(std::move(node));
+                }
+            }
+        }
     }
 }
 
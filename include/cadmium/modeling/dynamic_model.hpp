@@ -28,7 +28,10 @@
 #define CADMIUM_ATOMIC_HPP
 
 #include <iostream>
+#include <memory>
+#include <stdexcept>
 #include <vector>
+#include <boost/any.hpp>
 #include <cadmium/modeling/dynamic_message_bag.hpp>
 #include <cadmium/engine/pdevs_dynamic_link.hpp>
 
@@ -127,6 +130,76 @@ namespace cadmium {
                 virtual void confluence_transition(TIME e, cadmium::dynamic::message_bags dynamic_bags) = 0;
                 virtual dynamic::message_bags output() const = 0;
                 virtual TIME time_advance() const = 0;
+
+                /**
+                 * @brief Minimum time between any transition of the model and its next output, used by
+                 * the conservative parallel engine to find the time windows models can be simulated
+                 * independently. Models declare it defining a TIME lookahead() const method, by default
+                 * it is zero.
+                 */
+                virtual TIME lookahead() const {
+                    return TIME();
+                }
+
+                /**
+                 * @brief Copies the model state, used by the optimistic engine to roll the model back.
+                 * By default models do not support it.
+                 */
+                virtual boost::any save_state() const {
+                    throw std::domain_error("The model " + this->get_id() + " does not support saving its state");
+                }
+
+                /**
+                 * @brief Restores a state returned by save_state.
+                 */
+                virtual void restore_state(const boost::any& saved) {
+                    throw std::domain_error("The model " + this->get_id() + " does not support restoring its state");
+                }
+
+                /**
+                 * @brief Reallocates the memory of the model from the calling thread, so that the first
+                 * touch policy of the operating system places it on the NUMA node of that thread.
+                 * By default models keep their memory.
+                 */
+                virtual void relocate() {}
+
+                /**
+                 * @brief Copy of the model, with its parameters and state, to simulate replications of a
+                 * model without building it again. By default models can not be copied.
+                 */
+                virtual std::shared_ptr<atomic_abstract<TIME>> clone() const {
+                    throw std::domain_error("The model " + this->get_id() + " can not be copied");
+                }
+
+                /**
+                 * @brief Appends the state of the model to out as bytes, used to checkpoint simulations.
+                 * By default models do not support it.
+                 */
+                virtual void encode_state(std::string& out) const {
+                    throw std::domain_error("The model " + this->get_id() + " does not support encoding its state");
+                }
+
+                /**
+                 * @brief Restores a state encoded by encode_state, moving data after it.
+                 */
+                virtual void decode_state(const char*& data, const char* end) {
+                    throw std::domain_error("The model " + this->get_id() + " does not support decoding its state");
+                }
+
+                // Typed port storage, ports are identified by their position in get_input_ports() and
+                // get_output_ports(). Each slot points to the cadmium::bag of the port messages, it allows
+                // routing messages without translating them from and to cadmium::dynamic::message_bags.
+                virtual void* input_slot(std::size_t port) = 0;
+                virtual void* output_slot(std::size_t port) = 0;
+                virtual bool inbox_empty() const = 0;
+                virtual void clear_inbox() = 0;
+                virtual void clear_outbox() = 0;
+                virtual void add_to_inbox(cadmium::dynamic::message_bags& dynamic_bags) = 0;
+                virtual void collect_output() = 0;
+                virtual dynamic::message_bags outbox_as_map() const = 0;
+                virtual std::string outbox_as_string() const = 0;
+                virtual void external_transition_from_inbox(TIME e) = 0;
+                virtual void confluence_transition_from_inbox(TIME e) = 0;
             };
 
             class AsyncEventSubject {
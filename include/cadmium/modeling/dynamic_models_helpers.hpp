@@ -139,8 +139,9 @@ namespace cadmium {
                     using bag_type = decltype(b);
                     using port_type = typename bag_type::port;
 
-                    if (bags.find(typeid(port_type)) != bags.end()) {
-                        bag_type b2 = boost::any_cast<bag_type>(bags.at(typeid(port_type)));
+                    auto it = bags.find(typeid(port_type));
+                    if (it != bags.end()) {
+                        const bag_type& b2 = boost::any_cast<const bag_type&>(it->second);
                         auto& current_bag = cadmium::get_messages<port_type>(bs);
                         current_bag.insert(
                                 current_bag.end(),
@@ -160,7 +161,7 @@ namespace cadmium {
              * @param bs  - The BST message bag that carries the message to be placed in the bags parameter.
              */
             template<typename BST>
-            void fill_map_from_bags(BST &bs, cadmium::dynamic::message_bags &bags) {
+            void fill_map_from_bags(const BST &bs, cadmium::dynamic::message_bags &bags) {
 
                 auto add_messages_to_map = [&bags](auto b) -> void {
                     using bag_type = decltype(b);
@@ -168,7 +169,59 @@ namespace cadmium {
 
                     bags[typeid(port_type)] = b;
                 };
-                cadmium::helper::for_each<BST>(bs, add_messages_to_map);
+                cadmium::helper::for_each<const BST>(bs, add_messages_to_map);
+            }
+
+            /**
+             * @brief Finds the messages of the bag in the given position of the bs message bags.
+             *
+             * @tparam BST The message bag tuple.
+             * @param bs - The BST message bags.
+             * @param index - The position of the bag in the tuple, the same of the port in create_dynamic_ports<BST>.
+             * @return A pointer to the cadmium::bag of the port, nullptr if index is out of range.
+             */
+            template<typename BST>
+            void* message_bag_slot(BST &bs, std::size_t index) {
+
+                void* ret = nullptr;
+                std::size_t i = 0; // to dynamically count tuple index
+                auto find_slot = [&ret, &i, index](auto &b) -> void {
+                    if (i++ == index) {
+                        ret = &b.messages;
+                    }
+                };
+                cadmium::helper::for_each<BST>(bs, find_slot);
+                return ret;
+            }
+
+            /**
+             * @brief Removes all the messages of the bs message bags, the bags keep their capacity.
+             *
+             * @tparam BST The message bag tuple.
+             */
+            template<typename BST>
+            void clear_message_bags(BST &bs) {
+
+                auto clear_bag = [](auto &b) -> void {
+                    b.messages.clear();
+                };
+                cadmium::helper::for_each<BST>(bs, clear_bag);
+            }
+
+            /**
+             * @brief Checks if none of the bs message bags has messages.
+             *
+             * @tparam BST The message bag tuple.
+             */
+            template<typename BST>
+            bool message_bags_empty(const BST &bs) {
+
+                bool ret = true;
+                auto check_bag = [&ret](const auto &b) -> void {
+                    ret = ret && b.messages.empty();
+                };
+                cadmium::helper::for_each<const BST>(bs, check_bag);
+                return ret;
             }
 
             bool is_in(const std::type_index &port, const Ports &ports) {
@@ -31,6 +31,9 @@
 #include <tuple>
 #include <typeindex>
 #include <map>
+#include <type_traits>
+#include <boost/container/small_vector.hpp>
+#include <cadmium/modeling/ports.hpp>
 
 /**
  * Here we declare the tools to manage messages in the context of PDEVS models.
@@ -41,15 +44,35 @@
 
 namespace cadmium {
 
-template<typename T>
-using bag=std::vector<T>;
+/**
+ * A bag keeps up to N messages inside, as a small vector, and allocates memory only when it
+ * receives more. With N 0 it is a std::vector.
+ */
+template<typename T, std::size_t N=CADMIUM_MESSAGE_BAG_INLINE_CAPACITY>
+using bag=typename std::conditional<N == 0, std::vector<T>, boost::container::small_vector<T, N>>::type;
+
+//messages kept inside the bags of PORT, the ports not declaring inline_messages use the default
+template<typename PORT, typename=void>
+struct port_inline_messages : std::integral_constant<std::size_t, CADMIUM_MESSAGE_BAG_INLINE_CAPACITY> {};
+
+template<typename PORT>
+struct port_inline_messages<PORT, std::void_t<decltype(PORT::inline_messages)>>
+        : std::integral_constant<std::size_t, PORT::inline_messages> {};
+
+//ports declaring a combiner type receive the messages routed to them folded in a single message
+template<typename PORT, typename=void>
+struct port_combines : std::false_type {};
+
+template<typename PORT>
+struct port_combines<PORT, std::void_t<typename PORT::combiner>> : std::true_type {};
 
 template<typename PORT>
 struct message_bag{
     using port=PORT;
     using message_type=typename PORT::message_type;
+    using bag_type=bag<message_type, port_inline_messages<PORT>::value>;
 
-    bag<message_type> messages;
+    bag_type messages;
 
     message_bag(){}
 
@@ -68,15 +91,38 @@ struct make_message_bags{
 
 
 template<typename PORT, typename T>
-bag<typename message_bag<PORT>::message_type> & get_messages(T& mbs){
+typename message_bag<PORT>::bag_type & get_messages(T& mbs){
     return std::get<message_bag<PORT>>(mbs).messages;
 }
 
 template<typename PORT, typename T>
-const bag<typename message_bag<PORT>::message_type> & get_messages(const T& mbs){
+const typename message_bag<PORT>::bag_type & get_messages(const T& mbs){
     return std::get<message_bag<PORT>>(mbs).messages;
 }
 
+/**
+ * Appends the messages from first to last to the messages of PORT. If PORT declares a combiner, they
+ * are folded with it in the first message of the bag instead, see cadmium/modeling/combiners.hpp.
+ */
+template<typename PORT, typename BAG, typename IT>
+void append_messages(BAG& messages, IT first, IT last){
+    if constexpr (port_combines<PORT>::value) {
+        if (first == last) {
+            return;
+        }
+        if (messages.empty()) {
+            messages.push_back(*first);
+            ++first;
+        }
+        typename PORT::combiner combine;
+        for (; first != last; ++first) {
+            combine(messages.front(), *first);
+        }
+    } else {
+        messages.insert(messages.end(), first, last);
+    }
+}
+
 }
 
 #endif // CADMIUM_MESSAGE_BAG_HPP
@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef CADMIUM_MESSAGE_CODEC_HPP
+#define CADMIUM_MESSAGE_CODEC_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace cadmium {
+    namespace dynamic {
+
+        /**
+         * @brief Encoding of messages of type MSG as bytes, used by the engines sending messages to
+         * other processes.
+         *
+         * @details
+         * Messages of trivially copyable and default constructible types are copied byte by byte and
+         * strings are encoded as their size followed by their characters. Other message types need a
+         * specialization defining:
+         * - static constexpr bool defined = true;
+         * - static void encode(const MSG& msg, std::string& out), appending the bytes of msg to out.
+         * - static MSG decode(const char*& data, const char* end), reading a message and moving data
+         *   after it, throwing std::domain_error if the bytes up to end are not enough.
+         *
+         * Types without encoding have defined as false, engines throw when asked to encode them.
+         */
+        template<typename MSG, typename = void>
+        struct message_codec {
+            static constexpr bool defined = false;
+        };
+
+        template<typename MSG>
+        struct message_codec<MSG, std::enable_if_t<std::is_trivially_copyable_v<MSG> && std::is_default_constructible_v<MSG>>> {
+            static constexpr bool defined = true;
+
+            static void encode(const MSG& msg, std::string& out) {
+                out.append(reinterpret_cast<const char*>(&msg), sizeof(MSG));
+            }
+
+            static MSG decode(const char*& data, const char* end) {
+                if (static_cast<std::size_t>(end - data) < sizeof(MSG)) {
+                    throw std::domain_error("Truncated encoded message");
+                }
+                MSG msg;
+                std::memcpy(&msg, data, sizeof(MSG));
+                data += sizeof(MSG);
+                return msg;
+            }
+        };
+
+        template<>
+        struct message_codec<std::string> {
+            static constexpr bool defined = true;
+
+            static void encode(const std::string& msg, std::string& out) {
+                message_codec<std::uint64_t>::encode(msg.size(), out);
+                out.append(msg);
+            }
+
+            static std::string decode(const char*& data, const char* end) {
+                std::uint64_t size = message_codec<std::uint64_t>::decode(data, end);
+                if (static_cast<std::uint64_t>(end - data) < size) {
+                    throw std::domain_error("Truncated encoded message");
+                }
+                std::string msg(data, size);
+                data += size;
+                return msg;
+            }
+        };
+    }
+}
+
+#endif //CADMIUM_MESSAGE_CODEC_HPP
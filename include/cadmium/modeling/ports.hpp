@@ -27,20 +27,36 @@
 #ifndef CADMIUM_PORTS_HPP
 #define CADMIUM_PORTS_HPP
 
+#include <cstddef>
+
+/**
+ * Default amount of messages the bag of a port keeps inside, without allocating memory, for the
+ * ports not choosing it. With 0 the bags are std::vector.
+ */
+#ifndef CADMIUM_MESSAGE_BAG_INLINE_CAPACITY
+#define CADMIUM_MESSAGE_BAG_INLINE_CAPACITY 0
+#endif
+
 namespace cadmium {
 
 enum class port_kind { in, out };
 
-template<typename MSG>
+/**
+ * @tparam MSG the type of the messages of the port.
+ * @tparam INLINE_MESSAGES the messages kept inside the bag of the port, see cadmium::bag.
+ */
+template<typename MSG, std::size_t INLINE_MESSAGES=CADMIUM_MESSAGE_BAG_INLINE_CAPACITY>
 struct out_port {
     using message_type=MSG;
     static constexpr port_kind kind=port_kind::out;
+    static constexpr std::size_t inline_messages=INLINE_MESSAGES;
 };
 
-template<typename MSG>
+template<typename MSG, std::size_t INLINE_MESSAGES=CADMIUM_MESSAGE_BAG_INLINE_CAPACITY>
 struct in_port {
     using message_type=MSG;
     static constexpr port_kind kind=port_kind::in;
+    static constexpr std::size_t inline_messages=INLINE_MESSAGES;
 };
 
 }
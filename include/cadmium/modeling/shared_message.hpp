@@ -0,0 +1,158 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef CADMIUM_SHARED_MESSAGE_HPP
+#define CADMIUM_SHARED_MESSAGE_HPP
+
+#include <memory>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <cadmium/modeling/message_codec.hpp>
+#include <cadmium/modeling/state_codec.hpp>
+
+namespace cadmium {
+
+    /**
+     * @brief Message sharing an immutable payload of type T with its copies.
+     *
+     * @details
+     * The engines copy the messages when routing them through the couplings, into every destination
+     * bag. A port of shared_message<T> makes these copies of a handle, increasing a reference count,
+     * while the payload is allocated once by the model sending it and released with its last copy.
+     * Receivers read the payload, or keep the message to forward it or read it later. A message
+     * modified by a model is copied first if other messages share its payload (copy on write).
+     *
+     * The payload is only modified through a message not shared with other copies, so copies may be
+     * routed and read from several threads.
+     */
+    template<typename T>
+    class shared_message {
+        std::shared_ptr<T> _payload;
+
+        explicit shared_message(std::shared_ptr<T> payload) : _payload(std::move(payload)) {}
+
+        template<typename U, typename... Args>
+        friend shared_message<U> make_shared_message(Args&&... args);
+
+    public:
+        using payload_type = T;
+
+        shared_message() : _payload(std::make_shared<T>()) {}
+
+        shared_message(const T& payload) : _payload(std::make_shared<T>(payload)) {}
+
+        shared_message(T&& payload) : _payload(std::make_shared<T>(std::move(payload))) {}
+
+        const T& operator*() const noexcept {
+            return *_payload;
+        }
+
+        const T* operator->() const noexcept {
+            return _payload.get();
+        }
+
+        const T& get() const noexcept {
+            return *_payload;
+        }
+
+        /**
+         * @return The payload to modify it, copied before if other messages share it.
+         */
+        T& modify() {
+            if (_payload.use_count() > 1) {
+                _payload = std::make_shared<T>(*_payload);
+            }
+            return *_payload;
+        }
+
+        /**
+         * @return true if other is a copy of this message, sharing its payload.
+         */
+        bool shares_payload(const shared_message& other) const noexcept {
+            return _payload == other._payload;
+        }
+
+        long use_count() const noexcept {
+            return _payload.use_count();
+        }
+    };
+
+    /**
+     * @brief Builds a shared message constructing its payload in place with args.
+     */
+    template<typename T, typename... Args>
+    shared_message<T> make_shared_message(Args&&... args) {
+        return shared_message<T>(std::make_shared<T>(std::forward<Args>(args)...));
+    }
+
+    template<typename T>
+    bool operator==(const shared_message<T>& lhs, const shared_message<T>& rhs) {
+        return lhs.shares_payload(rhs) || *lhs == *rhs;
+    }
+
+    template<typename T>
+    bool operator!=(const shared_message<T>& lhs, const shared_message<T>& rhs) {
+        return !(lhs == rhs);
+    }
+
+    template<typename T>
+    bool operator<(const shared_message<T>& lhs, const shared_message<T>& rhs) {
+        return !lhs.shares_payload(rhs) && *lhs < *rhs;
+    }
+
+    //only defined for streamable payloads, so loggers print the other messages by their type name
+    template<typename T>
+    auto operator<<(std::ostream& os, const shared_message<T>& msg) -> decltype(os << std::declval<const T&>()) {
+        return os << *msg;
+    }
+
+    namespace dynamic {
+
+        /**
+         * @brief Shared messages sent to other processes are encoded with their payload, using its
+         * state_codec, and each process decodes them to its own payload.
+         */
+        template<typename T>
+        struct message_codec<cadmium::shared_message<T>, std::enable_if_t<state_codec<T>::defined && std::is_default_constructible_v<T>>> {
+            static constexpr bool defined = true;
+
+            static void encode(const cadmium::shared_message<T>& msg, std::string& out) {
+                state_codec<T>::encode(*msg, out);
+            }
+
+            static cadmium::shared_message<T> decode(const char*& data, const char* end) {
+                T payload;
+                state_codec<T>::decode(payload, data, end);
+                return cadmium::shared_message<T>(std::move(payload));
+            }
+        };
+    }
+}
+
+#endif //CADMIUM_SHARED_MESSAGE_HPP
@@ -0,0 +1,183 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef CADMIUM_STATE_CODEC_HPP
+#define CADMIUM_STATE_CODEC_HPP
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <cadmium/modeling/message_codec.hpp>
+
+namespace cadmium {
+    namespace dynamic {
+
+        /**
+         * @brief Encoding of model states of type STATE as bytes, used to checkpoint simulations.
+         *
+         * @details
+         * Unlike messages, states are decoded into an existing value, so a restored model keeps the
+         * memory and the iteration order of its containers, and continues exactly as the saved one.
+         * Types with a message_codec are encoded with it, vectors, maps, pairs and tuples of encoded
+         * types are encoded element by element. Other state types need a specialization defining:
+         * - static constexpr bool defined = true;
+         * - static void encode(const STATE& state, std::string& out), appending the bytes of state to out.
+         * - static void decode(STATE& state, const char*& data, const char* end), reading the state and
+         *   moving data after it, throwing std::domain_error if the bytes up to end are not enough.
+         *
+         * Models may also encode their whole data declaring the methods
+         * void encode_state(std::string& out) const and void decode_state(const char*& data, const char* end).
+         */
+        template<typename STATE, typename = void>
+        struct state_codec {
+            static constexpr bool defined = false;
+        };
+
+        template<typename STATE>
+        struct state_codec<STATE, std::enable_if_t<message_codec<STATE>::defined>> {
+            static constexpr bool defined = true;
+
+            static void encode(const STATE& state, std::string& out) {
+                message_codec<STATE>::encode(state, out);
+            }
+
+            static void decode(STATE& state, const char*& data, const char* end) {
+                state = message_codec<STATE>::decode(data, end);
+            }
+        };
+
+        template<typename T, typename A>
+        struct state_codec<std::vector<T, A>, std::enable_if_t<state_codec<T>::defined && !message_codec<std::vector<T, A>>::defined>> {
+            static constexpr bool defined = true;
+
+            static void encode(const std::vector<T, A>& state, std::string& out) {
+                message_codec<std::uint64_t>::encode(state.size(), out);
+                for (const T& e : state) {
+                    state_codec<T>::encode(e, out);
+                }
+            }
+
+            static void decode(std::vector<T, A>& state, const char*& data, const char* end) {
+                std::uint64_t size = message_codec<std::uint64_t>::decode(data, end);
+                if (static_cast<std::uint64_t>(end - data) < size) {
+                    throw std::domain_error("Truncated encoded state");
+                }
+                state.resize(size);
+                for (T& e : state) {
+                    state_codec<T>::decode(e, data, end);
+                }
+            }
+        };
+
+        /**
+         * @brief Encoding of maps by key, values are decoded into the entries with the same key so
+         * hash maps keep their iteration order, and entries not encoded are erased.
+         */
+        template<typename MAP>
+        struct map_state_codec {
+            using key_type = typename MAP::key_type;
+            using mapped_type = typename MAP::mapped_type;
+
+            static constexpr bool defined = true;
+
+            static void encode(const MAP& state, std::string& out) {
+                message_codec<std::uint64_t>::encode(state.size(), out);
+                for (const auto& entry : state) {
+                    state_codec<key_type>::encode(entry.first, out);
+                    state_codec<mapped_type>::encode(entry.second, out);
+                }
+            }
+
+            static void decode(MAP& state, const char*& data, const char* end) {
+                std::uint64_t size = message_codec<std::uint64_t>::decode(data, end);
+                if (static_cast<std::uint64_t>(end - data) < size) {
+                    throw std::domain_error("Truncated encoded state");
+                }
+                std::vector<key_type> keys;
+                keys.reserve(size);
+                for (std::uint64_t i = 0; i < size; i++) {
+                    key_type key;
+                    state_codec<key_type>::decode(key, data, end);
+                    state_codec<mapped_type>::decode(state[key], data, end);
+                    keys.push_back(std::move(key));
+                }
+                if (state.size() != size) {
+                    MAP encoded;
+                    for (auto& key : keys) {
+                        encoded[key];
+                    }
+                    for (auto it = state.begin(); it != state.end();) {
+                        it = encoded.count(it->first) == 0 ? state.erase(it) : std::next(it);
+                    }
+                }
+            }
+        };
+
+        template<typename K, typename V, typename H, typename E, typename A>
+        struct state_codec<std::unordered_map<K, V, H, E, A>, std::enable_if_t<state_codec<K>::defined && state_codec<V>::defined>>
+                : map_state_codec<std::unordered_map<K, V, H, E, A>> {};
+
+        template<typename K, typename V, typename C, typename A>
+        struct state_codec<std::map<K, V, C, A>, std::enable_if_t<state_codec<K>::defined && state_codec<V>::defined>>
+                : map_state_codec<std::map<K, V, C, A>> {};
+
+        template<typename T1, typename T2>
+        struct state_codec<std::pair<T1, T2>, std::enable_if_t<state_codec<T1>::defined && state_codec<T2>::defined && !message_codec<std::pair<T1, T2>>::defined>> {
+            static constexpr bool defined = true;
+
+            static void encode(const std::pair<T1, T2>& state, std::string& out) {
+                state_codec<T1>::encode(state.first, out);
+                state_codec<T2>::encode(state.second, out);
+            }
+
+            static void decode(std::pair<T1, T2>& state, const char*& data, const char* end) {
+                state_codec<T1>::decode(state.first, data, end);
+                state_codec<T2>::decode(state.second, data, end);
+            }
+        };
+
+        template<typename... TS>
+        struct state_codec<std::tuple<TS...>, std::enable_if_t<(state_codec<TS>::defined && ...) && !message_codec<std::tuple<TS...>>::defined>> {
+            static constexpr bool defined = true;
+
+            static void encode(const std::tuple<TS...>& state, std::string& out) {
+                std::apply([&out](const TS&... e) { (state_codec<TS>::encode(e, out), ...); }, state);
+            }
+
+            static void decode(std::tuple<TS...>& state, const char*& data, const char* end) {
+                std::apply([&data, end](TS&... e) { (state_codec<TS>::decode(e, data, end), ...); }, state);
+            }
+        };
+    }
+}
+
+#endif //CADMIUM_STATE_CODEC_HPP
@@ -190,3 +190,48 @@ BOOST_AUTO_TEST_CASE(hybrid) {
     BOOST_CHECK_EQUAL(buffer->next_state(), 1);
     BOOST_CHECK_EQUAL(buffer->next_timeout(), std::numeric_limits<float>::infinity());
 }
+
+BOOST_AUTO_TEST_CASE(encoded) {
+    for (const char *type: {"inertial", "transport", "hybrid"}) {
+        auto buffer = delay_buffer_factory<float, int>::create_delay_buffer(type);
+        for (int i = 1; i <= 5; i++) {
+            buffer->add_to_buffer(i, 10 - i);
+            buffer->add_to_buffer(i * 2, i * 3);
+        }
+        buffer->pop_buffer();
+        std::string bytes;
+        buffer->encode(bytes);
+
+        // The decoded buffer transmits the same states at the same times
+        auto decoded = delay_buffer_factory<float, int>::create_delay_buffer(type);
+        decoded->add_to_buffer(7, 1);
+        const char *data = bytes.data();
+        decoded->decode(data, bytes.data() + bytes.size());
+        BOOST_CHECK(data == bytes.data() + bytes.size());
+        while (buffer->next_timeout() != std::numeric_limits<float>::infinity()) {
+            BOOST_CHECK_EQUAL(decoded->next_state(), buffer->next_state());
+            BOOST_CHECK_EQUAL(decoded->next_timeout(), buffer->next_timeout());
+            buffer->pop_buffer();
+            decoded->pop_buffer();
+        }
+        BOOST_CHECK_EQUAL(decoded->next_state(), buffer->next_state());
+        BOOST_CHECK_EQUAL(decoded->next_timeout(), std::numeric_limits<float>::infinity());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(cloned) {
+    for (const char *type: {"inertial", "transport", "hybrid"}) {
+        auto buffer = delay_buffer_factory<float, int>::create_delay_buffer(type);
+        buffer->add_to_buffer(1, 2);
+        buffer->add_to_buffer(3, 4);
+        auto copy = buffer->clone();
+
+        // The copy keeps its scheduled states when the original buffer changes
+        int state = buffer->next_state();
+        float timeout = buffer->next_timeout();
+        buffer->pop_buffer();
+        buffer->add_to_buffer(5, 6);
+        BOOST_CHECK_EQUAL(copy->next_state(), state);
+        BOOST_CHECK_EQUAL(copy->next_timeout(), timeout);
+    }
+}
@@ -0,0 +1,172 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CADMIUM_TEST_DYNAMIC_RUNNER_FIXTURES_HPP
+#define CADMIUM_TEST_DYNAMIC_RUNNER_FIXTURES_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <cadmium/basic_model/pdevs/generator.hpp>
+#include <cadmium/basic_model/pdevs/accumulator.hpp>
+
+#include <cadmium/modeling/dynamic_coupled.hpp>
+#include <cadmium/modeling/dynamic_atomic.hpp>
+#include <cadmium/modeling/dynamic_model_translator.hpp>
+
+#include <cadmium/engine/pdevs_dynamic_runner.hpp>
+#include <cadmium/logger/common_loggers.hpp>
+
+/**
+ * Models shared by the tests of the runners splitting a simulation in processes, which compare
+ * their results with the ones of the sequential runner.
+ */
+namespace dynamic_runner_fixtures {
+
+    using generator_out = cadmium::basic_models::pdevs::generator_defs<int>::out;
+    using accumulator_add = cadmium::basic_models::pdevs::accumulator_defs<int>::add;
+
+    //sends 1 every second
+    template<typename TIME>
+    struct slow_generator : public cadmium::basic_models::pdevs::generator<int, TIME> {
+        float period() const override {
+            return 1.0f;
+        }
+
+        int output_message() const override {
+            return 1;
+        }
+    };
+
+    //sends 2 four times per second
+    template<typename TIME>
+    struct fast_generator : public cadmium::basic_models::pdevs::generator<int, TIME> {
+        float period() const override {
+            return 0.25f;
+        }
+
+        int output_message() const override {
+            return 2;
+        }
+    };
+
+    template<typename TIME>
+    using int_accumulator = cadmium::basic_models::pdevs::accumulator<int, TIME>;
+
+    using accumulator_ptr = std::shared_ptr<cadmium::dynamic::modeling::atomic<int_accumulator, float>>;
+
+    //a link of every group, from its "slow" or "fast" generator to the accumulator offset groups after it
+    struct group_link {
+        std::string from;
+        int offset;
+    };
+
+    //groups of a slow generator, a fast generator and an accumulator, linked to the accumulators of
+    //the groups as given. The accumulators are appended to accumulators in the order of their groups.
+    template<template<typename> class SLOW = slow_generator>
+    std::shared_ptr<cadmium::dynamic::modeling::coupled<float>>
+    make_groups(int groups, const std::vector<group_link>& links, std::vector<accumulator_ptr>& accumulators) {
+        using cadmium::dynamic::translate::make_link;
+        cadmium::dynamic::modeling::Models models;
+        cadmium::dynamic::modeling::ICs ics;
+        for (int g = 0; g < groups; g++) {
+            std::string n = std::to_string(g);
+            auto acc = cadmium::dynamic::translate::make_dynamic_atomic_model<int_accumulator, float>("acc" + n);
+            accumulators.push_back(std::dynamic_pointer_cast<cadmium::dynamic::modeling::atomic<int_accumulator, float>>(acc));
+            models.push_back(cadmium::dynamic::translate::make_dynamic_atomic_model<SLOW, float>("slow" + n));
+            models.push_back(cadmium::dynamic::translate::make_dynamic_atomic_model<fast_generator, float>("fast" + n));
+            models.push_back(acc);
+            for (const group_link& l : links) {
+                ics.emplace_back(l.from + n, "acc" + std::to_string((g + l.offset) % groups), make_link<generator_out, accumulator_add>());
+            }
+        }
+        return std::make_shared<cadmium::dynamic::modeling::coupled<float>>(
+                "top", models, cadmium::dynamic::modeling::Ports{}, cadmium::dynamic::modeling::Ports{},
+                cadmium::dynamic::modeling::EICs{}, cadmium::dynamic::modeling::EOCs{}, ics
+        );
+    }
+
+    //each group is a coupled model of a fast generator sending to an accumulator, next to a slow
+    //generator and another accumulator, receiving from the slow generators of both groups
+    inline std::shared_ptr<cadmium::dynamic::modeling::coupled<float>> make_coupled_groups() {
+        using cadmium::dynamic::translate::make_link;
+        using cadmium::dynamic::translate::make_dynamic_atomic_model;
+        cadmium::dynamic::modeling::Models models;
+        cadmium::dynamic::modeling::ICs ics;
+        for (int g = 0; g < 2; g++) {
+            std::string n = std::to_string(g);
+            cadmium::dynamic::modeling::Models group_models = {
+                    make_dynamic_atomic_model<fast_generator, float>("fast" + n),
+                    make_dynamic_atomic_model<int_accumulator, float>("acc_fast" + n)
+            };
+            cadmium::dynamic::modeling::ICs group_ics = {
+                    cadmium::dynamic::modeling::IC("fast" + n, "acc_fast" + n, make_link<generator_out, accumulator_add>())
+            };
+            models.push_back(std::make_shared<cadmium::dynamic::modeling::coupled<float>>(
+                    "group" + n, group_models, cadmium::dynamic::modeling::Ports{}, cadmium::dynamic::modeling::Ports{},
+                    cadmium::dynamic::modeling::EICs{}, cadmium::dynamic::modeling::EOCs{}, group_ics
+            ));
+            models.push_back(make_dynamic_atomic_model<slow_generator, float>("slow" + n));
+            models.push_back(make_dynamic_atomic_model<int_accumulator, float>("acc_slow" + n));
+        }
+        ics.emplace_back("slow0", "acc_slow0", make_link<generator_out, accumulator_add>());
+        ics.emplace_back("slow1", "acc_slow0", make_link<generator_out, accumulator_add>());
+        ics.emplace_back("slow0", "acc_slow1", make_link<generator_out, accumulator_add>());
+        return std::make_shared<cadmium::dynamic::modeling::coupled<float>>(
+                "top", models, cadmium::dynamic::modeling::Ports{}, cadmium::dynamic::modeling::Ports{},
+                cadmium::dynamic::modeling::EICs{}, cadmium::dynamic::modeling::EOCs{}, ics
+        );
+    }
+
+    struct sequential_result {
+        float next;
+        std::vector<std::string> states; // of the atomic models, in the order of the flattened model
+    };
+
+    //simulates the model with the runner of the execution mode, using two threads when it has them
+    inline sequential_result run_sequentially(std::shared_ptr<cadmium::dynamic::modeling::coupled<float>> top, float until) {
+#if defined CPU_PARALLEL || defined CADMIUM_EXECUTE_CONCURRENT || defined CADMIUM_EXECUTE_TEAM
+        cadmium::dynamic::engine::runner<float, cadmium::logger::not_logger> r(top, 0, 2);
+#else
+        cadmium::dynamic::engine::runner<float, cadmium::logger::not_logger> r(top, 0);
+#endif
+        sequential_result result{r.run_until(until), {}};
+        for (const auto& m : cadmium::dynamic::modeling::flatten<float>(top).atomics) {
+            result.states.push_back(std::dynamic_pointer_cast<cadmium::dynamic::modeling::atomic_abstract<float>>(m)->model_state_as_string());
+        }
+        return result;
+    }
+
+    inline std::vector<int> totals(const std::vector<accumulator_ptr>& accumulators) {
+        std::vector<int> totals;
+        for (const auto& a : accumulators) {
+            totals.push_back(std::get<0>(a->state));
+        }
+        return totals;
+    }
+}
+
+#endif //CADMIUM_TEST_DYNAMIC_RUNNER_FIXTURES_HPP
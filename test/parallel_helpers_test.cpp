@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <cadmium/engine/parallel_helpers.hpp>
+
+/**
+ * This test is for the OpenMP loops used by the CPU_PARALLEL dynamic engine. The loops do not
+ * depend on that flag, so the test runs in every execution mode.
+ */
+BOOST_AUTO_TEST_SUITE(parallel_helpers_test_suite)
+
+    BOOST_AUTO_TEST_CASE(weighted_loop_visits_every_index_once_test) {
+        const std::size_t n = 1000;
+        std::vector<std::atomic<int>> visits(n);
+        for (auto& v : visits) v = 0;
+        auto f = [&visits](std::size_t i) { visits[i]++; };
+        // a few expensive indexes concentrated at the end
+        auto cost = [n](std::size_t i) { return i < n - 10 ? 1.0 : 500.0; };
+
+        cadmium::parallel::cpu_parallel_for_each_weighted(n, f, cost, 4);
+
+        for (std::size_t i = 0; i < n; i++) {
+            BOOST_CHECK_EQUAL(visits[i].load(), 1);
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(weighted_loop_with_no_cost_visits_every_index_once_test) {
+        const std::size_t n = 100;
+        std::vector<std::atomic<int>> visits(n);
+        for (auto& v : visits) v = 0;
+        auto f = [&visits](std::size_t i) { visits[i]++; };
+        auto cost = [](std::size_t) { return 0.0; };
+
+        cadmium::parallel::cpu_parallel_for_each_weighted(n, f, cost, 3);
+
+        for (std::size_t i = 0; i < n; i++) {
+            BOOST_CHECK_EQUAL(visits[i].load(), 1);
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(small_loops_run_sequentially_on_caller_test) {
+        const std::size_t n = CADMIUM_PARALLEL_SEQUENTIAL_THRESHOLD - 1;
+        std::vector<std::size_t> order;
+        std::thread::id caller = std::this_thread::get_id();
+        bool same_thread = true;
+        auto f = [&](std::size_t i) {
+            same_thread = same_thread && std::this_thread::get_id() == caller;
+            order.push_back(i);
+        };
+        auto cost = [](std::size_t) { return 1.0; };
+
+        cadmium::parallel::cpu_parallel_for_each_weighted(n, f, cost, 4);
+        BOOST_CHECK(same_thread);
+        BOOST_REQUIRE_EQUAL(order.size(), n);
+        for (std::size_t i = 0; i < n; i++) {
+            BOOST_CHECK_EQUAL(order[i], i);
+        }
+
+        std::vector<int> values(n, 0);
+        auto increment = [&](int& v) {
+            same_thread = same_thread && std::this_thread::get_id() == caller;
+            v++;
+        };
+        cadmium::parallel::cpu_parallel_for_each(values.begin(), values.end(), increment, 4);
+        BOOST_CHECK(same_thread);
+        for (int v : values) {
+            BOOST_CHECK_EQUAL(v, 1);
+        }
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,335 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <unordered_map>
+#include <utility>
+
+#include <cadmium/basic_model/pdevs/generator.hpp>
+#include <cadmium/basic_model/pdevs/accumulator.hpp>
+#include <cadmium/modeling/coupling.hpp>
+#include <cadmium/engine/pdevs_runner.hpp>
+
+#include <cadmium/modeling/dynamic_coupled.hpp>
+#include <cadmium/modeling/dynamic_atomic.hpp>
+#include <cadmium/modeling/dynamic_model_translator.hpp>
+#include <cadmium/engine/pdevs_dynamic_runner.hpp>
+#include <cadmium/celldevs/cell/cell.hpp>
+#include <cadmium/logger/common_loggers.hpp>
+
+#include "allocation_counter.hpp"
+
+/**
+ * allocation_counter.hpp counts the allocations of operator new made while a measure is running,
+ * from any thread. Models run until their allocations settle and then each measure runs them
+ * further, reporting the allocations and the bytes per event, a transition of an atomic model.
+ * Budgets are set for each execution mode, so a change allocating on every step fails here.
+ */
+
+namespace {
+    // transitions of the atomic models of this test
+    std::atomic<std::size_t> transitions{0};
+}
+
+BOOST_AUTO_TEST_SUITE(pdevs_allocations_test_suite)
+
+    namespace {
+        #if defined CADMIUM_EXECUTE_CONCURRENT
+        const char* mode = "concurrent";
+        #elif defined CPU_PARALLEL
+        const char* mode = "parallel";
+        #elif defined CADMIUM_EXECUTE_TEAM
+        const char* mode = "team";
+        #else
+        const char* mode = "sequential";
+        #endif
+
+        // allocations allowed per event once the simulation is warmed up, in every mode
+        const double allocations_budget = 0.0;
+
+        struct allocation_report {
+            std::size_t events;
+            double allocations_per_event;
+            double bytes_per_event;
+        };
+
+        template<typename RUN>
+        allocation_report measure(const std::string& model, RUN&& run) {
+            transitions = 0;
+            allocations = 0;
+            allocated_bytes = 0;
+            counting = true;
+            run();
+            counting = false;
+            allocation_report report{transitions.load(), 0, 0};
+            if (report.events > 0) {
+                report.allocations_per_event = double(allocations.load()) / report.events;
+                report.bytes_per_event = double(allocated_bytes.load()) / report.events;
+            }
+            BOOST_TEST_MESSAGE(model << " (" << mode << "): " << report.events << " events, "
+                               << report.allocations_per_event << " allocations and "
+                               << report.bytes_per_event << " bytes per event");
+            return report;
+        }
+
+        // generator -> accumulator, the accumulator is never reset
+        template<typename TIME>
+        struct counted_generator : public cadmium::basic_models::pdevs::generator<int, TIME> {
+            float period() const override {
+                return 1.0f;
+            }
+
+            int output_message() const override {
+                return 1;
+            }
+
+            void internal_transition() {
+                transitions++;
+            }
+        };
+
+        using accumulator_defs = cadmium::basic_models::pdevs::accumulator_defs<int>;
+
+        template<typename TIME>
+        struct counted_accumulator : public cadmium::basic_models::pdevs::accumulator<int, TIME> {
+            using input_bags = typename cadmium::make_message_bags<typename cadmium::basic_models::pdevs::accumulator<int, TIME>::input_ports>::type;
+
+            void external_transition(TIME e, const input_bags& mbs) {
+                transitions++;
+                cadmium::basic_models::pdevs::accumulator<int, TIME>::external_transition(e, mbs);
+            }
+        };
+
+        using generator_out = cadmium::basic_models::pdevs::generator_defs<int>::out;
+
+        template<typename TIME>
+        using generator_accumulator = cadmium::modeling::pdevs::coupled_model<TIME, std::tuple<>, std::tuple<>,
+                cadmium::modeling::models_tuple<counted_generator, counted_accumulator>, std::tuple<>, std::tuple<>,
+                std::tuple<cadmium::modeling::IC<counted_generator, generator_out, counted_accumulator, accumulator_defs::add>>>;
+
+        std::shared_ptr<cadmium::dynamic::modeling::coupled<float>> make_generator_accumulator() {
+            using namespace cadmium::dynamic::translate;
+            return std::make_shared<cadmium::dynamic::modeling::coupled<float>>(
+                    "generator_accumulator",
+                    cadmium::dynamic::modeling::Models{make_dynamic_atomic_model<counted_generator, float>("generator"), make_dynamic_atomic_model<counted_accumulator, float>("accumulator")},
+                    cadmium::dynamic::modeling::Ports{}, cadmium::dynamic::modeling::Ports{},
+                    cadmium::dynamic::modeling::EICs{}, cadmium::dynamic::modeling::EOCs{},
+                    cadmium::dynamic::modeling::ICs{cadmium::dynamic::modeling::IC("generator", "accumulator", make_link<generator_out, accumulator_defs::add>())}
+            );
+        }
+
+        // square lattice of cells adding the states of their von Neumann neighbors
+        template<typename TIME>
+        struct adding_cell : public cadmium::celldevs::cell<TIME, int, int> {
+            using cadmium::celldevs::cell<TIME, int, int>::state;
+
+            adding_cell() = default;
+
+            adding_cell(int id, std::unordered_map<int, int> const& neighborhood, int initial_state)
+                    : cadmium::celldevs::cell<TIME, int, int>(id, neighborhood, initial_state, "inertial") {}
+
+            int local_computation() const override {
+                transitions++;
+                int next = state.current_state;
+                for (auto const& neighbor : state.neighbors_state) {
+                    next += neighbor.second;
+                }
+                return next % 7;
+            }
+
+            TIME output_delay(int const&) const override {
+                return 1;
+            }
+        };
+
+        std::shared_ptr<cadmium::dynamic::modeling::coupled<float>> make_lattice(int side) {
+            using namespace cadmium::dynamic::translate;
+            using ports = cadmium::celldevs::cell_ports_def<int, int>;
+            cadmium::dynamic::modeling::Models models;
+            cadmium::dynamic::modeling::ICs ics;
+            for (int c = 0; c < side * side; c++) {
+                int row = c / side;
+                int column = c % side;
+                std::unordered_map<int, int> neighborhood;
+                for (int n : {((row + side - 1) % side) * side + column, ((row + 1) % side) * side + column,
+                              row * side + (column + side - 1) % side, row * side + (column + 1) % side}) {
+                    neighborhood[n] = 1;
+                    ics.emplace_back("cell_" + std::to_string(n), "cell_" + std::to_string(c), make_link<ports::cell_out, ports::cell_in>());
+                }
+                int initial_state = c % 3;
+                models.push_back(make_dynamic_atomic_model<adding_cell, float>("cell_" + std::to_string(c), c, neighborhood, initial_state));
+            }
+            return std::make_shared<cadmium::dynamic::modeling::coupled<float>>(
+                    "lattice", models, cadmium::dynamic::modeling::Ports{}, cadmium::dynamic::modeling::Ports{},
+                    cadmium::dynamic::modeling::EICs{}, cadmium::dynamic::modeling::EOCs{}, ics
+            );
+        }
+
+        // DEVStone like tree of coupled models, each level relays the received values to the next one
+        struct relay_in : public cadmium::in_port<int> {
+        };
+        struct relay_out : public cadmium::out_port<int> {
+        };
+
+        template<typename TIME>
+        struct relay {
+            using input_ports = std::tuple<relay_in>;
+            using output_ports = std::tuple<relay_out>;
+            using input_bags = typename cadmium::make_message_bags<input_ports>::type;
+            using output_bags = typename cadmium::make_message_bags<output_ports>::type;
+            using state_type = int;
+            state_type state = 0; // values received, not relayed yet
+
+            void internal_transition() {
+                transitions++;
+                state = 0;
+            }
+
+            void external_transition(TIME, const input_bags& mbs) {
+                transitions++;
+                for (int x : cadmium::get_messages<relay_in>(mbs)) {
+                    state += x;
+                }
+            }
+
+            void confluence_transition(TIME, const input_bags& mbs) {
+                internal_transition();
+                external_transition(TIME(), mbs);
+            }
+
+            output_bags output() const {
+                output_bags bags;
+                output(bags);
+                return bags;
+            }
+
+            void output(output_bags& bags) const {
+                cadmium::get_messages<relay_out>(bags).push_back(state);
+            }
+
+            TIME time_advance() const {
+                return state > 0 ? TIME(0.5) : std::numeric_limits<TIME>::infinity();
+            }
+        };
+
+        struct level_in : public cadmium::in_port<int> {
+        };
+        struct level_out : public cadmium::out_port<int> {
+        };
+
+        std::shared_ptr<cadmium::dynamic::modeling::coupled<float>> make_level(int depth) {
+            using namespace cadmium::dynamic::translate;
+            std::string relay_id = "relay_" + std::to_string(depth);
+            cadmium::dynamic::modeling::Models models = {make_dynamic_atomic_model<relay, float>(relay_id)};
+            cadmium::dynamic::modeling::EICs eics = {cadmium::dynamic::modeling::EIC(relay_id, make_link<level_in, relay_in>())};
+            cadmium::dynamic::modeling::EOCs eocs = {cadmium::dynamic::modeling::EOC(relay_id, make_link<relay_out, level_out>())};
+            cadmium::dynamic::modeling::ICs ics;
+            if (depth > 0) {
+                auto below = make_level(depth - 1);
+                models.push_back(below);
+                eics.emplace_back(below->get_id(), make_link<level_in, level_in>());
+                eocs.emplace_back(below->get_id(), make_link<level_out, level_out>());
+                ics.emplace_back(relay_id, below->get_id(), make_link<relay_out, level_in>());
+            }
+            return std::make_shared<cadmium::dynamic::modeling::coupled<float>>(
+                    "level_" + std::to_string(depth), models,
+                    cadmium::dynamic::modeling::Ports{typeid(level_in)}, cadmium::dynamic::modeling::Ports{typeid(level_out)},
+                    eics, eocs, ics
+            );
+        }
+
+        std::shared_ptr<cadmium::dynamic::modeling::coupled<float>> make_tree(int depth) {
+            using namespace cadmium::dynamic::translate;
+            auto levels = make_level(depth);
+            return std::make_shared<cadmium::dynamic::modeling::coupled<float>>(
+                    "tree",
+                    cadmium::dynamic::modeling::Models{make_dynamic_atomic_model<counted_generator, float>("generator"), levels, make_dynamic_atomic_model<relay, float>("sink")},
+                    cadmium::dynamic::modeling::Ports{}, cadmium::dynamic::modeling::Ports{},
+                    cadmium::dynamic::modeling::EICs{}, cadmium::dynamic::modeling::EOCs{},
+                    cadmium::dynamic::modeling::ICs{
+                            cadmium::dynamic::modeling::IC("generator", levels->get_id(), make_link<generator_out, level_in>()),
+                            cadmium::dynamic::modeling::IC(levels->get_id(), "sink", make_link<level_out, relay_in>())
+                    }
+            );
+        }
+
+        using dynamic_runner = cadmium::dynamic::engine::runner<float, cadmium::logger::not_logger>;
+
+        // the parallel modes use several threads even on hosts with one processor
+        template<typename... ARGS>
+        dynamic_runner make_dynamic_runner(ARGS&&... args) {
+            #if defined CADMIUM_EXECUTE_CONCURRENT || defined CPU_PARALLEL || defined CADMIUM_EXECUTE_TEAM
+            return dynamic_runner(std::forward<ARGS>(args)..., 4);
+            #else
+            return dynamic_runner(std::forward<ARGS>(args)...);
+            #endif
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(static_generator_accumulator_allocations_test) {
+        cadmium::engine::runner<float, generator_accumulator, cadmium::logger::not_logger> r{0.0};
+        r.run_until(100.0);
+        allocation_report report = measure("static generator -> accumulator", [&r]() { r.run_until(1100.0); });
+        BOOST_CHECK_EQUAL(report.events, 2000);
+        BOOST_CHECK_LE(report.allocations_per_event, allocations_budget);
+    }
+
+    BOOST_AUTO_TEST_CASE(dynamic_generator_accumulator_allocations_test) {
+        dynamic_runner r = make_dynamic_runner(make_generator_accumulator(), 0.0);
+        r.run_until(100.0);
+        allocation_report report = measure("dynamic generator -> accumulator", [&r]() { r.run_until(1100.0); });
+        BOOST_CHECK_EQUAL(report.events, 2000);
+        BOOST_CHECK_LE(report.allocations_per_event, allocations_budget);
+    }
+
+    BOOST_AUTO_TEST_CASE(dynamic_lattice_allocations_test) {
+        dynamic_runner r = make_dynamic_runner(make_lattice(8), 0.0);
+        r.run_until(20.0);
+        allocation_report report = measure("dynamic 8x8 Cell-DEVS lattice", [&r]() { r.run_until(120.0); });
+        BOOST_CHECK_GT(report.events, 0);
+        BOOST_CHECK_LE(report.allocations_per_event, allocations_budget);
+    }
+
+    BOOST_AUTO_TEST_CASE(dynamic_tree_allocations_test) {
+        dynamic_runner r = make_dynamic_runner(make_tree(8), 0.0);
+        r.run_until(100.0);
+        allocation_report report = measure("dynamic 8 levels tree", [&r]() { r.run_until(1100.0); });
+        BOOST_CHECK_GT(report.events, 0);
+        BOOST_CHECK_LE(report.allocations_per_event, allocations_budget);
+    }
+
+    BOOST_AUTO_TEST_CASE(flattened_tree_allocations_test) {
+        dynamic_runner r = make_dynamic_runner(make_tree(8), 0.0, cadmium::dynamic::engine::flatten_hierarchy);
+        r.run_until(100.0);
+        allocation_report report = measure("flattened 8 levels tree", [&r]() { r.run_until(1100.0); });
+        BOOST_CHECK_GT(report.events, 0);
+        BOOST_CHECK_LE(report.allocations_per_event, allocations_budget);
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -200,6 +200,22 @@ BOOST_AUTO_TEST_SUITE(pdevs_coordinator_test_suite)
         BOOST_REQUIRE(cadmium::get_messages<g2a_coupled_out_port>(output_bags).empty());//was reset
     }
 
+    BOOST_AUTO_TEST_CASE(step_advances_like_collecting_and_advancing_test) {
+        cadmium::engine::coordinator<coupled_g2a_model, float, cadmium::logger::not_logger> stepped;
+        cadmium::engine::coordinator<coupled_g2a_model, float, cadmium::logger::not_logger> collected;
+        stepped.init(0);
+        collected.init(0);
+        for (int i = 0; i < 12; i++) {
+            float t = collected.next();
+            BOOST_CHECK_EQUAL(t, stepped.next());
+            stepped.step(t);
+            collected.collect_outputs(t);
+            collected.advance_simulation(t);
+        }
+        BOOST_CHECK_EQUAL(collected.next(), stepped.next());
+        BOOST_CHECK_THROW(stepped.step(stepped.next() + 1), std::domain_error);
+    }
+
 //next test is similar to previous, but models are split in 2 coupled ones
 //2 generators connected to an infinite_counter are coordinated and routing messages correctly
 //connecting generators to acumm coupled model definition
@@ -298,6 +314,38 @@ BOOST_AUTO_TEST_SUITE(pdevs_coordinator_test_suite)
     }
 
 
+//a generator output port read by two EOCs is copied to both while a port with one consumer is moved
+    struct other_coupled_out_port : public cadmium::out_port<test_tick> {
+    };
+    using shared_port_oports = std::tuple<coupled_out_port, other_coupled_out_port>;
+    using shared_port_eocs=std::tuple<
+            cadmium::modeling::EOC<test_generator, out_port, coupled_out_port>,
+            cadmium::modeling::EOC<test_generator, out_port, other_coupled_out_port>
+    >;
+
+    template<typename TIME>
+    using coupled_generator_to_two_ports=cadmium::modeling::pdevs::coupled_model<TIME, iports, shared_port_oports, submodels, eics, shared_port_eocs, ics>;
+
+    BOOST_AUTO_TEST_CASE(coordinated_generator_output_port_shared_by_couplings_test) {
+        static_assert(cadmium::engine::output_port_consumers<float, test_generator<float>, out_port, shared_port_eocs, ics>::value == 2);
+        static_assert(cadmium::engine::output_port_consumers<float, test_generator<float>, out_port, eocs, ics>::value == 1);
+
+        cadmium::engine::coordinator<coupled_generator_to_two_ports, float, cadmium::logger::not_logger> cg;
+        cadmium::engine::coordinator<coupled_generator, float, cadmium::logger::not_logger> single_cg;
+        cg.init(0);
+        single_cg.init(0);
+        for (int i = 1; i < 4; i++) {
+            cg.collect_outputs((float) i);
+            single_cg.collect_outputs((float) i);
+            BOOST_CHECK_EQUAL(cadmium::get_messages<coupled_out_port>(cg.outbox()).size(), 1);
+            BOOST_CHECK_EQUAL(cadmium::get_messages<other_coupled_out_port>(cg.outbox()).size(), 1);
+            BOOST_CHECK_EQUAL(cadmium::get_messages<coupled_out_port>(single_cg.outbox()).size(), 1);
+            cg.advance_simulation((float) i);
+            single_cg.advance_simulation((float) i);
+            BOOST_CHECK(cadmium::engine::all_bags_empty(cg.outbox()));
+        }
+    }
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
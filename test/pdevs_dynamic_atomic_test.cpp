@@ -30,6 +30,8 @@
 #include <cadmium/basic_model/pdevs/accumulator.hpp>
 #include <cadmium/modeling/dynamic_atomic.hpp>
 #include <cadmium/modeling/dynamic_model_translator.hpp>
+#include <cadmium/modeling/state_codec.hpp>
+#include <unordered_map>
 
 /**
   * This test is for the dynamic atomic class that wraps an atomic model to make it pointer friendly
@@ -62,4 +64,122 @@ BOOST_AUTO_TEST_SUITE( pdevs_dynamic_atomic_test_suite )
         std::shared_ptr<cadmium::dynamic::modeling::atomic_abstract<float>> atomic_model = cadmium::dynamic::translate::make_dynamic_atomic_model<test_custom_acumulator, float, int>("id_test", 2);
     }
 
+    BOOST_AUTO_TEST_CASE(dynamic_atomic_typed_port_storage_test) {
+        using add_port = cadmium::basic_models::pdevs::accumulator_defs<int>::add;
+        using reset_port = cadmium::basic_models::pdevs::accumulator_defs<int>::reset;
+        using sum_port = cadmium::basic_models::pdevs::accumulator_defs<int>::sum;
+        using reset_tick = cadmium::basic_models::pdevs::accumulator_defs<int>::reset_tick;
+
+        cadmium::dynamic::modeling::atomic<int_accumulator, float> wrapped_model;
+
+        // slots follow the order of the ports
+        BOOST_CHECK(wrapped_model.get_input_ports() == cadmium::dynamic::modeling::Ports({typeid(add_port), typeid(reset_port)}));
+        auto add_messages = static_cast<cadmium::bag<int>*>(wrapped_model.input_slot(0));
+        auto reset_messages = static_cast<cadmium::bag<reset_tick>*>(wrapped_model.input_slot(1));
+        BOOST_CHECK(wrapped_model.input_slot(2) == nullptr);
+        BOOST_CHECK(wrapped_model.inbox_empty());
+
+        add_messages->push_back(3);
+        add_messages->push_back(4);
+        BOOST_CHECK(!wrapped_model.inbox_empty());
+
+        // messages received by port type are merged with the ones in the slots
+        cadmium::dynamic::message_bags bags;
+        cadmium::message_bag<add_port> more_add;
+        more_add.messages.push_back(5);
+        bags[typeid(add_port)] = more_add;
+        wrapped_model.add_to_inbox(bags);
+        BOOST_CHECK_EQUAL(add_messages->size(), 3);
+
+        wrapped_model.external_transition_from_inbox(1.0f);
+        BOOST_CHECK_EQUAL(std::get<int>(wrapped_model.state), 12);
+
+        wrapped_model.clear_inbox();
+        BOOST_CHECK(wrapped_model.inbox_empty());
+        reset_messages->push_back(reset_tick{});
+        wrapped_model.external_transition_from_inbox(1.0f);
+        BOOST_CHECK(std::get<bool>(wrapped_model.state));
+
+        wrapped_model.collect_output();
+        auto sum_messages = static_cast<cadmium::bag<int>*>(wrapped_model.output_slot(0));
+        BOOST_CHECK(sum_messages->size() == 1 && sum_messages->front() == 12);
+        BOOST_CHECK(boost::any_cast<cadmium::message_bag<sum_port>>(wrapped_model.outbox_as_map().at(typeid(sum_port))).messages == *sum_messages);
+
+        wrapped_model.clear_outbox();
+        BOOST_CHECK(sum_messages->empty());
+    }
+
+    BOOST_AUTO_TEST_CASE(dynamic_atomic_relocate_keeps_state_and_slots_test) {
+        using reset_tick = cadmium::basic_models::pdevs::accumulator_defs<int>::reset_tick;
+
+        cadmium::dynamic::modeling::atomic<int_accumulator, float> wrapped_model;
+        auto add_messages = static_cast<cadmium::bag<int>*>(wrapped_model.input_slot(0));
+        add_messages->push_back(7);
+        wrapped_model.external_transition_from_inbox(1.0f);
+        wrapped_model.clear_inbox();
+        auto state = wrapped_model.state;
+
+        // the slots stay bound to the same bags, so routes bound to them remain valid
+        wrapped_model.relocate();
+        BOOST_CHECK(wrapped_model.state == state);
+        BOOST_CHECK(wrapped_model.input_slot(0) == add_messages);
+        BOOST_CHECK(wrapped_model.inbox_empty());
+
+        // pending messages are not dropped
+        auto reset_messages = static_cast<cadmium::bag<reset_tick>*>(wrapped_model.input_slot(1));
+        reset_messages->push_back(reset_tick{});
+        wrapped_model.relocate();
+        BOOST_CHECK_EQUAL(reset_messages->size(), 1);
+    }
+
+    BOOST_AUTO_TEST_CASE(dynamic_atomic_encodes_its_state_test) {
+        cadmium::dynamic::modeling::atomic<int_accumulator, float> wrapped_model;
+        auto add_messages = static_cast<cadmium::bag<int>*>(wrapped_model.input_slot(0));
+        add_messages->push_back(12);
+        wrapped_model.external_transition_from_inbox(1.0f);
+        std::string bytes;
+        wrapped_model.encode_state(bytes);
+
+        cadmium::dynamic::modeling::atomic<int_accumulator, float> restored_model;
+        const char* data = bytes.data();
+        restored_model.decode_state(data, bytes.data() + bytes.size());
+        BOOST_CHECK(data == bytes.data() + bytes.size());
+        BOOST_CHECK(restored_model.state == wrapped_model.state);
+
+        data = bytes.data();
+        BOOST_CHECK_THROW(restored_model.decode_state(data, bytes.data() + bytes.size() - 1), std::domain_error);
+    }
+
+    BOOST_AUTO_TEST_CASE(state_codec_decodes_maps_into_their_entries_test) {
+        using map_type = std::unordered_map<int, std::vector<int>>;
+        map_type state;
+        for (int i = 0; i < 20; i++) {
+            state[i] = std::vector<int>(i % 3, i);
+        }
+        std::string bytes;
+        cadmium::dynamic::state_codec<map_type>::encode(state, bytes);
+
+        // the restored map keeps its iteration order, and drops the entries not encoded
+        map_type restored = state;
+        for (auto& entry : restored) {
+            entry.second.clear();
+        }
+        restored[50] = {1};
+        restored.erase(50);
+        restored[60] = {2};
+        const char* data = bytes.data();
+        cadmium::dynamic::state_codec<map_type>::decode(restored, data, bytes.data() + bytes.size());
+        BOOST_CHECK(data == bytes.data() + bytes.size());
+        BOOST_CHECK(restored == state);
+        std::vector<int> keys;
+        std::vector<int> restored_keys;
+        for (const auto& entry : state) {
+            keys.push_back(entry.first);
+        }
+        for (const auto& entry : restored) {
+            restored_keys.push_back(entry.first);
+        }
+        BOOST_CHECK(keys == restored_keys);
+    }
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,139 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <cadmium/basic_model/pdevs/generator.hpp>
+#include <cadmium/basic_model/pdevs/accumulator.hpp>
+
+#include <cadmium/modeling/dynamic_coupled.hpp>
+#include <cadmium/modeling/dynamic_atomic.hpp>
+#include <cadmium/modeling/dynamic_model_translator.hpp>
+
+#include <cadmium/engine/pdevs_dynamic_runner.hpp>
+#include <cadmium/engine/pdevs_dynamic_branching.hpp>
+#include <cadmium/logger/common_loggers.hpp>
+
+BOOST_AUTO_TEST_SUITE(pdevs_dynamic_branching_test_suite)
+
+    using generator_out = cadmium::basic_models::pdevs::generator_defs<int>::out;
+    using accumulator_add = cadmium::basic_models::pdevs::accumulator_defs<int>::add;
+
+    //sends its value every second, the value is the parameter patched by the branches
+    template<typename TIME>
+    struct patchable_generator : public cadmium::basic_models::pdevs::generator<int, TIME> {
+        int value = 1;
+
+        float period() const override {
+            return 1.0f;
+        }
+
+        int output_message() const override {
+            return value;
+        }
+    };
+
+    template<typename TIME>
+    using int_accumulator = cadmium::basic_models::pdevs::accumulator<int, TIME>;
+
+    struct scenario {
+        std::shared_ptr<patchable_generator<float>> generator;
+        std::shared_ptr<int_accumulator<float>> accumulator;
+        std::shared_ptr<cadmium::dynamic::modeling::coupled<float>> top;
+    };
+
+    scenario make_scenario() {
+        using cadmium::dynamic::translate::make_link;
+        using cadmium::dynamic::translate::make_dynamic_atomic_model;
+        auto generator = make_dynamic_atomic_model<patchable_generator, float>("generator");
+        auto accumulator = make_dynamic_atomic_model<int_accumulator, float>("accumulator");
+        auto top = std::make_shared<cadmium::dynamic::modeling::coupled<float>>(
+                "top",
+                cadmium::dynamic::modeling::Models{generator, accumulator},
+                cadmium::dynamic::modeling::Ports{},
+                cadmium::dynamic::modeling::Ports{},
+                cadmium::dynamic::modeling::EICs{},
+                cadmium::dynamic::modeling::EOCs{},
+                cadmium::dynamic::modeling::ICs{cadmium::dynamic::modeling::IC("generator", "accumulator", make_link<generator_out, accumulator_add>())}
+        );
+        return scenario{std::dynamic_pointer_cast<patchable_generator<float>>(generator), std::dynamic_pointer_cast<int_accumulator<float>>(accumulator), top};
+    }
+
+    #if defined CADMIUM_EXECUTE_CONCURRENT || defined CADMIUM_EXECUTE_TEAM || defined CPU_PARALLEL
+    BOOST_AUTO_TEST_CASE(branches_need_a_sequential_runner_test) {
+        scenario s = make_scenario();
+        cadmium::dynamic::engine::runner<float, cadmium::logger::not_logger> r(s.top, 0.0);
+        BOOST_CHECK_THROW(cadmium::dynamic::engine::branch(r, 2, [](std::size_t, auto&) {}), std::domain_error);
+    }
+    #else
+    BOOST_AUTO_TEST_CASE(branches_continue_from_the_current_time_with_their_patches_test) {
+        scenario s = make_scenario();
+        cadmium::dynamic::engine::runner<float, cadmium::logger::not_logger> r(s.top, 0.0);
+        r.run_until(4.5);
+
+        auto patch_and_run = [](scenario& patched, std::size_t b, auto& branch_runner) -> std::string {
+            patched.generator->value = b + 1;
+            branch_runner.run_until(10.0);
+            return std::to_string(std::get<int>(patched.accumulator->state));
+        };
+        std::vector<std::string> results = cadmium::dynamic::engine::branch(r, 4, [&](std::size_t b, auto& branch_runner) {
+            return patch_and_run(s, b, branch_runner);
+        }, 2);
+
+        for (std::size_t b = 0; b < 4; b++) {
+            // the same patch applied without branching
+            scenario expected = make_scenario();
+            cadmium::dynamic::engine::runner<float, cadmium::logger::not_logger> expected_runner(expected.top, 0.0);
+            expected_runner.run_until(4.5);
+            BOOST_CHECK_EQUAL(results[b], patch_and_run(expected, b, expected_runner));
+        }
+        BOOST_CHECK_EQUAL(results[3], std::to_string(4 + 5 * 4));
+
+        // the simulation that was branched is not affected by the branches
+        BOOST_CHECK_EQUAL(std::get<int>(s.accumulator->state), 4);
+        BOOST_CHECK_EQUAL(s.generator->value, 1);
+        r.run_until(10.0);
+        BOOST_CHECK_EQUAL(std::get<int>(s.accumulator->state), 9);
+    }
+
+    BOOST_AUTO_TEST_CASE(failed_branches_are_reported_test) {
+        scenario s = make_scenario();
+        cadmium::dynamic::engine::runner<float, cadmium::logger::not_logger> r(s.top, 0.0);
+        auto continuation = [](std::size_t b, auto& branch_runner) {
+            branch_runner.run_until(2.0);
+            if (b == 1) {
+                throw std::domain_error("patch rejected");
+            }
+        };
+        BOOST_CHECK_EXCEPTION(cadmium::dynamic::engine::branch(r, 3, continuation), std::runtime_error, [](const std::runtime_error& e) {
+            return std::string(e.what()) == "Branch 1 failed: patch rejected";
+        });
+    }
+    #endif
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,115 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <cadmium/engine/pdevs_dynamic_conservative_runner.hpp>
+
+#include "dynamic_runner_fixtures.hpp"
+
+BOOST_AUTO_TEST_SUITE(pdevs_dynamic_conservative_runner_test_suite)
+
+    using namespace dynamic_runner_fixtures;
+
+    //sends 1 every second, declaring its outputs are one second apart
+    template<typename TIME>
+    struct lookahead_generator : public slow_generator<TIME> {
+        TIME lookahead() const {
+            return 1.0f;
+        }
+    };
+
+    //declares a lookahead longer than its period
+    template<typename TIME>
+    struct lying_generator : public slow_generator<TIME> {
+        TIME lookahead() const {
+            return 2.0f;
+        }
+    };
+
+    //two groups of a slow generator, a fast generator and an accumulator, where each slow
+    //generator also sends to the accumulator of the other group
+    template<template<typename> class SLOW>
+    std::shared_ptr<cadmium::dynamic::modeling::coupled<float>> make_groups(std::vector<accumulator_ptr>& accumulators) {
+        return dynamic_runner_fixtures::make_groups<SLOW>(2, {{"fast", 0}, {"slow", 0}, {"slow", 1}}, accumulators);
+    }
+
+    std::vector<int> sequential_totals(std::shared_ptr<cadmium::dynamic::modeling::coupled<float>> top, const std::vector<accumulator_ptr>& accumulators, float until) {
+        run_sequentially(top, until);
+        return totals(accumulators);
+    }
+
+    BOOST_AUTO_TEST_CASE(atomic_models_report_their_declared_lookahead_test) {
+        auto slow = cadmium::dynamic::translate::make_dynamic_atomic_model<lookahead_generator, float>("slow");
+        auto fast = cadmium::dynamic::translate::make_dynamic_atomic_model<fast_generator, float>("fast");
+        BOOST_CHECK_EQUAL(1.0f, slow->lookahead());
+        BOOST_CHECK_EQUAL(0.0f, fast->lookahead());
+    }
+
+    BOOST_AUTO_TEST_CASE(lookahead_windows_simulate_the_same_as_the_sequential_runner_test) {
+        std::vector<accumulator_ptr> expected_accumulators;
+        std::vector<int> expected = sequential_totals(make_groups<lookahead_generator>(expected_accumulators), expected_accumulators, 10.5f);
+
+        std::vector<accumulator_ptr> accumulators;
+        cadmium::dynamic::engine::conservative_runner<float, cadmium::logger::not_logger> r(make_groups<lookahead_generator>(accumulators), 0, {0, 0, 0, 1, 1, 1}, 2);
+        BOOST_CHECK_EQUAL(2, r.processes());
+        BOOST_CHECK_EQUAL(10.5f, r.run_until(10.5f));
+
+        std::vector<int> result = totals(accumulators);
+        BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), result.begin(), result.end());
+        // the fast generators run alone in the windows between the outputs of the slow ones
+        BOOST_CHECK_GT(r.windows(), 0);
+        BOOST_CHECK_GT(r.window_steps(), 0);
+        BOOST_CHECK_EQUAL(10, r.synchronized_steps());
+    }
+
+    BOOST_AUTO_TEST_CASE(zero_lookahead_synchronizes_every_step_test) {
+        std::vector<accumulator_ptr> expected_accumulators;
+        std::vector<int> expected = sequential_totals(make_groups<fast_generator>(expected_accumulators), expected_accumulators, 5.0f);
+
+        std::vector<accumulator_ptr> accumulators;
+        cadmium::dynamic::engine::conservative_runner<float, cadmium::logger::not_logger> r(make_groups<fast_generator>(accumulators), 0, 2, 2);
+        r.run_until(5.0f);
+
+        std::vector<int> result = totals(accumulators);
+        BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), result.begin(), result.end());
+        BOOST_CHECK_EQUAL(0, r.windows());
+    }
+
+    BOOST_AUTO_TEST_CASE(outputs_before_the_declared_lookahead_throw_test) {
+        std::vector<accumulator_ptr> accumulators;
+        cadmium::dynamic::engine::conservative_runner<float, cadmium::logger::not_logger> r(make_groups<lying_generator>(accumulators), 0, {0, 0, 0, 1, 1, 1}, 2);
+        BOOST_CHECK_THROW(r.run_until(5.0f), std::domain_error);
+    }
+
+    BOOST_AUTO_TEST_CASE(models_must_be_assigned_to_a_process_test) {
+        std::vector<accumulator_ptr> accumulators;
+        using runner_type = cadmium::dynamic::engine::conservative_runner<float, cadmium::logger::not_logger>;
+        BOOST_CHECK_THROW(runner_type(make_groups<lookahead_generator>(accumulators), 0, std::vector<std::size_t>{0, 1}, 2), std::domain_error);
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -86,8 +86,7 @@ BOOST_AUTO_TEST_SUITE(pdevs_dynamic_coordinator_test_suite)
     using eics=std::tuple<>;
     using ics=std::tuple<>;
 
-    BOOST_AUTO_TEST_CASE(coordinator_of_tic_coupled_model) {
-
+    std::shared_ptr<cadmium::dynamic::modeling::coupled<float>> make_tic_coupled_model() {
         std::shared_ptr<cadmium::dynamic::modeling::model> sp_test_generator = cadmium::dynamic::translate::make_dynamic_atomic_model<test_generator, float>();
 
         cadmium::dynamic::translate::models_by_type models_by_type;
@@ -102,7 +101,7 @@ BOOST_AUTO_TEST_SUITE(pdevs_dynamic_coordinator_test_suite)
         cadmium::dynamic::modeling::ICs dynamic_ics = cadmium::dynamic::translate::make_dynamic_ic<float, ics>(
                 models_by_type);
 
-        std::shared_ptr<cadmium::dynamic::modeling::coupled<float>> coupled = std::make_shared<cadmium::dynamic::modeling::coupled<float>>(
+        return std::make_shared<cadmium::dynamic::modeling::coupled<float>>(
                 "dynamic_coupled_test_generator",
                 submodels,
                 input_ports,
@@ -111,6 +110,10 @@ BOOST_AUTO_TEST_SUITE(pdevs_dynamic_coordinator_test_suite)
                 dynamic_eocs,
                 dynamic_ics
         );
+    }
+
+    BOOST_AUTO_TEST_CASE(coordinator_of_tic_coupled_model) {
+        std::shared_ptr<cadmium::dynamic::modeling::coupled<float>> coupled = make_tic_coupled_model();
         cadmium::dynamic::engine::coordinator<float, cadmium::logger::not_logger> cg(coupled);
         //check init sets the right next time
         cg.init(0);
@@ -148,4 +151,38 @@ BOOST_AUTO_TEST_SUITE(pdevs_dynamic_coordinator_test_suite)
                 output_bags.at(typeid(coupled_out_port))).messages.size(), 1); //only a tick happened.
     }
 
+    BOOST_AUTO_TEST_CASE(step_advances_the_tic_coupled_model_like_collecting_and_advancing) {
+        cadmium::dynamic::engine::coordinator<float, cadmium::logger::not_logger> stepped(make_tic_coupled_model());
+        stepped.init(0);
+        //stepping before the next scheduled transition only advances the time
+        stepped.step(0.5f);
+        BOOST_CHECK_EQUAL(1.0f, stepped.next());
+        for (float t = 1.0f; t < 5.0f; t++) {
+            stepped.step(t);
+            BOOST_CHECK_EQUAL(t + 1.0f, stepped.next());
+        }
+        //check stepping after next scheduled transition throws
+        BOOST_CHECK_THROW(stepped.step(6.0f), std::domain_error);
+        //the outputs of the coordinator are still collected on demand
+        stepped.collect_outputs(5.0f);
+        BOOST_CHECK_EQUAL(boost::any_cast<cadmium::message_bag<coupled_out_port>>(
+                stepped.outbox().at(typeid(coupled_out_port))).messages.size(), 1);
+    }
+
+    BOOST_AUTO_TEST_CASE(coordinator_reuses_the_bags_of_its_ports_between_steps) {
+        cadmium::dynamic::engine::coordinator<float, cadmium::logger::not_logger> cg(make_tic_coupled_model());
+        cg.init(0);
+        cg.collect_outputs(1.0f);
+        const auto* first = boost::any_cast<cadmium::message_bag<coupled_out_port>>(&cg.outbox().at(typeid(coupled_out_port)));
+        const test_tick* first_messages = first->messages.data();
+        cg.advance_simulation(1.0f);
+        //the bags are released when the outbox is cleared, so it only defines the ports with messages
+        BOOST_CHECK(cg.outbox().empty());
+        cg.collect_outputs(2.0f);
+        const auto* second = boost::any_cast<cadmium::message_bag<coupled_out_port>>(&cg.outbox().at(typeid(coupled_out_port)));
+        BOOST_CHECK_EQUAL(first, second);
+        BOOST_CHECK_EQUAL(first_messages, second->messages.data());
+        BOOST_CHECK_EQUAL(second->messages.size(), 1);
+    }
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -88,4 +88,48 @@ BOOST_AUTO_TEST_SUITE( pdevs_dynamic_engine_helpers_test_suite )
 #endif
     }
 
+    BOOST_AUTO_TEST_CASE(routes_by_destination_groups_keep_the_order_they_were_added_in){
+        struct test_out: public cadmium::out_port<int>{};
+        struct test_in: public cadmium::in_port<int>{};
+        auto l = std::make_shared<cadmium::dynamic::engine::link<test_out, test_in>>();
+
+        std::vector<cadmium::dynamic::message_bags> sources(3);
+        for (int s = 0; s < 3; s++) {
+            cadmium::message_bag<test_out> b;
+            b.messages = {s * 10, s * 10 + 1};
+            sources[s][typeid(test_out)] = b;
+        }
+        std::vector<cadmium::dynamic::message_bags> destinations(2);
+
+        auto route = [&](int from, int to) -> cadmium::dynamic::engine::bound_route {
+            return {cadmium::dynamic::port_endpoint{nullptr, &sources[from]}, cadmium::dynamic::port_endpoint{nullptr, &destinations[to]}, l};
+        };
+        cadmium::dynamic::engine::bound_routes routes = {route(0, 1), route(1, 0), route(2, 1), route(0, 0)};
+
+        cadmium::dynamic::engine::routes_by_destination grouped;
+        grouped.resize(destinations.size());
+        for (int step = 0; step < 2; step++) {
+            for (auto& d : destinations) {
+                d.clear();
+            }
+            grouped.clear();
+            grouped.add(1, routes[0]);
+            grouped.add(0, routes[1]);
+            grouped.add(1, routes[2]);
+            grouped.add(0, routes[3]);
+            grouped.group();
+
+            BOOST_REQUIRE_EQUAL(grouped.size(), 2);
+            BOOST_CHECK_EQUAL(grouped.routes_in_group(0), 2);
+            BOOST_CHECK_EQUAL(grouped.routes_in_group(1), 2);
+            // groups are independent, routing them in any order gives the sequential result
+            grouped.route_group<cadmium::logger::not_logger>(1);
+            grouped.route_group<cadmium::logger::not_logger>(0);
+
+            auto messages = [&](int d) { return boost::any_cast<cadmium::message_bag<test_in>&>(destinations[d].at(typeid(test_in))).messages; };
+            BOOST_CHECK((messages(0) == std::vector<int>{10, 11, 0, 1}));
+            BOOST_CHECK((messages(1) == std::vector<int>{0, 1, 20, 21}));
+        }
+    }
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,180 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <sstream>
+
+#include <cadmium/basic_model/pdevs/accumulator.hpp>
+
+#include <cadmium/modeling/dynamic_coupled.hpp>
+#include <cadmium/modeling/dynamic_atomic.hpp>
+#include <cadmium/modeling/dynamic_model_translator.hpp>
+
+#include <cadmium/engine/pdevs_dynamic_runner.hpp>
+#include <cadmium/engine/pdevs_dynamic_ensemble_runner.hpp>
+#include <cadmium/logger/common_loggers.hpp>
+
+BOOST_AUTO_TEST_SUITE(pdevs_dynamic_ensemble_runner_test_suite)
+
+    using accumulator_add = cadmium::basic_models::pdevs::accumulator_defs<int>::add;
+
+    struct walker_defs {
+        struct out : public cadmium::out_port<int> {
+        };
+    };
+
+    struct walker_state {
+        int position = 0;
+        std::uint64_t random = 1;
+    };
+
+    std::ostream& operator<<(std::ostream& os, const walker_state& s) {
+        os << s.position;
+        return os;
+    }
+
+    //moves one step back, stays or moves one step forward every second, sending its position
+    template<typename TIME>
+    struct random_walker {
+        using input_ports = std::tuple<>;
+        using output_ports = std::tuple<walker_defs::out>;
+        using state_type = walker_state;
+        state_type state;
+
+        void seed(std::uint64_t s) {
+            state.random = s;
+        }
+
+        void internal_transition() {
+            state.random = state.random * 6364136223846793005ULL + 1442695040888963407ULL;
+            state.position += static_cast<int>((state.random >> 33) % 3) - 1;
+        }
+
+        void external_transition(TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {}
+
+        void confluence_transition(TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {
+            internal_transition();
+        }
+
+        typename cadmium::make_message_bags<output_ports>::type output() const {
+            typename cadmium::make_message_bags<output_ports>::type bags;
+            cadmium::get_messages<walker_defs::out>(bags).push_back(state.position);
+            return bags;
+        }
+
+        TIME time_advance() const {
+            return TIME(1);
+        }
+    };
+
+    template<typename TIME>
+    using int_accumulator = cadmium::basic_models::pdevs::accumulator<int, TIME>;
+
+    std::shared_ptr<cadmium::dynamic::modeling::coupled<float>> make_walk() {
+        using cadmium::dynamic::translate::make_link;
+        using cadmium::dynamic::translate::make_dynamic_atomic_model;
+        return std::make_shared<cadmium::dynamic::modeling::coupled<float>>(
+                "walk",
+                cadmium::dynamic::modeling::Models{make_dynamic_atomic_model<random_walker, float>("walker"), make_dynamic_atomic_model<int_accumulator, float>("accumulator")},
+                cadmium::dynamic::modeling::Ports{},
+                cadmium::dynamic::modeling::Ports{},
+                cadmium::dynamic::modeling::EICs{},
+                cadmium::dynamic::modeling::EOCs{},
+                cadmium::dynamic::modeling::ICs{cadmium::dynamic::modeling::IC("walker", "accumulator", make_link<walker_defs::out, accumulator_add>())}
+        );
+    }
+
+    template<typename MODELS>
+    void seed(const MODELS& models, std::size_t replication) {
+        std::dynamic_pointer_cast<random_walker<float>>(models[0])->seed(replication + 1);
+    }
+
+    template<typename MODELS>
+    std::string sum(const MODELS& models) {
+        return std::to_string(std::get<int>(std::dynamic_pointer_cast<int_accumulator<float>>(models[1])->state));
+    }
+
+    using state_logger = cadmium::logger::logger<cadmium::logger::logger_state, cadmium::dynamic::logger::formatter<float>, cadmium::dynamic::engine::replication_sink_provider>;
+
+    BOOST_AUTO_TEST_CASE(replications_reach_the_states_of_separate_runs_test) {
+        auto model = make_walk();
+        cadmium::dynamic::engine::ensemble_runner<float, state_logger> ensemble(model, 0.0);
+        std::vector<std::ostringstream> logs(6);
+        std::vector<std::ostream*> sinks;
+        for (auto& log : logs) {
+            sinks.push_back(&log);
+        }
+        ensemble.set_sinks(sinks);
+
+        auto setup = [](std::size_t r, auto& models) {
+            seed(models, r);
+        };
+        auto collect = [](std::size_t r, auto& models) {
+            return sum(models);
+        };
+        std::vector<std::string> results = ensemble.run_until(6, 20.0, setup, collect, 3);
+
+        for (std::size_t r = 0; r < 6; r++) {
+            auto separate_model = make_walk();
+            auto atomics = cadmium::dynamic::modeling::flatten<float>(separate_model).atomics;
+            seed(atomics, r);
+            std::ostringstream separate_log;
+            cadmium::dynamic::engine::replication_sink_provider::current() = &separate_log;
+            cadmium::dynamic::engine::runner<float, state_logger> separate(separate_model, 0.0);
+            separate.run_until(20.0);
+            cadmium::dynamic::engine::replication_sink_provider::current() = &std::cout;
+
+            BOOST_CHECK_EQUAL(results[r], sum(atomics));
+            BOOST_CHECK(!logs[r].str().empty());
+            BOOST_CHECK_EQUAL(logs[r].str(), separate_log.str());
+        }
+        BOOST_CHECK(results[0] != results[1] || results[1] != results[2]);
+
+        // the model given to the ensemble is not simulated
+        auto accumulator = std::dynamic_pointer_cast<int_accumulator<float>>(cadmium::dynamic::modeling::flatten<float>(model).atomics[1]);
+        BOOST_CHECK_EQUAL(std::get<int>(accumulator->state), 0);
+    }
+
+    BOOST_AUTO_TEST_CASE(replication_errors_are_thrown_after_the_others_test) {
+        cadmium::dynamic::engine::ensemble_runner<float, cadmium::logger::not_logger> ensemble(make_walk(), 0.0);
+        std::atomic<int> collected{0};
+        auto setup = [](std::size_t r, auto& models) {
+            if (r == 2) {
+                throw std::domain_error("invalid seed");
+            }
+        };
+        auto collect = [&collected](std::size_t r, auto& models) {
+            collected++;
+        };
+        BOOST_CHECK_THROW(ensemble.run_until(5, 10.0, setup, collect, 2), std::domain_error);
+        BOOST_CHECK_EQUAL(collected.load(), 4);
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,138 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <boost/mpl/list.hpp>
+
+#include <cadmium/engine/pdevs_dynamic_fel.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(pdevs_dynamic_fel_test_suite)
+
+    using fel_policies = boost::mpl::list<
+            cadmium::dynamic::engine::linear_scan_fel<double>,
+            cadmium::dynamic::engine::binary_heap_fel<double>,
+            cadmium::dynamic::engine::calendar_queue_fel<double>
+    >;
+
+    template<typename FEL>
+    std::vector<std::size_t> sorted_imminent(const FEL& fel, double t) {
+        std::vector<std::size_t> ret;
+        fel.imminent(t, ret);
+        std::sort(ret.begin(), ret.end());
+        return ret;
+    }
+
+    std::vector<std::size_t> expected_imminent(const std::vector<double>& times, double t) {
+        std::vector<std::size_t> ret;
+        for (std::size_t i = 0; i < times.size(); i++) {
+            if (times[i] == t) {
+                ret.push_back(i);
+            }
+        }
+        return ret;
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(fel_finds_minimum_and_imminent_after_assign_test, FEL, fel_policies) {
+        const double inf = std::numeric_limits<double>::infinity();
+        std::vector<double> times = {3.0, 1.0, inf, 1.0, 2.5};
+        FEL fel;
+        fel.assign(times);
+        BOOST_CHECK_EQUAL(fel.size(), 5);
+        BOOST_CHECK(!fel.empty());
+        BOOST_CHECK_EQUAL(fel.min(), 1.0);
+        std::vector<std::size_t> expected = {1, 3};
+        auto imminent = sorted_imminent(fel, 1.0);
+        BOOST_CHECK_EQUAL_COLLECTIONS(imminent.begin(), imminent.end(), expected.begin(), expected.end());
+        BOOST_CHECK(sorted_imminent(fel, 2.0).empty());
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(fel_reschedules_with_decrease_and_increase_key_test, FEL, fel_policies) {
+        const double inf = std::numeric_limits<double>::infinity();
+        FEL fel;
+        fel.assign({3.0, 1.0, inf});
+        fel.update(1, 4.0); // increase the minimum
+        BOOST_CHECK_EQUAL(fel.min(), 3.0);
+        fel.update(2, 0.5); // wake up a passive entry
+        BOOST_CHECK_EQUAL(fel.min(), 0.5);
+        fel.update(2, inf); // passivate it again
+        fel.update(0, inf);
+        BOOST_CHECK_EQUAL(fel.min(), 4.0);
+        fel.update(1, inf);
+        BOOST_CHECK_EQUAL(fel.min(), inf);
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(fel_matches_a_linear_search_on_a_simulated_workload_test, FEL, fel_policies) {
+        // hold model: the imminent entries are rescheduled to a random later time, or passivated
+        const double inf = std::numeric_limits<double>::infinity();
+        const std::size_t n = 500;
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<int> delay(0, 20);
+        std::bernoulli_distribution passivate(0.05);
+        std::uniform_int_distribution<std::size_t> pick(0, n - 1);
+
+        std::vector<double> times(n);
+        for (auto& t : times) {
+            t = delay(gen) * 0.25;
+        }
+        FEL fel;
+        fel.assign(times);
+
+        for (int step = 0; step < 2000; step++) {
+            double expected_min = *std::min_element(times.begin(), times.end());
+            BOOST_REQUIRE_EQUAL(fel.min(), expected_min);
+            if (expected_min == inf) {
+                break;
+            }
+            auto imminent = sorted_imminent(fel, expected_min);
+            auto expected = expected_imminent(times, expected_min);
+            BOOST_REQUIRE(imminent == expected);
+            for (std::size_t i : imminent) {
+                times[i] = passivate(gen) ? inf : expected_min + delay(gen) * 0.25;
+                fel.update(i, times[i]);
+            }
+            // some passive entries receive inputs and are scheduled again
+            std::size_t woken = pick(gen);
+            if (times[woken] == inf) {
+                times[woken] = expected_min + delay(gen) * 0.25;
+                fel.update(woken, times[woken]);
+            }
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(fel_without_entries_is_empty_test, FEL, fel_policies) {
+        FEL fel;
+        fel.assign({});
+        BOOST_CHECK(fel.empty());
+        BOOST_CHECK_EQUAL(fel.size(), 0);
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,196 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <cadmium/basic_model/pdevs/generator.hpp>
+#include <cadmium/basic_model/pdevs/accumulator.hpp>
+#include <cadmium/modeling/dynamic_coupled.hpp>
+#include <cadmium/modeling/dynamic_atomic.hpp>
+#include <cadmium/modeling/dynamic_model_translator.hpp>
+#include <cadmium/modeling/dynamic_flattened_coupled.hpp>
+
+BOOST_AUTO_TEST_SUITE(pdevs_dynamic_flattened_coupled_test_suite)
+
+    using generator_out = cadmium::basic_models::pdevs::generator_defs<int>::out;
+    using accumulator_add = cadmium::basic_models::pdevs::accumulator_defs<int>::add;
+    using accumulator_sum = cadmium::basic_models::pdevs::accumulator_defs<int>::sum;
+
+    struct coupled_in : public cadmium::in_port<int> {
+    };
+    struct coupled_out : public cadmium::out_port<int> {
+    };
+
+    template<typename TIME>
+    struct int_generator : public cadmium::basic_models::pdevs::generator<int, TIME> {
+        float period() const override {
+            return 1.0f;
+        }
+
+        int output_message() const override {
+            return 1;
+        }
+    };
+
+    template<typename TIME>
+    using int_accumulator = cadmium::basic_models::pdevs::accumulator<int, TIME>;
+
+    using coupled_ptr = std::shared_ptr<cadmium::dynamic::modeling::coupled<float>>;
+
+    /*
+     * Builds a tree of coupled models where each level receives its input in an accumulator and in the
+     * level below, and sends out the outputs of both.
+     */
+    coupled_ptr make_level(int depth) {
+        using namespace cadmium::dynamic::translate;
+        std::string accumulator_id = "accumulator_" + std::to_string(depth);
+        auto accumulator = make_dynamic_atomic_model<int_accumulator, float>(accumulator_id);
+        cadmium::dynamic::modeling::Models models = {accumulator};
+        cadmium::dynamic::modeling::EICs eics = {cadmium::dynamic::modeling::EIC(accumulator_id, make_link<coupled_in, accumulator_add>())};
+        cadmium::dynamic::modeling::EOCs eocs = {cadmium::dynamic::modeling::EOC(accumulator_id, make_link<accumulator_sum, coupled_out>())};
+        cadmium::dynamic::modeling::ICs ics;
+        if (depth > 0) {
+            coupled_ptr below = make_level(depth - 1);
+            models.push_back(below);
+            eics.emplace_back(below->get_id(), make_link<coupled_in, coupled_in>());
+            eocs.emplace_back(below->get_id(), make_link<coupled_out, coupled_out>());
+            ics.emplace_back(accumulator_id, below->get_id(), make_link<accumulator_sum, coupled_in>());
+        }
+        return std::make_shared<cadmium::dynamic::modeling::coupled<float>>(
+                "level_" + std::to_string(depth),
+                models,
+                cadmium::dynamic::modeling::Ports{typeid(coupled_in)},
+                cadmium::dynamic::modeling::Ports{typeid(coupled_out)},
+                eics, eocs, ics
+        );
+    }
+
+    BOOST_AUTO_TEST_CASE(flatten_lists_atomics_in_depth_first_order_and_routes_between_them_test) {
+        using namespace cadmium::dynamic::translate;
+        auto generator = make_dynamic_atomic_model<int_generator, float>("generator");
+        coupled_ptr levels = make_level(2);
+        auto top = std::make_shared<cadmium::dynamic::modeling::coupled<float>>(
+                "top",
+                cadmium::dynamic::modeling::Models{generator, levels},
+                cadmium::dynamic::modeling::Ports{typeid(coupled_in)},
+                cadmium::dynamic::modeling::Ports{typeid(coupled_out)},
+                cadmium::dynamic::modeling::EICs{cadmium::dynamic::modeling::EIC(levels->get_id(), make_link<coupled_in, coupled_in>())},
+                cadmium::dynamic::modeling::EOCs{cadmium::dynamic::modeling::EOC(levels->get_id(), make_link<coupled_out, coupled_out>())},
+                cadmium::dynamic::modeling::ICs{cadmium::dynamic::modeling::IC("generator", levels->get_id(), make_link<generator_out, coupled_in>())}
+        );
+
+        cadmium::dynamic::modeling::flattened_coupled<float> flat = cadmium::dynamic::modeling::flatten<float>(top);
+
+        BOOST_CHECK_EQUAL(flat.id, "top");
+        std::vector<std::string> ids;
+        for (const auto& m : flat.atomics) {
+            ids.push_back(m->get_id());
+        }
+        std::vector<std::string> expected_ids = {"generator", "accumulator_2", "accumulator_1", "accumulator_0"};
+        BOOST_CHECK_EQUAL_COLLECTIONS(ids.begin(), ids.end(), expected_ids.begin(), expected_ids.end());
+
+        // the generator reaches every accumulator, and each accumulator reaches all the ones below it.
+        // Routes to the same accumulator keep the hierarchical delivery order: closer ICs first.
+        std::vector<std::pair<std::size_t, std::size_t>> ics;
+        for (const auto& ic : flat.ic) {
+            ics.emplace_back(ic.from, ic.to);
+            BOOST_CHECK(ic.link->from_port_type_index() == flat.atomics[ic.from]->get_output_ports().front());
+            BOOST_CHECK(ic.link->to_port_type_index() == flat.atomics[ic.to]->get_input_ports().front());
+        }
+        std::vector<std::pair<std::size_t, std::size_t>> expected_ics = {
+                {0, 1},
+                {1, 2}, {0, 2},
+                {2, 3}, {1, 3}, {0, 3}
+        };
+        BOOST_CHECK(ics == expected_ics);
+
+        // top input reaches every accumulator, and all of them reach the top output
+        BOOST_CHECK_EQUAL(flat.eic.size(), 3);
+        BOOST_CHECK_EQUAL(flat.eoc.size(), 3);
+        for (const auto& eic : flat.eic) {
+            BOOST_CHECK(eic.link->from_port_type_index() == typeid(coupled_in));
+            BOOST_CHECK(eic.link->to_port_type_index() == typeid(accumulator_add));
+        }
+        for (std::size_t i = 0; i < flat.eoc.size(); i++) {
+            BOOST_CHECK_EQUAL(flat.eoc[i].model, i + 1);
+            BOOST_CHECK(flat.eoc[i].link->from_port_type_index() == typeid(accumulator_sum));
+            BOOST_CHECK(flat.eoc[i].link->to_port_type_index() == typeid(coupled_out));
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(flattened_routes_deliver_the_messages_to_the_atomic_ports_test) {
+        coupled_ptr levels = make_level(3);
+        cadmium::dynamic::modeling::flattened_coupled<float> flat = cadmium::dynamic::modeling::flatten<float>(levels);
+
+        // the output of the top accumulator is routed to the accumulator at the bottom of the tree
+        std::size_t bottom = flat.atomics.size() - 1;
+        auto route = std::find_if(flat.ic.begin(), flat.ic.end(), [bottom](const auto& ic) { return ic.from == 0 && ic.to == bottom; });
+        BOOST_REQUIRE(route != flat.ic.end());
+
+        cadmium::message_bag<accumulator_sum> sum;
+        sum.messages.push_back(7);
+        cadmium::dynamic::message_bags outbox;
+        outbox[typeid(accumulator_sum)] = sum;
+        cadmium::dynamic::message_bags inbox;
+        route->link->route_messages(outbox, inbox);
+
+        BOOST_CHECK_EQUAL(inbox.size(), 1);
+        auto received = boost::any_cast<cadmium::message_bag<accumulator_add>>(inbox.at(typeid(accumulator_add))).messages;
+        BOOST_CHECK_EQUAL(received.size(), 1);
+        BOOST_CHECK_EQUAL(received.front(), 7);
+    }
+
+    BOOST_AUTO_TEST_CASE(grouping_by_part_renumbers_the_couplings_test) {
+        coupled_ptr levels = make_level(2);
+        cadmium::dynamic::modeling::flattened_coupled<float> flat = cadmium::dynamic::modeling::flatten<float>(levels);
+        BOOST_CHECK_EQUAL(3, cadmium::dynamic::modeling::count_atomics<float>(levels));
+
+        // accumulator_2 and accumulator_0 in part 0, accumulator_1 in part 1
+        cadmium::dynamic::modeling::flattened_coupled<float> grouped = cadmium::dynamic::modeling::group_by_part(flat, {0, 1, 0});
+        std::vector<std::string> ids;
+        for (const auto& m : grouped.atomics) {
+            ids.push_back(m->get_id());
+        }
+        std::vector<std::string> expected_ids = {"accumulator_2", "accumulator_0", "accumulator_1"};
+        BOOST_CHECK_EQUAL_COLLECTIONS(ids.begin(), ids.end(), expected_ids.begin(), expected_ids.end());
+        BOOST_REQUIRE_EQUAL(flat.ic.size(), grouped.ic.size());
+        std::vector<std::size_t> position = {0, 2, 1};
+        for (std::size_t i = 0; i < flat.ic.size(); i++) {
+            BOOST_CHECK_EQUAL(position[flat.ic[i].from], grouped.ic[i].from);
+            BOOST_CHECK_EQUAL(position[flat.ic[i].to], grouped.ic[i].to);
+            BOOST_CHECK(flat.ic[i].link == grouped.ic[i].link);
+        }
+        for (std::size_t i = 0; i < flat.eic.size(); i++) {
+            BOOST_CHECK_EQUAL(position[flat.eic[i].model], grouped.eic[i].model);
+        }
+        for (std::size_t i = 0; i < flat.eoc.size(); i++) {
+            BOOST_CHECK_EQUAL(position[flat.eoc[i].model], grouped.eoc[i].model);
+        }
+        BOOST_CHECK_THROW(cadmium::dynamic::modeling::group_by_part(flat, {0, 1}), std::domain_error);
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,240 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <cadmium/basic_model/pdevs/generator.hpp>
+#include <cadmium/basic_model/pdevs/accumulator.hpp>
+
+#include <cadmium/modeling/dynamic_coupled.hpp>
+#include <cadmium/modeling/dynamic_atomic.hpp>
+#include <cadmium/modeling/dynamic_model_translator.hpp>
+
+#include <cadmium/engine/pdevs_dynamic_runner.hpp>
+#include <cadmium/engine/pdevs_dynamic_graph_partitioner.hpp>
+#include <cadmium/logger/common_loggers.hpp>
+
+BOOST_AUTO_TEST_SUITE(pdevs_dynamic_graph_partitioner_test_suite)
+
+    using generator_out = cadmium::basic_models::pdevs::generator_defs<int>::out;
+    using accumulator_add = cadmium::basic_models::pdevs::accumulator_defs<int>::add;
+
+    //sends 1 every second
+    template<typename TIME>
+    struct slow_generator : public cadmium::basic_models::pdevs::generator<int, TIME> {
+        float period() const override {
+            return 1.0f;
+        }
+
+        int output_message() const override {
+            return 1;
+        }
+    };
+
+    //sends 2 four times per second
+    template<typename TIME>
+    struct fast_generator : public cadmium::basic_models::pdevs::generator<int, TIME> {
+        float period() const override {
+            return 0.25f;
+        }
+
+        int output_message() const override {
+            return 2;
+        }
+    };
+
+    template<typename TIME>
+    using int_accumulator = cadmium::basic_models::pdevs::accumulator<int, TIME>;
+
+    //two fast and two slow generators, each one sending to its accumulator, all the generators
+    //declared before the accumulators so contiguous blocks of models cut every coupling
+    std::shared_ptr<cadmium::dynamic::modeling::coupled<float>> make_interleaved_pairs() {
+        using cadmium::dynamic::translate::make_link;
+        using cadmium::dynamic::translate::make_dynamic_atomic_model;
+        cadmium::dynamic::modeling::Models models;
+        cadmium::dynamic::modeling::ICs ics;
+        for (int g = 0; g < 2; g++) {
+            models.push_back(make_dynamic_atomic_model<fast_generator, float>("fast" + std::to_string(g)));
+            models.push_back(make_dynamic_atomic_model<slow_generator, float>("slow" + std::to_string(g)));
+        }
+        for (int g = 0; g < 2; g++) {
+            std::string n = std::to_string(g);
+            models.push_back(make_dynamic_atomic_model<int_accumulator, float>("acc_fast" + n));
+            models.push_back(make_dynamic_atomic_model<int_accumulator, float>("acc_slow" + n));
+            ics.emplace_back("fast" + n, "acc_fast" + n, make_link<generator_out, accumulator_add>());
+            ics.emplace_back("slow" + n, "acc_slow" + n, make_link<generator_out, accumulator_add>());
+        }
+        return std::make_shared<cadmium::dynamic::modeling::coupled<float>>(
+                "top", models, cadmium::dynamic::modeling::Ports{}, cadmium::dynamic::modeling::Ports{},
+                cadmium::dynamic::modeling::EICs{}, cadmium::dynamic::modeling::EOCs{}, ics
+        );
+    }
+
+    //side x side lattice with its cells numbered in a scattered order
+    cadmium::dynamic::engine::coupling_graph make_scattered_lattice(std::size_t side) {
+        std::size_t n = side * side;
+        auto vertex = [side, n](std::size_t row, std::size_t column) { return ((row * side + column) * 37) % n; };
+        cadmium::dynamic::engine::coupling_graph graph(n);
+        for (std::size_t row = 0; row < side; row++) {
+            for (std::size_t column = 0; column < side; column++) {
+                if (column + 1 < side) {
+                    graph.add_edge(vertex(row, column), vertex(row, column + 1));
+                }
+                if (row + 1 < side) {
+                    graph.add_edge(vertex(row, column), vertex(row + 1, column));
+                }
+            }
+        }
+        return graph;
+    }
+
+    BOOST_AUTO_TEST_CASE(parallel_edges_are_merged_test) {
+        cadmium::dynamic::engine::coupling_graph graph(3);
+        graph.add_edge(0, 1, 2.0);
+        graph.add_edge(1, 0, 1.0);
+        graph.add_edge(1, 2);
+        graph.add_edge(2, 2);
+        graph.compact();
+        BOOST_CHECK_EQUAL(2, graph.edges());
+        BOOST_REQUIRE_EQUAL(2, graph.neighbors(1).size());
+        BOOST_CHECK_EQUAL(0, graph.neighbors(1)[0].first);
+        BOOST_CHECK_EQUAL(3.0, graph.neighbors(1)[0].second);
+        BOOST_CHECK_THROW(graph.add_edge(0, 3), std::domain_error);
+    }
+
+    BOOST_AUTO_TEST_CASE(bridged_cliques_are_split_at_the_bridge_test) {
+        cadmium::dynamic::engine::coupling_graph graph(12);
+        for (std::size_t a = 0; a < 6; a++) {
+            for (std::size_t b = a + 1; b < 6; b++) {
+                // the cliques interleave their vertices
+                graph.add_edge(2 * a, 2 * b);
+                graph.add_edge(2 * a + 1, 2 * b + 1);
+            }
+        }
+        graph.add_edge(0, 1);
+        auto partition = cadmium::dynamic::engine::partition_graph(graph, 2);
+        BOOST_CHECK_EQUAL(31, partition.edges);
+        BOOST_CHECK_EQUAL(1, partition.cut_edges);
+        BOOST_CHECK_EQUAL(1.0, partition.imbalance);
+        for (std::size_t v = 2; v < 12; v++) {
+            BOOST_CHECK_EQUAL(partition.part_of[v % 2], partition.part_of[v]);
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(lattice_is_split_in_compact_balanced_parts_test) {
+        auto graph = make_scattered_lattice(16);
+        auto partition = cadmium::dynamic::engine::partition_graph(graph, 4);
+        auto contiguous = cadmium::dynamic::engine::contiguous_partition(graph, 4);
+        BOOST_TEST_MESSAGE("partitioned " << partition.report());
+        BOOST_TEST_MESSAGE("contiguous " << contiguous.report());
+        BOOST_CHECK_EQUAL(480, partition.edges);
+        // four quadrants cut 32 edges
+        BOOST_CHECK_LE(partition.cut_edges, 48);
+        BOOST_CHECK_LT(partition.cut_edges * 4, contiguous.cut_edges);
+        BOOST_CHECK_LE(partition.imbalance, 1.05);
+        BOOST_CHECK_EQUAL(4, partition.part_weights.size());
+    }
+
+    BOOST_AUTO_TEST_CASE(parts_are_balanced_by_vertex_weight_test) {
+        // a chain with a heavy vertex at one end
+        cadmium::dynamic::engine::coupling_graph graph(8);
+        graph.set_weight(0, 7.0);
+        for (std::size_t v = 0; v + 1 < 8; v++) {
+            graph.add_edge(v, v + 1);
+        }
+        auto partition = cadmium::dynamic::engine::partition_graph(graph, 2);
+        BOOST_CHECK_EQUAL(1, partition.cut_edges);
+        BOOST_CHECK_EQUAL(7.0, partition.part_weights[partition.part_of[0]]);
+        BOOST_CHECK_EQUAL(1.0, partition.imbalance);
+
+        BOOST_CHECK_THROW(cadmium::dynamic::engine::partition_graph(graph, 0), std::domain_error);
+        auto single = cadmium::dynamic::engine::partition_graph(graph, 1);
+        BOOST_CHECK_EQUAL(0, single.cut_edges);
+    }
+
+    BOOST_AUTO_TEST_CASE(more_parts_than_vertices_test) {
+        cadmium::dynamic::engine::coupling_graph graph(3);
+        graph.add_edge(0, 1);
+        auto partition = cadmium::dynamic::engine::partition_graph(graph, 5);
+        BOOST_CHECK_EQUAL(5, partition.parts);
+        BOOST_CHECK_EQUAL(3, partition.part_of.size());
+        for (std::size_t p : partition.part_of) {
+            BOOST_CHECK_LT(p, 5);
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(weights_are_measured_simulating_the_model_test) {
+        auto weights = cadmium::dynamic::engine::measure_coupling_weights<float>(make_interleaved_pairs(), 0, 10.1f);
+        // fast0, slow0, fast1, slow1, acc_fast0, acc_slow0, acc_fast1, acc_slow1
+        std::vector<double> transitions = {40, 10, 40, 10, 40, 10, 40, 10};
+        BOOST_CHECK_EQUAL_COLLECTIONS(transitions.begin(), transitions.end(), weights.transitions.begin(), weights.transitions.end());
+        BOOST_REQUIRE_EQUAL(4, weights.messages.size());
+        double messages = 0;
+        for (double m : weights.messages) {
+            messages += m;
+        }
+        BOOST_CHECK_EQUAL(100, messages);
+    }
+
+    BOOST_AUTO_TEST_CASE(atomic_models_partition_keeps_the_pairs_together_test) {
+        auto weights = cadmium::dynamic::engine::measure_coupling_weights<float>(make_interleaved_pairs(), 0, 10.1f);
+        auto partition = cadmium::dynamic::engine::partition_atomics<float>(make_interleaved_pairs(), 2, weights);
+        auto contiguous = cadmium::dynamic::engine::contiguous_partition(
+                cadmium::dynamic::engine::make_coupling_graph<float>(cadmium::dynamic::modeling::flatten<float>(make_interleaved_pairs()), weights), 2);
+        BOOST_CHECK_EQUAL(0, partition.cut_edges);
+        BOOST_CHECK_EQUAL(4, contiguous.cut_edges);
+        BOOST_CHECK_EQUAL(1.0, partition.imbalance);
+        for (std::size_t g = 0; g < 4; g++) {
+            BOOST_CHECK_EQUAL(partition.part_of[g], partition.part_of[g + 4]);
+        }
+
+        auto children = cadmium::dynamic::engine::partition_children<float>(make_interleaved_pairs(), 2, weights);
+        BOOST_CHECK(partition.part_of == children.part_of);
+    }
+
+    BOOST_AUTO_TEST_CASE(runner_simulates_the_partitioned_model_as_the_sequential_one_test) {
+        auto expected_model = make_interleaved_pairs();
+        auto partitioned_model = make_interleaved_pairs();
+        auto partition = cadmium::dynamic::engine::partition_atomics<float>(make_interleaved_pairs(), 2);
+#if defined CPU_PARALLEL || defined CADMIUM_EXECUTE_CONCURRENT || defined CADMIUM_EXECUTE_TEAM
+        cadmium::dynamic::engine::runner<float, cadmium::logger::not_logger> sequential(expected_model, 0, 2);
+        cadmium::dynamic::engine::runner<float, cadmium::logger::not_logger> partitioned(partitioned_model, 0, partition.part_of, 2);
+#else
+        cadmium::dynamic::engine::runner<float, cadmium::logger::not_logger> sequential(expected_model, 0);
+        cadmium::dynamic::engine::runner<float, cadmium::logger::not_logger> partitioned(partitioned_model, 0, partition.part_of);
+#endif
+        BOOST_CHECK_EQUAL(sequential.run_until(10.1f), partitioned.run_until(10.1f));
+        auto expected = cadmium::dynamic::modeling::flatten<float>(expected_model).atomics;
+        auto states = cadmium::dynamic::modeling::flatten<float>(partitioned_model).atomics;
+        for (std::size_t a = 0; a < expected.size(); a++) {
+            BOOST_CHECK_EQUAL(std::dynamic_pointer_cast<cadmium::dynamic::modeling::atomic_abstract<float>>(expected[a])->model_state_as_string(),
+                              std::dynamic_pointer_cast<cadmium::dynamic::modeling::atomic_abstract<float>>(states[a])->model_state_as_string());
+        }
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -92,6 +92,58 @@ BOOST_AUTO_TEST_SUITE( test_links )
         BOOST_CHECK_EQUAL(boost::any_cast<cadmium::message_bag<test_in>>(bag_to.at(link_test->to_port_type_index())).messages[1], 3);
     }
 
+    BOOST_AUTO_TEST_CASE( test_chained_links_route_from_the_first_from_port_to_the_last_to_port ) {
+        struct a_out: public cadmium::out_port<int>{};
+        struct b_out: public cadmium::out_port<int>{};
+        struct c_in: public cadmium::in_port<int>{};
+        struct d_in: public cadmium::in_port<int>{};
+
+        auto a_to_b = cadmium::dynamic::translate::make_link<a_out, b_out>();
+        auto b_to_c = cadmium::dynamic::translate::make_link<b_out, c_in>();
+        auto c_to_d = cadmium::dynamic::translate::make_link<c_in, d_in>();
+
+        std::shared_ptr<cadmium::dynamic::engine::link_abstract> a_to_d = a_to_b->chain(b_to_c)->chain(c_to_d);
+        BOOST_CHECK(a_to_d->from_port_type_index() == typeid(a_out));
+        BOOST_CHECK(a_to_d->to_port_type_index() == typeid(d_in));
+
+        cadmium::message_bag<a_out> bag_out;
+        bag_out.messages.push_back(3);
+        bag_out.messages.push_back(5);
+        cadmium::dynamic::message_bags bag_from;
+        bag_from[typeid(a_out)] = bag_out;
+
+        cadmium::dynamic::message_bags bag_to;
+        cadmium::dynamic::logger::routed_messages routed = a_to_d->route_messages(bag_from, bag_to);
+
+        // only the last to port is filled
+        BOOST_CHECK_EQUAL(bag_to.size(), 1);
+        auto messages = boost::any_cast<cadmium::message_bag<d_in>>(bag_to.at(typeid(d_in))).messages;
+        BOOST_CHECK_EQUAL(messages.size(), 2);
+        BOOST_CHECK_EQUAL(messages[0], 3);
+        BOOST_CHECK_EQUAL(messages[1], 5);
+        BOOST_CHECK_EQUAL(routed.from_port, boost::typeindex::type_id<a_out>().pretty_name());
+        BOOST_CHECK_EQUAL(routed.to_port, boost::typeindex::type_id<d_in>().pretty_name());
+        BOOST_CHECK_EQUAL(routed.to_messages.size(), 2);
+
+        // empty bags are not created in the destination
+        cadmium::dynamic::message_bags empty_from;
+        empty_from[typeid(a_out)] = cadmium::message_bag<a_out>();
+        cadmium::dynamic::message_bags empty_to;
+        a_to_d->route_messages(empty_from, empty_to);
+        BOOST_CHECK(empty_to.empty());
+    }
+
+    BOOST_AUTO_TEST_CASE( test_chaining_links_of_different_message_types_throws ) {
+        struct int_out: public cadmium::out_port<int>{};
+        struct int_in: public cadmium::in_port<int>{};
+        struct float_out: public cadmium::out_port<float>{};
+        struct float_in: public cadmium::in_port<float>{};
+
+        auto int_link = cadmium::dynamic::translate::make_link<int_out, int_in>();
+        auto float_link = cadmium::dynamic::translate::make_link<float_out, float_in>();
+        BOOST_CHECK_THROW(int_link->chain(float_link), std::domain_error);
+    }
+
     BOOST_AUTO_TEST_CASE( make_ports_from_cadmium_tuple_port_type ) {
         struct in_port_0 : public cadmium::in_port<int>{};
         struct in_port_1 : public cadmium::in_port<int>{};
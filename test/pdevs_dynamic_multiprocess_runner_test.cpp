@@ -0,0 +1,123 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <csignal>
+#include <unistd.h>
+
+#include <cadmium/modeling/message_codec.hpp>
+#include <cadmium/engine/pdevs_dynamic_multiprocess_runner.hpp>
+
+#include "dynamic_runner_fixtures.hpp"
+
+BOOST_AUTO_TEST_SUITE(pdevs_dynamic_multiprocess_runner_test_suite)
+
+    using namespace dynamic_runner_fixtures;
+
+    struct text_out : public cadmium::out_port<std::string> {
+    };
+
+    struct text_in : public cadmium::in_port<std::string> {
+    };
+
+    struct numbers_out : public cadmium::out_port<std::vector<int>> {
+    };
+
+    struct numbers_in : public cadmium::in_port<std::vector<int>> {
+    };
+
+    pid_t test_process = ::getpid();
+
+    //a slow generator whose worker process is killed on its first internal transition
+    template<typename TIME>
+    struct crashing_generator : public slow_generator<TIME> {
+        void internal_transition() {
+            if (::getpid() != test_process) {
+                ::raise(SIGKILL);
+            }
+            slow_generator<TIME>::internal_transition();
+        }
+    };
+
+    BOOST_AUTO_TEST_CASE(links_encode_and_decode_their_messages_test) {
+        auto numbers = cadmium::dynamic::translate::make_link<generator_out, accumulator_add>();
+        cadmium::bag<int> from = {1, 2, 3};
+        cadmium::bag<int> to = {0};
+        std::string bytes;
+        numbers->encode_messages(cadmium::dynamic::port_endpoint{&from, nullptr}, bytes);
+        numbers->decode_messages(bytes.data(), bytes.size(), cadmium::dynamic::port_endpoint{&to, nullptr});
+        BOOST_CHECK((cadmium::bag<int>{0, 1, 2, 3}) == to);
+
+        auto text = cadmium::dynamic::translate::make_link<text_out, text_in>();
+        cadmium::bag<std::string> text_from = {"", "cadmium"};
+        cadmium::bag<std::string> text_to;
+        bytes.clear();
+        text->encode_messages(cadmium::dynamic::port_endpoint{&text_from, nullptr}, bytes);
+        text->decode_messages(bytes.data(), bytes.size(), cadmium::dynamic::port_endpoint{&text_to, nullptr});
+        BOOST_CHECK(text_from == text_to);
+        BOOST_CHECK_THROW(text->decode_messages(bytes.data(), bytes.size() - 1, cadmium::dynamic::port_endpoint{&text_to, nullptr}), std::domain_error);
+    }
+
+    BOOST_AUTO_TEST_CASE(messages_without_codec_can_not_be_encoded_test) {
+        BOOST_CHECK(!cadmium::dynamic::message_codec<std::vector<int>>::defined);
+        auto l = cadmium::dynamic::translate::make_link<numbers_out, numbers_in>();
+        cadmium::bag<std::vector<int>> from = {{1, 2}};
+        std::string bytes;
+        BOOST_CHECK_THROW(l->encode_messages(cadmium::dynamic::port_endpoint{&from, nullptr}, bytes), std::domain_error);
+    }
+
+    BOOST_AUTO_TEST_CASE(worker_processes_simulate_the_same_as_the_sequential_runner_test) {
+        sequential_result expected = run_sequentially(make_coupled_groups(), 10.1f);
+
+        // each group and its slow generator and accumulator in a worker process
+        cadmium::dynamic::engine::multiprocess_runner<float, cadmium::logger::not_logger> r(make_coupled_groups(), 0, 2);
+        BOOST_CHECK_EQUAL(2, r.processes());
+        BOOST_CHECK_EQUAL(5.25f, r.run_until(5.1f));
+        BOOST_CHECK_EQUAL(expected.next, r.run_until(10.1f));
+        std::vector<std::string> states = r.model_states();
+        BOOST_CHECK_EQUAL_COLLECTIONS(expected.states.begin(), expected.states.end(), states.begin(), states.end());
+    }
+
+    BOOST_AUTO_TEST_CASE(dead_worker_processes_stop_the_simulation_test) {
+        using cadmium::dynamic::translate::make_dynamic_atomic_model;
+        auto top = std::make_shared<cadmium::dynamic::modeling::coupled<float>>(
+                "top", cadmium::dynamic::modeling::Models{make_dynamic_atomic_model<crashing_generator, float>("crashing"), make_dynamic_atomic_model<slow_generator, float>("slow")},
+                cadmium::dynamic::modeling::Ports{}, cadmium::dynamic::modeling::Ports{},
+                cadmium::dynamic::modeling::EICs{}, cadmium::dynamic::modeling::EOCs{}, cadmium::dynamic::modeling::ICs{}
+        );
+        cadmium::dynamic::engine::multiprocess_runner<float, cadmium::logger::not_logger> r(top, 0, 2);
+        BOOST_CHECK_THROW(r.run_until(5.1f), std::runtime_error);
+        BOOST_CHECK_THROW(r.run_until(5.1f), std::runtime_error);
+    }
+
+    BOOST_AUTO_TEST_CASE(children_must_be_assigned_to_a_worker_test) {
+        using runner_type = cadmium::dynamic::engine::multiprocess_runner<float, cadmium::logger::not_logger>;
+        BOOST_CHECK_THROW(runner_type(make_coupled_groups(), 0, std::vector<std::size_t>{0, 1}), std::domain_error);
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -28,7 +28,12 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <filesystem>
+#include <fstream>
+
 #include <cadmium/basic_model/pdevs/generator.hpp>
+#include <cadmium/basic_model/pdevs/accumulator.hpp>
+#include <cadmium/basic_model/pdevs/passive.hpp>
 
 #include <cadmium/modeling/dynamic_coupled.hpp>
 #include <cadmium/modeling/dynamic_atomic.hpp>
@@ -36,6 +41,7 @@
 
 #include <cadmium/engine/pdevs_dynamic_runner.hpp>
 #include <cadmium/modeling/coupling.hpp>
+#include <cadmium/logger/common_loggers.hpp>
 
 BOOST_AUTO_TEST_SUITE(pdevs_dynamic_runner_test_suite)
 
@@ -271,5 +277,369 @@ BOOST_AUTO_TEST_SUITE(pdevs_dynamic_runner_test_suite)
 
     BOOST_AUTO_TEST_SUITE_END()
 
+    BOOST_AUTO_TEST_SUITE(fel_policies_dynamic_runner_test_suite)
+
+        namespace {
+            std::ostringstream fel_oss;
+
+            struct fel_oss_test_sink_provider {
+                static std::ostream &sink() {
+                    return fel_oss;
+                }
+            };
+
+            using int_out_port = cadmium::basic_models::pdevs::generator_defs<int>::out;
+            using add_port = cadmium::basic_models::pdevs::accumulator_defs<int>::add;
+
+            template<typename TIME>
+            struct fast_generator : public cadmium::basic_models::pdevs::generator<int, TIME> {
+                float period() const override {
+                    return 1.0f;
+                }
+
+                int output_message() const override {
+                    return 1;
+                }
+            };
+
+            template<typename TIME>
+            struct slow_generator : public cadmium::basic_models::pdevs::generator<int, TIME> {
+                float period() const override {
+                    return 2.5f;
+                }
+
+                int output_message() const override {
+                    return 10;
+                }
+            };
+
+            template<typename TIME>
+            using int_accumulator = cadmium::basic_models::pdevs::accumulator<int, TIME>;
+
+            struct sum_out_port : public cadmium::out_port<int> {
+            };
+
+            template<typename TIME>
+            using generators_to_accumulator = cadmium::modeling::pdevs::coupled_model<
+                    TIME,
+                    std::tuple<>,
+                    std::tuple<sum_out_port>,
+                    cadmium::modeling::models_tuple<fast_generator, slow_generator, int_accumulator>,
+                    std::tuple<>,
+                    std::tuple<cadmium::modeling::EOC<slow_generator, int_out_port, sum_out_port>>,
+                    std::tuple<
+                            cadmium::modeling::IC<fast_generator, int_out_port, int_accumulator, add_port>,
+                            cadmium::modeling::IC<slow_generator, int_out_port, int_accumulator, add_port>
+                    >
+            >;
+
+            template<template<typename> class FEL>
+            std::string run_generators_to_accumulator() {
+                using log_state_to_oss = cadmium::logger::logger<cadmium::logger::logger_state, cadmium::dynamic::logger::formatter<float>, fel_oss_test_sink_provider>;
+                fel_oss.str("");
+                auto model = cadmium::dynamic::translate::make_dynamic_coupled_model<float, generators_to_accumulator>();
+                cadmium::dynamic::engine::runner<float, log_state_to_oss, FEL> r(model, 0.0);
+                r.run_until(20.0);
+                return fel_oss.str();
+            }
+        }
+
+        BOOST_AUTO_TEST_CASE(dynamic_runner_produces_the_same_states_with_every_fel_policy_test) {
+            std::string linear_scan = run_generators_to_accumulator<cadmium::dynamic::engine::linear_scan_fel>();
+            std::string binary_heap = run_generators_to_accumulator<cadmium::dynamic::engine::binary_heap_fel>();
+            std::string calendar_queue = run_generators_to_accumulator<cadmium::dynamic::engine::calendar_queue_fel>();
+
+            BOOST_CHECK(!linear_scan.empty());
+            BOOST_CHECK_EQUAL(linear_scan, binary_heap);
+            BOOST_CHECK_EQUAL(linear_scan, calendar_queue);
+            // 19 ticks of the fast generator and 7 ticks of the slow one were accumulated
+            BOOST_CHECK(linear_scan.find("is [89, 0]") != std::string::npos);
+        }
+
+    BOOST_AUTO_TEST_SUITE_END()
+
+    BOOST_AUTO_TEST_SUITE(flattened_dynamic_runner_test_suite)
+
+        namespace {
+            // relays every message received with a delay of 0.5
+            struct relay_defs {
+                struct in : public cadmium::in_port<int> {
+                };
+                struct out : public cadmium::out_port<int> {
+                };
+            };
+
+            struct relay_state {
+                std::vector<int> pending;
+                int received = 0;
+            };
+
+            std::ostream& operator<<(std::ostream& os, const relay_state& s) {
+                os << "received " << s.received << " pending";
+                for (int x : s.pending) {
+                    os << " " << x;
+                }
+                return os;
+            }
+
+            template<typename TIME>
+            class relay {
+            public:
+                using input_ports = std::tuple<relay_defs::in>;
+                using output_ports = std::tuple<relay_defs::out>;
+                using state_type = relay_state;
+                state_type state;
+
+                void internal_transition() {
+                    state.pending.clear();
+                }
+
+                void external_transition(TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {
+                    for (int x : cadmium::get_messages<relay_defs::in>(mbs)) {
+                        state.pending.push_back(x + 1);
+                        state.received++;
+                    }
+                }
+
+                void confluence_transition(TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {
+                    internal_transition();
+                    external_transition(TIME(), std::move(mbs));
+                }
+
+                typename cadmium::make_message_bags<output_ports>::type output() const {
+                    typename cadmium::make_message_bags<output_ports>::type bags;
+                    cadmium::get_messages<relay_defs::out>(bags) = state.pending;
+                    return bags;
+                }
+
+                TIME time_advance() const {
+                    return state.pending.empty() ? std::numeric_limits<TIME>::infinity() : TIME(0.5);
+                }
+
+                void encode_state(std::string& out) const {
+                    cadmium::dynamic::state_codec<std::vector<int>>::encode(state.pending, out);
+                    cadmium::dynamic::state_codec<int>::encode(state.received, out);
+                }
+
+                void decode_state(const char*& data, const char* end) {
+                    cadmium::dynamic::state_codec<std::vector<int>>::decode(state.pending, data, end);
+                    cadmium::dynamic::state_codec<int>::decode(state.received, data, end);
+                }
+            };
+
+            template<typename TIME>
+            struct int_generator : public cadmium::basic_models::pdevs::generator<int, TIME> {
+                float period() const override {
+                    return 1.0f;
+                }
+
+                int output_message() const override {
+                    return 0;
+                }
+            };
+
+            struct level_in : public cadmium::in_port<int> {
+            };
+            struct level_out : public cadmium::out_port<int> {
+            };
+
+            using coupled_ptr = std::shared_ptr<cadmium::dynamic::modeling::coupled<float>>;
+
+            // DEVStone HO like tree of coupled models
+            coupled_ptr make_level(int depth) {
+                using namespace cadmium::dynamic::translate;
+                std::string relay_id = "relay_" + std::to_string(depth);
+                cadmium::dynamic::modeling::Models models = {make_dynamic_atomic_model<relay, float>(relay_id)};
+                cadmium::dynamic::modeling::EICs eics = {cadmium::dynamic::modeling::EIC(relay_id, make_link<level_in, relay_defs::in>())};
+                cadmium::dynamic::modeling::EOCs eocs = {cadmium::dynamic::modeling::EOC(relay_id, make_link<relay_defs::out, level_out>())};
+                cadmium::dynamic::modeling::ICs ics;
+                if (depth > 0) {
+                    coupled_ptr below = make_level(depth - 1);
+                    models.push_back(below);
+                    eics.emplace_back(below->get_id(), make_link<level_in, level_in>());
+                    eocs.emplace_back(below->get_id(), make_link<level_out, level_out>());
+                    ics.emplace_back(relay_id, below->get_id(), make_link<relay_defs::out, level_in>());
+                }
+                return std::make_shared<cadmium::dynamic::modeling::coupled<float>>(
+                        "level_" + std::to_string(depth), models,
+                        cadmium::dynamic::modeling::Ports{typeid(level_in)}, cadmium::dynamic::modeling::Ports{typeid(level_out)},
+                        eics, eocs, ics
+                );
+            }
+
+            coupled_ptr make_top(int depth) {
+                using namespace cadmium::dynamic::translate;
+                coupled_ptr levels = make_level(depth);
+                return std::make_shared<cadmium::dynamic::modeling::coupled<float>>(
+                        "top",
+                        cadmium::dynamic::modeling::Models{make_dynamic_atomic_model<int_generator, float>("generator"), levels, make_dynamic_atomic_model<relay, float>("sink")},
+                        cadmium::dynamic::modeling::Ports{},
+                        cadmium::dynamic::modeling::Ports{typeid(level_out)},
+                        cadmium::dynamic::modeling::EICs{},
+                        cadmium::dynamic::modeling::EOCs{cadmium::dynamic::modeling::EOC(levels->get_id(), make_link<level_out, level_out>())},
+                        cadmium::dynamic::modeling::ICs{
+                                cadmium::dynamic::modeling::IC("generator", levels->get_id(), make_link<cadmium::basic_models::pdevs::generator_defs<int>::out, level_in>()),
+                                cadmium::dynamic::modeling::IC(levels->get_id(), "sink", make_link<level_out, relay_defs::in>())
+                        }
+                );
+            }
+
+            std::vector<std::string> atomic_states(const coupled_ptr& top) {
+                std::vector<std::string> ret;
+                for (const auto& m : cadmium::dynamic::modeling::flatten<float>(top).atomics) {
+                    auto atomic = std::dynamic_pointer_cast<cadmium::dynamic::modeling::atomic_abstract<float>>(m);
+                    ret.push_back(atomic->get_id() + ": " + atomic->model_state_as_string());
+                }
+                return ret;
+            }
+        }
+
+        BOOST_AUTO_TEST_CASE(flattened_runner_reaches_the_same_states_than_the_hierarchical_one_test) {
+            coupled_ptr hierarchical_model = make_top(4);
+            cadmium::dynamic::engine::runner<float, cadmium::logger::not_logger> hierarchical(hierarchical_model, 0.0);
+            float hierarchical_next = hierarchical.run_until(10.0);
+
+            coupled_ptr flattened_model = make_top(4);
+            cadmium::dynamic::engine::runner<float, cadmium::logger::not_logger> flattened(flattened_model, 0.0, cadmium::dynamic::engine::flatten_hierarchy);
+            float flattened_next = flattened.run_until(10.0);
+
+            BOOST_CHECK_EQUAL(hierarchical_next, flattened_next);
+            auto hierarchical_states = atomic_states(hierarchical_model);
+            auto flattened_states = atomic_states(flattened_model);
+            BOOST_CHECK_EQUAL_COLLECTIONS(hierarchical_states.begin(), hierarchical_states.end(), flattened_states.begin(), flattened_states.end());
+            BOOST_CHECK_EQUAL(hierarchical_states.back(), "sink: received 247 pending 2 2 4 2 4 4 4 2 6 4 4 4 4 4 4 2");
+        }
+
+        BOOST_AUTO_TEST_CASE(runner_restored_from_a_checkpoint_reaches_the_same_states_test) {
+            std::string path = (std::filesystem::temp_directory_path() / "cadmium-runner-checkpoint-test").string();
+
+            coupled_ptr straight_model = make_top(4);
+            cadmium::dynamic::engine::runner<float, cadmium::logger::not_logger> straight(straight_model, 0.0);
+            float straight_next = straight.run_until(10.0);
+
+            {
+                coupled_ptr checkpointed_model = make_top(4);
+                cadmium::dynamic::engine::runner<float, cadmium::logger::not_logger> checkpointed(checkpointed_model, 0.0);
+                checkpointed.checkpoint_every(path, 3);
+                checkpointed.run_until(4.2);
+                checkpointed.checkpoint();
+            }
+            // a frame interrupted while being written is ignored
+            std::ofstream(path, std::ios::binary | std::ios::app) << std::string(12, '\x7f');
+
+            coupled_ptr restored_model = make_top(4);
+            cadmium::dynamic::engine::runner<float, cadmium::logger::not_logger> restored(restored_model, 0.0);
+            BOOST_CHECK_EQUAL(4.5, restored.restore_checkpoint(path));
+            float restored_next = restored.run_until(10.0);
+            std::filesystem::remove(path);
+
+            BOOST_CHECK_EQUAL(straight_next, restored_next);
+            auto straight_states = atomic_states(straight_model);
+            auto restored_states = atomic_states(restored_model);
+            BOOST_CHECK_EQUAL_COLLECTIONS(straight_states.begin(), straight_states.end(), restored_states.begin(), restored_states.end());
+        }
+
+        #ifdef CADMIUM_EXECUTE_TEAM
+        BOOST_AUTO_TEST_CASE(rebalanced_team_runner_reaches_the_same_states_than_the_fixed_one_test) {
+            coupled_ptr fixed_model = make_top(4);
+            cadmium::dynamic::engine::runner<float, cadmium::logger::not_logger> fixed(fixed_model, 0.0, cadmium::dynamic::engine::flatten_hierarchy, 3);
+            fixed.set_rebalance_interval(0);
+            float fixed_next = fixed.run_until(10.0);
+
+            coupled_ptr rebalanced_model = make_top(4);
+            cadmium::dynamic::engine::runner<float, cadmium::logger::not_logger> rebalanced(rebalanced_model, 0.0, cadmium::dynamic::engine::flatten_hierarchy, 3);
+            rebalanced.set_rebalance_interval(2);
+            float rebalanced_next = rebalanced.run_until(10.0);
+
+            BOOST_CHECK_EQUAL(fixed_next, rebalanced_next);
+            auto fixed_states = atomic_states(fixed_model);
+            auto rebalanced_states = atomic_states(rebalanced_model);
+            BOOST_CHECK_EQUAL_COLLECTIONS(fixed_states.begin(), fixed_states.end(), rebalanced_states.begin(), rebalanced_states.end());
+            BOOST_CHECK_EQUAL(3, rebalanced.busy_times().size());
+            BOOST_CHECK(fixed.busy_times() == std::vector<double>(3, 0.0));
+            double busy = 0;
+            for (double b : rebalanced.busy_times()) {
+                busy += b;
+            }
+            BOOST_CHECK(busy > 0);
+        }
+        #endif //CADMIUM_EXECUTE_TEAM
+
+    BOOST_AUTO_TEST_SUITE_END()
+
+    BOOST_AUTO_TEST_SUITE(disabled_logging_dynamic_runner_test_suite)
+
+        namespace {
+            std::ostringstream routing_oss;
+
+            struct routing_oss_test_sink_provider {
+                static std::ostream &sink() {
+                    return routing_oss;
+                }
+            };
+
+            // messages counting how many times they were formatted
+            int formatted_messages = 0;
+
+            struct counted_message {
+            };
+
+            std::ostream& operator<<(std::ostream& os, const counted_message& m) {
+                formatted_messages++;
+                return os << "counted";
+            }
+
+            using counted_out_port = cadmium::basic_models::pdevs::generator_defs<counted_message>::out;
+            using counted_in_port = cadmium::basic_models::pdevs::passive_defs<counted_message>::in;
+
+            template<typename TIME>
+            struct counted_generator : public cadmium::basic_models::pdevs::generator<counted_message, TIME> {
+                float period() const override {
+                    return 1.0f;
+                }
+
+                counted_message output_message() const override {
+                    return counted_message();
+                }
+            };
+
+            template<typename TIME>
+            using counted_passive = cadmium::basic_models::pdevs::passive<counted_message, TIME>;
+
+            struct counted_coupled_out_port : public cadmium::out_port<counted_message> {
+            };
+
+            template<typename TIME>
+            using counted_generator_to_passive = cadmium::modeling::pdevs::coupled_model<
+                    TIME,
+                    std::tuple<>,
+                    std::tuple<counted_coupled_out_port>,
+                    cadmium::modeling::models_tuple<counted_generator, counted_passive>,
+                    std::tuple<>,
+                    std::tuple<cadmium::modeling::EOC<counted_generator, counted_out_port, counted_coupled_out_port>>,
+                    std::tuple<cadmium::modeling::IC<counted_generator, counted_out_port, counted_passive, counted_in_port>>
+            >;
+        }
+
+        BOOST_AUTO_TEST_CASE(dynamic_runner_does_not_format_messages_when_logging_is_disabled_test) {
+            formatted_messages = 0;
+            auto model = cadmium::dynamic::translate::make_dynamic_coupled_model<float, counted_generator_to_passive>();
+            cadmium::dynamic::engine::runner<float, cadmium::logger::not_logger> r(model, 0.0);
+            r.run_until(10.0);
+            BOOST_CHECK_EQUAL(formatted_messages, 0);
+        }
+
+        BOOST_AUTO_TEST_CASE(dynamic_runner_formats_messages_when_logging_routing_test) {
+            using log_routing_to_oss = cadmium::logger::logger<cadmium::logger::logger_message_routing, cadmium::dynamic::logger::formatter<float>, routing_oss_test_sink_provider>;
+            formatted_messages = 0;
+            routing_oss.str("");
+            auto model = cadmium::dynamic::translate::make_dynamic_coupled_model<float, counted_generator_to_passive>();
+            cadmium::dynamic::engine::runner<float, log_routing_to_oss> r(model, 0.0);
+            r.run_until(10.0);
+            BOOST_CHECK_GT(formatted_messages, 0);
+        }
+
+    BOOST_AUTO_TEST_SUITE_END()
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,150 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cadmium/engine/pdevs_dynamic_socket_runner.hpp>
+
+#include "dynamic_runner_fixtures.hpp"
+
+BOOST_AUTO_TEST_SUITE(pdevs_dynamic_socket_runner_test_suite)
+
+    using namespace dynamic_runner_fixtures;
+
+    using node_type = cadmium::dynamic::engine::socket_node<float, cadmium::logger::not_logger>;
+    using coordinator_type = cadmium::dynamic::engine::socket_coordinator<float>;
+
+    //forks a process for each node, building its own model and serving until the coordinator exits
+    std::vector<pid_t> fork_nodes(const std::vector<std::size_t>& part_of_child, std::size_t nodes, const cadmium::concurrency::socket_address& coordinator) {
+        std::vector<pid_t> pids;
+        for (std::size_t n = 0; n < nodes; n++) {
+            pid_t pid = ::fork();
+            BOOST_REQUIRE(pid >= 0);
+            if (pid == 0) {
+                try {
+                    node_type node(make_coupled_groups(), 0, part_of_child, n, coordinator);
+                    node.serve();
+                    ::_exit(0);
+                } catch (...) {
+                    ::_exit(1);
+                }
+            }
+            pids.push_back(pid);
+        }
+        return pids;
+    }
+
+    std::vector<int> wait_nodes(const std::vector<pid_t>& pids) {
+        std::vector<int> results;
+        for (pid_t pid : pids) {
+            int status = -1;
+            ::waitpid(pid, &status, 0);
+            results.push_back(WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+        }
+        return results;
+    }
+
+    void check_nodes_simulate_the_same_as_the_sequential_runner(const cadmium::concurrency::socket_address& address) {
+        sequential_result expected = run_sequentially(make_coupled_groups(), 10.1f);
+
+        // each group and its slow generator and accumulator in a node
+        std::vector<std::size_t> part_of_child = {0, 0, 0, 1, 1, 1};
+        std::vector<pid_t> pids;
+        {
+            coordinator_type coordinator(address, 2);
+            pids = fork_nodes(part_of_child, 2, coordinator.address());
+            BOOST_CHECK_EQUAL(5.25f, coordinator.run_until(5.1f));
+            BOOST_CHECK_EQUAL(expected.next, coordinator.run_until(10.1f));
+            BOOST_CHECK_EQUAL(40, coordinator.steps());
+            std::vector<std::string> states = coordinator.model_states();
+            BOOST_CHECK_EQUAL_COLLECTIONS(expected.states.begin(), expected.states.end(), states.begin(), states.end());
+        }
+        std::vector<int> results = wait_nodes(pids);
+        BOOST_CHECK((std::vector<int>{0, 0}) == results);
+    }
+
+    BOOST_AUTO_TEST_CASE(connections_exchange_whole_frames_test) {
+        cadmium::concurrency::socket_listener listener(cadmium::concurrency::socket_address::tcp("127.0.0.1", 0));
+        BOOST_CHECK_NE(0, listener.address().port());
+        auto client = cadmium::concurrency::socket_connection::connect(listener.address());
+        auto server = listener.accept();
+        std::string big(1 << 20, 'c');
+        client.send_frame("cadmium");
+        client.send_frame("");
+        client.send_frame(big);
+        std::string frame;
+        server.receive_frame(frame);
+        BOOST_CHECK_EQUAL("cadmium", frame);
+        server.receive_frame(frame);
+        BOOST_CHECK(frame.empty());
+        server.receive_frame(frame);
+        BOOST_CHECK(big == frame);
+        client.close();
+        BOOST_CHECK_THROW(server.receive_frame(frame), std::runtime_error);
+    }
+
+    BOOST_AUTO_TEST_CASE(connections_refuse_frames_above_their_limit_test) {
+        cadmium::concurrency::socket_listener listener(cadmium::concurrency::socket_address::tcp("127.0.0.1", 0));
+        auto client = cadmium::concurrency::socket_connection::connect(listener.address());
+        auto server = listener.accept();
+        BOOST_CHECK_EQUAL(CADMIUM_SOCKET_MAX_FRAME_BYTES, server.max_frame_bytes());
+        server.set_max_frame_bytes(16);
+        client.send_frame(std::string(16, 'c'));
+        client.send_frame(std::string(17, 'c'));
+        std::string frame;
+        server.receive_frame(frame);
+        BOOST_CHECK_EQUAL(16, frame.size());
+        BOOST_CHECK_THROW(server.receive_frame(frame), std::runtime_error);
+    }
+
+    BOOST_AUTO_TEST_CASE(tcp_nodes_simulate_the_same_as_the_sequential_runner_test) {
+        check_nodes_simulate_the_same_as_the_sequential_runner(cadmium::concurrency::socket_address::tcp("127.0.0.1", 0));
+    }
+
+    BOOST_AUTO_TEST_CASE(unix_domain_nodes_simulate_the_same_as_the_sequential_runner_test) {
+        std::string path = "/tmp/cadmium-socket-runner-test-" + std::to_string(::getpid());
+        check_nodes_simulate_the_same_as_the_sequential_runner(cadmium::concurrency::socket_address::unix_domain(path));
+        BOOST_CHECK_NE(0, ::access(path.c_str(), F_OK));
+    }
+
+    BOOST_AUTO_TEST_CASE(nodes_must_match_the_partition_of_the_coordinator_test) {
+        std::vector<pid_t> pids;
+        {
+            coordinator_type coordinator(cadmium::concurrency::socket_address::tcp("127.0.0.1", 0), 2);
+            // three parts, so the nodes do not match the two nodes expected by the coordinator
+            pids = fork_nodes({0, 0, 1, 1, 2, 2}, 2, coordinator.address());
+            BOOST_CHECK_THROW(coordinator.run_until(1.0f), std::domain_error);
+        }
+        std::vector<int> results = wait_nodes(pids);
+        BOOST_CHECK((std::vector<int>{1, 1}) == results);
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
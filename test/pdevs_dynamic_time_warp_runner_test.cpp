@@ -0,0 +1,161 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <cadmium/engine/pdevs_dynamic_time_warp_runner.hpp>
+
+#include "dynamic_runner_fixtures.hpp"
+
+BOOST_AUTO_TEST_SUITE(pdevs_dynamic_time_warp_runner_test_suite)
+
+    using namespace dynamic_runner_fixtures;
+
+    using process_type = cadmium::dynamic::engine::time_warp_process<float, cadmium::logger::not_logger>;
+
+    //groups of a slow generator, a fast generator and an accumulator, where each generator
+    //also sends to the accumulator of the next group
+    std::shared_ptr<cadmium::dynamic::modeling::coupled<float>> make_groups(int groups, std::vector<accumulator_ptr>& accumulators) {
+        return dynamic_runner_fixtures::make_groups(groups, {{"fast", 0}, {"slow", 1}, {"fast", 1}}, accumulators);
+    }
+
+    BOOST_AUTO_TEST_CASE(atomic_models_restore_their_saved_state_test) {
+        auto acc = std::dynamic_pointer_cast<cadmium::dynamic::modeling::atomic<int_accumulator, float>>(
+                cadmium::dynamic::translate::make_dynamic_atomic_model<int_accumulator, float>("acc"));
+        std::get<0>(acc->state) = 3;
+        boost::any saved = acc->save_state();
+        std::get<0>(acc->state) = 5;
+        acc->restore_state(saved);
+        BOOST_CHECK_EQUAL(3, std::get<0>(acc->state));
+    }
+
+    BOOST_AUTO_TEST_CASE(time_warp_simulates_the_same_as_the_sequential_runner_test) {
+        std::vector<accumulator_ptr> expected_accumulators;
+        float expected_next = run_sequentially(make_groups(4, expected_accumulators), 20.1f).next;
+        std::vector<int> expected = totals(expected_accumulators);
+
+        std::vector<accumulator_ptr> accumulators;
+        cadmium::dynamic::engine::time_warp_runner<float, cadmium::logger::not_logger> r(make_groups(4, accumulators), 0, 4, 4);
+        BOOST_CHECK_EQUAL(4, r.processes());
+        BOOST_CHECK_EQUAL(expected_next, r.run_until(20.1f));
+
+        std::vector<int> result = totals(accumulators);
+        BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), result.begin(), result.end());
+        BOOST_CHECK_EQUAL(expected_next, r.gvt());
+        // every step before the GVT was released
+        BOOST_CHECK_EQUAL(0, r.uncommitted_steps());
+    }
+
+    BOOST_AUTO_TEST_CASE(stragglers_and_anti_messages_roll_processes_back_test) {
+        using cadmium::dynamic::translate::make_link;
+        auto fast = cadmium::dynamic::translate::make_dynamic_atomic_model<fast_generator, float>("fast");
+        auto slow = cadmium::dynamic::translate::make_dynamic_atomic_model<slow_generator, float>("slow");
+        auto acc_fast = std::dynamic_pointer_cast<cadmium::dynamic::modeling::atomic<int_accumulator, float>>(
+                cadmium::dynamic::translate::make_dynamic_atomic_model<int_accumulator, float>("acc_fast"));
+        auto acc_slow = std::dynamic_pointer_cast<cadmium::dynamic::modeling::atomic<int_accumulator, float>>(
+                cadmium::dynamic::translate::make_dynamic_atomic_model<int_accumulator, float>("acc_slow"));
+
+        // the fast generator and its accumulator in a process, the slow ones in another
+        // process, and the fast generator also sends to the slow accumulator
+        process_type p0(0);
+        process_type p1(1);
+        p0.connect({&p0, &p1});
+        p1.connect({&p0, &p1});
+        auto fast_to_acc = make_link<generator_out, accumulator_add>();
+        auto slow_to_acc = make_link<generator_out, accumulator_add>();
+        auto fast_to_remote_acc = make_link<generator_out, accumulator_add>();
+        p0.add_model(fast);
+        p0.add_model(acc_fast);
+        p1.add_model(slow);
+        p1.add_model(acc_slow);
+        p0.add_route(0, 0, 1, fast_to_acc);
+        p1.add_route(1, 0, 1, slow_to_acc);
+        p0.add_outgoing_route(2, 0, 1, fast_to_remote_acc);
+        p1.add_incoming_route(2, 1, fast_to_remote_acc);
+        p0.init(0);
+        p1.init(0);
+
+        // the slow process runs ahead, then receives the messages of the fast generator since 0.25
+        p1.run(4.5f, 100);
+        BOOST_CHECK_EQUAL(4, std::get<0>(acc_slow->state));
+        p0.run(4.5f, 100);
+        p1.run(4.5f, 100);
+        BOOST_CHECK_EQUAL(1, p1.rollbacks());
+        BOOST_CHECK_EQUAL(4, p1.rolled_back_steps());
+
+        BOOST_CHECK_EQUAL(34, std::get<0>(acc_fast->state));
+        BOOST_CHECK_EQUAL(38, std::get<0>(acc_slow->state));
+        BOOST_CHECK_EQUAL(4.5f, std::min(p0.next(), p1.next()));
+
+        // releasing the steps before the GVT
+        p0.fossil_collect(4.5f);
+        p1.fossil_collect(4.5f);
+        BOOST_CHECK_EQUAL(0, p0.uncommitted_steps());
+        BOOST_CHECK_EQUAL(0, p1.uncommitted_steps());
+    }
+
+    BOOST_AUTO_TEST_CASE(anti_messages_cancel_processed_messages_test) {
+        using cadmium::dynamic::translate::make_link;
+        auto fast = cadmium::dynamic::translate::make_dynamic_atomic_model<fast_generator, float>("fast");
+        auto slow = cadmium::dynamic::translate::make_dynamic_atomic_model<slow_generator, float>("slow");
+        auto acc_fast = std::dynamic_pointer_cast<cadmium::dynamic::modeling::atomic<int_accumulator, float>>(
+                cadmium::dynamic::translate::make_dynamic_atomic_model<int_accumulator, float>("acc_fast"));
+        auto acc_slow = std::dynamic_pointer_cast<cadmium::dynamic::modeling::atomic<int_accumulator, float>>(
+                cadmium::dynamic::translate::make_dynamic_atomic_model<int_accumulator, float>("acc_slow"));
+
+        // the slow generator sends to the accumulator of the fast process, and the fast generator
+        // to the accumulator of the slow process
+        process_type p0(0);
+        process_type p1(1);
+        p0.connect({&p0, &p1});
+        p1.connect({&p0, &p1});
+        auto fast_to_remote_acc = make_link<generator_out, accumulator_add>();
+        auto slow_to_remote_acc = make_link<generator_out, accumulator_add>();
+        p0.add_model(fast);
+        p0.add_model(acc_fast);
+        p1.add_model(slow);
+        p1.add_model(acc_slow);
+        p0.add_outgoing_route(0, 0, 1, fast_to_remote_acc);
+        p1.add_incoming_route(0, 1, fast_to_remote_acc);
+        p1.add_outgoing_route(1, 0, 0, slow_to_remote_acc);
+        p0.add_incoming_route(1, 1, slow_to_remote_acc);
+        p0.init(0);
+        p1.init(0);
+
+        // the slow process sends its messages until 4 and the fast process simulates them
+        p1.run(4.5f, 100);
+        p0.run(4.5f, 100);
+        BOOST_CHECK_EQUAL(4, std::get<0>(acc_fast->state));
+        // the slow process rolls back and cancels its messages, then sends them again
+        p1.run(4.5f, 100);
+        p0.run(4.5f, 100);
+        BOOST_CHECK_EQUAL(1, p0.rollbacks());
+        BOOST_CHECK_EQUAL(4, std::get<0>(acc_fast->state));
+        BOOST_CHECK_EQUAL(34, std::get<0>(acc_slow->state));
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,362 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+#include <cadmium/modeling/ports.hpp>
+#include <cadmium/modeling/message_bag.hpp>
+#include <cadmium/modeling/combiners.hpp>
+#include <cadmium/modeling/coupling.hpp>
+#include <cadmium/engine/pdevs_runner.hpp>
+#include <cadmium/modeling/dynamic_coupled.hpp>
+#include <cadmium/modeling/dynamic_atomic.hpp>
+#include <cadmium/modeling/dynamic_model_translator.hpp>
+#include <cadmium/engine/pdevs_dynamic_runner.hpp>
+#include <cadmium/logger/common_loggers.hpp>
+
+BOOST_AUTO_TEST_SUITE(pdevs_message_combiners_test_suite)
+
+    namespace {
+        struct value_out : public cadmium::out_port<int> {};
+        struct sum_in : public cadmium::in_port<int> {
+            using combiner = cadmium::sum_combiner;
+        };
+        struct max_in : public cadmium::in_port<int> {
+            using combiner = cadmium::max_combiner;
+        };
+        struct min_in : public cadmium::in_port<int> {
+            using combiner = cadmium::min_combiner;
+        };
+        struct latest_in : public cadmium::in_port<int> {
+            using combiner = cadmium::latest_combiner;
+        };
+
+        // sends N at times 1 and 2
+        template<typename TIME, int N>
+        struct emitter {
+            using input_ports = std::tuple<>;
+            using output_ports = std::tuple<value_out>;
+            using output_bags = typename cadmium::make_message_bags<output_ports>::type;
+            using state_type = int;
+            state_type state = 0;
+
+            void internal_transition() {
+                state++;
+            }
+
+            void external_transition(TIME, typename cadmium::make_message_bags<input_ports>::type) {}
+
+            void confluence_transition(TIME, typename cadmium::make_message_bags<input_ports>::type) {
+                internal_transition();
+            }
+
+            output_bags output() const {
+                output_bags bags;
+                cadmium::get_messages<value_out>(bags).push_back(N);
+                return bags;
+            }
+
+            TIME time_advance() const {
+                return state < 2 ? TIME(1) : std::numeric_limits<TIME>::infinity();
+            }
+        };
+
+        template<typename TIME>
+        using emitter_1 = emitter<TIME, 1>;
+        template<typename TIME>
+        using emitter_2 = emitter<TIME, 2>;
+        template<typename TIME>
+        using emitter_3 = emitter<TIME, 3>;
+        template<typename TIME>
+        using emitter_4 = emitter<TIME, 4>;
+
+        // the messages received by the aggregators, one vector per transition and port
+        std::vector<std::vector<int>> sums_received;
+        std::vector<std::vector<int>> maxs_received;
+        std::mutex received_mutex;
+
+        template<typename TIME>
+        struct aggregator {
+            using input_ports = std::tuple<sum_in, max_in>;
+            using output_ports = std::tuple<>;
+            using input_bags = typename cadmium::make_message_bags<input_ports>::type;
+            using state_type = int;
+            state_type state = 0;
+
+            void internal_transition() {}
+
+            void external_transition(TIME, const input_bags& mbs) {
+                std::lock_guard<std::mutex> lock(received_mutex);
+                const auto& sums = cadmium::get_messages<sum_in>(mbs);
+                const auto& maxs = cadmium::get_messages<max_in>(mbs);
+                sums_received.emplace_back(sums.begin(), sums.end());
+                maxs_received.emplace_back(maxs.begin(), maxs.end());
+                for (int x : sums) {
+                    state += x;
+                }
+            }
+
+            void confluence_transition(TIME e, const input_bags& mbs) {
+                external_transition(e, mbs);
+            }
+
+            typename cadmium::make_message_bags<output_ports>::type output() const {
+                return {};
+            }
+
+            TIME time_advance() const {
+                return std::numeric_limits<TIME>::infinity();
+            }
+        };
+
+        // all the emitters to the sum port of the aggregator, emitters 2 and 4 to its max port
+        template<typename TIME>
+        using top = cadmium::modeling::pdevs::coupled_model<TIME, std::tuple<>, std::tuple<>,
+                cadmium::modeling::models_tuple<emitter_1, emitter_2, emitter_3, emitter_4, aggregator>, std::tuple<>, std::tuple<>,
+                std::tuple<cadmium::modeling::IC<emitter_1, value_out, aggregator, sum_in>,
+                        cadmium::modeling::IC<emitter_2, value_out, aggregator, sum_in>,
+                        cadmium::modeling::IC<emitter_3, value_out, aggregator, sum_in>,
+                        cadmium::modeling::IC<emitter_4, value_out, aggregator, sum_in>,
+                        cadmium::modeling::IC<emitter_2, value_out, aggregator, max_in>,
+                        cadmium::modeling::IC<emitter_4, value_out, aggregator, max_in>>>;
+
+        struct values_in : public cadmium::in_port<int> {};
+        struct total_in : public cadmium::in_port<int> {
+            using combiner = cadmium::sum_combiner;
+        };
+
+        // the aggregator inside a coupled model, receiving through the port values or total
+        template<typename PORT>
+        std::shared_ptr<cadmium::dynamic::modeling::coupled<float>> make_top() {
+            using namespace cadmium::dynamic::translate;
+            auto sink = std::make_shared<cadmium::dynamic::modeling::coupled<float>>(
+                    "sink",
+                    cadmium::dynamic::modeling::Models{make_dynamic_atomic_model<aggregator, float>("aggregator")},
+                    cadmium::dynamic::modeling::Ports{typeid(PORT)}, cadmium::dynamic::modeling::Ports{},
+                    cadmium::dynamic::modeling::EICs{cadmium::dynamic::modeling::EIC("aggregator", make_link<PORT, sum_in>())},
+                    cadmium::dynamic::modeling::EOCs{}, cadmium::dynamic::modeling::ICs{}
+            );
+            return std::make_shared<cadmium::dynamic::modeling::coupled<float>>(
+                    "top",
+                    cadmium::dynamic::modeling::Models{
+                            make_dynamic_atomic_model<emitter_1, float>("emitter_1"), make_dynamic_atomic_model<emitter_2, float>("emitter_2"),
+                            make_dynamic_atomic_model<emitter_3, float>("emitter_3"), make_dynamic_atomic_model<emitter_4, float>("emitter_4"),
+                            sink},
+                    cadmium::dynamic::modeling::Ports{}, cadmium::dynamic::modeling::Ports{},
+                    cadmium::dynamic::modeling::EICs{}, cadmium::dynamic::modeling::EOCs{},
+                    cadmium::dynamic::modeling::ICs{
+                            cadmium::dynamic::modeling::IC("emitter_1", "sink", make_link<value_out, PORT>()),
+                            cadmium::dynamic::modeling::IC("emitter_2", "sink", make_link<value_out, PORT>()),
+                            cadmium::dynamic::modeling::IC("emitter_3", "sink", make_link<value_out, PORT>()),
+                            cadmium::dynamic::modeling::IC("emitter_4", "sink", make_link<value_out, PORT>())}
+            );
+        }
+
+        // the messages received by the latest port, one vector per transition
+        std::vector<std::vector<int>> latest_received;
+
+        template<typename TIME>
+        struct latest_receiver {
+            using input_ports = std::tuple<latest_in>;
+            using output_ports = std::tuple<>;
+            using input_bags = typename cadmium::make_message_bags<input_ports>::type;
+            using state_type = int;
+            state_type state = 0;
+
+            void internal_transition() {}
+
+            void external_transition(TIME, const input_bags& mbs) {
+                std::lock_guard<std::mutex> lock(received_mutex);
+                const auto& latest = cadmium::get_messages<latest_in>(mbs);
+                latest_received.emplace_back(latest.begin(), latest.end());
+            }
+
+            void confluence_transition(TIME e, const input_bags& mbs) {
+                external_transition(e, mbs);
+            }
+
+            typename cadmium::make_message_bags<output_ports>::type output() const {
+                return {};
+            }
+
+            TIME time_advance() const {
+                return std::numeric_limits<TIME>::infinity();
+            }
+        };
+
+        // the couplings to the latest port are declared in a different order than the emitters
+        template<typename TIME>
+        using latest_top = cadmium::modeling::pdevs::coupled_model<TIME, std::tuple<>, std::tuple<>,
+                cadmium::modeling::models_tuple<emitter_1, emitter_2, emitter_3, emitter_4, latest_receiver>, std::tuple<>, std::tuple<>,
+                std::tuple<cadmium::modeling::IC<emitter_3, value_out, latest_receiver, latest_in>,
+                        cadmium::modeling::IC<emitter_1, value_out, latest_receiver, latest_in>,
+                        cadmium::modeling::IC<emitter_4, value_out, latest_receiver, latest_in>,
+                        cadmium::modeling::IC<emitter_2, value_out, latest_receiver, latest_in>>>;
+
+        std::shared_ptr<cadmium::dynamic::modeling::coupled<float>> make_latest_top() {
+            using namespace cadmium::dynamic::translate;
+            return std::make_shared<cadmium::dynamic::modeling::coupled<float>>(
+                    "top",
+                    cadmium::dynamic::modeling::Models{
+                            make_dynamic_atomic_model<emitter_1, float>("emitter_1"), make_dynamic_atomic_model<emitter_2, float>("emitter_2"),
+                            make_dynamic_atomic_model<emitter_3, float>("emitter_3"), make_dynamic_atomic_model<emitter_4, float>("emitter_4"),
+                            make_dynamic_atomic_model<latest_receiver, float>("latest_receiver")},
+                    cadmium::dynamic::modeling::Ports{}, cadmium::dynamic::modeling::Ports{},
+                    cadmium::dynamic::modeling::EICs{}, cadmium::dynamic::modeling::EOCs{},
+                    cadmium::dynamic::modeling::ICs{
+                            cadmium::dynamic::modeling::IC("emitter_3", "latest_receiver", make_link<value_out, latest_in>()),
+                            cadmium::dynamic::modeling::IC("emitter_1", "latest_receiver", make_link<value_out, latest_in>()),
+                            cadmium::dynamic::modeling::IC("emitter_4", "latest_receiver", make_link<value_out, latest_in>()),
+                            cadmium::dynamic::modeling::IC("emitter_2", "latest_receiver", make_link<value_out, latest_in>())}
+            );
+        }
+
+        void clear_received() {
+            sums_received.clear();
+            maxs_received.clear();
+            latest_received.clear();
+        }
+
+        // the latest port transitions at times 1 and 2, keeping the message of the coupling routed last
+        void check_latest_received(int expected) {
+            BOOST_CHECK_EQUAL(latest_received.size(), 2);
+            for (const auto& latest : latest_received) {
+                BOOST_CHECK((latest == std::vector<int>{expected}));
+            }
+        }
+
+        // the aggregator transitions at times 1 and 2, receiving the sum of the 4 emitters
+        void check_sums_received() {
+            BOOST_CHECK_EQUAL(sums_received.size(), 2);
+            for (const auto& sums : sums_received) {
+                BOOST_CHECK((sums == std::vector<int>{10}));
+            }
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(combiners_fold_the_appended_messages_test) {
+        std::vector<int> values = {3, 7, 5};
+
+        cadmium::bag<int> sum;
+        cadmium::append_messages<sum_in>(sum, values.begin(), values.end());
+        BOOST_CHECK((sum == cadmium::bag<int>{15}));
+        cadmium::append_messages<sum_in>(sum, values.begin(), values.begin() + 1);
+        BOOST_CHECK((sum == cadmium::bag<int>{18}));
+
+        cadmium::bag<int> max;
+        cadmium::append_messages<max_in>(max, values.begin(), values.end());
+        BOOST_CHECK((max == cadmium::bag<int>{7}));
+
+        cadmium::bag<int> min;
+        cadmium::append_messages<min_in>(min, values.begin(), values.end());
+        BOOST_CHECK((min == cadmium::bag<int>{3}));
+        cadmium::bag<int> latest;
+        cadmium::append_messages<latest_in>(latest, values.begin(), values.end());
+        BOOST_CHECK((latest == cadmium::bag<int>{5}));
+
+        // ports without combiner keep all the messages
+        cadmium::bag<int> all;
+        cadmium::append_messages<values_in>(all, values.begin(), values.end());
+        BOOST_CHECK((all == values));
+
+        // nothing is added without messages
+        cadmium::bag<int> none;
+        cadmium::append_messages<sum_in>(none, values.begin(), values.begin());
+        BOOST_CHECK(none.empty());
+    }
+
+    BOOST_AUTO_TEST_CASE(links_combine_the_messages_of_their_to_port_test) {
+        auto to_sum = cadmium::dynamic::translate::make_link<value_out, sum_in>();
+        cadmium::dynamic::message_bags bags_from;
+        bags_from[typeid(value_out)] = cadmium::message_bag<value_out>{1, 2, 3};
+
+        cadmium::dynamic::message_bags bags_to;
+        to_sum->route_messages(bags_from, bags_to);
+        to_sum->route_messages(bags_from, bags_to);
+        BOOST_CHECK((boost::any_cast<cadmium::message_bag<sum_in>&>(bags_to.at(typeid(sum_in))).messages == cadmium::bag<int>{12}));
+
+        cadmium::message_bag<sum_in> slot;
+        to_sum->route(cadmium::dynamic::port_endpoint{nullptr, &bags_from}, cadmium::dynamic::port_endpoint{&slot.messages, nullptr});
+        BOOST_CHECK((slot.messages == cadmium::bag<int>{6}));
+    }
+
+    BOOST_AUTO_TEST_CASE(static_engine_combines_the_routed_messages_test) {
+        clear_received();
+        cadmium::engine::runner<float, top, cadmium::logger::not_logger> r{0.0};
+        r.run_until_passivate();
+        check_sums_received();
+        BOOST_CHECK_EQUAL(maxs_received.size(), 2);
+        for (const auto& maxs : maxs_received) {
+            BOOST_CHECK((maxs == std::vector<int>{4}));
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(dynamic_engine_combines_the_routed_messages_test) {
+        clear_received();
+        cadmium::dynamic::engine::runner<float, cadmium::logger::not_logger> r(make_top<values_in>(), 0.0);
+        r.run_until_passivate();
+        check_sums_received();
+
+        clear_received();
+        cadmium::dynamic::engine::runner<float, cadmium::logger::not_logger> f(make_top<values_in>(), 0.0, cadmium::dynamic::engine::flatten_hierarchy);
+        f.run_until_passivate();
+        check_sums_received();
+    }
+
+    BOOST_AUTO_TEST_CASE(coupled_ports_combine_the_routed_messages_test) {
+        clear_received();
+        cadmium::dynamic::engine::runner<float, cadmium::logger::not_logger> r(make_top<total_in>(), 0.0);
+        r.run_until_passivate();
+        check_sums_received();
+
+        // a flattened link would skip the combiner of the coupled port
+        BOOST_CHECK_THROW((cadmium::dynamic::engine::runner<float, cadmium::logger::not_logger>(make_top<total_in>(), 0.0, cadmium::dynamic::engine::flatten_hierarchy)), std::domain_error);
+    }
+
+    BOOST_AUTO_TEST_CASE(latest_combiner_keeps_the_coupling_routed_last_test) {
+        // the static engine routes the couplings from the last declared to the first
+        clear_received();
+        cadmium::engine::runner<float, latest_top, cadmium::logger::not_logger> s{0.0};
+        s.run_until_passivate();
+        check_latest_received(3);
+
+        clear_received();
+        cadmium::dynamic::engine::runner<float, cadmium::logger::not_logger> r(make_latest_top(), 0.0);
+        r.run_until_passivate();
+        check_latest_received(2);
+
+        clear_received();
+        cadmium::dynamic::engine::runner<float, cadmium::logger::not_logger> f(make_latest_top(), 0.0, cadmium::dynamic::engine::flatten_hierarchy);
+        f.run_until_passivate();
+        check_latest_received(2);
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -363,5 +363,61 @@ BOOST_AUTO_TEST_SUITE(pdevs_runner_test_suite)
 
     BOOST_AUTO_TEST_SUITE_END()
 
+    BOOST_AUTO_TEST_SUITE(disabled_logging_runner_test_suite)
+
+        namespace {
+            // messages counting how many times they were formatted
+            int formatted_messages = 0;
+
+            struct counted_message {
+            };
+
+            std::ostream& operator<<(std::ostream& os, const counted_message& m) {
+                formatted_messages++;
+                return os << "counted";
+            }
+
+            using counted_out_port = cadmium::basic_models::pdevs::generator_defs<counted_message>::out;
+
+            template<typename TIME>
+            struct counted_generator : public cadmium::basic_models::pdevs::generator<counted_message, TIME> {
+                float period() const override {
+                    return 1.0f;
+                }
+
+                counted_message output_message() const override {
+                    return counted_message();
+                }
+            };
+
+            struct counted_coupled_out_port : public cadmium::out_port<counted_message> {
+            };
+
+            template<typename TIME>
+            using counted_coupled_generator = cadmium::modeling::pdevs::coupled_model<
+                    TIME,
+                    std::tuple<>,
+                    std::tuple<counted_coupled_out_port>,
+                    cadmium::modeling::models_tuple<counted_generator>,
+                    std::tuple<>,
+                    std::tuple<cadmium::modeling::EOC<counted_generator, counted_out_port, counted_coupled_out_port>>,
+                    std::tuple<>
+            >;
+        }
+
+        BOOST_AUTO_TEST_CASE(runner_does_not_format_messages_when_logging_is_disabled_test) {
+            formatted_messages = 0;
+            cadmium::engine::runner<float, counted_coupled_generator, cadmium::logger::not_logger> r{0.0};
+            r.run_until(10.0);
+            BOOST_CHECK_EQUAL(formatted_messages, 0);
+
+            // the counter sees the messages that are formatted
+            std::ostringstream oss;
+            oss << counted_message();
+            BOOST_CHECK_EQUAL(formatted_messages, 1);
+        }
+
+    BOOST_AUTO_TEST_SUITE_END()
+
 BOOST_AUTO_TEST_SUITE_END()
 
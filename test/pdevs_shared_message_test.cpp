@@ -0,0 +1,276 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <limits>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <vector>
+
+#include <cadmium/modeling/ports.hpp>
+#include <cadmium/modeling/message_bag.hpp>
+#include <cadmium/modeling/shared_message.hpp>
+#include <cadmium/modeling/coupling.hpp>
+#include <cadmium/engine/pdevs_runner.hpp>
+#include <cadmium/modeling/dynamic_coupled.hpp>
+#include <cadmium/modeling/dynamic_atomic.hpp>
+#include <cadmium/modeling/dynamic_model_translator.hpp>
+#include <cadmium/engine/pdevs_dynamic_runner.hpp>
+#include <cadmium/logger/common_loggers.hpp>
+
+BOOST_AUTO_TEST_SUITE(pdevs_shared_message_test_suite)
+
+    namespace {
+        // payload counting its copies
+        struct agents {
+            static inline int copies = 0;
+            std::vector<int> ids;
+
+            agents() = default;
+
+            explicit agents(std::vector<int> ids) : ids(std::move(ids)) {}
+
+            agents(const agents& other) : ids(other.ids) {
+                copies++;
+            }
+
+            agents& operator=(const agents& other) {
+                ids = other.ids;
+                copies++;
+                return *this;
+            }
+
+            bool operator==(const agents& other) const {
+                return ids == other.ids;
+            }
+        };
+
+        std::ostream& operator<<(std::ostream& os, const agents& a) {
+            return os << a.ids.size() << " agents";
+        }
+
+        using agents_message = cadmium::shared_message<agents>;
+
+        struct census_out : public cadmium::out_port<agents_message> {};
+        struct census_in : public cadmium::in_port<agents_message> {};
+
+        // sends 1000 agents three times
+        template<typename TIME>
+        struct census {
+            using input_ports = std::tuple<>;
+            using output_ports = std::tuple<census_out>;
+            using output_bags = typename cadmium::make_message_bags<output_ports>::type;
+            using state_type = int;
+            state_type state = 0;
+
+            void internal_transition() {
+                state++;
+            }
+
+            void external_transition(TIME, typename cadmium::make_message_bags<input_ports>::type) {}
+
+            void confluence_transition(TIME, typename cadmium::make_message_bags<input_ports>::type) {
+                internal_transition();
+            }
+
+            output_bags output() const {
+                output_bags bags;
+                cadmium::get_messages<census_out>(bags).push_back(cadmium::make_shared_message<agents>(std::vector<int>(1000, state)));
+                return bags;
+            }
+
+            TIME time_advance() const {
+                return state < 3 ? TIME(1) : std::numeric_limits<TIME>::infinity();
+            }
+        };
+
+        // all the messages received by the readers, which keep the last one
+        std::vector<agents_message> received;
+        std::mutex received_mutex;
+
+        // payloads of the received messages
+        std::size_t payloads_received() {
+            std::set<const agents*> payloads;
+            for (const auto& m : received) {
+                payloads.insert(&m.get());
+            }
+            return payloads.size();
+        }
+
+        template<typename TIME, int N>
+        struct reader {
+            using input_ports = std::tuple<census_in>;
+            using output_ports = std::tuple<>;
+            using input_bags = typename cadmium::make_message_bags<input_ports>::type;
+            using state_type = agents_message;
+            state_type state;
+
+            void internal_transition() {}
+
+            void external_transition(TIME, const input_bags& mbs) {
+                for (const agents_message& m : cadmium::get_messages<census_in>(mbs)) {
+                    std::lock_guard<std::mutex> lock(received_mutex);
+                    received.push_back(m);
+                    state = m;
+                }
+            }
+
+            void confluence_transition(TIME e, const input_bags& mbs) {
+                external_transition(e, mbs);
+            }
+
+            typename cadmium::make_message_bags<output_ports>::type output() const {
+                return {};
+            }
+
+            TIME time_advance() const {
+                return std::numeric_limits<TIME>::infinity();
+            }
+        };
+
+        template<typename TIME>
+        using reader_0 = reader<TIME, 0>;
+        template<typename TIME>
+        using reader_1 = reader<TIME, 1>;
+        template<typename TIME>
+        using reader_2 = reader<TIME, 2>;
+        template<typename TIME>
+        using reader_3 = reader<TIME, 3>;
+
+        struct readers_in : public cadmium::in_port<agents_message> {};
+
+        template<typename TIME>
+        using readers = cadmium::modeling::pdevs::coupled_model<TIME, std::tuple<readers_in>, std::tuple<>,
+                cadmium::modeling::models_tuple<reader_0, reader_1, reader_2, reader_3>,
+                std::tuple<cadmium::modeling::EIC<readers_in, reader_0, census_in>, cadmium::modeling::EIC<readers_in, reader_1, census_in>,
+                        cadmium::modeling::EIC<readers_in, reader_2, census_in>, cadmium::modeling::EIC<readers_in, reader_3, census_in>>,
+                std::tuple<>, std::tuple<>>;
+
+        template<typename TIME>
+        using top = cadmium::modeling::pdevs::coupled_model<TIME, std::tuple<>, std::tuple<>,
+                cadmium::modeling::models_tuple<census, readers>, std::tuple<>, std::tuple<>,
+                std::tuple<cadmium::modeling::IC<census, census_out, readers, readers_in>>>;
+
+        std::shared_ptr<cadmium::dynamic::modeling::coupled<float>> make_top() {
+            using namespace cadmium::dynamic::translate;
+            cadmium::dynamic::modeling::Models models;
+            cadmium::dynamic::modeling::EICs eics;
+            for (int i = 0; i < 8; i++) {
+                std::string id = "reader_" + std::to_string(i);
+                models.push_back(make_dynamic_atomic_model<reader_0, float>(id));
+                eics.emplace_back(id, make_link<readers_in, census_in>());
+            }
+            auto inner = std::make_shared<cadmium::dynamic::modeling::coupled<float>>(
+                    "readers", models, cadmium::dynamic::modeling::Ports{typeid(readers_in)}, cadmium::dynamic::modeling::Ports{},
+                    eics, cadmium::dynamic::modeling::EOCs{}, cadmium::dynamic::modeling::ICs{}
+            );
+            return std::make_shared<cadmium::dynamic::modeling::coupled<float>>(
+                    "top",
+                    cadmium::dynamic::modeling::Models{make_dynamic_atomic_model<census, float>("census"), inner},
+                    cadmium::dynamic::modeling::Ports{}, cadmium::dynamic::modeling::Ports{},
+                    cadmium::dynamic::modeling::EICs{}, cadmium::dynamic::modeling::EOCs{},
+                    cadmium::dynamic::modeling::ICs{cadmium::dynamic::modeling::IC("census", "readers", make_link<census_out, readers_in>())}
+            );
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(copies_share_the_payload_until_modified_test) {
+        agents::copies = 0;
+        agents_message m = cadmium::make_shared_message<agents>(std::vector<int>{1, 2, 3});
+        agents_message copy = m;
+        BOOST_CHECK(copy.shares_payload(m));
+        BOOST_CHECK_EQUAL(m.use_count(), 2);
+        BOOST_CHECK_EQUAL(&copy.get(), &m.get());
+        BOOST_CHECK_EQUAL(agents::copies, 0);
+
+        copy.modify().ids.push_back(4);
+        BOOST_CHECK_EQUAL(agents::copies, 1);
+        BOOST_CHECK(!copy.shares_payload(m));
+        BOOST_CHECK_EQUAL(m->ids.size(), 3);
+        BOOST_CHECK_EQUAL(copy->ids.size(), 4);
+        BOOST_CHECK(copy != m);
+
+        // not shared anymore, modified in place
+        copy.modify().ids.push_back(5);
+        BOOST_CHECK_EQUAL(agents::copies, 1);
+        BOOST_CHECK(copy == agents_message(agents(std::vector<int>{1, 2, 3, 4, 5})));
+    }
+
+    BOOST_AUTO_TEST_CASE(shared_messages_are_encoded_with_their_payload_test) {
+        cadmium::shared_message<std::vector<int>> m(std::vector<int>{7, 8, 9});
+        BOOST_CHECK(cadmium::dynamic::message_codec<cadmium::shared_message<std::vector<int>>>::defined);
+        BOOST_CHECK(!cadmium::dynamic::message_codec<agents_message>::defined);
+
+        std::string bytes;
+        cadmium::dynamic::message_codec<cadmium::shared_message<std::vector<int>>>::encode(m, bytes);
+        const char* data = bytes.data();
+        auto decoded = cadmium::dynamic::message_codec<cadmium::shared_message<std::vector<int>>>::decode(data, bytes.data() + bytes.size());
+        BOOST_CHECK(data == bytes.data() + bytes.size());
+        BOOST_CHECK(!decoded.shares_payload(m));
+        BOOST_CHECK(decoded == m);
+    }
+
+    BOOST_AUTO_TEST_CASE(shared_messages_are_logged_as_their_payload_test) {
+        struct opaque {};
+        BOOST_CHECK(cadmium::logger::is_streamable<agents_message>::value);
+        BOOST_CHECK(!cadmium::logger::is_streamable<cadmium::shared_message<opaque>>::value);
+        std::ostringstream oss;
+        oss << cadmium::make_shared_message<agents>(std::vector<int>{1, 2});
+        BOOST_CHECK_EQUAL(oss.str(), "2 agents");
+    }
+
+    BOOST_AUTO_TEST_CASE(static_engine_routes_shared_messages_without_copying_payloads_test) {
+        agents::copies = 0;
+        received.clear();
+        cadmium::engine::runner<float, top, cadmium::logger::not_logger> r{0.0};
+        r.run_until_passivate();
+        BOOST_CHECK_EQUAL(agents::copies, 0);
+        // one payload for each of the three censuses
+        BOOST_CHECK_EQUAL(received.size(), 12);
+        BOOST_CHECK_EQUAL(payloads_received(), 3);
+    }
+
+    BOOST_AUTO_TEST_CASE(dynamic_engine_routes_shared_messages_without_copying_payloads_test) {
+        agents::copies = 0;
+        received.clear();
+        cadmium::dynamic::engine::runner<float, cadmium::logger::not_logger> r(make_top(), 0.0);
+        r.run_until_passivate();
+        BOOST_CHECK_EQUAL(agents::copies, 0);
+        BOOST_CHECK_EQUAL(received.size(), 24);
+        BOOST_CHECK_EQUAL(payloads_received(), 3);
+
+        agents::copies = 0;
+        received.clear();
+        cadmium::dynamic::engine::runner<float, cadmium::logger::not_logger> f(make_top(), 0.0, cadmium::dynamic::engine::flatten_hierarchy);
+        f.run_until_passivate();
+        BOOST_CHECK_EQUAL(agents::copies, 0);
+        BOOST_CHECK_EQUAL(received.size(), 24);
+        BOOST_CHECK_EQUAL(payloads_received(), 3);
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,278 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include <cadmium/modeling/ports.hpp>
+#include <cadmium/modeling/message_bag.hpp>
+#include <cadmium/modeling/coupling.hpp>
+#include <cadmium/engine/pdevs_runner.hpp>
+#include <cadmium/modeling/dynamic_coupled.hpp>
+#include <cadmium/modeling/dynamic_atomic.hpp>
+#include <cadmium/modeling/dynamic_model_translator.hpp>
+#include <cadmium/engine/pdevs_dynamic_runner.hpp>
+#include <cadmium/logger/common_loggers.hpp>
+
+/**
+ * Ports keeping their messages inside the bags, linked to ports of other inline capacities.
+ */
+
+BOOST_AUTO_TEST_SUITE(pdevs_small_message_bags_test_suite)
+
+    namespace {
+        struct inline_out : public cadmium::out_port<int, 1> {};
+        struct inline_in : public cadmium::in_port<int, 2> {};
+        struct vector_out : public cadmium::out_port<int, 0> {};
+        struct vector_in : public cadmium::in_port<int, 0> {};
+
+        // sends its counter, from 1 to 3, twice on each internal transition
+        template<typename TIME, typename OUT>
+        struct counter {
+            using input_ports = std::tuple<>;
+            using output_ports = std::tuple<OUT>;
+            using output_bags = typename cadmium::make_message_bags<output_ports>::type;
+            using state_type = int;
+            state_type state = 1;
+
+            void internal_transition() {
+                state++;
+            }
+
+            void external_transition(TIME, typename cadmium::make_message_bags<input_ports>::type) {}
+
+            void confluence_transition(TIME, typename cadmium::make_message_bags<input_ports>::type) {
+                internal_transition();
+            }
+
+            output_bags output() const {
+                output_bags bags;
+                cadmium::get_messages<OUT>(bags).push_back(state);
+                cadmium::get_messages<OUT>(bags).push_back(state);
+                return bags;
+            }
+
+            TIME time_advance() const {
+                return state <= 3 ? TIME(1) : std::numeric_limits<TIME>::infinity();
+            }
+        };
+
+        // adds all the messages received in its port, to the total of the port
+        template<typename TIME, typename IN>
+        struct adder {
+            using input_ports = std::tuple<IN>;
+            using output_ports = std::tuple<>;
+            using input_bags = typename cadmium::make_message_bags<input_ports>::type;
+            using state_type = int;
+            state_type state = 0;
+            static inline int total = 0;
+
+            void internal_transition() {}
+
+            void external_transition(TIME, const input_bags& mbs) {
+                for (int x : cadmium::get_messages<IN>(mbs)) {
+                    state += x;
+                    total += x;
+                }
+            }
+
+            void confluence_transition(TIME e, const input_bags& mbs) {
+                external_transition(e, mbs);
+            }
+
+            typename cadmium::make_message_bags<output_ports>::type output() const {
+                return {};
+            }
+
+            TIME time_advance() const {
+                return std::numeric_limits<TIME>::infinity();
+            }
+        };
+
+        template<typename TIME>
+        using inline_counter = counter<TIME, inline_out>;
+        template<typename TIME>
+        using inline_adder = adder<TIME, inline_in>;
+        template<typename TIME>
+        using vector_counter = counter<TIME, vector_out>;
+        template<typename TIME>
+        using vector_adder = adder<TIME, vector_in>;
+
+        struct top_out : public cadmium::out_port<int, 3> {};
+        struct sink_in : public cadmium::in_port<int, 1> {};
+
+        template<typename TIME>
+        using sink = adder<TIME, sink_in>;
+
+        // inline_counter -> inline_adder, inline_counter -> vector_adder, vector_counter -> inline_adder
+        template<typename TIME>
+        using counters = cadmium::modeling::pdevs::coupled_model<TIME, std::tuple<>, std::tuple<top_out>,
+                cadmium::modeling::models_tuple<inline_counter, vector_counter, inline_adder, vector_adder>, std::tuple<>,
+                std::tuple<cadmium::modeling::EOC<inline_counter, inline_out, top_out>>,
+                std::tuple<cadmium::modeling::IC<inline_counter, inline_out, inline_adder, inline_in>,
+                        cadmium::modeling::IC<inline_counter, inline_out, vector_adder, vector_in>,
+                        cadmium::modeling::IC<vector_counter, vector_out, inline_adder, inline_in>>>;
+
+        template<typename TIME>
+        using top = cadmium::modeling::pdevs::coupled_model<TIME, std::tuple<>, std::tuple<>,
+                cadmium::modeling::models_tuple<counters, sink>, std::tuple<>, std::tuple<>,
+                std::tuple<cadmium::modeling::IC<counters, top_out, sink, sink_in>>>;
+
+        std::shared_ptr<cadmium::dynamic::modeling::coupled<float>> make_top() {
+            using namespace cadmium::dynamic::translate;
+            auto inner = std::make_shared<cadmium::dynamic::modeling::coupled<float>>(
+                    "counters",
+                    cadmium::dynamic::modeling::Models{
+                            make_dynamic_atomic_model<inline_counter, float>("inline_counter"),
+                            make_dynamic_atomic_model<vector_counter, float>("vector_counter"),
+                            make_dynamic_atomic_model<inline_adder, float>("inline_adder"),
+                            make_dynamic_atomic_model<vector_adder, float>("vector_adder")},
+                    cadmium::dynamic::modeling::Ports{}, cadmium::dynamic::modeling::Ports{typeid(top_out)},
+                    cadmium::dynamic::modeling::EICs{},
+                    cadmium::dynamic::modeling::EOCs{cadmium::dynamic::modeling::EOC("inline_counter", make_link<inline_out, top_out>())},
+                    cadmium::dynamic::modeling::ICs{
+                            cadmium::dynamic::modeling::IC("inline_counter", "inline_adder", make_link<inline_out, inline_in>()),
+                            cadmium::dynamic::modeling::IC("inline_counter", "vector_adder", make_link<inline_out, vector_in>()),
+                            cadmium::dynamic::modeling::IC("vector_counter", "inline_adder", make_link<vector_out, inline_in>())}
+            );
+            return std::make_shared<cadmium::dynamic::modeling::coupled<float>>(
+                    "top",
+                    cadmium::dynamic::modeling::Models{inner, make_dynamic_atomic_model<sink, float>("sink")},
+                    cadmium::dynamic::modeling::Ports{}, cadmium::dynamic::modeling::Ports{},
+                    cadmium::dynamic::modeling::EICs{}, cadmium::dynamic::modeling::EOCs{},
+                    cadmium::dynamic::modeling::ICs{cadmium::dynamic::modeling::IC("counters", "sink", make_link<top_out, sink_in>())}
+            );
+        }
+
+        void reset_totals() {
+            inline_adder<float>::total = 0;
+            vector_adder<float>::total = 0;
+            sink<float>::total = 0;
+        }
+
+        // each counter sends 1, 1, 2, 2, 3, 3
+        void check_totals() {
+            BOOST_CHECK_EQUAL(inline_adder<float>::total, 24);
+            BOOST_CHECK_EQUAL(vector_adder<float>::total, 12);
+            BOOST_CHECK_EQUAL(sink<float>::total, 12);
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(ports_choose_the_messages_kept_inside_their_bags_test) {
+        BOOST_CHECK((std::is_same<cadmium::message_bag<inline_in>::bag_type, boost::container::small_vector<int, 2>>::value));
+        BOOST_CHECK((std::is_same<cadmium::message_bag<vector_in>::bag_type, std::vector<int>>::value));
+        BOOST_CHECK((std::is_same<cadmium::message_bag<cadmium::in_port<int>>::bag_type, cadmium::bag<int>>::value));
+
+        cadmium::make_message_bags<std::tuple<inline_in>>::type bags;
+        auto& messages = cadmium::get_messages<inline_in>(bags);
+        messages.push_back(1);
+        messages.push_back(2);
+        const char* first = reinterpret_cast<const char*>(&bags);
+        const char* data = reinterpret_cast<const char*>(messages.data());
+        BOOST_CHECK(data >= first && data < first + sizeof(bags));
+        messages.push_back(3);
+        BOOST_CHECK_EQUAL(messages.size(), 3);
+        BOOST_CHECK_EQUAL(messages[2], 3);
+    }
+
+    BOOST_AUTO_TEST_CASE(links_route_between_ports_of_different_inline_capacities_test) {
+        auto inline_to_vector = cadmium::dynamic::translate::make_link<inline_out, vector_in>();
+        auto vector_to_inline = cadmium::dynamic::translate::make_link<vector_out, inline_in>();
+
+        cadmium::dynamic::message_bags bags_from;
+        cadmium::message_bag<inline_out> inline_messages{4};
+        cadmium::message_bag<vector_out> vector_messages{5, 6, 7};
+        bags_from[typeid(inline_out)] = inline_messages;
+        bags_from[typeid(vector_out)] = vector_messages;
+
+        cadmium::dynamic::message_bags bags_to;
+        inline_to_vector->route_messages(bags_from, bags_to);
+        vector_to_inline->route_messages(bags_from, bags_to);
+        BOOST_CHECK((boost::any_cast<cadmium::message_bag<vector_in>&>(bags_to.at(typeid(vector_in))).messages == std::vector<int>{4}));
+        BOOST_CHECK((boost::any_cast<cadmium::message_bag<inline_in>&>(bags_to.at(typeid(inline_in))).messages == cadmium::message_bag<inline_in>::bag_type{5, 6, 7}));
+
+        // typed slots of atomic models
+        cadmium::message_bag<vector_in> slot;
+        inline_to_vector->route(cadmium::dynamic::port_endpoint{&inline_messages.messages, nullptr}, cadmium::dynamic::port_endpoint{&slot.messages, nullptr});
+        BOOST_CHECK((slot.messages == std::vector<int>{4}));
+
+        // chained through a port of another capacity
+        struct middle : public cadmium::out_port<int, 4> {};
+        auto chained = cadmium::dynamic::translate::make_link<vector_out, middle>()->chain(cadmium::dynamic::translate::make_link<middle, inline_in>());
+        cadmium::dynamic::message_bags chained_to;
+        chained->route_messages(bags_from, chained_to);
+        BOOST_CHECK((boost::any_cast<cadmium::message_bag<inline_in>&>(chained_to.at(typeid(inline_in))).messages == cadmium::message_bag<inline_in>::bag_type{5, 6, 7}));
+    }
+
+    BOOST_AUTO_TEST_CASE(links_route_bool_messages_test) {
+        // bags of bool ports keeping no messages inside are std::vector<bool>, packed in bits
+        struct packed_out : public cadmium::out_port<bool, 0> {};
+        struct packed_in : public cadmium::in_port<bool, 0> {};
+        struct inline_bool_in : public cadmium::in_port<bool, 2> {};
+        auto packed_to_packed = cadmium::dynamic::translate::make_link<packed_out, packed_in>();
+        auto packed_to_inline = cadmium::dynamic::translate::make_link<packed_out, inline_bool_in>();
+
+        cadmium::dynamic::message_bags bags_from;
+        bags_from[typeid(packed_out)] = cadmium::message_bag<packed_out>{true, false, true};
+
+        cadmium::dynamic::message_bags bags_to;
+        packed_to_packed->route_messages(bags_from, bags_to);
+        packed_to_inline->route_messages(bags_from, bags_to);
+        BOOST_CHECK((boost::any_cast<cadmium::message_bag<packed_in>&>(bags_to.at(typeid(packed_in))).messages == std::vector<bool>{true, false, true}));
+        BOOST_CHECK((boost::any_cast<cadmium::message_bag<inline_bool_in>&>(bags_to.at(typeid(inline_bool_in))).messages == cadmium::message_bag<inline_bool_in>::bag_type{true, false, true}));
+
+        // typed slots and encoded messages
+        cadmium::message_bag<packed_in> slot;
+        packed_to_packed->route(cadmium::dynamic::port_endpoint{nullptr, &bags_from}, cadmium::dynamic::port_endpoint{&slot.messages, nullptr});
+        std::string encoded;
+        packed_to_packed->encode_messages(cadmium::dynamic::port_endpoint{nullptr, &bags_from}, encoded);
+        packed_to_packed->decode_messages(encoded.data(), encoded.size(), cadmium::dynamic::port_endpoint{&slot.messages, nullptr});
+        BOOST_CHECK((slot.messages == std::vector<bool>{true, false, true, true, false, true}));
+    }
+
+    BOOST_AUTO_TEST_CASE(static_engine_routes_between_ports_of_different_inline_capacities_test) {
+        reset_totals();
+        cadmium::engine::runner<float, top, cadmium::logger::not_logger> r{0.0};
+        r.run_until_passivate();
+        check_totals();
+    }
+
+    BOOST_AUTO_TEST_CASE(dynamic_engine_routes_between_ports_of_different_inline_capacities_test) {
+        reset_totals();
+        cadmium::dynamic::engine::runner<float, cadmium::logger::not_logger> r(make_top(), 0.0);
+        r.run_until_passivate();
+        check_totals();
+
+        reset_totals();
+        cadmium::dynamic::engine::runner<float, cadmium::logger::not_logger> f(make_top(), 0.0, cadmium::dynamic::engine::flatten_hierarchy);
+        f.run_until_passivate();
+        check_totals();
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,153 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <cadmium/engine/work_stealing_executor.hpp>
+
+#ifdef CADMIUM_EXECUTE_CONCURRENT
+#include <cadmium/engine/concurrency_helpers.hpp>
+#endif //CADMIUM_EXECUTE_CONCURRENT
+
+/**
+ * This test is for the executor running the concurrent simulation phases of the dynamic engine
+ */
+BOOST_AUTO_TEST_SUITE(work_stealing_executor_test_suite)
+
+    namespace {
+        // work proportional to the index, so chunks have uneven costs
+        long uneven_work(std::size_t i) {
+            long acc = 0;
+            for (std::size_t k = 0; k < i * 50; k++) {
+                acc = (acc * 31 + k) % 1000003;
+            }
+            return acc;
+        }
+
+        template<typename RUN>
+        double elapsed_milliseconds(RUN run) {
+            auto start = std::chrono::steady_clock::now();
+            run();
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(parallel_for_visits_every_index_once_test) {
+        for (std::size_t threads : {1, 2, 4}) {
+            cadmium::concurrency::work_stealing_executor executor(threads);
+            BOOST_CHECK_EQUAL(executor.thread_count(), threads);
+            for (std::size_t size : {0, 1, 7, 1000}) {
+                std::vector<std::atomic<int>> visits(size);
+                auto visit = [&visits](std::size_t i) { visits[i]++; };
+                executor.parallel_for(size, visit);
+                for (const auto& v : visits) {
+                    BOOST_CHECK_EQUAL(v.load(), 1);
+                }
+            }
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(nested_parallel_for_runs_in_the_calling_thread_test) {
+        cadmium::concurrency::work_stealing_executor executor(3);
+        std::atomic<int> visits{0};
+        auto inner = [&visits](std::size_t i) { visits++; };
+        auto outer = [&executor, &inner](std::size_t i) { executor.parallel_for(10, inner); };
+        executor.parallel_for(10, outer);
+        BOOST_CHECK_EQUAL(visits.load(), 100);
+    }
+
+    BOOST_AUTO_TEST_CASE(parallel_for_rethrows_exceptions_test) {
+        cadmium::concurrency::work_stealing_executor executor(2);
+        auto fail = [](std::size_t i) {
+            if (i == 5) {
+                throw std::domain_error("failed task");
+            }
+        };
+        BOOST_CHECK_THROW(executor.parallel_for(100, fail), std::domain_error);
+
+        // the executor is still usable
+        std::atomic<int> visits{0};
+        auto visit = [&visits](std::size_t i) { visits++; };
+        executor.parallel_for(100, visit);
+        BOOST_CHECK_EQUAL(visits.load(), 100);
+    }
+
+    BOOST_AUTO_TEST_CASE(concurrent_for_each_processes_all_elements_test) {
+        cadmium::concurrency::work_stealing_executor executor(4);
+        std::vector<int> values(100);
+        std::iota(values.begin(), values.end(), 0);
+        auto twice = [](int& v) { v *= 2; };
+        cadmium::concurrency::concurrent_for_each(executor, values.begin(), values.end(), twice);
+        for (int i = 0; i < 100; i++) {
+            BOOST_CHECK_EQUAL(values[i], 2 * i);
+        }
+    }
+
+    // the times of each thread count are only reported, run with '--log_level=message' to compare them
+    BOOST_AUTO_TEST_CASE(uneven_work_gives_the_same_results_with_any_thread_count_test) {
+        const std::size_t size = 400;
+        const int steps = 20;
+        std::vector<long> expected(size);
+        for (std::size_t i = 0; i < size; i++) {
+            expected[i] = uneven_work(i);
+        }
+
+        for (std::size_t threads : {1, 2, 4}) {
+            cadmium::concurrency::work_stealing_executor executor(threads);
+            std::vector<long> results(size);
+            auto compute = [&results](std::size_t i) { results[i] = uneven_work(i); };
+            double ms = elapsed_milliseconds([&]() {
+                for (int s = 0; s < steps; s++) {
+                    executor.parallel_for(size, compute);
+                }
+            });
+            BOOST_CHECK(results == expected);
+            BOOST_TEST_MESSAGE("work stealing executor, " << threads << " threads: " << ms << " ms");
+
+            #ifdef CADMIUM_EXECUTE_CONCURRENT
+            boost::basic_thread_pool threadpool(threads);
+            std::vector<std::size_t> indexes(size);
+            std::iota(indexes.begin(), indexes.end(), 0);
+            std::vector<long> pool_results(size);
+            auto pool_compute = [&pool_results](std::size_t i) { pool_results[i] = uneven_work(i); };
+            double pool_ms = elapsed_milliseconds([&]() {
+                for (int s = 0; s < steps; s++) {
+                    cadmium::concurrency::concurrent_for_each(threadpool, indexes.begin(), indexes.end(), pool_compute);
+                }
+            });
+            BOOST_CHECK(pool_results == expected);
+            BOOST_TEST_MESSAGE("boost thread pool, " << threads << " threads: " << pool_ms << " ms");
+            #endif //CADMIUM_EXECUTE_CONCURRENT
+        }
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
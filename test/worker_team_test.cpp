@@ -0,0 +1,213 @@
+/**
+ * Copyright (c) 2026, Cadmium contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <cadmium/engine/worker_team.hpp>
+
+/**
+ * This test is for the persistent team running the phases of the dynamic engine steps
+ */
+BOOST_AUTO_TEST_SUITE(worker_team_test_suite)
+
+    BOOST_AUTO_TEST_CASE(run_phase_runs_every_participant_once_test) {
+        for (std::size_t threads : {1, 2, 4}) {
+            cadmium::concurrency::worker_team team(threads, false);
+            BOOST_CHECK_EQUAL(team.size(), threads);
+            for (bool active : {false, true}) {
+                if (active) {
+                    team.activate();
+                }
+                for (int phase = 0; phase < 50; phase++) {
+                    std::vector<std::atomic<int>> visits(threads);
+                    auto visit = [&visits](std::size_t p) { visits[p]++; };
+                    team.run_phase(visit);
+                    for (const auto& v : visits) {
+                        BOOST_CHECK_EQUAL(v.load(), 1);
+                    }
+                }
+                team.deactivate();
+            }
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(participants_run_in_their_own_thread_test) {
+        cadmium::concurrency::worker_team team(3, false);
+        cadmium::concurrency::worker_team::active_scope active(team);
+        std::vector<std::thread::id> ids(3);
+        auto record = [&ids](std::size_t p) { ids[p] = std::this_thread::get_id(); };
+        for (int phase = 0; phase < 10; phase++) {
+            team.run_phase(record);
+            // the caller is always the last participant, and each worker keeps its participant
+            BOOST_CHECK(ids[2] == std::this_thread::get_id());
+            BOOST_CHECK(ids[0] != ids[1] && ids[0] != ids[2] && ids[1] != ids[2]);
+        }
+        std::vector<std::thread::id> first = ids;
+        team.run_phase(record);
+        BOOST_CHECK(ids == first);
+    }
+
+    BOOST_AUTO_TEST_CASE(nested_run_phase_runs_in_the_calling_thread_test) {
+        cadmium::concurrency::worker_team team(3, false);
+        std::atomic<int> visits{0};
+        auto inner = [&visits](std::size_t p) { visits++; };
+        auto outer = [&team, &inner](std::size_t p) { team.run_phase(inner); };
+        team.run_phase(outer);
+        BOOST_CHECK_EQUAL(visits.load(), 9);
+    }
+
+    BOOST_AUTO_TEST_CASE(run_phase_rethrows_exceptions_test) {
+        cadmium::concurrency::worker_team team(2, false);
+        auto fail = [](std::size_t p) {
+            if (p == 0) {
+                throw std::domain_error("failed phase");
+            }
+        };
+        BOOST_CHECK_THROW(team.run_phase(fail), std::domain_error);
+
+        // the team is still usable
+        std::atomic<int> visits{0};
+        auto visit = [&visits](std::size_t p) { visits++; };
+        team.run_phase(visit);
+        BOOST_CHECK_EQUAL(visits.load(), 2);
+    }
+
+    BOOST_AUTO_TEST_CASE(for_each_selected_runs_indexes_in_their_owner_test) {
+        const std::size_t size = 100;
+        cadmium::concurrency::worker_team team(4, false);
+        cadmium::concurrency::worker_team::active_scope active(team);
+        std::vector<std::size_t> owners = cadmium::concurrency::contiguous_owners(size, team.size());
+        BOOST_CHECK_EQUAL(owners.front(), 0);
+        BOOST_CHECK_EQUAL(owners.back(), 3);
+
+        // a participant always runs in the same thread, so indexes with the same owner share their thread
+        std::vector<std::thread::id> ran_in(size);
+        auto record = [&ran_in](std::size_t i) { ran_in[i] = std::this_thread::get_id(); };
+        cadmium::concurrency::team_selection selection;
+        selection.reset(team.size());
+        for (std::size_t i = 0; i < size; i += 2) {
+            selection.add(owners[i], i);
+        }
+        BOOST_CHECK_EQUAL(selection.size(), size / 2);
+        cadmium::concurrency::for_each_selected(&team, selection, record);
+        for (std::size_t i = 0; i < size; i++) {
+            if (i % 2 == 1) {
+                BOOST_CHECK(ran_in[i] == std::thread::id());
+            } else if (i >= 2 && owners[i] == owners[i - 2]) {
+                BOOST_CHECK(ran_in[i] == ran_in[i - 2]);
+            } else if (i >= 2) {
+                BOOST_CHECK(ran_in[i] != ran_in[i - 2]);
+            }
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(balanced_owners_split_contiguous_blocks_of_similar_cost_test) {
+        // the cost is concentrated at the end, where a front of activity would be
+        std::vector<double> costs(12, 1.0);
+        costs[9] = costs[10] = costs[11] = 7.0;
+        std::vector<std::size_t> owners = cadmium::concurrency::balanced_owners(costs, 3);
+        std::vector<std::size_t> expected = {0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 2};
+        BOOST_CHECK_EQUAL_COLLECTIONS(owners.begin(), owners.end(), expected.begin(), expected.end());
+
+        // without measures the blocks have the same size
+        owners = cadmium::concurrency::balanced_owners(std::vector<double>(12, 0.0), 3);
+        expected = cadmium::concurrency::contiguous_owners(12, 3);
+        BOOST_CHECK_EQUAL_COLLECTIONS(owners.begin(), owners.end(), expected.begin(), expected.end());
+    }
+
+    BOOST_AUTO_TEST_CASE(processors_are_taken_node_by_node_test) {
+        std::vector<int> cpus = cadmium::concurrency::cpus_by_numa_node();
+        for (std::size_t i = 1; i < cpus.size(); i++) {
+            BOOST_CHECK(cadmium::concurrency::numa_node_of_cpu(cpus[i - 1]) <= cadmium::concurrency::numa_node_of_cpu(cpus[i]));
+        }
+
+        cadmium::concurrency::worker_team team(3);
+        for (std::size_t p = 0; p < team.size(); p++) {
+            if (cpus.empty()) {
+                BOOST_CHECK_EQUAL(team.node_of(p), 0);
+            } else {
+                BOOST_CHECK_EQUAL(team.node_of(p), cadmium::concurrency::numa_node_of_cpu(cpus[(p + 1) % team.size() % cpus.size()]));
+            }
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(caller_is_pinned_while_the_team_is_active_test) {
+        #ifdef __linux__
+        std::vector<int> cpus = cadmium::concurrency::cpus_by_numa_node();
+        if (cpus.empty()) {
+            return;
+        }
+        cpu_set_t before;
+        CPU_ZERO(&before);
+        pthread_getaffinity_np(pthread_self(), sizeof(before), &before);
+
+        cadmium::concurrency::worker_team team(2);
+        {
+            cadmium::concurrency::worker_team::active_scope active(team);
+            // nested scopes keep the caller pinned
+            {
+                cadmium::concurrency::worker_team::caller_scope pinned(team);
+            }
+            cpu_set_t during;
+            CPU_ZERO(&during);
+            pthread_getaffinity_np(pthread_self(), sizeof(during), &during);
+            BOOST_CHECK_EQUAL(CPU_COUNT(&during), 1);
+            BOOST_CHECK(CPU_ISSET(cpus[0], &during));
+        }
+        cpu_set_t after;
+        CPU_ZERO(&after);
+        pthread_getaffinity_np(pthread_self(), sizeof(after), &after);
+        BOOST_CHECK(CPU_EQUAL(&before, &after));
+        #endif //__linux__
+    }
+
+    BOOST_AUTO_TEST_CASE(active_team_phase_latency_test) {
+        const int phases = 2000;
+        cadmium::concurrency::worker_team team(2, false);
+        std::atomic<int> visits{0};
+        auto visit = [&visits](std::size_t p) { visits++; };
+        for (bool active : {false, true}) {
+            if (active) {
+                team.activate();
+            }
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < phases; i++) {
+                team.run_phase(visit);
+            }
+            std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+            BOOST_TEST_MESSAGE("worker team, " << (active ? "active" : "inactive") << ": " << elapsed.count() / phases << " us by phase");
+            team.deactivate();
+        }
+        BOOST_CHECK_EQUAL(visits.load(), 2 * 2 * phases);
+    }
+
+BOOST_AUTO_TEST_SUITE_END()